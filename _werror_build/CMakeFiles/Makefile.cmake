@@ -0,0 +1,95 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/cmake/CMakeBuild/cmake/modules/BBuildEnv.cmake"
+  "/root/repo/cmake/CMakeBuild/cmake/modules/BBuildEnvMingw.cmake"
+  "/root/repo/cmake/CMakeBuild/cmake/modules/BBuildEnvVersion.cmake"
+  "/root/repo/source/App/CodecBench/CMakeLists.txt"
+  "/root/repo/source/App/DecoderAnalyserApp/CMakeLists.txt"
+  "/root/repo/source/App/DecoderApp/CMakeLists.txt"
+  "/root/repo/source/App/EncoderApp/CMakeLists.txt"
+  "/root/repo/source/App/KernelBench/CMakeLists.txt"
+  "/root/repo/source/App/Parcat/CMakeLists.txt"
+  "/root/repo/source/App/SEIRemovalApp/CMakeLists.txt"
+  "/root/repo/source/Lib/CommonAnalyserLib/CMakeLists.txt"
+  "/root/repo/source/Lib/CommonLib/CMakeLists.txt"
+  "/root/repo/source/Lib/DecoderAnalyserLib/CMakeLists.txt"
+  "/root/repo/source/Lib/DecoderLib/CMakeLists.txt"
+  "/root/repo/source/Lib/EncoderLib/CMakeLists.txt"
+  "/root/repo/source/Lib/Utilities/CMakeLists.txt"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "source/Lib/CommonLib/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "source/Lib/CommonAnalyserLib/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "source/Lib/DecoderAnalyserLib/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "source/Lib/DecoderLib/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "source/Lib/EncoderLib/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "source/Lib/Utilities/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "source/App/DecoderAnalyserApp/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "source/App/DecoderApp/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "source/App/EncoderApp/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "source/App/SEIRemovalApp/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "source/App/Parcat/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "source/App/KernelBench/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "source/App/CodecBench/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "source/Lib/CommonLib/CMakeFiles/CommonLib.dir/DependInfo.cmake"
+  "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/DependInfo.cmake"
+  "source/Lib/DecoderAnalyserLib/CMakeFiles/DecoderAnalyserLib.dir/DependInfo.cmake"
+  "source/Lib/DecoderLib/CMakeFiles/DecoderLib.dir/DependInfo.cmake"
+  "source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/DependInfo.cmake"
+  "source/Lib/Utilities/CMakeFiles/Utilities.dir/DependInfo.cmake"
+  "source/App/DecoderAnalyserApp/CMakeFiles/DecoderAnalyserApp.dir/DependInfo.cmake"
+  "source/App/DecoderApp/CMakeFiles/DecoderApp.dir/DependInfo.cmake"
+  "source/App/EncoderApp/CMakeFiles/EncoderApp.dir/DependInfo.cmake"
+  "source/App/SEIRemovalApp/CMakeFiles/SEIRemovalApp.dir/DependInfo.cmake"
+  "source/App/Parcat/CMakeFiles/parcat.dir/DependInfo.cmake"
+  "source/App/KernelBench/CMakeFiles/kernel_bench.dir/DependInfo.cmake"
+  "source/App/CodecBench/CMakeFiles/codec_bench.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,19 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_werror_build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("source/Lib/CommonLib")
+subdirs("source/Lib/CommonAnalyserLib")
+subdirs("source/Lib/DecoderAnalyserLib")
+subdirs("source/Lib/DecoderLib")
+subdirs("source/Lib/EncoderLib")
+subdirs("source/Lib/Utilities")
+subdirs("source/App/DecoderAnalyserApp")
+subdirs("source/App/DecoderApp")
+subdirs("source/App/EncoderApp")
+subdirs("source/App/SEIRemovalApp")
+subdirs("source/App/Parcat")
+subdirs("source/App/KernelBench")
+subdirs("source/App/CodecBench")
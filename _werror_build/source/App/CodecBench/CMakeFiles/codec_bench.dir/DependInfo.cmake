@@ -0,0 +1,29 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/source/App/CodecBench/CodecBench.cpp" "source/App/CodecBench/CMakeFiles/codec_bench.dir/CodecBench.cpp.o" "gcc" "source/App/CodecBench/CMakeFiles/codec_bench.dir/CodecBench.cpp.o.d"
+  "/root/repo/source/App/CodecBench/CodecBenchCfg.cpp" "source/App/CodecBench/CMakeFiles/codec_bench.dir/CodecBenchCfg.cpp.o" "gcc" "source/App/CodecBench/CMakeFiles/codec_bench.dir/CodecBenchCfg.cpp.o.d"
+  "/root/repo/source/App/DecoderApp/DecApp.cpp" "source/App/CodecBench/CMakeFiles/codec_bench.dir/__/DecoderApp/DecApp.cpp.o" "gcc" "source/App/CodecBench/CMakeFiles/codec_bench.dir/__/DecoderApp/DecApp.cpp.o.d"
+  "/root/repo/source/App/DecoderApp/DecAppCfg.cpp" "source/App/CodecBench/CMakeFiles/codec_bench.dir/__/DecoderApp/DecAppCfg.cpp.o" "gcc" "source/App/CodecBench/CMakeFiles/codec_bench.dir/__/DecoderApp/DecAppCfg.cpp.o.d"
+  "/root/repo/source/App/EncoderApp/EncApp.cpp" "source/App/CodecBench/CMakeFiles/codec_bench.dir/__/EncoderApp/EncApp.cpp.o" "gcc" "source/App/CodecBench/CMakeFiles/codec_bench.dir/__/EncoderApp/EncApp.cpp.o.d"
+  "/root/repo/source/App/EncoderApp/EncAppCfg.cpp" "source/App/CodecBench/CMakeFiles/codec_bench.dir/__/EncoderApp/EncAppCfg.cpp.o" "gcc" "source/App/CodecBench/CMakeFiles/codec_bench.dir/__/EncoderApp/EncAppCfg.cpp.o.d"
+  "/root/repo/source/App/CodecBench/codecbenchmain.cpp" "source/App/CodecBench/CMakeFiles/codec_bench.dir/codecbenchmain.cpp.o" "gcc" "source/App/CodecBench/CMakeFiles/codec_bench.dir/codecbenchmain.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_werror_build/source/Lib/CommonLib/CMakeFiles/CommonLib.dir/DependInfo.cmake"
+  "/root/repo/_werror_build/source/Lib/EncoderLib/CMakeFiles/EncoderLib.dir/DependInfo.cmake"
+  "/root/repo/_werror_build/source/Lib/DecoderLib/CMakeFiles/DecoderLib.dir/DependInfo.cmake"
+  "/root/repo/_werror_build/source/Lib/Utilities/CMakeFiles/Utilities.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
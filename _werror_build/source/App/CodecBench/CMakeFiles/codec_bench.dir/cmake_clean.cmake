@@ -0,0 +1,23 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/umake/gcc-12.2/x86_64/release/codec_bench"
+  "/root/repo/bin/umake/gcc-12.2/x86_64/release/codec_bench.pdb"
+  "CMakeFiles/codec_bench.dir/CodecBench.cpp.o"
+  "CMakeFiles/codec_bench.dir/CodecBench.cpp.o.d"
+  "CMakeFiles/codec_bench.dir/CodecBenchCfg.cpp.o"
+  "CMakeFiles/codec_bench.dir/CodecBenchCfg.cpp.o.d"
+  "CMakeFiles/codec_bench.dir/__/DecoderApp/DecApp.cpp.o"
+  "CMakeFiles/codec_bench.dir/__/DecoderApp/DecApp.cpp.o.d"
+  "CMakeFiles/codec_bench.dir/__/DecoderApp/DecAppCfg.cpp.o"
+  "CMakeFiles/codec_bench.dir/__/DecoderApp/DecAppCfg.cpp.o.d"
+  "CMakeFiles/codec_bench.dir/__/EncoderApp/EncApp.cpp.o"
+  "CMakeFiles/codec_bench.dir/__/EncoderApp/EncApp.cpp.o.d"
+  "CMakeFiles/codec_bench.dir/__/EncoderApp/EncAppCfg.cpp.o"
+  "CMakeFiles/codec_bench.dir/__/EncoderApp/EncAppCfg.cpp.o.d"
+  "CMakeFiles/codec_bench.dir/codecbenchmain.cpp.o"
+  "CMakeFiles/codec_bench.dir/codecbenchmain.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/codec_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,10 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/source/App/CodecBench
+# Build directory: /root/repo/_werror_build/source/App/CodecBench
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(wpp_bit_equal "/usr/bin/cmake" "-DCODEC_BENCH=/root/repo/bin/umake/gcc-12.2/x86_64/release/codec_bench" "-DCFG_DIR=/root/repo/cfg" "-DWORK_DIR=/root/repo/_werror_build/source/App/CodecBench/wpp_bit_equal" "-DOPTION=NumWppThreads" "-DVALUES=1,2,4" "-DENCODER_ARGS=--EnsureWppBitEqual=1" "-DBENCH_ARGS=--Contents=gradient,text --Presets=randomaccess -wdt 384 -hgt 256 -f 2" "-P" "/root/repo/source/App/CodecBench/BitEqualTest.cmake")
+set_tests_properties(wpp_bit_equal PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/source/App/CodecBench/CMakeLists.txt;83;add_test;/root/repo/source/App/CodecBench/CMakeLists.txt;0;")
+add_test(split_bit_equal "/usr/bin/cmake" "-DCODEC_BENCH=/root/repo/bin/umake/gcc-12.2/x86_64/release/codec_bench" "-DCFG_DIR=/root/repo/cfg" "-DWORK_DIR=/root/repo/_werror_build/source/App/CodecBench/split_bit_equal" "-DOPTION=NumSplitThreads" "-DVALUES=1,2,4" "-DENCODER_ARGS=--EnsureSplitBitEqual=1" "-DBENCH_ARGS=--Contents=gradient,noise,text --Presets=randomaccess -wdt 128 -hgt 128 -f 3" "-P" "/root/repo/source/App/CodecBench/BitEqualTest.cmake")
+set_tests_properties(split_bit_equal PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/source/App/CodecBench/CMakeLists.txt;91;add_test;/root/repo/source/App/CodecBench/CMakeLists.txt;0;")
@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/source/App/KernelBench/KernelBench.cpp" "source/App/KernelBench/CMakeFiles/kernel_bench.dir/KernelBench.cpp.o" "gcc" "source/App/KernelBench/CMakeFiles/kernel_bench.dir/KernelBench.cpp.o.d"
+  "/root/repo/source/App/KernelBench/KernelBenchCfg.cpp" "source/App/KernelBench/CMakeFiles/kernel_bench.dir/KernelBenchCfg.cpp.o" "gcc" "source/App/KernelBench/CMakeFiles/kernel_bench.dir/KernelBenchCfg.cpp.o.d"
+  "/root/repo/source/App/KernelBench/kernelbenchmain.cpp" "source/App/KernelBench/CMakeFiles/kernel_bench.dir/kernelbenchmain.cpp.o" "gcc" "source/App/KernelBench/CMakeFiles/kernel_bench.dir/kernelbenchmain.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_werror_build/source/Lib/CommonLib/CMakeFiles/CommonLib.dir/DependInfo.cmake"
+  "/root/repo/_werror_build/source/Lib/Utilities/CMakeFiles/Utilities.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
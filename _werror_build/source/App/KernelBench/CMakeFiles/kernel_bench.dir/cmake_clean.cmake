@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/umake/gcc-12.2/x86_64/release/kernel_bench"
+  "/root/repo/bin/umake/gcc-12.2/x86_64/release/kernel_bench.pdb"
+  "CMakeFiles/kernel_bench.dir/KernelBench.cpp.o"
+  "CMakeFiles/kernel_bench.dir/KernelBench.cpp.o.d"
+  "CMakeFiles/kernel_bench.dir/KernelBenchCfg.cpp.o"
+  "CMakeFiles/kernel_bench.dir/KernelBenchCfg.cpp.o.d"
+  "CMakeFiles/kernel_bench.dir/kernelbenchmain.cpp.o"
+  "CMakeFiles/kernel_bench.dir/kernelbenchmain.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/kernel_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,98 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/source/Lib/CommonLib/AdaptiveLoopFilter.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/AdaptiveLoopFilter.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/AdaptiveLoopFilter.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/AffineGradientSearch.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/AffineGradientSearch.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/AffineGradientSearch.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/BitStream.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/BitStream.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/BitStream.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/Buffer.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/Buffer.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/Buffer.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/CacheModel.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/CacheModel.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/CacheModel.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/ChromaFormat.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/ChromaFormat.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/ChromaFormat.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/CodingStructure.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/CodingStructure.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/CodingStructure.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/ContextModelling.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/ContextModelling.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/ContextModelling.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/Contexts.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/Contexts.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/Contexts.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/CrossCompPrediction.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/CrossCompPrediction.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/CrossCompPrediction.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/DepQuant.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/DepQuant.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/DepQuant.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/Hash.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/Hash.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/Hash.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/IbcHashMap.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/IbcHashMap.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/IbcHashMap.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/InLoopFilterStage.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/InLoopFilterStage.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/InLoopFilterStage.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/InterPrediction.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/InterPrediction.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/InterPrediction.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/InterpolationFilter.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/InterpolationFilter.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/InterpolationFilter.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/IntraPrediction.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/IntraPrediction.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/IntraPrediction.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/LoopFilter.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/LoopFilter.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/LoopFilter.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/MCTS.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/MCTS.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/MCTS.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/MatrixIntraPrediction.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/MatrixIntraPrediction.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/MatrixIntraPrediction.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/Mv.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/Mv.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/Mv.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/PicYuvMD5.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/PicYuvMD5.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/PicYuvMD5.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/Picture.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/Picture.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/Picture.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/Quant.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/Quant.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/Quant.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/QuantRDOQ.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/QuantRDOQ.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/QuantRDOQ.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/RdCost.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/RdCost.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/RdCost.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/RdCostWeightPrediction.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/RdCostWeightPrediction.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/RdCostWeightPrediction.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/Reshape.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/Reshape.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/Reshape.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/Rom.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/Rom.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/Rom.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/RomLFNST.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/RomLFNST.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/RomLFNST.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/RomTr.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/RomTr.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/RomTr.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/SEI.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/SEI.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/SEI.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/SampleAdaptiveOffset.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/SampleAdaptiveOffset.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/SampleAdaptiveOffset.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/Slice.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/Slice.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/Slice.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/ThreadPool.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/ThreadPool.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/ThreadPool.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/TrQuant.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/TrQuant.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/TrQuant.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/TrQuant_EMT.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/TrQuant_EMT.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/TrQuant_EMT.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/Unit.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/Unit.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/Unit.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/UnitPartitioner.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/UnitPartitioner.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/UnitPartitioner.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/UnitTools.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/UnitTools.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/UnitTools.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/WeightPrediction.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/WeightPrediction.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/WeightPrediction.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/dtrace.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/dtrace.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/dtrace.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/dtrace_blockstatistics.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/dtrace_blockstatistics.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/dtrace_blockstatistics.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/CommonDefX86.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/CommonDefX86.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/CommonDefX86.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/InitX86.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/InitX86.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/InitX86.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx/AdaptiveLoopFilter_avx.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx/AdaptiveLoopFilter_avx.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx/AdaptiveLoopFilter_avx.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx/AffineGradientSearch_avx.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx/AffineGradientSearch_avx.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx/AffineGradientSearch_avx.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx/Buffer_avx.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx/Buffer_avx.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx/Buffer_avx.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx/InterpolationFilter_avx.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx/InterpolationFilter_avx.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx/InterpolationFilter_avx.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx/IntraPrediction_avx.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx/IntraPrediction_avx.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx/IntraPrediction_avx.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx/LoopFilter_avx.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx/LoopFilter_avx.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx/LoopFilter_avx.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx/MatrixIntraPrediction_avx.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx/MatrixIntraPrediction_avx.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx/MatrixIntraPrediction_avx.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx/RdCost_avx.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx/RdCost_avx.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx/RdCost_avx.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx/SampleAdaptiveOffset_avx.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx/SampleAdaptiveOffset_avx.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx/SampleAdaptiveOffset_avx.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx/TrQuant_avx.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx/TrQuant_avx.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx/TrQuant_avx.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx2/AdaptiveLoopFilter_avx2.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx2/AdaptiveLoopFilter_avx2.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx2/AdaptiveLoopFilter_avx2.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx2/AffineGradientSearch_avx2.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx2/AffineGradientSearch_avx2.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx2/AffineGradientSearch_avx2.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx2/Buffer_avx2.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx2/Buffer_avx2.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx2/Buffer_avx2.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx2/InterpolationFilter_avx2.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx2/InterpolationFilter_avx2.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx2/InterpolationFilter_avx2.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx2/IntraPrediction_avx2.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx2/IntraPrediction_avx2.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx2/IntraPrediction_avx2.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx2/LoopFilter_avx2.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx2/LoopFilter_avx2.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx2/LoopFilter_avx2.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx2/MatrixIntraPrediction_avx2.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx2/MatrixIntraPrediction_avx2.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx2/MatrixIntraPrediction_avx2.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx2/RdCost_avx2.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx2/RdCost_avx2.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx2/RdCost_avx2.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx2/SampleAdaptiveOffset_avx2.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx2/SampleAdaptiveOffset_avx2.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx2/SampleAdaptiveOffset_avx2.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx2/TrQuant_avx2.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx2/TrQuant_avx2.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx2/TrQuant_avx2.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx512/Buffer_avx512.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx512/Buffer_avx512.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx512/Buffer_avx512.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx512/InterpolationFilter_avx512.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx512/InterpolationFilter_avx512.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx512/InterpolationFilter_avx512.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/avx512/RdCost_avx512.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx512/RdCost_avx512.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/avx512/RdCost_avx512.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/sse41/AdaptiveLoopFilter_sse41.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/sse41/AdaptiveLoopFilter_sse41.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/sse41/AdaptiveLoopFilter_sse41.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/sse41/AffineGradientSearch_sse41.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/sse41/AffineGradientSearch_sse41.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/sse41/AffineGradientSearch_sse41.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/sse41/Buffer_sse41.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/sse41/Buffer_sse41.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/sse41/Buffer_sse41.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/sse41/InterpolationFilter_sse41.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/sse41/InterpolationFilter_sse41.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/sse41/InterpolationFilter_sse41.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/sse41/IntraPrediction_sse41.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/sse41/IntraPrediction_sse41.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/sse41/IntraPrediction_sse41.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/sse41/LoopFilter_sse41.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/sse41/LoopFilter_sse41.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/sse41/LoopFilter_sse41.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/sse41/MatrixIntraPrediction_sse41.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/sse41/MatrixIntraPrediction_sse41.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/sse41/MatrixIntraPrediction_sse41.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/sse41/RdCost_sse41.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/sse41/RdCost_sse41.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/sse41/RdCost_sse41.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/sse41/SampleAdaptiveOffset_sse41.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/sse41/SampleAdaptiveOffset_sse41.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/sse41/SampleAdaptiveOffset_sse41.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/sse41/TrQuant_sse41.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/sse41/TrQuant_sse41.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/sse41/TrQuant_sse41.cpp.o.d"
+  "/root/repo/source/Lib/CommonLib/x86/sse42/IbcHashmap_sse42.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/sse42/IbcHashmap_sse42.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/CommonLib/x86/sse42/IbcHashmap_sse42.cpp.o.d"
+  "/root/repo/source/Lib/libmd5/libmd5.cpp" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/libmd5/libmd5.cpp.o" "gcc" "source/Lib/CommonAnalyserLib/CMakeFiles/CommonAnalyserLib.dir/__/libmd5/libmd5.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,6 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/source/Lib/CommonAnalyserLib
+# Build directory: /root/repo/_werror_build/source/Lib/CommonAnalyserLib
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
@@ -0,0 +1,28 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/source/Lib/DecoderLib/AnnexBread.cpp" "source/Lib/DecoderLib/CMakeFiles/DecoderLib.dir/AnnexBread.cpp.o" "gcc" "source/Lib/DecoderLib/CMakeFiles/DecoderLib.dir/AnnexBread.cpp.o.d"
+  "/root/repo/source/Lib/DecoderLib/BinDecoder.cpp" "source/Lib/DecoderLib/CMakeFiles/DecoderLib.dir/BinDecoder.cpp.o" "gcc" "source/Lib/DecoderLib/CMakeFiles/DecoderLib.dir/BinDecoder.cpp.o.d"
+  "/root/repo/source/Lib/DecoderLib/CABACReader.cpp" "source/Lib/DecoderLib/CMakeFiles/DecoderLib.dir/CABACReader.cpp.o" "gcc" "source/Lib/DecoderLib/CMakeFiles/DecoderLib.dir/CABACReader.cpp.o.d"
+  "/root/repo/source/Lib/DecoderLib/DecCu.cpp" "source/Lib/DecoderLib/CMakeFiles/DecoderLib.dir/DecCu.cpp.o" "gcc" "source/Lib/DecoderLib/CMakeFiles/DecoderLib.dir/DecCu.cpp.o.d"
+  "/root/repo/source/Lib/DecoderLib/DecLib.cpp" "source/Lib/DecoderLib/CMakeFiles/DecoderLib.dir/DecLib.cpp.o" "gcc" "source/Lib/DecoderLib/CMakeFiles/DecoderLib.dir/DecLib.cpp.o.d"
+  "/root/repo/source/Lib/DecoderLib/DecSlice.cpp" "source/Lib/DecoderLib/CMakeFiles/DecoderLib.dir/DecSlice.cpp.o" "gcc" "source/Lib/DecoderLib/CMakeFiles/DecoderLib.dir/DecSlice.cpp.o.d"
+  "/root/repo/source/Lib/DecoderLib/NALread.cpp" "source/Lib/DecoderLib/CMakeFiles/DecoderLib.dir/NALread.cpp.o" "gcc" "source/Lib/DecoderLib/CMakeFiles/DecoderLib.dir/NALread.cpp.o.d"
+  "/root/repo/source/Lib/DecoderLib/SEIread.cpp" "source/Lib/DecoderLib/CMakeFiles/DecoderLib.dir/SEIread.cpp.o" "gcc" "source/Lib/DecoderLib/CMakeFiles/DecoderLib.dir/SEIread.cpp.o.d"
+  "/root/repo/source/Lib/DecoderLib/VLCReader.cpp" "source/Lib/DecoderLib/CMakeFiles/DecoderLib.dir/VLCReader.cpp.o" "gcc" "source/Lib/DecoderLib/CMakeFiles/DecoderLib.dir/VLCReader.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_werror_build/source/Lib/CommonLib/CMakeFiles/CommonLib.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
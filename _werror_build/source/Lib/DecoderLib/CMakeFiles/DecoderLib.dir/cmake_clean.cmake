@@ -0,0 +1,27 @@
+file(REMOVE_RECURSE
+  "/root/repo/lib/umake/gcc-12.2/x86_64/release/libDecoderLib.a"
+  "/root/repo/lib/umake/gcc-12.2/x86_64/release/libDecoderLib.pdb"
+  "CMakeFiles/DecoderLib.dir/AnnexBread.cpp.o"
+  "CMakeFiles/DecoderLib.dir/AnnexBread.cpp.o.d"
+  "CMakeFiles/DecoderLib.dir/BinDecoder.cpp.o"
+  "CMakeFiles/DecoderLib.dir/BinDecoder.cpp.o.d"
+  "CMakeFiles/DecoderLib.dir/CABACReader.cpp.o"
+  "CMakeFiles/DecoderLib.dir/CABACReader.cpp.o.d"
+  "CMakeFiles/DecoderLib.dir/DecCu.cpp.o"
+  "CMakeFiles/DecoderLib.dir/DecCu.cpp.o.d"
+  "CMakeFiles/DecoderLib.dir/DecLib.cpp.o"
+  "CMakeFiles/DecoderLib.dir/DecLib.cpp.o.d"
+  "CMakeFiles/DecoderLib.dir/DecSlice.cpp.o"
+  "CMakeFiles/DecoderLib.dir/DecSlice.cpp.o.d"
+  "CMakeFiles/DecoderLib.dir/NALread.cpp.o"
+  "CMakeFiles/DecoderLib.dir/NALread.cpp.o.d"
+  "CMakeFiles/DecoderLib.dir/SEIread.cpp.o"
+  "CMakeFiles/DecoderLib.dir/SEIread.cpp.o.d"
+  "CMakeFiles/DecoderLib.dir/VLCReader.cpp.o"
+  "CMakeFiles/DecoderLib.dir/VLCReader.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/DecoderLib.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,64 @@
+# Encoder determinism test, run by ctest
+#
+# Encodes the synthetic codec_bench contents once per value of an encoder option and fails if the bitstreams differ
+# or if a decoder output differs from the encoder reconstruction.
+#
+# parameters:
+#   CODEC_BENCH   codec_bench executable
+#   CFG_DIR       directory of the encoder configuration files
+#   WORK_DIR      directory for the generated sequences and bitstreams
+#   OPTION        encoder option to vary, e.g. NumWppThreads
+#   VALUES        comma separated values of the option
+#   ENCODER_ARGS  additional encoder options passed with every value (optional)
+#   BENCH_ARGS    additional codec_bench options, separated by spaces (optional)
+
+foreach( _var CODEC_BENCH CFG_DIR WORK_DIR OPTION VALUES )
+  if( NOT DEFINED ${_var} )
+    message( FATAL_ERROR "BitEqualTest: ${_var} is not set" )
+  endif()
+endforeach()
+
+string( REPLACE "," ";" _values "${VALUES}" )
+separate_arguments( _benchArgs UNIX_COMMAND "${BENCH_ARGS}" )
+
+unset( _refValue )
+foreach( _value IN LISTS _values )
+  set( _dir "${WORK_DIR}/${OPTION}_${_value}" )
+  file( REMOVE_RECURSE "${_dir}" )
+  file( MAKE_DIRECTORY "${_dir}" )
+
+  execute_process( COMMAND "${CODEC_BENCH}" --CfgDir=${CFG_DIR} --WorkDir=${_dir} --Output=${_dir}/codec_bench.json
+                           --KeepFiles=1 "--EncoderArgs=--${OPTION}=${_value} ${ENCODER_ARGS}" ${_benchArgs}
+                   RESULT_VARIABLE _result
+                   OUTPUT_FILE     "${_dir}/codec_bench.log"
+                   ERROR_FILE      "${_dir}/codec_bench.log" )
+  if( NOT _result EQUAL 0 )
+    message( FATAL_ERROR "${OPTION}=${_value}: codec_bench failed (${_result}), see ${_dir}/codec_bench.log" )
+  endif()
+
+  file( GLOB _bitstreams RELATIVE "${_dir}" "${_dir}/*.bin" )
+  list( SORT _bitstreams )
+  if( NOT _bitstreams )
+    message( FATAL_ERROR "${OPTION}=${_value}: no bitstreams written to ${_dir}" )
+  endif()
+
+  foreach( _bitstream IN LISTS _bitstreams )
+    file( MD5 "${_dir}/${_bitstream}" _md5 )
+    message( STATUS "${OPTION}=${_value}: ${_bitstream} ${_md5}" )
+
+    if( NOT DEFINED _refValue )
+      set( _refMd5_${_bitstream} ${_md5} )
+    elseif( NOT DEFINED _refMd5_${_bitstream} )
+      message( FATAL_ERROR "${OPTION}=${_value}: ${_bitstream} has no counterpart with ${OPTION}=${_refValue}" )
+    elseif( NOT _md5 STREQUAL _refMd5_${_bitstream} )
+      message( FATAL_ERROR "${OPTION}=${_value}: ${_bitstream} differs from the bitstream with ${OPTION}=${_refValue}" )
+    endif()
+  endforeach()
+
+  if( NOT DEFINED _refValue )
+    set( _refValue ${_value} )
+    set( _refBitstreams ${_bitstreams} )
+  elseif( NOT _bitstreams STREQUAL _refBitstreams )
+    message( FATAL_ERROR "${OPTION}=${_value}: other bitstreams written than with ${OPTION}=${_refValue}" )
+  endif()
+endforeach()
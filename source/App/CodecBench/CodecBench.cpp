@@ -0,0 +1,547 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     CodecBench.cpp
+    \brief    Codec benchmark class
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include "CodecBench.h"
+#include "../EncoderApp/EncApp.h"
+#include "../DecoderApp/DecApp.h"
+#include "libmd5/MD5.h"
+
+#if !defined( __linux__ ) && !defined( _WIN32 )
+#include <sys/resource.h>
+#endif
+
+//! \ingroup CodecBench
+//! \{
+
+// ====================================================================================================================
+// Local functions
+// ====================================================================================================================
+
+static void resetPeakRss()
+{
+#ifdef __linux__
+  // writing 5 resets the peak resident set size, without it the peak is the one of the whole process
+  std::ofstream clearRefs( "/proc/self/clear_refs" );
+  clearRefs << "5";
+#endif
+}
+
+static int64_t getPeakRssKb()
+{
+#if defined( __linux__ )
+  std::ifstream status( "/proc/self/status" );
+  std::string   line;
+  while( std::getline( status, line ) )
+  {
+    if( line.compare( 0, 6, "VmHWM:" ) == 0 )
+    {
+      return atoll( line.c_str() + 6 );
+    }
+  }
+  return -1;
+#elif !defined( _WIN32 )
+  struct rusage usage;
+  getrusage( RUSAGE_SELF, &usage );
+#ifdef __APPLE__
+  return usage.ru_maxrss >> 10;
+#else
+  return usage.ru_maxrss;
+#endif
+#else
+  return -1;
+#endif
+}
+
+static std::string fileMd5( const std::string& fileName )
+{
+  std::ifstream file( fileName.c_str(), std::ios::binary );
+  if( !file )
+  {
+    return std::string();
+  }
+
+  MD5                  md5;
+  std::vector<uint8_t> buf( 1 << 16 );
+  while( file )
+  {
+    file.read( ( char* ) buf.data(), buf.size() );
+    md5.update( buf.data(), ( uint32_t ) file.gcount() );
+  }
+
+  uint8_t digest[MD5_DIGEST_STRING_LENGTH];
+  md5.finalize( digest );
+
+  std::string result;
+  char        hex[3];
+  for( int i = 0; i < MD5_DIGEST_STRING_LENGTH; i++ )
+  {
+    snprintf( hex, sizeof( hex ), "%02x", digest[i] );
+    result += hex;
+  }
+  return result;
+}
+
+static int64_t fileSize( const std::string& fileName )
+{
+  std::ifstream file( fileName.c_str(), std::ios::binary | std::ios::ate );
+  return file ? ( int64_t ) file.tellg() : -1;
+}
+
+static bool fileExists( const std::string& fileName )
+{
+  return std::ifstream( fileName.c_str() ).good();
+}
+
+static std::string jsonString( const std::string& str )
+{
+  std::string result = "\"";
+  for( char c : str )
+  {
+    if( c == '"' || c == '\\' )
+    {
+      result += '\\';
+    }
+    result += c;
+  }
+  return result + "\"";
+}
+
+static void writeStage( FILE* file, const char* name, const double* fps, const std::string& indent, double seconds, double cpuSeconds, int64_t peakRssKb, bool last )
+{
+  fprintf( file, "%s\"%s\": { \"seconds\": %.3f, \"cpu_seconds\": %.3f, ", indent.c_str(), name, seconds, cpuSeconds );
+  if( fps )
+  {
+    fprintf( file, "\"fps\": %.3f, ", *fps );
+  }
+  fprintf( file, "\"peak_rss_kb\": %lld }%s\n", ( long long ) peakRssKb, last ? "" : "," );
+}
+
+// synthetic 8 bit 4:2:0 frames
+static inline int triangle( int val )
+{
+  val = ( ( val % 512 ) + 512 ) % 512;
+  return val < 256 ? val : 511 - val;
+}
+
+static void generateGradient( std::vector<uint8_t>& frame, int width, int height, int poc )
+{
+  uint8_t* lumaRow = frame.data();
+  for( int y = 0; y < height; y++, lumaRow += width )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      // two gradients moving in different directions
+      lumaRow[x] = 16 + ( triangle( 2 * x + y + 3 * poc ) + triangle( 3 * y - x - 5 * poc ) ) * 219 / 510;
+    }
+  }
+
+  uint8_t* cbRow = frame.data() + width * height;
+  uint8_t* crRow = cbRow + ( width >> 1 ) * ( height >> 1 );
+  for( int y = 0; y < ( height >> 1 ); y++, cbRow += width >> 1, crRow += width >> 1 )
+  {
+    for( int x = 0; x < ( width >> 1 ); x++ )
+    {
+      cbRow[x] = 64 + triangle( 3 * x + 2 * poc ) / 2;
+      crRow[x] = 64 + triangle( 2 * y - x - poc ) / 2;
+    }
+  }
+}
+
+static void generateNoise( std::vector<uint8_t>& frame, int width, int height, std::mt19937& rng )
+{
+  uint8_t* lumaRow = frame.data();
+  for( int y = 0; y < height; y++, lumaRow += width )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      // the noise is drawn from the raw generator output, so the sequence is the same with every standard library
+      lumaRow[x] = Clip3( 16, 235, 96 + 64 * x / width + int( rng() % 81 ) - 40 );
+    }
+  }
+
+  uint8_t* chroma = frame.data() + width * height;
+  for( int i = 0; i < ( width >> 1 ) * ( height >> 1 ) * 2; i++ )
+  {
+    chroma[i] = 116 + rng() % 25;
+  }
+}
+
+struct TextPage
+{
+  static const int cellWidth  = 8;
+  static const int cellHeight = 12;
+
+  std::vector<uint8_t>          glyphs;               ///< 16 glyphs of 7 rows with 5 bits each
+  std::vector<std::vector<int>> lines;                ///< glyph per character cell, -1 for a space
+  std::vector<int>              colours;              ///< colour index per line
+};
+
+static void createTextPage( TextPage& page, int width, int height, int numFrames, int scrollSpeed, std::mt19937& rng )
+{
+  page.glyphs.resize( 16 * 7 );
+  for( auto& row : page.glyphs )
+  {
+    row = 1 + rng() % 31;
+  }
+
+  const int numLines = ( height + numFrames * scrollSpeed ) / TextPage::cellHeight + 2;
+  const int numCells = width / TextPage::cellWidth;
+  page.lines.resize( numLines );
+  page.colours.resize( numLines );
+  for( int l = 0; l < numLines; l++ )
+  {
+    // indented lines of varying length with spaces between the words, some of them empty
+    const int indent = ( rng() % 4 ) * 2;
+    const int length = rng() % 5 ? indent + rng() % std::max( 1, numCells - indent ) : 0;
+    page.lines[l].assign( numCells, -1 );
+    for( int c = indent; c < length; c++ )
+    {
+      page.lines[l][c] = rng() % 6 ? int( rng() % 16 ) : -1;
+    }
+    page.colours[l] = rng() % 4;
+  }
+}
+
+static void generateText( std::vector<uint8_t>& frame, int width, int height, int poc, int scrollSpeed, const TextPage& page )
+{
+  // black, blue, red and green text on a white background
+  static const uint8_t textColours[4][3] = { { 16, 128, 128 }, { 41, 240, 110 }, { 81, 90, 240 }, { 145, 54, 34 } };
+  static const uint8_t background[3]     = { 235, 128, 128 };
+
+  const int cWidth  = width >> 1;
+  const int cHeight = height >> 1;
+  uint8_t*  planes[3] = { frame.data(), frame.data() + width * height, frame.data() + width * height + cWidth * cHeight };
+
+  for( int y = 0; y < height; y++ )
+  {
+    const int pageY  = y + poc * scrollSpeed;
+    const int line   = pageY / TextPage::cellHeight;
+    const int glyphY = pageY % TextPage::cellHeight - 2;
+
+    for( int x = 0; x < width; x++ )
+    {
+      const int cell   = x / TextPage::cellWidth;
+      const int glyphX = x % TextPage::cellWidth - 1;
+      const int glyph  = cell < ( int ) page.lines[line].size() ? page.lines[line][cell] : -1;
+      const bool ink   = glyph >= 0 && glyphX >= 0 && glyphX < 5 && glyphY >= 0 && glyphY < 7 && ( ( page.glyphs[glyph * 7 + glyphY] >> glyphX ) & 1 );
+      const uint8_t* colour = ink ? textColours[page.colours[line]] : background;
+
+      planes[0][y * width + x] = colour[0];
+      if( !( ( x | y ) & 1 ) )
+      {
+        planes[1][( y >> 1 ) * cWidth + ( x >> 1 )] = colour[1];
+        planes[2][( y >> 1 ) * cWidth + ( x >> 1 )] = colour[2];
+      }
+    }
+  }
+}
+
+// ====================================================================================================================
+// Constructor / destructor
+// ====================================================================================================================
+
+CodecBench::CodecBench()
+: m_simdName( "SCALAR" )
+{
+}
+
+CodecBench::~CodecBench()
+{
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+int CodecBench::run()
+{
+#if ENABLE_SIMD_OPT
+  m_simdName = read_x86_extension( m_simd );
+#endif
+
+  for( const std::string& preset : m_presets )
+  {
+    const std::string cfgFileName = m_cfgDir + "/encoder_" + preset + "_vtm.cfg";
+    if( !fileExists( cfgFileName ) )
+    {
+      EXIT( "Encoder configuration " << cfgFileName << " of preset " << preset << " not found" );
+    }
+  }
+
+  std::vector<std::pair<std::string, StageStats>> generate;
+  std::vector<RunStats>                           runs;
+  int                                             numMismatches = 0;
+
+  printf( "\n%-10s %-16s %10s %10s %10s %12s %12s  %s\n", "Content", "Preset", "kbps", "Enc fps", "Dec fps", "Enc RSS[kB]", "Dec RSS[kB]", "MD5" );
+
+  for( const std::string& content : m_contents )
+  {
+    const std::string inputFileName = xFileName( content, "", ".yuv" );
+    generate.push_back( std::make_pair( content, StageStats() ) );
+    xMeasureStage( generate.back().second, [&]() { xGenerate( content, inputFileName ); } );
+
+    for( const std::string& preset : m_presets )
+    {
+      const std::string bitstreamFileName = xFileName( content, preset, ".bin" );
+      const std::string reconFileName     = xFileName( content, preset, "_rec.yuv" );
+      const std::string decodedFileName   = xFileName( content, preset, "_dec.yuv" );
+
+      runs.push_back( RunStats() );
+      RunStats& stats = runs.back();
+      stats.content   = content;
+      stats.preset    = preset;
+
+      xMeasureStage( stats.encode, [&]() { xEncode( m_cfgDir + "/encoder_" + preset + "_vtm.cfg", inputFileName, bitstreamFileName, reconFileName ); } );
+      xMeasureStage( stats.decode, [&]() { stats.numHashErrors = xDecode( bitstreamFileName, decodedFileName ); } );
+      xMeasureStage( stats.verify, [&]()
+      {
+        stats.reconMd5   = fileMd5( reconFileName );
+        stats.decodedMd5 = fileMd5( decodedFileName );
+      } );
+      stats.bytes = fileSize( bitstreamFileName );
+
+      const bool match = !stats.reconMd5.empty() && stats.reconMd5 == stats.decodedMd5 && !stats.numHashErrors;
+      numMismatches += match ? 0 : 1;
+
+      printf( "%-10s %-16s %10.2f %10.3f %10.3f %12lld %12lld  %s\n", content.c_str(), preset.c_str(),
+              stats.bytes * 8.0 * m_frameRate / m_framesToBeEncoded / 1000.0,
+              m_framesToBeEncoded / stats.encode.seconds, m_framesToBeEncoded / stats.decode.seconds,
+              ( long long ) stats.encode.peakRssKb, ( long long ) stats.decode.peakRssKb, match ? "match" : "MISMATCH" );
+      fflush( stdout );
+
+      if( !m_keepFiles )
+      {
+        remove( bitstreamFileName.c_str() );
+        remove( reconFileName.c_str() );
+        remove( decodedFileName.c_str() );
+      }
+    }
+
+    if( !m_keepFiles )
+    {
+      remove( inputFileName.c_str() );
+    }
+  }
+
+  if( !xWriteReport( generate, runs, numMismatches ) )
+  {
+    EXIT( "Failed to write the report " << m_outputFileName );
+  }
+  printf( "\n%d runs, %d with decoder output different from the encoder reconstruction, report written to %s\n", ( int ) runs.size(), numMismatches, m_outputFileName.c_str() );
+
+  return numMismatches;
+}
+
+// ====================================================================================================================
+// Private member functions
+// ====================================================================================================================
+
+std::string CodecBench::xFileName( const std::string& content, const std::string& preset, const std::string& suffix ) const
+{
+  return m_workDir + "/codec_bench_" + content + ( preset.empty() ? "" : "_" + preset ) + suffix;
+}
+
+void CodecBench::xMeasureStage( StageStats& stats, const std::function<void()>& stage )
+{
+  resetPeakRss();
+
+  const auto    startTime  = std::chrono::steady_clock::now();
+  const clock_t startClock = clock();
+
+  stage();
+
+  stats.cpuSeconds = double( clock() - startClock ) / CLOCKS_PER_SEC;
+  stats.seconds    = std::chrono::duration<double>( std::chrono::steady_clock::now() - startTime ).count();
+  stats.peakRssKb  = getPeakRssKb();
+}
+
+void CodecBench::xGenerate( const std::string& content, const std::string& fileName )
+{
+  std::ofstream file( fileName.c_str(), std::ios::binary );
+  if( !file )
+  {
+    EXIT( "Failed to open " << fileName << " for writing" );
+  }
+
+  // every content starts from the seed, so the sequences do not depend on the selected contents
+  const int            scrollSpeed = 2;
+  std::mt19937         rng( m_seed );
+  std::vector<uint8_t> frame( m_sourceWidth * m_sourceHeight * 3 / 2 );
+  TextPage             page;
+
+  if( content == "text" )
+  {
+    createTextPage( page, m_sourceWidth, m_sourceHeight, m_framesToBeEncoded, scrollSpeed, rng );
+  }
+
+  for( int poc = 0; poc < m_framesToBeEncoded; poc++ )
+  {
+    if( content == "gradient" )
+    {
+      generateGradient( frame, m_sourceWidth, m_sourceHeight, poc );
+    }
+    else if( content == "noise" )
+    {
+      generateNoise( frame, m_sourceWidth, m_sourceHeight, rng );
+    }
+    else
+    {
+      generateText( frame, m_sourceWidth, m_sourceHeight, poc, scrollSpeed, page );
+    }
+    file.write( ( const char* ) frame.data(), frame.size() );
+  }
+
+  if( !file )
+  {
+    EXIT( "Failed to write " << fileName );
+  }
+}
+
+void CodecBench::xEncode( const std::string& cfgFileName, const std::string& inputFileName, const std::string& bitstreamFileName, const std::string& reconFileName )
+{
+  // the sequence options follow the preset, the additional options override both
+  std::vector<std::string> args = { "codec_bench", "-c", cfgFileName,
+                                    "--InputFile=" + inputFileName, "--BitstreamFile=" + bitstreamFileName, "--ReconFile=" + reconFileName,
+                                    "--SourceWidth=" + std::to_string( m_sourceWidth ), "--SourceHeight=" + std::to_string( m_sourceHeight ),
+                                    "--FrameRate=" + std::to_string( m_frameRate ), "--FramesToBeEncoded=" + std::to_string( m_framesToBeEncoded ),
+                                    "--TemporalSubsampleRatio=1", "--InputBitDepth=8", "--InputChromaFormat=420",
+                                    "--QP=" + std::to_string( m_qp ), "--SEIDecodedPictureHash=1", "--Verbosity=" + std::to_string( m_verbosity ) };
+  args.insert( args.end(), m_encoderArgs.begin(), m_encoderArgs.end() );
+
+  std::vector<char*> argv;
+  for( std::string& arg : args )
+  {
+    argv.push_back( &arg[0] );
+  }
+
+  EncApp* pcEncApp = new EncApp;
+  pcEncApp->create();
+
+  if( !pcEncApp->parseCfg( ( int ) argv.size(), argv.data() ) )
+  {
+    pcEncApp->destroy();
+    delete pcEncApp;
+    EXIT( "Invalid encoder configuration " << cfgFileName );
+  }
+
+  pcEncApp->encode();
+  pcEncApp->destroy();
+
+  delete pcEncApp;
+}
+
+uint32_t CodecBench::xDecode( const std::string& bitstreamFileName, const std::string& reconFileName )
+{
+  std::vector<std::string> args = { "codec_bench", "--BitstreamFile=" + bitstreamFileName, "--ReconFile=" + reconFileName };
+
+  std::vector<char*> argv;
+  for( std::string& arg : args )
+  {
+    argv.push_back( &arg[0] );
+  }
+
+  DecApp* pcDecApp = new DecApp;
+  if( !pcDecApp->parseCfg( ( int ) argv.size(), argv.data() ) )
+  {
+    delete pcDecApp;
+    EXIT( "Invalid decoder configuration" );
+  }
+
+  const uint32_t numHashErrors = pcDecApp->decode();
+
+  delete pcDecApp;
+
+  return numHashErrors;
+}
+
+bool CodecBench::xWriteReport( const std::vector<std::pair<std::string, StageStats>>& generate, const std::vector<RunStats>& runs, int numMismatches )
+{
+  FILE* file = fopen( m_outputFileName.c_str(), "w" );
+  if( !file )
+  {
+    return false;
+  }
+
+  fprintf( file, "{\n" );
+  fprintf( file, "  \"version\": %s,\n", jsonString( VTM_VERSION ).c_str() );
+  fprintf( file, "  \"simd\": %s,\n", jsonString( m_simdName ).c_str() );
+  fprintf( file, "  \"width\": %d,\n  \"height\": %d,\n  \"frames\": %d,\n  \"frame_rate\": %d,\n  \"qp\": %d,\n  \"seed\": %d,\n",
+           m_sourceWidth, m_sourceHeight, m_framesToBeEncoded, m_frameRate, m_qp, m_seed );
+
+  fprintf( file, "  \"contents\": [\n" );
+  for( size_t i = 0; i < generate.size(); i++ )
+  {
+    const StageStats& stats = generate[i].second;
+    fprintf( file, "    { \"name\": %s,\n", jsonString( generate[i].first ).c_str() );
+    writeStage( file, "generate", nullptr, "      ", stats.seconds, stats.cpuSeconds, stats.peakRssKb, true );
+    fprintf( file, "    }%s\n", i + 1 < generate.size() ? "," : "" );
+  }
+  fprintf( file, "  ],\n" );
+
+  fprintf( file, "  \"runs\": [\n" );
+  for( size_t i = 0; i < runs.size(); i++ )
+  {
+    const RunStats& stats  = runs[i];
+    const double    encFps = m_framesToBeEncoded / stats.encode.seconds;
+    const double    decFps = m_framesToBeEncoded / stats.decode.seconds;
+    const bool      match  = !stats.reconMd5.empty() && stats.reconMd5 == stats.decodedMd5 && !stats.numHashErrors;
+
+    fprintf( file, "    { \"content\": %s, \"preset\": %s,\n", jsonString( stats.content ).c_str(), jsonString( stats.preset ).c_str() );
+    fprintf( file, "      \"bytes\": %lld, \"kbps\": %.3f,\n", ( long long ) stats.bytes, stats.bytes * 8.0 * m_frameRate / m_framesToBeEncoded / 1000.0 );
+    writeStage( file, "encode", &encFps, "      ", stats.encode.seconds, stats.encode.cpuSeconds, stats.encode.peakRssKb, false );
+    writeStage( file, "decode", &decFps, "      ", stats.decode.seconds, stats.decode.cpuSeconds, stats.decode.peakRssKb, false );
+    writeStage( file, "verify", nullptr, "      ", stats.verify.seconds, stats.verify.cpuSeconds, stats.verify.peakRssKb, false );
+    fprintf( file, "      \"md5\": { \"reconstruction\": %s, \"decoded\": %s, \"hash_sei_errors\": %u, \"match\": %s }\n",
+             jsonString( stats.reconMd5 ).c_str(), jsonString( stats.decodedMd5 ).c_str(), stats.numHashErrors, match ? "true" : "false" );
+    fprintf( file, "    }%s\n", i + 1 < runs.size() ? "," : "" );
+  }
+  fprintf( file, "  ],\n" );
+
+  fprintf( file, "  \"mismatches\": %d\n", numMismatches );
+  fprintf( file, "}\n" );
+
+  return fclose( file ) == 0;
+}
+
+//! \}
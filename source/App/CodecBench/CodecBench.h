@@ -0,0 +1,102 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     CodecBench.h
+    \brief    Codec benchmark class (header)
+*/
+
+#ifndef __CODECBENCH__
+#define __CODECBENCH__
+
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "CommonLib/CommonDef.h"
+
+#include "CodecBenchCfg.h"
+
+//! \ingroup CodecBench
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// encodes synthetic sequences with the encoder presets, decodes them and reports the throughput as JSON
+class CodecBench : public CodecBenchCfg
+{
+public:
+  CodecBench();
+  virtual ~CodecBench();
+
+  int   run               (); ///< runs every content with every preset, returns the number of runs whose decoded output differs from the reconstruction
+
+private:
+  struct StageStats
+  {
+    double      seconds;                              ///< wall clock time
+    double      cpuSeconds;                           ///< processor time of all threads
+    int64_t     peakRssKb;                            ///< peak resident set size during the stage, -1 if unknown
+  };
+
+  struct RunStats
+  {
+    std::string content;
+    std::string preset;
+    int64_t     bytes;                                ///< bitstream size
+    StageStats  encode;
+    StageStats  decode;
+    StageStats  verify;
+    std::string reconMd5;                             ///< MD5 of the encoder reconstruction file
+    std::string decodedMd5;                           ///< MD5 of the decoder output file
+    uint32_t    numHashErrors;                        ///< pictures failing the decoded picture hash SEI check
+  };
+
+  std::string xFileName   ( const std::string& content, const std::string& preset, const std::string& suffix ) const;
+  void  xMeasureStage     ( StageStats& stats, const std::function<void()>& stage );
+  void  xGenerate         ( const std::string& content, const std::string& fileName );
+  void  xEncode           ( const std::string& cfgFileName, const std::string& inputFileName, const std::string& bitstreamFileName, const std::string& reconFileName );
+  uint32_t xDecode        ( const std::string& bitstreamFileName, const std::string& reconFileName );
+  bool  xWriteReport      ( const std::vector<std::pair<std::string, StageStats>>& generate, const std::vector<RunStats>& runs, int numMismatches );
+
+  std::string                         m_simdName;             ///< SIMD extension in use
+};
+
+//! \}
+
+#endif // __CODECBENCH__
@@ -0,0 +1,182 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     CodecBenchCfg.cpp
+    \brief    Codec benchmark configuration class
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <sstream>
+#include "CodecBenchCfg.h"
+#include "Utilities/program_options_lite.h"
+
+using namespace std;
+namespace po = df::program_options_lite;
+
+//! \ingroup CodecBench
+//! \{
+
+// ====================================================================================================================
+// Local functions
+// ====================================================================================================================
+
+static vector<string> splitList( const string& list, char separator )
+{
+  vector<string> items;
+  istringstream  stream( list );
+  string         item;
+
+  while( getline( stream, item, separator ) )
+  {
+    if( !item.empty() )
+    {
+      items.push_back( item );
+    }
+  }
+  return items;
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/** \param argc number of arguments
+    \param argv array of arguments
+ */
+bool CodecBenchCfg::parseCfg( int argc, char* argv[] )
+{
+  bool   do_help = false;
+  string contents;
+  string presets;
+  string encoderArgs;
+  po::Options opts;
+  opts.addOptions()
+
+  ("help",                      do_help,                               false,           "this help text")
+  ("Contents",                  contents,                              string("gradient,noise,text"), "comma separated list of synthetic contents: gradient (moving gradients), noise, text (scrolling screen content)")
+  ("Presets,p",                 presets,                               string("intra,randomaccess,lowdelay"), "comma separated list of encoder presets, preset <name> uses the configuration file encoder_<name>_vtm.cfg")
+  ("CfgDir",                    m_cfgDir,                              string("cfg"),   "directory of the encoder configuration files")
+  ("WorkDir",                   m_workDir,                             string("."),     "directory the sequences, bitstreams and reconstructions are written to")
+  ("Output,o",                  m_outputFileName,                      string("codec_bench.json"), "JSON report file name")
+  ("EncoderArgs",               encoderArgs,                           string(""),      "additional encoder options, separated by spaces, passed after the preset configuration")
+  ("SIMD",                      m_simd,                                string(""),      "SIMD extension to use (SCALAR, SSE41, SSE42, AVX, AVX2, AVX512), default: the highest supported extension")
+  ("SourceWidth,-wdt",          m_sourceWidth,                         416,             "width of the generated sequences")
+  ("SourceHeight,-hgt",         m_sourceHeight,                        240,             "height of the generated sequences")
+  ("FramesToBeEncoded,f",       m_framesToBeEncoded,                   8,               "number of frames generated and encoded per sequence")
+  ("FrameRate,-fr",             m_frameRate,                           30,              "frame rate of the generated sequences")
+  ("QP,q",                      m_qp,                                  32,              "Qp value")
+  ("Seed",                      m_seed,                                1,               "seed of the synthetic content generator")
+  ("Verbosity,v",               m_verbosity,                           (int)ERROR,      "verbosity of the encoder and the decoder")
+  ("KeepFiles",                 m_keepFiles,                           false,           "keep the generated sequences, bitstreams and reconstructions")
+  ;
+
+  po::setDefaults(opts);
+  po::ErrorReporter err;
+  const list<const char*>& argv_unhandled = po::scanArgv(opts, argc, (const char**) argv, err);
+
+  for (list<const char*>::const_iterator it = argv_unhandled.begin(); it != argv_unhandled.end(); it++)
+  {
+    std::cerr << "Unhandled argument ignored: "<< *it << std::endl;
+  }
+
+  if (do_help)
+  {
+    po::doHelp(cout, opts);
+    return false;
+  }
+
+  if (err.is_errored)
+  {
+    /* errors have already been reported to stderr */
+    return false;
+  }
+
+  m_contents    = splitList( contents, ',' );
+  m_presets     = splitList( presets, ',' );
+  m_encoderArgs = splitList( encoderArgs, ' ' );
+
+  for( const string& content : m_contents )
+  {
+    if( content != "gradient" && content != "noise" && content != "text" )
+    {
+      std::cerr << "Unknown content " << content << ", the contents are gradient, noise and text" << std::endl;
+      return false;
+    }
+  }
+  if( m_contents.empty() || m_presets.empty() )
+  {
+    std::cerr << "No content or no preset specified, aborting" << std::endl;
+    return false;
+  }
+
+  // the sizes are kept at multiples of the minimum CU size, so that neither the encoder nor the decoder pads or crops
+  if( m_sourceWidth <= 0 || m_sourceHeight <= 0 || ( m_sourceWidth & 7 ) || ( m_sourceHeight & 7 ) )
+  {
+    std::cerr << "The source width and height must be positive multiples of 8" << std::endl;
+    return false;
+  }
+  if( m_framesToBeEncoded <= 0 || m_frameRate <= 0 )
+  {
+    std::cerr << "The number of frames and the frame rate must be positive" << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+CodecBenchCfg::CodecBenchCfg()
+: m_contents()
+, m_presets()
+, m_cfgDir()
+, m_workDir()
+, m_outputFileName()
+, m_encoderArgs()
+, m_simd()
+, m_sourceWidth( 0 )
+, m_sourceHeight( 0 )
+, m_framesToBeEncoded( 0 )
+, m_frameRate( 0 )
+, m_qp( 0 )
+, m_seed( 1 )
+, m_verbosity( ERROR )
+, m_keepFiles( false )
+{
+}
+
+CodecBenchCfg::~CodecBenchCfg()
+{
+}
+
+//! \}
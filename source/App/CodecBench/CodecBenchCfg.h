@@ -0,0 +1,85 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     CodecBenchCfg.h
+    \brief    Codec benchmark configuration class (header)
+*/
+
+#ifndef __CODECBENCHCFG__
+#define __CODECBENCHCFG__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include "CommonLib/CommonDef.h"
+#include <string>
+#include <vector>
+
+//! \ingroup CodecBench
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// codec benchmark configuration class
+class CodecBenchCfg
+{
+protected:
+  std::vector<std::string> m_contents;                ///< synthetic contents the sequences are generated with
+  std::vector<std::string> m_presets;                 ///< encoder configurations, cfg/encoder_<preset>_vtm.cfg
+  std::string              m_cfgDir;                  ///< directory of the encoder configuration files
+  std::string              m_workDir;                 ///< directory of the generated sequences, bitstreams and reconstructions
+  std::string              m_outputFileName;          ///< JSON report file name
+  std::vector<std::string> m_encoderArgs;             ///< additional encoder options, passed after the preset
+  std::string              m_simd;                    ///< SIMD extension used by the encoder and the decoder
+  int                      m_sourceWidth;
+  int                      m_sourceHeight;
+  int                      m_framesToBeEncoded;
+  int                      m_frameRate;
+  int                      m_qp;
+  int                      m_seed;                    ///< seed of the synthetic content generator
+  int                      m_verbosity;               ///< verbosity of the encoder and the decoder
+  bool                     m_keepFiles;               ///< keep the generated sequences, bitstreams and reconstructions
+
+public:
+  CodecBenchCfg();
+  virtual ~CodecBenchCfg();
+
+  bool  parseCfg        ( int argc, char* argv[] );   ///< initialize option class from configuration
+};
+
+//! \}
+
+#endif  // __CODECBENCHCFG__
@@ -78,14 +78,12 @@ uint32_t DecApp::decode()
   int                 poc;
   PicList* pcListPic = NULL;
 
-  ifstream bitstreamFile(m_bitstreamFileName.c_str(), ifstream::in | ifstream::binary);
-  if (!bitstreamFile)
+  InputByteBuffer bytestream;
+  if (!bytestream.open(m_bitstreamFileName))
   {
     EXIT( "Failed to open bitstream file " << m_bitstreamFileName.c_str() << " for reading" ) ;
   }
 
-  InputByteStream bytestream(bitstreamFile);
-
   if (!m_outputDecodedSEIMessagesFilename.empty() && m_outputDecodedSEIMessagesFilename!="-")
   {
     m_seiMessageFileStream.open(m_outputDecodedSEIMessagesFilename.c_str(), std::ios::out);
@@ -114,7 +112,7 @@ uint32_t DecApp::decode()
   bool openedReconFile = false; // reconstruction file not yet opened. (must be performed after SPS is seen)
   bool loopFiltered = false;
 
-  while (!!bitstreamFile)
+  while (!bytestream.eof())
   {
     /* location serves to work around a design fault in the decoder, whereby
      * the process of reading a new slice that is the first slice of a new frame
@@ -128,11 +126,7 @@ uint32_t DecApp::decode()
     CodingStatistics::CodingStatisticsData* backupStats = new CodingStatistics::CodingStatisticsData(CodingStatistics::GetStatistics());
 #endif
 
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-    streampos location = bitstreamFile.tellg() - streampos(bytestream.GetNumBufferedBytes());
-#else
-    streampos location = bitstreamFile.tellg();
-#endif
+    size_t location = bytestream.getPos();
     AnnexBStats stats = AnnexBStats();
 
     InputNALUnit nalu;
@@ -162,18 +156,10 @@ uint32_t DecApp::decode()
         bNewPicture = m_cDecLib.decode(nalu, m_iSkipFrame, m_iPOCLastDisplay);
         if (bNewPicture)
         {
-          bitstreamFile.clear();
-          /* location points to the current nalunit payload[1] due to the
-           * need for the annexB parser to read three extra bytes.
-           * [1] except for the first NAL unit in the file
-           *     (but bNewPicture doesn't happen then) */
+          /* location points to the start of the current nalunit */
+          bytestream.setPos(location);
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-          bitstreamFile.seekg(location);
-          bytestream.reset();
           CodingStatistics::SetStatistics(*backupStats);
-#else
-          bitstreamFile.seekg(location-streamoff(3));
-          bytestream.reset();
 #endif
         }
       }
@@ -181,9 +167,9 @@ uint32_t DecApp::decode()
 
 
 
-    if( ( bNewPicture || !bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS ) && !m_cDecLib.getFirstSliceInSequence() )
+    if( ( bNewPicture || bytestream.eof() || nalu.m_nalUnitType == NAL_UNIT_EOS ) && !m_cDecLib.getFirstSliceInSequence() )
     {
-      if (!loopFiltered || bitstreamFile)
+      if (!loopFiltered || !bytestream.eof())
       {
         m_cDecLib.executeLoopFilters();
         m_cDecLib.finishPicture( poc, pcListPic );
@@ -195,7 +181,7 @@ uint32_t DecApp::decode()
       }
 
     }
-    else if ( (bNewPicture || !bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS ) &&
+    else if ( (bNewPicture || bytestream.eof() || nalu.m_nalUnitType == NAL_UNIT_EOS ) &&
               m_cDecLib.getFirstSliceInSequence () )
     {
       m_cDecLib.setFirstSliceInPicture (true);
@@ -220,6 +206,7 @@ uint32_t DecApp::decode()
         }
 
         m_cVideoIOYuvReconFile.open( m_reconFileName, true, m_outputBitDepth, m_outputBitDepth, bitDepths.recon ); // write mode
+        m_cVideoIOYuvReconWriter.create( m_cVideoIOYuvReconFile, m_asyncIOFrames );
         openedReconFile = true;
       }
       // write reconstruction to file
@@ -294,6 +281,8 @@ void DecApp::xCreateDecLib()
   initROM();
 
   // create decoder class
+  m_cDecLib.setNumDecThreads( m_numDecThreads );
+  m_cDecLib.setMaxPicsInFlight( m_maxPicsInFlight );
   m_cDecLib.create();
 
   // initialize decoder class
@@ -314,6 +303,8 @@ void DecApp::xDestroyDecLib()
 {
   if ( !m_reconFileName.empty() )
   {
+    m_cVideoIOYuvReconWriter.flush();
+    m_cVideoIOYuvReconWriter.destroy();
     m_cVideoIOYuvReconFile.close();
   }
 
@@ -392,6 +383,8 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
       {
         // write to file
         numPicsNotYetDisplayed = numPicsNotYetDisplayed-2;
+        pcPicTop->waitForReconstruction();
+        pcPicBottom->waitForReconstruction();
         if ( !m_reconFileName.empty() )
         {
           const Window &conf = pcPicTop->cs->sps->getConformanceWindow();
@@ -411,14 +404,14 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
 
           if (display)
           {
-            m_cVideoIOYuvReconFile.write( pcPicTop->getRecoBuf(), pcPicBottom->getRecoBuf(),
-                                          m_outputColourSpaceConvert,
-                                          false, // TODO: m_packedYUVMode,
-                                          conf.getWindowLeftOffset()   + defDisp.getWindowLeftOffset(),
-                                          conf.getWindowRightOffset()  + defDisp.getWindowRightOffset(),
-                                          conf.getWindowTopOffset()    + defDisp.getWindowTopOffset(),
-                                          conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(),
-                                          NUM_CHROMA_FORMAT, isTff );
+            m_cVideoIOYuvReconWriter.write( pcPicTop->getRecoBuf(), pcPicBottom->getRecoBuf(),
+                                            m_outputColourSpaceConvert,
+                                            false, // TODO: m_packedYUVMode,
+                                            conf.getWindowLeftOffset()   + defDisp.getWindowLeftOffset(),
+                                            conf.getWindowRightOffset()  + defDisp.getWindowRightOffset(),
+                                            conf.getWindowTopOffset()    + defDisp.getWindowTopOffset(),
+                                            conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(),
+                                            NUM_CHROMA_FORMAT, isTff );
           }
         }
 
@@ -457,20 +450,22 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
           dpbFullness--;
         }
 
+        // the in-loop filters might still run in the frame pipeline of the decoder
+        pcPic->waitForReconstruction();
 
         if (!m_reconFileName.empty())
         {
           const Window &conf    = pcPic->cs->sps->getConformanceWindow();
           const Window  defDisp = (m_respectDefDispWindow && pcPic->cs->sps->getVuiParametersPresentFlag()) ? pcPic->cs->sps->getVuiParameters()->getDefaultDisplayWindow() : Window();
 
-          m_cVideoIOYuvReconFile.write( pcPic->getRecoBuf(),
-                                        m_outputColourSpaceConvert,
-                                        m_packedYUVMode,
-                                        conf.getWindowLeftOffset()   + defDisp.getWindowLeftOffset(),
-                                        conf.getWindowRightOffset()  + defDisp.getWindowRightOffset(),
-                                        conf.getWindowTopOffset()    + defDisp.getWindowTopOffset(),
-                                        conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(),
-                                        NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
+          m_cVideoIOYuvReconWriter.write( pcPic->getRecoBuf(),
+                                          m_outputColourSpaceConvert,
+                                          m_packedYUVMode,
+                                          conf.getWindowLeftOffset()   + defDisp.getWindowLeftOffset(),
+                                          conf.getWindowRightOffset()  + defDisp.getWindowRightOffset(),
+                                          conf.getWindowTopOffset()    + defDisp.getWindowTopOffset(),
+                                          conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(),
+                                          NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
         }
 
         if (m_seiMessageFileStream.is_open())
@@ -502,6 +497,9 @@ void DecApp::xFlushOutput( PicList* pcListPic )
   {
     return;
   }
+  // all pictures get destroyed, none may still be filtered
+  m_cDecLib.finishPendingPictures();
+
   PicList::iterator iterPic   = pcListPic->begin();
 
   iterPic   = pcListPic->begin();
@@ -527,14 +525,14 @@ void DecApp::xFlushOutput( PicList* pcListPic )
           const Window  defDisp = (m_respectDefDispWindow && pcPicTop->cs->sps->getVuiParametersPresentFlag()) ? pcPicTop->cs->sps->getVuiParameters()->getDefaultDisplayWindow() : Window();
           const bool    isTff   = pcPicTop->topField;
 
-          m_cVideoIOYuvReconFile.write( pcPicTop->getRecoBuf(), pcPicBottom->getRecoBuf(),
-                                        m_outputColourSpaceConvert,
-                                        false, // TODO: m_packedYUVMode,
-                                        conf.getWindowLeftOffset()   + defDisp.getWindowLeftOffset(),
-                                        conf.getWindowRightOffset()  + defDisp.getWindowRightOffset(),
-                                        conf.getWindowTopOffset()    + defDisp.getWindowTopOffset(),
-                                        conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(),
-                                        NUM_CHROMA_FORMAT, isTff );
+          m_cVideoIOYuvReconWriter.write( pcPicTop->getRecoBuf(), pcPicBottom->getRecoBuf(),
+                                          m_outputColourSpaceConvert,
+                                          false, // TODO: m_packedYUVMode,
+                                          conf.getWindowLeftOffset()   + defDisp.getWindowLeftOffset(),
+                                          conf.getWindowRightOffset()  + defDisp.getWindowRightOffset(),
+                                          conf.getWindowTopOffset()    + defDisp.getWindowTopOffset(),
+                                          conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(),
+                                          NUM_CHROMA_FORMAT, isTff );
         }
 
         // update POC of display order
@@ -582,14 +580,14 @@ void DecApp::xFlushOutput( PicList* pcListPic )
           const Window &conf    = pcPic->cs->sps->getConformanceWindow();
           const Window  defDisp = (m_respectDefDispWindow && pcPic->cs->sps->getVuiParametersPresentFlag()) ? pcPic->cs->sps->getVuiParameters()->getDefaultDisplayWindow() : Window();
 
-          m_cVideoIOYuvReconFile.write( pcPic->getRecoBuf(),
-                                        m_outputColourSpaceConvert,
-                                        m_packedYUVMode,
-                                        conf.getWindowLeftOffset()   + defDisp.getWindowLeftOffset(),
-                                        conf.getWindowRightOffset()  + defDisp.getWindowRightOffset(),
-                                        conf.getWindowTopOffset()    + defDisp.getWindowTopOffset(),
-                                        conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(),
-                                        NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
+          m_cVideoIOYuvReconWriter.write( pcPic->getRecoBuf(),
+                                          m_outputColourSpaceConvert,
+                                          m_packedYUVMode,
+                                          conf.getWindowLeftOffset()   + defDisp.getWindowLeftOffset(),
+                                          conf.getWindowRightOffset()  + defDisp.getWindowRightOffset(),
+                                          conf.getWindowTopOffset()    + defDisp.getWindowTopOffset(),
+                                          conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(),
+                                          NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
         }
 
         if (m_seiMessageFileStream.is_open())
@@ -43,6 +43,7 @@
 #endif // _MSC_VER > 1000
 
 #include "Utilities/VideoIOYuv.h"
+#include "Utilities/VideoIOYuvAsync.h"
 #include "Utilities/ColourRemapping.h"
 #include "CommonLib/Picture.h"
 #include "DecoderLib/DecLib.h"
@@ -62,6 +63,7 @@ private:
   // class interface
   DecLib          m_cDecLib;                     ///< decoder class
   VideoIOYuv      m_cVideoIOYuvReconFile;        ///< reconstruction YUV class
+  VideoIOYuvWriteBehind m_cVideoIOYuvReconWriter; ///< writes the reconstruction file on a background thread
 
   // for output control
   int             m_iPOCLastDisplay;              ///< last POC in display order
@@ -113,6 +113,9 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
                                                                                    "\t3: enable bit and tool statistic\n")
 #endif
   ("MCTSCheck",                m_mctsCheck,                           false,       "If enabled, the decoder checks for violations of mc_exact_sample_value_match_flag in Temporal MCTS ")
+  ("NumThreads",                m_numDecThreads,                       1,           "Number of threads used to decode the tiles and WPP CTU rows of a slice, to filter CTU rows and to decode consecutive pictures in parallel (1: single threaded)")
+  ("MaxPicsInFlight",           m_maxPicsInFlight,                     2,           "Maximum number of pictures decoded or in-loop filtered at the same time when using more than one thread (1: no frame pipelining)")
+  ("AsyncIOFrames",             m_asyncIOFrames,                       2,           "Number of decoded frames written behind on a background thread (0: synchronous file output)")
   ;
 
   po::setDefaults(opts);
@@ -163,6 +166,24 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
     return false;
   }
 
+  if (m_numDecThreads < 1)
+  {
+    msg( ERROR, "NumThreads has to be at least 1\n");
+    return false;
+  }
+
+  if (m_maxPicsInFlight < 1)
+  {
+    msg( ERROR, "MaxPicsInFlight has to be at least 1\n");
+    return false;
+  }
+
+  if (m_asyncIOFrames < 0)
+  {
+    msg( ERROR, "AsyncIOFrames cannot be negative\n");
+    return false;
+  }
+
   if (m_bitstreamFileName.empty())
   {
     msg( ERROR, "No input file specified, aborting\n");
@@ -233,6 +254,9 @@ DecAppCfg::DecAppCfg()
 , m_packedYUVMode(false)
 , m_statMode(0)
 , m_mctsCheck(false)
+, m_numDecThreads(1)
+, m_maxPicsInFlight(2)
+, m_asyncIOFrames(2)
 {
   for (uint32_t channelTypeIndex = 0; channelTypeIndex < MAX_NUM_CHANNEL_TYPE; channelTypeIndex++)
   {
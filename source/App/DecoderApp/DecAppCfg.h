@@ -74,6 +74,9 @@ protected:
   std::string   m_cacheCfgFile;                       ///< Config file of cache model
   int           m_statMode;                           ///< Config statistic mode (0 - bit stat, 1 - tool stat, 3 - both)
   bool          m_mctsCheck;
+  int           m_numDecThreads;                      ///< number of threads for parallel substream decoding
+  int           m_maxPicsInFlight;                    ///< bound of the frame pipeline
+  int           m_asyncIOFrames;                      ///< number of decoded frames written behind by the I/O thread
 
 public:
   DecAppCfg();
@@ -586,6 +586,8 @@ void EncApp::xInitLibCfg()
   m_cEncLib.setStopAfterFFtoPOC                                  ( m_stopAfterFFtoPOC );
   m_cEncLib.setBs2ModPOCAndType                                  ( m_bs2ModPOCAndType );
   m_cEncLib.setDebugCTU                                          ( m_debugCTU );
+  m_cEncLib.setNumThreads                                        ( m_numThreads );
+  m_cEncLib.setModeProfile                                       ( m_modeProfile );
 #if ENABLE_SPLIT_PARALLELISM
   m_cEncLib.setNumSplitThreads                                   ( m_numSplitThreads );
   m_cEncLib.setForceSingleSplitThread                            ( m_forceSplitSequential );
@@ -627,6 +629,7 @@ void EncApp::xCreateLib( std::list<PelUnitBuf*>& recBufList
     }
 
     m_cVideoIOYuvReconFile.open(m_reconFileName, true, m_outputBitDepth, m_outputBitDepth, m_internalBitDepth);  // write mode
+    m_cVideoIOYuvReconWriter.create( m_cVideoIOYuvReconFile, m_asyncIOFrames );
   }
 
   // create the encoder
@@ -642,6 +645,9 @@ void EncApp::xCreateLib( std::list<PelUnitBuf*>& recBufList
 void EncApp::xDestroyLib()
 {
   // Video I/O
+  m_cVideoIOYuvInputReader.destroy();
+  m_cVideoIOYuvReconWriter.flush();
+  m_cVideoIOYuvReconWriter.destroy();
   m_cVideoIOYuvInputFile.close();
   m_cVideoIOYuvReconFile.close();
 
@@ -701,21 +707,49 @@ void EncApp::encode()
   TExt360AppEncTop           ext360(*this, m_cEncLib.getGOPEncoder()->getExt360Data(), *(m_cEncLib.getGOPEncoder()), orgPic);
 #endif
 
+  // the source frames are read ahead on a background thread, except for the 360 video conversion of the input
+  bool readAhead = m_asyncIOFrames > 0;
+#if EXTENSION_360_VIDEO
+  readAhead = readAhead && !ext360.isEnabled();
+#endif
+  if( readAhead )
+  {
+    m_cVideoIOYuvInputReader.create( m_cVideoIOYuvInputFile, m_asyncIOFrames, unitArea, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range,
+                                     m_isField ? ( m_framesToBeEncoded >> 1 ) : m_framesToBeEncoded, m_temporalSubsampleRatio - 1,
+#if EXTENSION_360_VIDEO
+                                     m_inputFileWidth, m_inputFileHeight, m_InputChromaFormatIDC );
+#else
+                                     m_iSourceWidth - m_aiPad[0], m_iSourceHeight - m_aiPad[1], m_InputChromaFormatIDC );
+#endif
+  }
+
   while ( !bEos )
   {
+    PelStorage* pcOrgPic     = &orgPic;
+    PelStorage* pcTrueOrgPic = &trueOrgPic;
+    bool        isEof        = false;
+
     // read input YUV file
-#if EXTENSION_360_VIDEO
-    if (ext360.isEnabled())
+    if( readAhead )
     {
-      ext360.read(m_cVideoIOYuvInputFile, orgPic, trueOrgPic, ipCSC);
+      isEof = !m_cVideoIOYuvInputReader.read( pcOrgPic, pcTrueOrgPic );
     }
     else
     {
-      m_cVideoIOYuvInputFile.read(orgPic, trueOrgPic, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range);
-    }
+#if EXTENSION_360_VIDEO
+      if (ext360.isEnabled())
+      {
+        ext360.read(m_cVideoIOYuvInputFile, orgPic, trueOrgPic, ipCSC);
+      }
+      else
+      {
+        m_cVideoIOYuvInputFile.read(orgPic, trueOrgPic, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range);
+      }
 #else
-    m_cVideoIOYuvInputFile.read( orgPic, trueOrgPic, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range );
+      m_cVideoIOYuvInputFile.read( orgPic, trueOrgPic, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range );
 #endif
+      isEof = m_cVideoIOYuvInputFile.isEof();
+    }
 
     // increase number of received frames
     m_iFrameRcvd++;
@@ -724,7 +758,7 @@ void EncApp::encode()
 
     bool flush = 0;
     // if end of file (which is only detected on a read failure) flush the encoder of any queued pictures
-    if (m_cVideoIOYuvInputFile.isEof())
+    if (isEof)
     {
       flush = true;
       bEos = true;
@@ -735,12 +769,12 @@ void EncApp::encode()
     // call encoding function for one frame
     if ( m_isField )
     {
-      m_cEncLib.encode( bEos, flush ? 0 : &orgPic, flush ? 0 : &trueOrgPic, snrCSC, recBufList,
+      m_cEncLib.encode( bEos, flush ? 0 : pcOrgPic, flush ? 0 : pcTrueOrgPic, snrCSC, recBufList,
                         iNumEncoded, m_isTopFieldFirst );
     }
     else
     {
-      m_cEncLib.encode( bEos, flush ? 0 : &orgPic, flush ? 0 : &trueOrgPic, snrCSC, recBufList,
+      m_cEncLib.encode( bEos, flush ? 0 : pcOrgPic, flush ? 0 : pcTrueOrgPic, snrCSC, recBufList,
                         iNumEncoded );
     }
 	
@@ -751,7 +785,7 @@ void EncApp::encode()
       );
     }
     // temporally skip frames
-    if( m_temporalSubsampleRatio > 1 )
+    if( m_temporalSubsampleRatio > 1 && !readAhead )
     {
 #if EXTENSION_360_VIDEO
       m_cVideoIOYuvInputFile.skipFrames(m_temporalSubsampleRatio - 1, m_inputFileWidth, m_inputFileHeight, m_InputChromaFormatIDC);
@@ -762,6 +796,10 @@ void EncApp::encode()
   }
 
   m_cEncLib.printSummary(m_isField);
+  if( m_modeProfile )
+  {
+    m_cEncLib.printModeProfile( m_modeProfileFileName );
+  }
 
 
   // delete used buffers in encoder class
@@ -814,10 +852,10 @@ void EncApp::xWriteOutput( int iNumEncoded, std::list<PelUnitBuf*>& recBufList
 
       if (!m_reconFileName.empty())
       {
-        m_cVideoIOYuvReconFile.write( *pcPicYuvRecTop, *pcPicYuvRecBottom,
-                                      ipCSC,
-                                      false, // TODO: m_packedYUVMode,
-                                      m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom, NUM_CHROMA_FORMAT, m_isTopFieldFirst );
+        m_cVideoIOYuvReconWriter.write( *pcPicYuvRecTop, *pcPicYuvRecBottom,
+                                        ipCSC,
+                                        false, // TODO: m_packedYUVMode,
+                                        m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom, NUM_CHROMA_FORMAT, m_isTopFieldFirst );
       }
     }
   }
@@ -828,10 +866,10 @@ void EncApp::xWriteOutput( int iNumEncoded, std::list<PelUnitBuf*>& recBufList
       const PelUnitBuf* pcPicYuvRec = *(iterPicYuvRec++);
       if (!m_reconFileName.empty())
       {
-        m_cVideoIOYuvReconFile.write( *pcPicYuvRec,
-                                      ipCSC,
-                                      m_packedYUVMode,
-                                      m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom, NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
+        m_cVideoIOYuvReconWriter.write( *pcPicYuvRec,
+                                        ipCSC,
+                                        m_packedYUVMode,
+                                        m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom, NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
       }
     }
   }
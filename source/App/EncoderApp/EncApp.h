@@ -43,6 +43,7 @@
 
 #include "EncoderLib/EncLib.h"
 #include "Utilities/VideoIOYuv.h"
+#include "Utilities/VideoIOYuvAsync.h"
 #include "CommonLib/NAL.h"
 #include "EncAppCfg.h"
 
@@ -61,6 +62,8 @@ private:
   EncLib            m_cEncLib;                    ///< encoder class
   VideoIOYuv        m_cVideoIOYuvInputFile;       ///< input YUV file
   VideoIOYuv        m_cVideoIOYuvReconFile;       ///< output reconstruction file
+  VideoIOYuvReadAhead   m_cVideoIOYuvInputReader;  ///< reads the input file on a background thread
+  VideoIOYuvWriteBehind m_cVideoIOYuvReconWriter;  ///< writes the reconstruction file on a background thread
   int               m_iFrameRcvd;                 ///< number of received frames
   uint32_t              m_essentialBytes;
   uint32_t              m_totalBytes;
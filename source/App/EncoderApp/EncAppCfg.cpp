@@ -1313,16 +1313,17 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("StopAfterFFtoPOC",                                m_stopAfterFFtoPOC,                       false, "If using fast forward to POC, after the POC of interest has been hit, stop further encoding.")
   ("ForceDecodeBitstream1",                           m_forceDecodeBitstream1,                  false, "force decoding of bitstream 1 - use this only if you are realy sure about what you are doing ")
   ("DecodeBitstream2ModPOCAndType",                   m_bs2ModPOCAndType,                       false, "Modify POC and NALU-type of second input bitstream, to use second BS as closing I-slice")
-  ("NumSplitThreads",                                 m_numSplitThreads,                            1, "Number of threads used to parallelize splitting")
-  ("ForceSingleSplitThread",                          m_forceSplitSequential,                   false, "Force single thread execution even if taking the parallelized path")
+  ("NumThreads",                                      m_numThreads,                                 1, "Number of threads used to run the deblocking filter of a picture in CTU rows")
+  ("NumSplitThreads",                                 m_numSplitThreads,                            1, "Number of threads used to evaluate the split alternatives of a CU in parallel (1: serial mode decision)")
+  ("ForceSingleSplitThread",                          m_forceSplitSequential,                   false, "Run the split jobs on the calling thread, the result is the same as with parallel split jobs")
+  ("EnsureSplitBitEqual",                             m_ensureSplitBitEqual,                    false, "Ensure the results are equal to results with split parallelism, even with NumSplitThreads=1 (runs the split jobs on the calling thread)")
   ("NumWppThreads",                                   m_numWppThreads,                              1, "Number of threads used to run WPP-style parallelization")
   ("NumWppExtraLines",                                m_numWppExtraLines,                           0, "Number of additional wpp lines to switch when threads are blocked")
+  ("AsyncIOFrames",                                   m_asyncIOFrames,                              2, "Number of source frames read ahead and of reconstructed frames written behind on a background thread (0: synchronous file I/O)")
+  ("ModeProfile",                                     m_modeProfile,                            false, "Measure the encoder time per CU test mode, CU size, QP and temporal layer, and print it per mode at the end")
+  ("ModeProfileFile",                                 m_modeProfileFileName,                 string(""), "CSV file the encoder time per CU test mode, CU size, QP and temporal layer is written to, enables ModeProfile")
   ("DebugCTU",                                        m_debugCTU,                                  -1, "If DebugBitstream is present, load frames up to this POC from this bitstream. Starting with DebugPOC-frame at CTUline containin debug CTU.")
-#if ENABLE_WPP_PARALLELISM
-  ("EnsureWppBitEqual",                               m_ensureWppBitEqual,                       true, "Ensure the results are equal to results with WPP-style parallelism, even if WPP is off")
-#else
-  ("EnsureWppBitEqual",                               m_ensureWppBitEqual,                      false, "Ensure the results are equal to results with WPP-style parallelism, even if WPP is off")
-#endif
+  ("EnsureWppBitEqual",                               m_ensureWppBitEqual,                      false, "Ensure the results are equal to results with WPP-style parallelism, even if WPP is off (implied by NumWppThreads > 1)")
   ( "ALF",                                             m_alf,                                    true, "Adpative Loop Filter\n" )
     ;
 
@@ -1381,6 +1382,20 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   /*
    * Set any derived parameters
    */
+  m_modeProfile |= !m_modeProfileFileName.empty();
+#if ENABLE_WPP_PARALLELISM
+  // WPP-style parallelism codes the CTU rows independently
+  m_ensureWppBitEqual |= m_numWppThreads > 1;
+#endif
+#if ENABLE_SPLIT_PARALLELISM
+  if( m_ensureSplitBitEqual && m_numSplitThreads == 1 )
+  {
+    // the split jobs decide differently from the serial mode decision, so they also run without a second thread
+    m_numSplitThreads      = 2;
+    m_forceSplitSequential = true;
+  }
+#endif
+
 #if EXTENSION_360_VIDEO
   m_inputFileWidth = m_iSourceWidth;
   m_inputFileHeight = m_iSourceHeight;
@@ -2024,25 +2039,46 @@ bool EncAppCfg::xCheckParameter()
     xConfirmPara( m_wrapAroundOffset % minCUSize != 0, "Wrap-around offset must be an integer multiple of the specified minimum CU size" );
   }
 
+  xConfirmPara( m_numThreads < 1, "Number of threads cannot be smaller than 1" );
+  xConfirmPara( m_asyncIOFrames < 0, "Number of asynchronous I/O frames cannot be negative" );
+
 #if ENABLE_SPLIT_PARALLELISM
   xConfirmPara( m_numSplitThreads < 1, "Number of used threads cannot be smaller than 1" );
   xConfirmPara( m_numSplitThreads > PARL_SPLIT_MAX_NUM_THREADS, "Number of used threads cannot be higher than the number of actual jobs" );
-#if _MSC_VER && ENABLE_WPP_PARALLELISM
-  xConfirmPara( m_numSplitThreads > 1 && m_numSplitThreads != NUM_SPLIT_THREADS_IF_MSVC, "Due to poor implementation by Microsoft, NumSplitThreads cannot be set dynamically on runtime!" );
-#endif
+  if( m_numSplitThreads > 1 )
+  {
+    // the split jobs run on copies of the CU encoder, tools sharing encoder state outside of it are not supported
+    xConfirmPara( m_encDbOpt,                                             "Split parallelization cannot be used together with EncDbOpt" );
+    xConfirmPara( m_IBCMode,                                              "Split parallelization cannot be used together with IBC" );
+  }
 #else
   xConfirmPara( m_numSplitThreads != 1, "ENABLE_SPLIT_PARALLELISM is disabled, numSplitThreads has to be 1" );
+  xConfirmPara( m_ensureSplitBitEqual, "ENABLE_SPLIT_PARALLELISM is disabled, cannot ensure being split bit-equal" );
 #endif
 
 #if ENABLE_WPP_PARALLELISM
   xConfirmPara( m_numWppThreads < 1, "Number of threads used for WPP-style parallelization cannot be smaller than 1" );
   xConfirmPara( m_numWppThreads > PARL_WPP_MAX_NUM_THREADS, "Number of threads used for WPP-style parallelization cannot be bigger than PARL_WPP_MAX_NUM_THREADS" );
-  xConfirmPara( !m_ensureWppBitEqual && m_numWppThreads > 1, "WPP bit equality is implied when using WPP-style parallelism" );
 #if ENABLE_WPP_STATIC_LINK
   xConfirmPara( m_numWppExtraLines != 0, "WPP-style extra lines out of range" );
 #else
   xConfirmPara( m_numWppExtraLines < 0, "WPP-style extra lines out of range" );
 #endif
+  xConfirmPara( m_numWppThreads + m_numWppExtraLines > PARL_WPP_MAX_NUM_THREADS, "Number of WPP-style threads and extra lines cannot be bigger than PARL_WPP_MAX_NUM_THREADS" );
+  if( m_numWppThreads > 1 )
+  {
+    // the CTU rows of a picture are encoded concurrently, tools keeping picture level encoder state are not supported
+    xConfirmPara( m_RCEnableRateControl,                                  "WPP-style parallelization cannot be used together with rate control" );
+#if ENABLE_QPA
+    xConfirmPara( m_bUsePerceptQPA,                                       "WPP-style parallelization cannot be used together with perceptual QPA" );
+#endif
+    xConfirmPara( m_lumaLevelToDeltaQPMapping.mode != LUMALVL_TO_DQP_DISABLED, "WPP-style parallelization cannot be used together with luma-level-based Delta QP" );
+    xConfirmPara( m_encDbOpt,                                             "WPP-style parallelization cannot be used together with EncDbOpt" );
+    xConfirmPara( m_IBCMode,                                              "WPP-style parallelization cannot be used together with IBC" );
+    xConfirmPara( m_MCTSEncConstraint,                                    "WPP-style parallelization cannot be used together with MCTS" );
+    xConfirmPara( m_sliceMode != NO_SLICES,                               "WPP-style parallelization requires one slice per picture" );
+    xConfirmPara( m_numTileColumnsMinus1 > 0 || m_numTileRowsMinus1 > 0,  "WPP-style parallelization cannot be used together with tiles" );
+  }
 #else
   xConfirmPara( m_numWppThreads != 1, "ENABLE_WPP_PARALLELISM is disabled, numWppThreads has to be 1" );
   xConfirmPara( m_ensureWppBitEqual, "ENABLE_WPP_PARALLELISM is disabled, cannot ensure being WPP bit-equal" );
@@ -3260,6 +3296,7 @@ void EncAppCfg::xPrintParameter()
   if( m_MIP ) msg(VERBOSE, "FastMIP:%d ", m_useFastMIP);
 #endif
 
+  msg( VERBOSE, "NumThreads:%d ", m_numThreads );
   msg( VERBOSE, "NumSplitThreads:%d ", m_numSplitThreads );
   if( m_numSplitThreads > 1 )
   {
@@ -3267,6 +3304,8 @@ void EncAppCfg::xPrintParameter()
   }
   msg( VERBOSE, "NumWppThreads:%d+%d ", m_numWppThreads, m_numWppExtraLines );
   msg( VERBOSE, "EnsureWppBitEqual:%d ", m_ensureWppBitEqual );
+  msg( VERBOSE, "AsyncIOFrames:%d ", m_asyncIOFrames );
+  msg( VERBOSE, "ModeProfile:%d ", m_modeProfile );
 
 #if EXTENSION_360_VIDEO
   m_ext360.outputConfigurationSummary();
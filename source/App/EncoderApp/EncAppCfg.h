@@ -322,11 +322,16 @@ protected:
 #endif
 
 
+  int       m_numThreads;
   int       m_numSplitThreads;
   bool      m_forceSplitSequential;
+  bool      m_ensureSplitBitEqual;
   int       m_numWppThreads;
   int       m_numWppExtraLines;
   bool      m_ensureWppBitEqual;
+  int       m_asyncIOFrames;                                  ///< frames read ahead and written behind by the I/O thread
+  bool      m_modeProfile;                                    ///< measure and print the time of the CU test modes
+  std::string m_modeProfileFileName;                          ///< CSV file the time of the CU test modes is written to
 
 #if MAX_TB_SIZE_SIGNALLING
   int       m_log2MaxTbSize;
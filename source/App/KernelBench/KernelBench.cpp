@@ -0,0 +1,1438 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     KernelBench.cpp
+    \brief    Kernel benchmark class
+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include "KernelBench.h"
+#include "CommonLib/Slice.h"
+#include "CommonLib/CodingStructure.h"
+#include "CommonLib/Rom.h"
+#if JVET_N0217_MATRIX_INTRAPRED
+#include "CommonLib/MipData.h"
+#endif
+
+#ifdef TARGET_SIMD_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+//! \ingroup KernelBench
+//! \{
+
+#ifdef TARGET_SIMD_X86
+
+// ====================================================================================================================
+// Constants and local functions
+// ====================================================================================================================
+
+static const int         c_blockSizes[] = { 4, 8, 16, 32, 64, 128 };
+static const int         c_margin       = 8;     ///< border around the input blocks read by the filters
+static const char* const c_isaNames[]   = { "C", "SSE41", "SSE42", "AVX", "AVX2", "AVX512" };
+static const int         c_timingPixels = 1 << 18;
+static const int         c_timingRuns   = 3;
+
+template<typename T>
+static void appendBlock( std::vector<int64_t>& out, const T* buf, int stride, int width, int height )
+{
+  for( int y = 0; y < height; y++, buf += stride )
+  {
+    out.insert( out.end(), buf, buf + width );
+  }
+}
+
+/// sample as it leaves the first stage of the interpolation filter
+static Pel toIntermediate( const Pel pel, const int bitDepth )
+{
+  return ( Pel ) ( ( pel << std::max<int>( 2, IF_INTERNAL_PREC - bitDepth ) ) - IF_INTERNAL_OFFS );
+}
+
+#endif // TARGET_SIMD_X86
+
+// ====================================================================================================================
+// Constructor / destructor / initialization / destroy
+// ====================================================================================================================
+
+KernelBench::KernelBench()
+#ifdef TARGET_SIMD_X86
+: m_numKernels   ( 0 )
+, m_numMismatches( 0 )
+#if ENABLE_SIMD_OPT_DIST
+, m_rdCost       ( nullptr )
+, m_rdCostIsa    ( 0 )
+#endif
+#endif
+{
+}
+
+KernelBench::~KernelBench()
+{
+#ifdef TARGET_SIMD_X86
+  xDestroyKernels();
+#endif
+}
+
+#ifdef TARGET_SIMD_X86
+void KernelBench::xInitKernels()
+{
+  // the constructors only set up the C functions, as the extension detection is latched to SCALAR, the kernels of
+  // each level are then installed by the same entry points the encoder and decoder use
+#if ENABLE_SIMD_OPT_DIST
+  m_rdCost    = new RdCost;
+  m_rdCostIsa = 0;
+#endif
+
+  for( size_t isa = 0; isa < m_isaLevels.size(); isa++ )
+  {
+    m_interpolationFilter.push_back( new InterpolationFilter );
+    m_pelBufOps.push_back( new PelBufferOps );
+    m_adaptiveLoopFilter.push_back( new AdaptiveLoopFilter );
+    m_affineGradientSearch.push_back( new AffineGradientSearch );
+    m_ibcHashMap.push_back( new IbcHashMap );
+    m_loopFilter.push_back( new LoopFilter );
+    m_sampleAdaptiveOffset.push_back( new SampleAdaptiveOffset );
+    m_trQuant.push_back( new TrQuant );
+    m_intraPrediction.push_back( new IntraPrediction );
+#if JVET_N0217_MATRIX_INTRAPRED
+    m_predictorMip.push_back( new Mip::PredictorMIP );
+#endif
+
+#if ENABLE_SIMD_OPT_MCIF
+    m_interpolationFilter.back()->initInterpolationFilterX86( m_isaLevels[isa] );
+#endif
+#if ENABLE_SIMD_OPT_BUFFER
+    m_pelBufOps.back()->initPelBufOpsX86( m_isaLevels[isa] );
+#endif
+#if ENABLE_SIMD_OPT_ALF
+    m_adaptiveLoopFilter.back()->initAdaptiveLoopFilterX86( m_isaLevels[isa] );
+#endif
+#if ENABLE_SIMD_OPT_AFFINE_ME
+    m_affineGradientSearch.back()->initAffineGradientSearchX86( m_isaLevels[isa] );
+#endif
+#if ENABLE_SIMD_OPT_IBC
+    m_ibcHashMap.back()->initIbcHashMapX86( m_isaLevels[isa] );
+#endif
+#if ENABLE_SIMD_OPT_DBF
+    m_loopFilter.back()->initLoopFilterX86( m_isaLevels[isa] );
+#endif
+#if ENABLE_SIMD_OPT_SAO
+    m_sampleAdaptiveOffset.back()->initSampleAdaptiveOffsetX86( m_isaLevels[isa] );
+#endif
+#if ENABLE_SIMD_OPT_TRAFO
+    m_trQuant.back()->initTrQuantX86( m_isaLevels[isa] );
+#endif
+#if ENABLE_SIMD_OPT_INTRAPRED
+    m_intraPrediction.back()->initIntraPredictionX86( m_isaLevels[isa] );
+#endif
+#if ENABLE_SIMD_OPT_MIP && JVET_N0217_MATRIX_INTRAPRED
+    m_predictorMip.back()->initPredictorMipX86( m_isaLevels[isa] );
+#endif
+  }
+}
+
+void KernelBench::xDestroyKernels()
+{
+#if ENABLE_SIMD_OPT_DIST
+  delete m_rdCost;
+  m_rdCost = nullptr;
+#endif
+
+  for( size_t isa = 0; isa < m_interpolationFilter.size(); isa++ )
+  {
+    delete m_interpolationFilter[isa];
+    delete m_pelBufOps[isa];
+    delete m_adaptiveLoopFilter[isa];
+    delete m_affineGradientSearch[isa];
+    delete m_ibcHashMap[isa];
+    delete m_loopFilter[isa];
+    delete m_sampleAdaptiveOffset[isa];
+    delete m_trQuant[isa];
+    delete m_intraPrediction[isa];
+#if JVET_N0217_MATRIX_INTRAPRED
+    delete m_predictorMip[isa];
+#endif
+  }
+  m_interpolationFilter.clear();
+  m_pelBufOps.clear();
+  m_adaptiveLoopFilter.clear();
+  m_affineGradientSearch.clear();
+  m_ibcHashMap.clear();
+  m_loopFilter.clear();
+  m_sampleAdaptiveOffset.clear();
+  m_trQuant.clear();
+  m_intraPrediction.clear();
+#if JVET_N0217_MATRIX_INTRAPRED
+  m_predictorMip.clear();
+#endif
+}
+#endif
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+int KernelBench::run()
+{
+#ifdef TARGET_SIMD_X86
+  CHECK( read_x86_extension_flags( "SCALAR" ) != SCALAR, "Instruction set extension selected before the kernel benchmark" );
+
+  X86_VEXT maxLevel = _get_x86_extensions();
+  if( !m_simd.empty() )
+  {
+    const char* const* level = std::find_if( c_isaNames + 1, c_isaNames + AVX512 + 1, [this]( const char* name ) { return m_simd == name; } );
+    if( level == c_isaNames + AVX512 + 1 || level - c_isaNames > maxLevel )
+    {
+      std::cerr << "Mode not supported by this CPU: " << m_simd << std::endl;
+      return -1;
+    }
+    maxLevel = ( X86_VEXT ) ( level - c_isaNames );
+  }
+
+  m_isaLevels.clear();
+  for( int level = SCALAR; level <= maxLevel; level++ )
+  {
+    m_isaLevels.push_back( ( X86_VEXT ) level );
+  }
+  m_rng.seed( m_seed );
+  m_numKernels    = 0;
+  m_numMismatches = 0;
+  // the transform, intra and MIP kernels look up the block sizes in g_aucLog2
+  initROM();
+  xInitKernels();
+
+  printf( "\n%-24s %2s %9s", "Kernel", "BD", "Size" );
+  for( X86_VEXT level : m_isaLevels )
+  {
+    printf( " %8s", c_isaNames[level] );
+  }
+  printf( m_checkOnly ? "\n" : "   [cycles/pixel]\n" );
+
+  for( int bitDepth : m_bitDepths )
+  {
+#if ENABLE_SIMD_OPT_DIST
+    xBenchRdCost( bitDepth );
+#endif
+#if ENABLE_SIMD_OPT_MCIF
+    xBenchInterpolationFilter( bitDepth );
+#endif
+#if ENABLE_SIMD_OPT_BUFFER
+    xBenchPelBufOps( bitDepth );
+    xBenchBdof( bitDepth );
+#endif
+#if ENABLE_SIMD_OPT_ALF
+    xBenchAdaptiveLoopFilter( bitDepth );
+#endif
+#if ENABLE_SIMD_OPT_AFFINE_ME
+    xBenchAffineGradientSearch( bitDepth );
+#endif
+#if ENABLE_SIMD_OPT_IBC
+    xBenchIbcHashMap( bitDepth );
+#endif
+#if ENABLE_SIMD_OPT_DBF
+    xBenchLoopFilter( bitDepth );
+#endif
+#if ENABLE_SIMD_OPT_SAO
+    xBenchSampleAdaptiveOffset( bitDepth );
+#endif
+#if ENABLE_SIMD_OPT_TRAFO
+    xBenchTrQuant( bitDepth );
+#endif
+#if ENABLE_SIMD_OPT_INTRAPRED
+    xBenchIntraPrediction( bitDepth );
+#endif
+#if ENABLE_SIMD_OPT_MIP && JVET_N0217_MATRIX_INTRAPRED
+    xBenchMip( bitDepth );
+#endif
+  }
+
+  printf( "\n%d kernels checked, %d with SIMD output different from C\n", m_numKernels, m_numMismatches );
+
+  xDestroyKernels();
+  destroyROM();
+  return m_numMismatches;
+#else
+  printf( "\nThe SIMD kernels are not compiled in, nothing to compare\n" );
+  return 0;
+#endif
+}
+
+#ifdef TARGET_SIMD_X86
+// ====================================================================================================================
+// Private member functions
+// ====================================================================================================================
+
+bool KernelBench::xIsSelected( const std::string& name ) const
+{
+  if( m_kernelFilter.empty() )
+  {
+    return true;
+  }
+  for( const std::string& filter : m_kernelFilter )
+  {
+    if( name.find( filter ) != std::string::npos )
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void KernelBench::xFillRandom( Pel* buf, size_t size, int minVal, int maxVal )
+{
+  std::uniform_int_distribution<int> dist( minVal, maxVal );
+  for( size_t i = 0; i < size; i++ )
+  {
+    buf[i] = ( Pel ) dist( m_rng );
+  }
+}
+
+double KernelBench::xMeasure( const KernelCall& call, size_t isa, int numPixels )
+{
+  const int iterations = m_iterations > 0 ? m_iterations : std::max( 1, c_timingPixels / numPixels );
+  uint64_t  minCycles  = std::numeric_limits<uint64_t>::max();
+
+  for( int run = 0; run < c_timingRuns; run++ )
+  {
+    const uint64_t start = __rdtsc();
+    for( int i = 0; i < iterations; i++ )
+    {
+      call( isa );
+    }
+    minCycles = std::min<uint64_t>( minCycles, __rdtsc() - start );
+  }
+  return ( double ) minCycles / ( ( double ) iterations * numPixels );
+}
+
+void KernelBench::xRunKernel( const std::string& name, int width, int height, int bitDepth, const KernelCall& call, const KernelResult& result, const KernelReset& reset )
+{
+  if( !xIsSelected( name ) )
+  {
+    return;
+  }
+
+  std::vector<int64_t> reference;
+  std::vector<int64_t> output;
+  std::vector<double>  cyclesPerPixel( m_isaLevels.size(), 0.0 );
+  std::vector<bool>    differs( m_isaLevels.size(), false );
+  std::string          mismatches;
+
+  for( size_t isa = 0; isa < m_isaLevels.size(); isa++ )
+  {
+    std::vector<int64_t>& out = isa ? output : reference;
+    out.clear();
+    if( reset )
+    {
+      reset();
+    }
+    call( isa );
+    result( out );
+
+    if( isa && output != reference )
+    {
+      differs[isa] = true;
+      mismatches += std::string( " " ) + c_isaNames[m_isaLevels[isa]];
+    }
+    if( !m_checkOnly )
+    {
+      cyclesPerPixel[isa] = xMeasure( call, isa, width * height );
+    }
+  }
+
+  m_numKernels++;
+  m_numMismatches += mismatches.empty() ? 0 : 1;
+
+  printf( "%-24s %2d %4dx%-4d", name.c_str(), bitDepth, width, height );
+  for( size_t isa = 0; isa < m_isaLevels.size(); isa++ )
+  {
+    if( m_checkOnly )
+    {
+      printf( " %8s", differs[isa] ? "DIFF" : "ok" );
+    }
+    else
+    {
+      printf( " %8.3f", cyclesPerPixel[isa] );
+    }
+  }
+  if( !mismatches.empty() )
+  {
+    printf( "   MISMATCH:%s", mismatches.c_str() );
+  }
+  printf( "\n" );
+  fflush( stdout );
+}
+
+#if ENABLE_SIMD_OPT_DIST
+void KernelBench::xSelectRdCost( size_t isa )
+{
+  if( isa != m_rdCostIsa )
+  {
+    // the distortion functions are a static table, reset it to the C functions before switching the level
+    m_rdCost->init();
+    m_rdCost->initRdCostX86( m_isaLevels[isa] );
+    m_rdCostIsa = isa;
+  }
+}
+
+void KernelBench::xBenchRdCost( int bitDepth )
+{
+  static const int sadWidths[] = { 4, 8, 12, 16, 24, 32, 48, 64, 128 };
+
+  const int              stride = MAX_CU_SIZE;
+  std::vector<Pel>       org( stride * MAX_CU_SIZE );
+  std::vector<Pel>       cur( stride * MAX_CU_SIZE );
+  std::vector<DistParam> distParam( m_isaLevels.size() );
+  Distortion             dist = 0;
+
+  xFillRandom( org.data(), org.size(), 0, ( 1 << bitDepth ) - 1 );
+  xFillRandom( cur.data(), cur.size(), 0, ( 1 << bitDepth ) - 1 );
+
+  const KernelResult result   = [&]( std::vector<int64_t>& out ) { out.push_back( ( int64_t ) dist ); };
+  const KernelCall   distFunc = [&]( size_t isa ) { dist = distParam[isa].distFunc( distParam[isa] ); };
+
+  for( int width : sadWidths )
+  {
+    for( int height : c_blockSizes )
+    {
+      const CPelBuf orgBuf( org.data(), stride, width, height );
+      const CPelBuf curBuf( cur.data(), stride, width, height );
+
+      // the distortion function is taken from the table when the parameters are set
+      for( size_t isa = 0; isa < m_isaLevels.size(); isa++ )
+      {
+        xSelectRdCost( isa );
+        m_rdCost->setDistParam( distParam[isa], orgBuf, curBuf, bitDepth, COMPONENT_Y, false );
+      }
+      xRunKernel( "SAD", width, height, bitDepth, distFunc, result );
+
+      if( isPowerOf2( width ) )
+      {
+        for( size_t isa = 0; isa < m_isaLevels.size(); isa++ )
+        {
+          xSelectRdCost( isa );
+          m_rdCost->setDistParam( distParam[isa], orgBuf, curBuf, bitDepth, COMPONENT_Y, true );
+        }
+        xRunKernel( "HAD", width, height, bitDepth, distFunc, result );
+      }
+
+      if( isPowerOf2( width ) )
+      {
+        for( size_t isa = 0; isa < m_isaLevels.size(); isa++ )
+        {
+          xSelectRdCost( isa );
+          m_rdCost->setDistParam( distParam[isa], org.data(), cur.data(), stride, stride, bitDepth, COMPONENT_Y, width, height, 0, 1, false, true );
+        }
+        xRunKernel( "SAD_IBD", width, height, bitDepth, distFunc, result );
+      }
+
+      xRunKernel( "SSE", width, height, bitDepth, [&]( size_t isa )
+      {
+        xSelectRdCost( isa );
+        dist = m_rdCost->getDistPart( orgBuf, curBuf, bitDepth, COMPONENT_Y, DF_SSE );
+      }, result );
+    }
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_MCIF
+void KernelBench::xBenchInterpolationFilter( int bitDepth )
+{
+  static const TFilterCoeff        lumaCoeff    [NTAPS_LUMA]     = { -1, 4, -11, 40, 40, -11, 4, -1 };
+  static const TFilterCoeff        chromaCoeff  [NTAPS_CHROMA]   = { -4, 36, 36, -4 };
+  static const TFilterCoeff        bilinearCoeff[NTAPS_BILINEAR] = { 8, 8 };
+  static const TFilterCoeff* const coeffs [3] = { lumaCoeff, chromaCoeff, bilinearCoeff };
+  static const int                 numTaps[3] = { NTAPS_LUMA, NTAPS_CHROMA, NTAPS_BILINEAR };
+
+  const ClpRng     clpRng    = { 0, ( 1 << bitDepth ) - 1, bitDepth, 0 };
+  const int        srcStride = MAX_CU_SIZE + 2 * c_margin;
+  const int        srcOrigin = c_margin * srcStride + c_margin;
+  const int        dstStride = MAX_CU_SIZE;
+  std::vector<Pel> srcPel( srcStride * srcStride );
+  std::vector<Pel> srcIntermediate( srcPel.size() );
+  std::vector<Pel> srcBilinear( srcPel.size() );
+  std::vector<Pel> dst( dstStride * MAX_CU_SIZE );
+
+  xFillRandom( srcPel.data(), srcPel.size(), 0, ( 1 << bitDepth ) - 1 );
+  for( size_t i = 0; i < srcPel.size(); i++ )
+  {
+    srcIntermediate[i] = toIntermediate( srcPel[i], bitDepth );
+    // the bilinear DMVR prediction keeps IF_INTERNAL_PREC_BILINEAR bits
+    srcBilinear[i]     = bitDepth <= IF_INTERNAL_PREC_BILINEAR ? srcPel[i] << ( IF_INTERNAL_PREC_BILINEAR - bitDepth ) : srcPel[i] >> ( bitDepth - IF_INTERNAL_PREC_BILINEAR );
+  }
+
+  int width  = 0;
+  int height = 0;
+  const KernelResult result = [&]( std::vector<int64_t>& out ) { appendBlock( out, dst.data(), dstStride, width, height ); };
+  const KernelReset  reset  = [&]() { std::fill( dst.begin(), dst.end(), -1 ); };
+
+  for( int tapIdx = 0; tapIdx < 3; tapIdx++ )
+  {
+    const bool biMCForDMVR = numTaps[tapIdx] == NTAPS_BILINEAR;
+
+    for( int isVer = 0; isVer < 2; isVer++ )
+    {
+      for( int isFirst = 0; isFirst < 2; isFirst++ )
+      {
+        for( int isLast = 0; isLast < 2; isLast++ )
+        {
+          // only the stage combinations used by the inter prediction: the horizontal filter always runs first,
+          // the bilinear filter only feeds the DMVR search and the regular filters never run three stages
+          if( ( !isVer && !isFirst ) || ( biMCForDMVR ? isLast : !isFirst && !isLast ) )
+          {
+            continue;
+          }
+
+          const Pel* src = ( isFirst ? srcPel : biMCForDMVR ? srcBilinear : srcIntermediate ).data() + srcOrigin;
+          const std::string name = std::string( isVer ? "FilterVer" : "FilterHor" ) + std::to_string( numTaps[tapIdx] ) + "<" + std::to_string( isFirst ) + "," + std::to_string( isLast ) + ">";
+
+          for( int w : c_blockSizes )
+          {
+            for( int h : c_blockSizes )
+            {
+              width  = w;
+              height = h;
+              xRunKernel( name, width, height, bitDepth, [&]( size_t isa )
+              {
+                InterpolationFilter& filter = *m_interpolationFilter[isa];
+                ( isVer ? filter.m_filterVer : filter.m_filterHor )[tapIdx][isFirst][isLast]( clpRng, src, srcStride, dst.data(), dstStride, width, height, coeffs[tapIdx], biMCForDMVR );
+              }, result, reset );
+            }
+          }
+        }
+      }
+    }
+  }
+
+  for( int isFirst = 0; isFirst < 2; isFirst++ )
+  {
+    for( int isLast = 0; isLast < 2; isLast++ )
+    {
+      const Pel* src = ( isFirst ? srcPel : srcIntermediate ).data() + srcOrigin;
+      const std::string name = "FilterCopy<" + std::to_string( isFirst ) + "," + std::to_string( isLast ) + ">";
+
+      for( int w : c_blockSizes )
+      {
+        for( int h : c_blockSizes )
+        {
+          width  = w;
+          height = h;
+          xRunKernel( name, width, height, bitDepth, [&]( size_t isa )
+          {
+            m_interpolationFilter[isa]->m_filterCopy[isFirst][isLast]( clpRng, src, srcStride, dst.data(), dstStride, width, height, false );
+          }, result, reset );
+        }
+      }
+    }
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_BUFFER
+void KernelBench::xBenchPelBufOps( int bitDepth )
+{
+  const ClpRng     clpRng    = { 0, ( 1 << bitDepth ) - 1, bitDepth, 0 };
+  const int        stride    = MAX_CU_SIZE + 2 * c_margin;
+  const int        origin    = c_margin * stride + c_margin;
+  const int        avgShift  = IF_INTERNAL_PREC + 1 - bitDepth;
+  const int        avgOffset = ( 1 << ( avgShift - 1 ) ) + 2 * IF_INTERNAL_OFFS;
+  std::vector<Pel> pel0( stride * stride );
+  std::vector<Pel> pel1( pel0.size() );
+  std::vector<Pel> intermediate0( pel0.size() );
+  std::vector<Pel> intermediate1( pel0.size() );
+  std::vector<Pel> resi( pel0.size() );
+  std::vector<Pel> dst( pel0.size() );
+  uint64_t         sse = 0;
+
+  xFillRandom( pel0.data(), pel0.size(), 0, ( 1 << bitDepth ) - 1 );
+  xFillRandom( pel1.data(), pel1.size(), 0, ( 1 << bitDepth ) - 1 );
+  xFillRandom( resi.data(), resi.size(), -( 1 << bitDepth ), ( 1 << bitDepth ) - 1 );
+  for( size_t i = 0; i < pel0.size(); i++ )
+  {
+    intermediate0[i] = toIntermediate( pel0[i], bitDepth );
+    intermediate1[i] = toIntermediate( pel1[i], bitDepth );
+  }
+
+  const Pel* src0 = pel0.data() + origin;
+  const Pel* src1 = pel1.data() + origin;
+  const Pel* int0 = intermediate0.data() + origin;
+  const Pel* int1 = intermediate1.data() + origin;
+  Pel*       dstO = dst.data() + origin;
+
+  int width  = 0;
+  int height = 0;
+  const KernelResult result      = [&]( std::vector<int64_t>& out ) { appendBlock( out, dstO, stride, width, height ); };
+  const KernelReset  reset       = [&]() { std::fill( dst.begin(), dst.end(), -1 ); };
+  // the GBi high frequency removal works in place on the original samples
+  const KernelReset  resetInPlace = [&]() { std::copy( pel0.begin(), pel0.end(), dst.begin() ); };
+
+  for( int w : c_blockSizes )
+  {
+    for( int h : c_blockSizes )
+    {
+      width  = w;
+      height = h;
+
+      xRunKernel( "AddAvg4", width, height, bitDepth, [&]( size_t isa ) { m_pelBufOps[isa]->addAvg4( int0, stride, int1, stride, dstO, stride, width, height, avgShift, avgOffset, clpRng ); }, result, reset );
+      xRunKernel( "Reco4", width, height, bitDepth, [&]( size_t isa ) { m_pelBufOps[isa]->reco4( src0, stride, resi.data() + origin, stride, dstO, stride, width, height, clpRng ); }, result, reset );
+      xRunKernel( "LinTf4", width, height, bitDepth, [&]( size_t isa ) { m_pelBufOps[isa]->linTf4( src0, stride, dstO, stride, width, height, 37, 5, 17, clpRng, true ); }, result, reset );
+#if ENABLE_SIMD_OPT_GBI
+      // the 4 column variants only process the first 4 columns, AreaBuf uses them for widths not divisible by 8
+      if( width & 7 )
+      {
+        xRunKernel( "RemoveWeightHighFreq4", width, height, bitDepth, [&]( size_t isa ) { m_pelBufOps[isa]->removeWeightHighFreq4( dstO, stride, src1, stride, width, height, 16, 5 ); }, result, resetInPlace );
+        xRunKernel( "RemoveHighFreq4", width, height, bitDepth, [&]( size_t isa ) { m_pelBufOps[isa]->removeHighFreq4( dstO, stride, src1, stride, width, height ); }, result, resetInPlace );
+      }
+#endif
+      if( width >= 8 )
+      {
+        xRunKernel( "AddAvg8", width, height, bitDepth, [&]( size_t isa ) { m_pelBufOps[isa]->addAvg8( int0, stride, int1, stride, dstO, stride, width, height, avgShift, avgOffset, clpRng ); }, result, reset );
+        xRunKernel( "Reco8", width, height, bitDepth, [&]( size_t isa ) { m_pelBufOps[isa]->reco8( src0, stride, resi.data() + origin, stride, dstO, stride, width, height, clpRng ); }, result, reset );
+        xRunKernel( "LinTf8", width, height, bitDepth, [&]( size_t isa ) { m_pelBufOps[isa]->linTf8( src0, stride, dstO, stride, width, height, 37, 5, 17, clpRng, true ); }, result, reset );
+#if ENABLE_SIMD_OPT_GBI
+        xRunKernel( "RemoveWeightHighFreq8", width, height, bitDepth, [&]( size_t isa ) { m_pelBufOps[isa]->removeWeightHighFreq8( dstO, stride, src1, stride, width, height, 16, 5 ); }, result, resetInPlace );
+        xRunKernel( "RemoveHighFreq8", width, height, bitDepth, [&]( size_t isa ) { m_pelBufOps[isa]->removeHighFreq8( dstO, stride, src1, stride, width, height ); }, result, resetInPlace );
+#endif
+      }
+      xRunKernel( "CopyBuffer", width, height, bitDepth, [&]( size_t isa ) { m_pelBufOps[isa]->copyBuffer( ( Pel* ) src0, stride, dstO, stride, width, height ); }, result, reset );
+      xRunKernel( "CalcSSE", width, height, bitDepth, [&]( size_t isa ) { sse = m_pelBufOps[isa]->calcSSE( src0, stride, src1, stride, width, height, 0 ); }, [&]( std::vector<int64_t>& out ) { out.push_back( ( int64_t ) sse ); } );
+    }
+  }
+
+  // the DMVR reference block covers the block plus the luma filter taps and is padded by the search range
+  for( int w : { 8, 16 } )
+  {
+    for( int h : { 8, 16 } )
+    {
+      const int padSize = DMVR_NUM_ITERATION;
+      width  = w + NTAPS_LUMA - 1;
+      height = h + NTAPS_LUMA - 1;
+      xRunKernel( "Padding", width, height, bitDepth, [&]( size_t isa ) { m_pelBufOps[isa]->padding( dstO, stride, width, height, padSize ); },
+                  [&]( std::vector<int64_t>& out ) { appendBlock( out, dstO - padSize * stride - padSize, stride, width + 2 * padSize, height + 2 * padSize ); },
+                  resetInPlace );
+    }
+  }
+}
+
+void KernelBench::xBenchBdof( int bitDepth )
+{
+  const ClpRng clpRng    = { 0, ( 1 << bitDepth ) - 1, bitDepth, 0 };
+  const int    shiftNum  = IF_INTERNAL_PREC + 1 - bitDepth;
+  const int    offset    = ( 1 << ( shiftNum - 1 ) ) + 2 * IF_INTERNAL_OFFS;
+#if JVET_N0325_BDOF
+  const int    limit     = ( 1 << ( std::max<int>( 5, bitDepth - 7 ) ) );
+#else
+  const int    limit     = ( bitDepth > 12 ) ? 2 : ( ( int ) 1 << ( 4 + IF_INTERNAL_PREC - bitDepth - 5 ) );
+#endif
+
+  // the buffers are laid out as in InterPrediction::applyBiOptFlow
+  for( int width : { 8, 16 } )
+  {
+    for( int height : { 8, 16 } )
+    {
+      const int        widthG       = width + 2 * BIO_EXTEND_SIZE;
+      const int        heightG      = height + 2 * BIO_EXTEND_SIZE;
+      const int        offsetPos    = widthG * BIO_EXTEND_SIZE + BIO_EXTEND_SIZE;
+      const int        stridePredMC = widthG + 2;
+      const int        numUnits     = ( width >> 2 ) * ( height >> 2 );
+      std::vector<Pel> pred[2];
+      std::vector<Pel> gradX[2];
+      std::vector<Pel> gradY[2];
+      std::vector<int> dotProduct[5];
+      std::vector<Pel> dst( width * height );
+      std::vector<int> sums( 5 * numUnits );
+      std::vector<Pel> tmp( 2 * numUnits );
+
+      for( int refList = 0; refList < 2; refList++ )
+      {
+        pred [refList].resize( stridePredMC * ( heightG + 2 ) );
+        gradX[refList].resize( widthG * heightG );
+        gradY[refList].resize( widthG * heightG );
+        xFillRandom( pred[refList].data(), pred[refList].size(), 0, ( 1 << bitDepth ) - 1 );
+        for( Pel& sample : pred[refList] )
+        {
+          sample = toIntermediate( sample, bitDepth );
+        }
+      }
+      for( std::vector<int>& product : dotProduct )
+      {
+        product.resize( widthG * heightG );
+      }
+      xFillRandom( tmp.data(), tmp.size(), -limit, limit );
+
+      Pel*       srcY0 = pred[0].data() + stridePredMC + 1;
+      Pel*       srcY1 = pred[1].data() + stridePredMC + 1;
+      const int  units = width >> 2;
+      const auto resetGrad = [&]()
+      {
+        for( int refList = 0; refList < 2; refList++ )
+        {
+          std::fill( gradX[refList].begin(), gradX[refList].end(), 0 );
+          std::fill( gradY[refList].begin(), gradY[refList].end(), 0 );
+        }
+      };
+      const auto calcGrad = [&]( size_t isa )
+      {
+        m_pelBufOps[isa]->bioGradFilter( srcY0, stridePredMC, widthG, heightG, widthG, gradX[0].data(), gradY[0].data(), bitDepth );
+        m_pelBufOps[isa]->bioGradFilter( srcY1, stridePredMC, widthG, heightG, widthG, gradX[1].data(), gradY[1].data(), bitDepth );
+      };
+      const auto calcPar = [&]( size_t isa )
+      {
+        m_pelBufOps[isa]->calcBIOPar( srcY0, srcY1, gradX[0].data(), gradX[1].data(), gradY[0].data(), gradY[1].data(),
+                                      dotProduct[0].data(), dotProduct[1].data(), dotProduct[2].data(), dotProduct[3].data(), dotProduct[4].data(),
+                                      stridePredMC, stridePredMC, widthG, widthG, heightG, bitDepth );
+      };
+
+      xRunKernel( "BioGradFilter", width, height, bitDepth, calcGrad, [&]( std::vector<int64_t>& out )
+      {
+        for( int refList = 0; refList < 2; refList++ )
+        {
+          appendBlock( out, gradX[refList].data(), widthG, widthG, heightG );
+          appendBlock( out, gradY[refList].data(), widthG, widthG, heightG );
+        }
+      }, resetGrad );
+
+      // the following stages take the C results of the previous ones as input
+      resetGrad();
+      calcGrad( 0 );
+
+      xRunKernel( "CalcBIOPar", width, height, bitDepth, calcPar, [&]( std::vector<int64_t>& out )
+      {
+        for( const std::vector<int>& product : dotProduct )
+        {
+          appendBlock( out, product.data(), widthG, widthG, heightG );
+        }
+      }, [&]()
+      {
+        for( std::vector<int>& product : dotProduct )
+        {
+          std::fill( product.begin(), product.end(), 0 );
+        }
+      } );
+
+      calcPar( 0 );
+
+      xRunKernel( "CalcBlkGradient", width, height, bitDepth, [&]( size_t isa )
+      {
+        for( int unit = 0; unit < numUnits; unit++ )
+        {
+          const int xu  = unit % units;
+          const int yu  = unit / units;
+          const int pos = offsetPos + ( ( yu * widthG + xu ) << 2 );
+          int*      sum = &sums[5 * unit];
+          m_pelBufOps[isa]->calcBlkGradient( xu << 2, yu << 2, dotProduct[0].data() + pos, dotProduct[1].data() + pos, dotProduct[2].data() + pos, dotProduct[3].data() + pos, dotProduct[4].data() + pos,
+                                             sum[0], sum[1], sum[2], sum[3], sum[4], widthG, heightG, 1 << 2 );
+        }
+      }, [&]( std::vector<int64_t>& out ) { out.insert( out.end(), sums.begin(), sums.end() ); },
+      [&]() { std::fill( sums.begin(), sums.end(), 0 ); } );
+
+      xRunKernel( "AddBIOAvg4", width, height, bitDepth, [&]( size_t isa )
+      {
+        for( int unit = 0; unit < numUnits; unit++ )
+        {
+          const int xu      = unit % units;
+          const int yu      = unit / units;
+          const int srcPos  = stridePredMC + 1 + ( ( yu * stridePredMC + xu ) << 2 );
+          const int gradPos = offsetPos + ( ( yu * widthG + xu ) << 2 );
+          m_pelBufOps[isa]->addBIOAvg4( srcY0 + srcPos, stridePredMC, srcY1 + srcPos, stridePredMC, dst.data() + ( ( yu * width + xu ) << 2 ), width,
+                                        gradX[0].data() + gradPos, gradX[1].data() + gradPos, gradY[0].data() + gradPos, gradY[1].data() + gradPos, widthG,
+                                        1 << 2, 1 << 2, tmp[2 * unit], tmp[2 * unit + 1], shiftNum, offset, clpRng );
+        }
+      }, [&]( std::vector<int64_t>& out ) { out.insert( out.end(), dst.begin(), dst.end() ); },
+      [&]() { std::fill( dst.begin(), dst.end(), -1 ); } );
+    }
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_ALF
+void KernelBench::xBenchAdaptiveLoopFilter( int bitDepth )
+{
+  const ClpRng       clpRng   = { 0, ( 1 << bitDepth ) - 1, bitDepth, 0 };
+  const int          stride   = MAX_CU_SIZE + 2 * c_margin;
+  const int          origin   = c_margin * stride + c_margin;
+  const int          vbHeight = MAX_CU_SIZE;
+  std::vector<Pel>   src( stride * stride );
+  std::vector<Pel>   dst( src.size() );
+  std::vector<short> coeff( MAX_NUM_ALF_CLASSES * MAX_NUM_ALF_LUMA_COEFF );
+  std::vector<short> clip( coeff.size() );
+
+  xFillRandom( src.data(), src.size(), 0, ( 1 << bitDepth ) - 1 );
+  for( size_t i = 0; i < coeff.size(); i++ )
+  {
+    std::uniform_int_distribution<int> coeffDist( -128, 127 );
+    std::uniform_int_distribution<int> clipDist( 0, 1 << bitDepth );
+    coeff[i] = ( short ) coeffDist( m_rng );
+    clip [i] = ( short ) clipDist( m_rng );
+  }
+
+  // one classifier entry per sample of a CTU, the filter is steered by random classes
+  std::vector<AlfClassifier>  classifierBuf( MAX_CU_SIZE * MAX_CU_SIZE );
+  std::vector<AlfClassifier*> classifier( MAX_CU_SIZE );
+  std::vector<AlfClassifier>  randomClasses( classifierBuf.size() );
+  for( int y = 0; y < MAX_CU_SIZE; y++ )
+  {
+    classifier[y] = &classifierBuf[y * MAX_CU_SIZE];
+  }
+  for( AlfClassifier& cl : randomClasses )
+  {
+    cl = AlfClassifier( ( uint8_t ) ( m_rng() % MAX_NUM_ALF_CLASSES ), ( uint8_t ) ( m_rng() % 4 ) );
+  }
+
+  const int           lapSize = AdaptiveLoopFilter::m_CLASSIFICATION_BLK_SIZE + 5;
+  std::vector<int>    laplacianBuf( NUM_DIRECTIONS * lapSize * lapSize );
+  std::vector<int*>   laplacianRows( NUM_DIRECTIONS * lapSize );
+  int**               laplacian[NUM_DIRECTIONS];
+  for( int dir = 0; dir < NUM_DIRECTIONS; dir++ )
+  {
+    for( int y = 0; y < lapSize; y++ )
+    {
+      laplacianRows[dir * lapSize + y] = &laplacianBuf[( dir * lapSize + y ) * lapSize];
+    }
+    laplacian[dir] = &laplacianRows[dir * lapSize];
+  }
+
+  // the chroma filter checks the PCM flags of the SPS, the luma and chroma planes share the same size here
+  SPS             sps;
+  Slice           slice;
+  CodingStructure cs;
+  sps.setChromaFormatIdc( CHROMA_444 );
+  sps.setPCMFilterDisableFlag( false );
+  slice.setSPS( &sps );
+  slice.setNalUnitType( NAL_UNIT_CODED_SLICE_TRAIL );
+  cs.slice = &slice;
+
+  const CPelBuf    srcBuf( src.data() + origin, stride, MAX_CU_SIZE, MAX_CU_SIZE );
+  const PelBuf     dstBuf( dst.data() + origin, stride, MAX_CU_SIZE, MAX_CU_SIZE );
+  const CPelUnitBuf srcUnitBuf( CHROMA_444, srcBuf, srcBuf, srcBuf );
+  const PelUnitBuf  dstUnitBuf( CHROMA_444, dstBuf, dstBuf, dstBuf );
+
+  Area blk;
+  const KernelResult resultFilter = [&]( std::vector<int64_t>& out ) { appendBlock( out, dstBuf.buf + blk.y * stride + blk.x, stride, blk.width, blk.height ); };
+  const KernelReset  resetFilter  = [&]()
+  {
+    std::fill( dst.begin(), dst.end(), -1 );
+    std::copy( randomClasses.begin(), randomClasses.end(), classifierBuf.begin() );
+  };
+
+  // the blocks end at the bottom of the CTU to cover the virtual boundary processing
+  for( int width : c_blockSizes )
+  {
+    for( int height : c_blockSizes )
+    {
+      if( width <= AdaptiveLoopFilter::m_CLASSIFICATION_BLK_SIZE && height <= AdaptiveLoopFilter::m_CLASSIFICATION_BLK_SIZE && width >= 8 && height >= 8 )
+      {
+        blk = Area( 0, MAX_CU_SIZE - height, width, height );
+        xRunKernel( "AlfDeriveClassification", width, height, bitDepth, [&]( size_t isa )
+        {
+          m_adaptiveLoopFilter[isa]->m_deriveClassificationBlk( classifier.data(), laplacian, srcBuf, blk, bitDepth + 4, vbHeight, vbHeight - ALF_VB_POS_ABOVE_CTUROW_LUMA );
+        }, [&]( std::vector<int64_t>& out )
+        {
+          for( int y = blk.y; y < blk.y + ( int ) blk.height; y++ )
+          {
+            for( int x = blk.x; x < blk.x + ( int ) blk.width; x++ )
+            {
+              out.push_back( classifier[y][x].classIdx << 8 | classifier[y][x].transposeIdx );
+            }
+          }
+        }, [&]() { std::fill( classifierBuf.begin(), classifierBuf.end(), AlfClassifier( 0xff, 0xff ) ); } );
+      }
+
+      if( width >= 8 && height >= 8 )
+      {
+        blk = Area( 0, MAX_CU_SIZE - height, width, height );
+        xRunKernel( "AlfFilter7x7", width, height, bitDepth, [&]( size_t isa )
+        {
+          m_adaptiveLoopFilter[isa]->m_filter7x7Blk( classifier.data(), dstUnitBuf, srcUnitBuf, blk, COMPONENT_Y, coeff.data(), clip.data(), clpRng, cs, vbHeight, vbHeight - ALF_VB_POS_ABOVE_CTUROW_LUMA );
+        }, resultFilter, resetFilter );
+        xRunKernel( "AlfFilter5x5", width, height, bitDepth, [&]( size_t isa )
+        {
+          m_adaptiveLoopFilter[isa]->m_filter5x5Blk( classifier.data(), dstUnitBuf, srcUnitBuf, blk, COMPONENT_Cb, coeff.data(), clip.data(), clpRng, cs, vbHeight, vbHeight - ALF_VB_POS_ABOVE_CTUROW_CHMA );
+        }, resultFilter, resetFilter );
+      }
+    }
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_AFFINE_ME
+void KernelBench::xBenchAffineGradientSearch( int bitDepth )
+{
+  const int        predStride = MAX_CU_SIZE;
+  std::vector<Pel> pred( predStride * MAX_CU_SIZE );
+  std::vector<Pel> residue( MAX_CU_SIZE * MAX_CU_SIZE );
+  std::vector<int> derivate[2];
+  int64_t          equalCoeff[7][7];
+
+  xFillRandom( pred.data(), pred.size(), 0, ( 1 << bitDepth ) - 1 );
+  xFillRandom( residue.data(), residue.size(), -( 1 << bitDepth ) + 1, ( 1 << bitDepth ) - 1 );
+  derivate[0].resize( MAX_CU_SIZE * MAX_CU_SIZE );
+  derivate[1].resize( MAX_CU_SIZE * MAX_CU_SIZE );
+
+  // the derivative buffers have the block width as stride, as in InterSearch::xAffineMotionEstimation
+  for( int width : c_blockSizes )
+  {
+    for( int height : c_blockSizes )
+    {
+      if( width < 8 || height < 8 )
+      {
+        continue;
+      }
+
+      const KernelResult resultDerivate = [&]( std::vector<int64_t>& out ) { appendBlock( out, derivate[0].data(), width, width, height ); };
+      const KernelReset  resetDerivate  = [&]() { std::fill( derivate[0].begin(), derivate[0].end(), -1 ); };
+
+      xRunKernel( "AffineSobelHor", width, height, bitDepth, [&]( size_t isa )
+      {
+        m_affineGradientSearch[isa]->m_HorizontalSobelFilter( pred.data(), predStride, derivate[0].data(), width, width, height );
+      }, resultDerivate, resetDerivate );
+      xRunKernel( "AffineSobelVer", width, height, bitDepth, [&]( size_t isa )
+      {
+        m_affineGradientSearch[isa]->m_VerticalSobelFilter( pred.data(), predStride, derivate[0].data(), width, width, height );
+      }, resultDerivate, resetDerivate );
+
+      AffineGradientSearch::xHorizontalSobelFilter( pred.data(), predStride, derivate[0].data(), width, width, height );
+      AffineGradientSearch::xVerticalSobelFilter  ( pred.data(), predStride, derivate[1].data(), width, width, height );
+      int* derivatePtr[2] = { derivate[0].data(), derivate[1].data() };
+
+      for( int b6Param = 0; b6Param < 2; b6Param++ )
+      {
+        xRunKernel( b6Param ? "AffineEqualCoeff6" : "AffineEqualCoeff4", width, height, bitDepth, [&]( size_t isa )
+        {
+          m_affineGradientSearch[isa]->m_EqualCoeffComputer( residue.data(), width, derivatePtr, width, equalCoeff, width, height, b6Param );
+        }, [&]( std::vector<int64_t>& out ) { out.insert( out.end(), &equalCoeff[0][0], &equalCoeff[0][0] + 7 * 7 ); },
+        [&]() { memset( equalCoeff, 0, sizeof( equalCoeff ) ); } );
+      }
+    }
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_IBC
+void KernelBench::xBenchIbcHashMap( int bitDepth )
+{
+  std::vector<Pel> src( MAX_CU_SIZE * MAX_CU_SIZE );
+  uint32_t         crc = 0;
+
+  xFillRandom( src.data(), src.size(), 0, ( 1 << bitDepth ) - 1 );
+
+  for( int width : c_blockSizes )
+  {
+    for( int height : c_blockSizes )
+    {
+      xRunKernel( "IbcCrc32c", width, height, bitDepth, [&]( size_t isa )
+      {
+        IbcHashMap& hashMap = *m_ibcHashMap[isa];
+        const Pel*  pel     = src.data();
+        crc = 0;
+        for( int y = 0; y < height; y++, pel += MAX_CU_SIZE )
+        {
+          for( int x = 0; x < width; x++ )
+          {
+            crc = hashMap.m_computeCrc32c( crc, pel[x] );
+          }
+        }
+      }, [&]( std::vector<int64_t>& out ) { out.push_back( crc ); } );
+    }
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_DBF
+void KernelBench::xBenchLoopFilter( int bitDepth )
+{
+  static const int longSides[3][2] = { { 7, 7 }, { 5, 5 }, { 3, 7 } };
+
+  const ClpRng     clpRng = { 0, ( 1 << bitDepth ) - 1, bitDepth, 0 };
+  const int        stride = MAX_CU_SIZE + 2 * c_margin;
+  const int        origin = c_margin * stride + c_margin;
+  const int        tc     = 6 << std::max( 0, bitDepth - 8 );
+  std::vector<Pel> src( stride * stride );
+  std::vector<Pel> dst( src.size() );
+
+  // samples around mid-grey, so that most of the differences across the edges stay below the filter thresholds
+  xFillRandom( src.data(), src.size(), ( 1 << ( bitDepth - 1 ) ) - 2 * tc, ( 1 << ( bitDepth - 1 ) ) + 2 * tc );
+
+  Pel* dstO   = dst.data() + origin;
+  int  size   = 0;
+  bool isVer  = false;
+  const KernelResult result = [&]( std::vector<int64_t>& out ) { appendBlock( out, dst.data(), stride, size + 2 * c_margin, size + 2 * c_margin ); };
+  const KernelReset  reset  = [&]() { std::copy( src.begin(), src.end(), dst.begin() ); };
+
+  // the edges lie on the 8x8 grid of the block, the filters are called per segment of numLines lines as in
+  // LoopFilter::xEdgeFilterLuma and xEdgeFilterChroma
+  const auto filterEdges = [&]( const int numLines, const std::function<void( Pel*, int, int )>& filter )
+  {
+    const int offset = isVer ? 1 : stride;
+    const int step   = isVer ? stride : 1;
+    for( int edge = 0; edge < size; edge += 8 )
+    {
+      for( int line = 0; line < size; line += numLines )
+      {
+        filter( dstO + edge * offset + line * step, offset, step );
+      }
+    }
+  };
+
+  for( int dir = 0; dir < 2; dir++ )
+  {
+    isVer = dir == 0;
+    const std::string edgeName = isVer ? "Ver" : "Hor";
+
+    for( int s : c_blockSizes )
+    {
+      if( s < 8 )
+      {
+        continue;
+      }
+      size = s;
+
+      for( int sw = 0; sw < 2; sw++ )
+      {
+        xRunKernel( std::string( sw ? "DbfLumaStrong" : "DbfLumaWeak" ) + edgeName, size, size, bitDepth, [&]( size_t isa )
+        {
+          filterEdges( DEBLOCK_SMALLEST_BLOCK / 2, [&]( Pel* blk, int offset, int step )
+          {
+            m_loopFilter[isa]->m_filterLumaBlk( blk, offset, step, tc, sw, false, false, tc * 10, true, true, clpRng );
+          } );
+        }, result, reset );
+      }
+
+      for( const int* sides : longSides )
+      {
+        xRunKernel( "DbfLumaLong" + std::to_string( sides[0] ) + std::to_string( sides[1] ) + edgeName, size, size, bitDepth, [&]( size_t isa )
+        {
+          filterEdges( DEBLOCK_SMALLEST_BLOCK / 2, [&]( Pel* blk, int offset, int step )
+          {
+            m_loopFilter[isa]->m_filterLumaLongBlk( blk, offset, step, tc, false, false, sides[0], sides[1], clpRng );
+          } );
+        }, result, reset );
+      }
+
+      for( int numLines : { 2, 4 } )
+      {
+        for( int sw = 0; sw < 2; sw++ )
+        {
+          // the large boundary only changes the strong filter at the horizontal CTU boundaries
+          for( int largeBoundary = 0; largeBoundary < ( sw && !isVer ? 2 : 1 ); largeBoundary++ )
+          {
+            const std::string name = std::string( sw ? "DbfChromaStrong" : "DbfChromaWeak" ) + ( largeBoundary ? "Ctu" : "" ) + std::to_string( numLines ) + edgeName;
+            xRunKernel( name, size, size, bitDepth, [&]( size_t isa )
+            {
+              filterEdges( numLines, [&]( Pel* blk, int offset, int step )
+              {
+                m_loopFilter[isa]->m_filterChromaBlk( blk, offset, step, numLines, tc, sw, false, false, clpRng, largeBoundary );
+              } );
+            }, result, reset );
+          }
+        }
+      }
+    }
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_SAO
+void KernelBench::xBenchSampleAdaptiveOffset( int bitDepth )
+{
+  static const char* const eoNames[4] = { "0", "90", "135", "45" };
+
+  const ClpRng     clpRng    = { 0, ( 1 << bitDepth ) - 1, bitDepth, 0 };
+  const int        stride    = MAX_CU_SIZE + 2 * c_margin;
+  const int        origin    = c_margin * stride + c_margin;
+  const int        neighbours[4] = { 1, stride, stride + 1, stride - 1 };
+  // the offset range of SAOOffset, scaled to the bit depth as in SampleAdaptiveOffset::invertQuantOffsets
+  const int        maxOffset = ( ( 1 << ( std::min( bitDepth, 10 ) - 5 ) ) - 1 ) << ( bitDepth - std::min( bitDepth, 10 ) );
+  std::vector<Pel> src( stride * stride );
+  std::vector<Pel> org( src.size() );
+  std::vector<Pel> dst( src.size() );
+  int              offsetEO[NUM_SAO_EO_CLASSES];
+  int              offsetBO[MAX_NUM_SAO_CLASSES];
+  int64_t          diff [NUM_SAO_EO_CLASSES];
+  int64_t          count[NUM_SAO_EO_CLASSES];
+
+  xFillRandom( src.data(), src.size(), 0, ( 1 << bitDepth ) - 1 );
+  xFillRandom( org.data(), org.size(), 0, ( 1 << bitDepth ) - 1 );
+  std::uniform_int_distribution<int> offsetDist( -maxOffset, maxOffset );
+  for( int& offset : offsetEO )
+  {
+    offset = offsetDist( m_rng );
+  }
+  for( int& offset : offsetBO )
+  {
+    offset = offsetDist( m_rng );
+  }
+  offsetEO[SAO_CLASS_EO_PLAIN] = 0;
+
+  const Pel* srcO   = src.data() + origin;
+  const Pel* orgO   = org.data() + origin;
+  Pel*       dstO   = dst.data() + origin;
+  int        width  = 0;
+  int        height = 0;
+  const KernelResult result      = [&]( std::vector<int64_t>& out ) { appendBlock( out, dstO, stride, width, height ); };
+  const KernelReset  reset       = [&]() { std::fill( dst.begin(), dst.end(), -1 ); };
+  const KernelResult resultStats = [&]( std::vector<int64_t>& out ) { out.insert( out.end(), diff, diff + NUM_SAO_EO_CLASSES ); out.insert( out.end(), count, count + NUM_SAO_EO_CLASSES ); };
+  const KernelReset  resetStats  = [&]() { std::fill( diff, diff + NUM_SAO_EO_CLASSES, 0 ); std::fill( count, count + NUM_SAO_EO_CLASSES, 0 ); };
+
+  // the edge offset is also applied to blocks shortened by the unavailable samples at the picture boundaries
+  for( int size : c_blockSizes )
+  {
+    for( int w : { size, size - 1, size - 2 } )
+    {
+      width  = w;
+      height = size;
+
+      for( int eo = 0; eo < 4; eo++ )
+      {
+        const int neighbour = neighbours[eo];
+        xRunKernel( std::string( "SaoOffsetEO" ) + eoNames[eo], width, height, bitDepth, [&]( size_t isa )
+        {
+          m_sampleAdaptiveOffset[isa]->m_offsetBlkEO( srcO, dstO, stride, stride, width, height, neighbour, offsetEO, clpRng );
+        }, result, reset );
+        xRunKernel( std::string( "SaoStatsEO" ) + eoNames[eo], width, height, bitDepth, [&]( size_t isa )
+        {
+          m_sampleAdaptiveOffset[isa]->m_calcStatsEO( srcO, orgO, stride, stride, width, height, neighbour, diff, count );
+        }, resultStats, resetStats );
+      }
+
+      if( w == size )
+      {
+        xRunKernel( "SaoOffsetBO", width, height, bitDepth, [&]( size_t isa )
+        {
+          m_sampleAdaptiveOffset[isa]->m_offsetBlkBO( srcO, dstO, stride, stride, width, height, bitDepth - NUM_SAO_BO_CLASSES_LOG2, offsetBO, clpRng );
+        }, result, reset );
+      }
+    }
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_TRAFO
+void KernelBench::xBenchTrQuant( int bitDepth )
+{
+  static const char* const trNames[NUM_TRANS_TYPE] = { "DCT2", "DCT8", "DST7" };
+
+  // the dynamic range of the SPS without extended precision processing
+  const int           maxLog2TrDynamicRange = 15;
+  const TCoeff        clipMinimum           = -( 1 << maxLog2TrDynamicRange );
+  const TCoeff        clipMaximum           =  ( 1 << maxLog2TrDynamicRange ) - 1;
+  std::vector<TCoeff> resi( MAX_TB_SIZEY * MAX_TB_SIZEY );
+  std::vector<TCoeff> tmp( resi.size() );
+  std::vector<TCoeff> coeff( resi.size() );
+  std::vector<TCoeff> block( resi.size() );
+
+  std::uniform_int_distribution<int> resiDist( -( 1 << bitDepth ) + 1, ( 1 << bitDepth ) - 1 );
+  for( TCoeff& r : resi )
+  {
+    r = resiDist( m_rng );
+  }
+
+  int width  = 0;
+  int height = 0;
+  const KernelResult resultCoeff = [&]( std::vector<int64_t>& out ) { out.insert( out.end(), coeff.begin(), coeff.begin() + width * height ); };
+  const KernelReset  resetCoeff  = [&]() { std::fill( coeff.begin(), coeff.end(), -1 ); };
+  const KernelResult resultBlock = [&]( std::vector<int64_t>& out ) { out.insert( out.end(), block.begin(), block.begin() + width * height ); };
+  const KernelReset  resetBlock  = [&]() { std::fill( block.begin(), block.end(), -1 ); };
+
+  // the two stages of the two-dimensional transforms of TrQuant::xT and xIT, with the same type in both directions
+  for( int trType = 0; trType < NUM_TRANS_TYPE; trType++ )
+  {
+    for( int w : c_blockSizes )
+    {
+      for( int h : c_blockSizes )
+      {
+        const int widthIdx  = g_aucLog2[w] - 1;
+        const int heightIdx = g_aucLog2[h] - 1;
+        if( w > MAX_TB_SIZEY || h > MAX_TB_SIZEY || !m_trQuant[0]->m_fwdTrans[trType][widthIdx] || !m_trQuant[0]->m_fwdTrans[trType][heightIdx] )
+        {
+          continue;
+        }
+        width  = w;
+        height = h;
+
+        const int skipWidth   = ( trType != DCT2 && width  == 32 ) ? 16 : width  > JVET_C0024_ZERO_OUT_TH ? width  - JVET_C0024_ZERO_OUT_TH : 0;
+        const int skipHeight  = ( trType != DCT2 && height == 32 ) ? 16 : height > JVET_C0024_ZERO_OUT_TH ? height - JVET_C0024_ZERO_OUT_TH : 0;
+        const int fwdShift1st = g_aucLog2[width] + bitDepth + g_transformMatrixShift[TRANSFORM_FORWARD] - maxLog2TrDynamicRange + COM16_C806_TRANS_PREC;
+        const int fwdShift2nd = g_aucLog2[height] + g_transformMatrixShift[TRANSFORM_FORWARD] + COM16_C806_TRANS_PREC;
+        const int invShift1st = g_transformMatrixShift[TRANSFORM_INVERSE] + 1 + COM16_C806_TRANS_PREC;
+        const int invShift2nd = g_transformMatrixShift[TRANSFORM_INVERSE] + maxLog2TrDynamicRange - 1 - bitDepth + COM16_C806_TRANS_PREC;
+
+        const KernelCall fwdTrans = [&]( size_t isa )
+        {
+          m_trQuant[isa]->m_fwdTrans[trType][widthIdx] ( resi.data(), tmp.data(), fwdShift1st, height, 0, skipWidth );
+          m_trQuant[isa]->m_fwdTrans[trType][heightIdx]( tmp.data(), coeff.data(), fwdShift2nd, width, skipWidth, skipHeight );
+        };
+        xRunKernel( std::string( "FwdTrans" ) + trNames[trType], width, height, bitDepth, fwdTrans, resultCoeff, resetCoeff );
+
+        // the inverse transforms take the C forward transform of the residual as input
+        resetCoeff();
+        fwdTrans( 0 );
+
+        xRunKernel( std::string( "InvTrans" ) + trNames[trType], width, height, bitDepth, [&]( size_t isa )
+        {
+          m_trQuant[isa]->m_invTrans[trType][heightIdx]( coeff.data(), tmp.data(), invShift1st, width, skipWidth, skipHeight, clipMinimum, clipMaximum );
+          m_trQuant[isa]->m_invTrans[trType][widthIdx] ( tmp.data(), block.data(), invShift2nd, height, 0, skipWidth, clipMinimum, clipMaximum );
+        }, resultBlock, resetBlock );
+      }
+    }
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_INTRAPRED
+void KernelBench::xBenchIntraPrediction( int bitDepth )
+{
+  static const uint32_t    pdpcModes[4]     = { PLANAR_IDX, DC_IDX, HOR_IDX, VER_IDX };
+  static const char* const pdpcModeNames[4] = { "Planar", "DC", "Hor", "Ver" };
+
+  const ClpRng     clpRng    = { 0, ( 1 << bitDepth ) - 1, bitDepth, 0 };
+  const int        refStride = 2 * MAX_CU_SIZE + 1;
+  const int        predAngle = 13;
+  std::vector<Pel> ref( refStride * refStride );
+  std::vector<Pel> pred( MAX_CU_SIZE * MAX_CU_SIZE );
+  std::vector<Pel> dst( pred.size() );
+
+  xFillRandom( ref.data(), ref.size(), 0, ( 1 << bitDepth ) - 1 );
+  xFillRandom( pred.data(), pred.size(), 0, ( 1 << bitDepth ) - 1 );
+
+  // a smoothing filter of the shape of the intra Gaussian filter, whose table is local to IntraPrediction.cpp
+  TFilterCoeff smoothFilter[32][4];
+  for( int deltaFract = 0; deltaFract < 32; deltaFract++ )
+  {
+    smoothFilter[deltaFract][0] = 16 - ( deltaFract >> 1 );
+    smoothFilter[deltaFract][1] = 32 - ( deltaFract >> 1 );
+    smoothFilter[deltaFract][2] = 16 + ( deltaFract >> 1 );
+    smoothFilter[deltaFract][3] = deltaFract >> 1;
+  }
+
+  // the reference samples are laid out as in IntraPrediction::predIntraAng, the top row above the left column
+  const CPelBuf refBuf( ref.data(), refStride, refStride );
+  const Pel*    refMain = ref.data();
+  int width  = 0;
+  int height = 0;
+  const KernelResult result       = [&]( std::vector<int64_t>& out ) { appendBlock( out, dst.data(), width, width, height ); };
+  const KernelReset  reset        = [&]() { std::fill( dst.begin(), dst.end(), -1 ); };
+  // the PDPC filter works in place on the prediction
+  const KernelReset  resetInPlace = [&]() { std::copy( pred.begin(), pred.end(), dst.begin() ); };
+
+  for( int w : c_blockSizes )
+  {
+    for( int h : c_blockSizes )
+    {
+      if( w > MAX_TB_SIZEY || h > MAX_TB_SIZEY )
+      {
+        continue;
+      }
+      width  = w;
+      height = h;
+
+      xRunKernel( "IntraPlanar", width, height, bitDepth, [&]( size_t isa )
+      {
+        PelBuf dstBuf( dst.data(), width, width, height );
+        m_intraPrediction[isa]->m_predIntraPlanar( refBuf, dstBuf );
+      }, result, reset );
+
+      const int scale = ( g_aucLog2[width] - 2 + g_aucLog2[height] - 2 + 2 ) >> 2;
+      for( int mode = 0; mode < 4; mode++ )
+      {
+        xRunKernel( std::string( "IntraPdpc" ) + pdpcModeNames[mode], width, height, bitDepth, [&]( size_t isa )
+        {
+          PelBuf dstBuf( dst.data(), width, width, height );
+          m_intraPrediction[isa]->m_intraPdpcFilter( refBuf, dstBuf, pdpcModes[mode], scale, clpRng );
+        }, result, resetInPlace );
+      }
+
+      // one call per line with the fractional positions of a non-integer slope, as in IntraPrediction::xPredIntraAng
+      for( int useCubicFilter = 0; useCubicFilter < 2; useCubicFilter++ )
+      {
+        xRunKernel( useCubicFilter ? "IntraAngLumaCubic" : "IntraAngLumaSmooth", width, height, bitDepth, [&]( size_t isa )
+        {
+          for( int y = 0, deltaPos = predAngle; y < height; y++, deltaPos += predAngle )
+          {
+            const int           deltaFract = deltaPos & 31;
+            const TFilterCoeff* f          = useCubicFilter ? InterpolationFilter::getChromaFilterTable( deltaFract ) : smoothFilter[deltaFract];
+            m_intraPrediction[isa]->m_predIntraAngLuma( dst.data() + y * width, refMain + ( deltaPos >> 5 ), width, f, useCubicFilter, clpRng );
+          }
+        }, result, reset );
+      }
+      xRunKernel( "IntraAngChroma", width, height, bitDepth, [&]( size_t isa )
+      {
+        for( int y = 0, deltaPos = predAngle; y < height; y++, deltaPos += predAngle )
+        {
+          m_intraPrediction[isa]->m_predIntraAngChroma( dst.data() + y * width, refMain + ( deltaPos >> 5 ) + 1, width, deltaPos & 31 );
+        }
+      }, result, reset );
+    }
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_MIP && JVET_N0217_MATRIX_INTRAPRED
+void KernelBench::xBenchMip( int bitDepth )
+{
+  struct MatrixCase
+  {
+    const short* matrix;
+    const short* bias;
+    int          shiftMatrix;
+    int          shiftBias;
+    int          inputSize;
+    int          outWidth;
+    int          outHeight;
+    int          xStep;
+    int          yStep;
+  };
+  // the first mode of each block size class, with the rows and columns left out for the 4xN and Nx4 blocks
+  const MatrixCase matrixCases[] =
+  {
+    { &mipMatrix4x4  [0][0][0], mipBias4x4  [0], mipShiftMatrix4x4  [0], mipShiftBias4x4  [0] + bitDepth - 10, 4, 4, 4, 1, 0 },
+    { &mipMatrix8x8  [0][0][0], mipBias8x8  [0], mipShiftMatrix8x8  [0], mipShiftBias8x8  [0] + bitDepth - 10, 8, 4, 4, 1, 0 },
+    { &mipMatrix16x16[0][0][0], mipBias16x16[0], mipShiftMatrix16x16[0], mipShiftBias16x16[0] + bitDepth - 10, 8, 8, 8, 1, 0 },
+    { &mipMatrix16x16[0][0][0], mipBias16x16[0], mipShiftMatrix16x16[0], mipShiftBias16x16[0] + bitDepth - 10, 8, 4, 8, 2, 0 },
+    { &mipMatrix16x16[0][0][0], mipBias16x16[0], mipShiftMatrix16x16[0], mipShiftBias16x16[0] + bitDepth - 10, 8, 8, 4, 1, 8 },
+    { &mipMatrix16x16[0][0][0], mipBias16x16[0], mipShiftMatrix16x16[0], mipShiftBias16x16[0] + bitDepth - 10, 8, 4, 4, 2, 4 },
+  };
+
+  std::vector<int> boundary( MIP_MAX_WIDTH + MIP_MAX_HEIGHT );
+  std::vector<int> reduced( MIP_MAX_REDUCED_OUTPUT_SAMPLES );
+  std::vector<int> dst( MIP_MAX_WIDTH * MIP_MAX_HEIGHT );
+
+  std::uniform_int_distribution<int> sampleDist( 0, ( 1 << bitDepth ) - 1 );
+  for( int& sample : boundary )
+  {
+    sample = sampleDist( m_rng );
+  }
+  for( int& sample : reduced )
+  {
+    sample = sampleDist( m_rng );
+  }
+
+  int width  = 0;
+  int height = 0;
+  const KernelResult result = [&]( std::vector<int64_t>& out ) { out.insert( out.end(), dst.begin(), dst.begin() + width * height ); };
+  const KernelReset  reset  = [&]() { std::fill( dst.begin(), dst.end(), -1 ); };
+
+  for( int srcLen : c_blockSizes )
+  {
+    for( int dstLen : { 2, 4 } )
+    {
+      if( srcLen <= dstLen || srcLen > MIP_MAX_WIDTH )
+      {
+        continue;
+      }
+      width  = dstLen;
+      height = 1;
+      xRunKernel( "MipDownsampling" + std::to_string( dstLen ), srcLen, 1, bitDepth, [&]( size_t isa )
+      {
+        m_predictorMip[isa]->m_doDownsampling( dst.data(), boundary.data(), srcLen, dstLen );
+      }, result, reset );
+    }
+  }
+
+  for( const MatrixCase& mc : matrixCases )
+  {
+    width  = mc.outWidth;
+    height = mc.outHeight;
+    xRunKernel( "MipMatrix" + std::to_string( mc.inputSize ), width, height, bitDepth, [&]( size_t isa )
+    {
+      m_predictorMip[isa]->m_computeMatrixTimesRedBndry( dst.data(), boundary.data(), mc.matrix, mc.bias, mc.inputSize, mc.outWidth, mc.outHeight, mc.xStep, mc.yStep, mc.shiftMatrix, mc.shiftBias );
+    }, result, reset );
+  }
+
+  // the two passes of PredictorMIP::predictionUpsampling for a non-transposed reduced prediction, the shorter side first
+  for( int w : c_blockSizes )
+  {
+    for( int h : c_blockSizes )
+    {
+      if( w > MIP_MAX_WIDTH || h > MIP_MAX_HEIGHT || std::max( w, h ) < 16 )
+      {
+        continue;
+      }
+      width  = w;
+      height = h;
+
+      const int redWidth  = std::min( width, 8 );
+      const int redHeight = std::min( height, 8 );
+      const int factorHor = width / redWidth;
+      const int factorVer = height / redHeight;
+      const int* bndryTop  = boundary.data();
+      const int* bndryLeft = boundary.data() + MIP_MAX_WIDTH;
+
+      xRunKernel( "MipUpsampling", width, height, bitDepth, [&]( size_t isa )
+      {
+        Mip::PredictorMIP& mip = *m_predictorMip[isa];
+        if( height > width )
+        {
+          const int* verSrc       = reduced.data();
+          int        verSrcStep   = width;
+          int        verSrcStride = 1;
+          if( factorHor > 1 )
+          {
+            int* horDst = dst.data() + ( factorVer - 1 ) * width;
+            mip.m_predictionUpsampling1D( horDst, reduced.data(), bndryLeft, redWidth, redHeight, 1, redWidth, 1, factorVer * width, factorHor );
+            verSrc       = horDst;
+            verSrcStep   = factorVer * width;
+            verSrcStride = 1;
+          }
+          mip.m_predictionUpsampling1D( dst.data(), verSrc, bndryTop, redHeight, width, verSrcStep, verSrcStride, width, 1, factorVer );
+        }
+        else
+        {
+          const int* horSrc       = reduced.data();
+          int        horSrcStep   = 1;
+          int        horSrcStride = redWidth;
+          if( factorVer > 1 )
+          {
+            int* verDst = dst.data() + ( factorHor - 1 );
+            mip.m_predictionUpsampling1D( verDst, reduced.data(), bndryTop, redHeight, redWidth, redWidth, 1, width, factorHor, factorVer );
+            horSrc       = verDst;
+            horSrcStep   = factorHor;
+            horSrcStride = width;
+          }
+          mip.m_predictionUpsampling1D( dst.data(), horSrc, bndryLeft, redWidth, height, horSrcStep, horSrcStride, 1, width, factorHor );
+        }
+      }, result, reset );
+    }
+  }
+}
+#endif
+
+#endif // TARGET_SIMD_X86
+
+//! \}
@@ -0,0 +1,155 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     KernelBench.h
+    \brief    Kernel benchmark class (header)
+*/
+
+#ifndef __KERNELBENCH__
+#define __KERNELBENCH__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include "CommonLib/CommonDef.h"
+#include "CommonLib/RdCost.h"
+#include "CommonLib/InterpolationFilter.h"
+#include "CommonLib/Buffer.h"
+#include "CommonLib/AdaptiveLoopFilter.h"
+#include "CommonLib/AffineGradientSearch.h"
+#include "CommonLib/IbcHashMap.h"
+#include "CommonLib/LoopFilter.h"
+#include "CommonLib/SampleAdaptiveOffset.h"
+#include "CommonLib/TrQuant.h"
+#include "CommonLib/IntraPrediction.h"
+#include "CommonLib/MatrixIntraPrediction.h"
+
+#include "KernelBenchCfg.h"
+
+//! \ingroup KernelBench
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// runs the SIMD kernels of every instruction set level against their C versions
+class KernelBench : public KernelBenchCfg
+{
+public:
+  KernelBench();
+  virtual ~KernelBench();
+
+  int   run               (); ///< runs the selected kernels, returns the number of kernels with SIMD output different from C
+
+#ifdef TARGET_SIMD_X86
+private:
+  typedef std::function<void( size_t isa )>            KernelCall;   ///< calls the kernel of one instruction set level
+  typedef std::function<void( std::vector<int64_t>& )> KernelResult; ///< appends the output of the last call
+  typedef std::function<void()>                        KernelReset;  ///< restores the inputs and outputs before a checked call
+
+  void  xInitKernels      ();
+  void  xDestroyKernels   ();
+  bool  xIsSelected       ( const std::string& name ) const;
+  void  xFillRandom       ( Pel* buf, size_t size, int minVal, int maxVal );
+  double xMeasure         ( const KernelCall& call, size_t isa, int numPixels );
+  void  xRunKernel        ( const std::string& name, int width, int height, int bitDepth, const KernelCall& call, const KernelResult& result, const KernelReset& reset = KernelReset() );
+
+#if ENABLE_SIMD_OPT_DIST
+  void  xSelectRdCost     ( size_t isa );
+  void  xBenchRdCost      ( int bitDepth );
+#endif
+#if ENABLE_SIMD_OPT_MCIF
+  void  xBenchInterpolationFilter( int bitDepth );
+#endif
+#if ENABLE_SIMD_OPT_BUFFER
+  void  xBenchPelBufOps   ( int bitDepth );
+  void  xBenchBdof        ( int bitDepth );
+#endif
+#if ENABLE_SIMD_OPT_ALF
+  void  xBenchAdaptiveLoopFilter( int bitDepth );
+#endif
+#if ENABLE_SIMD_OPT_AFFINE_ME
+  void  xBenchAffineGradientSearch( int bitDepth );
+#endif
+#if ENABLE_SIMD_OPT_IBC
+  void  xBenchIbcHashMap  ( int bitDepth );
+#endif
+#if ENABLE_SIMD_OPT_DBF
+  void  xBenchLoopFilter  ( int bitDepth );
+#endif
+#if ENABLE_SIMD_OPT_SAO
+  void  xBenchSampleAdaptiveOffset( int bitDepth );
+#endif
+#if ENABLE_SIMD_OPT_TRAFO
+  void  xBenchTrQuant     ( int bitDepth );
+#endif
+#if ENABLE_SIMD_OPT_INTRAPRED
+  void  xBenchIntraPrediction( int bitDepth );
+#endif
+#if ENABLE_SIMD_OPT_MIP && JVET_N0217_MATRIX_INTRAPRED
+  void  xBenchMip         ( int bitDepth );
+#endif
+
+  std::vector<X86_VEXT>               m_isaLevels;              ///< compared instruction set levels, SCALAR first
+  std::mt19937                        m_rng;
+  int                                 m_numKernels;
+  int                                 m_numMismatches;
+
+#if ENABLE_SIMD_OPT_DIST
+  RdCost*                             m_rdCost;                 ///< the distortion functions are a static table, switched per level
+  size_t                              m_rdCostIsa;
+#endif
+  std::vector<InterpolationFilter*>   m_interpolationFilter;    ///< one instance per instruction set level
+  std::vector<PelBufferOps*>          m_pelBufOps;
+  std::vector<AdaptiveLoopFilter*>    m_adaptiveLoopFilter;
+  std::vector<AffineGradientSearch*>  m_affineGradientSearch;
+  std::vector<IbcHashMap*>            m_ibcHashMap;
+  std::vector<LoopFilter*>            m_loopFilter;
+  std::vector<SampleAdaptiveOffset*>  m_sampleAdaptiveOffset;
+  std::vector<TrQuant*>               m_trQuant;
+  std::vector<IntraPrediction*>       m_intraPrediction;
+#if JVET_N0217_MATRIX_INTRAPRED
+  std::vector<Mip::PredictorMIP*>     m_predictorMip;
+#endif
+#endif
+};
+
+//! \}
+
+#endif // __KERNELBENCH__
@@ -0,0 +1,159 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     KernelBenchCfg.cpp
+    \brief    Kernel benchmark configuration class
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <sstream>
+#include "KernelBenchCfg.h"
+#include "Utilities/program_options_lite.h"
+
+using namespace std;
+namespace po = df::program_options_lite;
+
+//! \ingroup KernelBench
+//! \{
+
+// ====================================================================================================================
+// Local functions
+// ====================================================================================================================
+
+static vector<string> splitList( const string& list )
+{
+  vector<string> items;
+  istringstream  stream( list );
+  string         item;
+
+  while( getline( stream, item, ',' ) )
+  {
+    if( !item.empty() )
+    {
+      items.push_back( item );
+    }
+  }
+  return items;
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/** \param argc number of arguments
+    \param argv array of arguments
+ */
+bool KernelBenchCfg::parseCfg( int argc, char* argv[] )
+{
+  bool   do_help = false;
+  string kernels;
+  string bitDepths;
+  po::Options opts;
+  opts.addOptions()
+
+  ("help",                      do_help,                               false,           "this help text")
+  ("Kernels,k",                 kernels,                               string(""),      "comma separated list of kernel name filters, a kernel runs if its name contains one of them (default: all kernels)")
+  ("BitDepths,b",               bitDepths,                             string("8,10,12"), "comma separated list of sample bit depths")
+  ("SIMD",                      m_simd,                                string(""),      "highest instruction set extension compared against C: SSE41, SSE42, AVX, AVX2, AVX512 (default: the highest one supported by the CPU)")
+  ("Iterations,n",              m_iterations,                          0,               "kernel calls per timing run, 0 scales the calls with the block size")
+  ("Seed",                      m_seed,                                1,               "seed of the random kernel inputs")
+  ("CheckOnly",                 m_checkOnly,                           false,           "only check the bit-exactness against C, skip the timing")
+  ;
+
+  po::setDefaults(opts);
+  po::ErrorReporter err;
+  const list<const char*>& argv_unhandled = po::scanArgv(opts, argc, (const char**) argv, err);
+
+  for (list<const char*>::const_iterator it = argv_unhandled.begin(); it != argv_unhandled.end(); it++)
+  {
+    std::cerr << "Unhandled argument ignored: "<< *it << std::endl;
+  }
+
+  if (do_help)
+  {
+    po::doHelp(cout, opts);
+    return false;
+  }
+
+  if (err.is_errored)
+  {
+    /* errors have already been reported to stderr */
+    return false;
+  }
+
+  m_kernelFilter = splitList( kernels );
+
+  // the inter prediction intermediates have IF_INTERNAL_PREC (14) bits, plus two bits of headroom with 16 bit samples
+  const int maxBitDepth = RExt__HIGH_BIT_DEPTH_SUPPORT ? 14 : 12;
+  m_bitDepths.clear();
+  for( const string& bitDepth : splitList( bitDepths ) )
+  {
+    m_bitDepths.push_back( atoi( bitDepth.c_str() ) );
+    if( m_bitDepths.back() < 8 || m_bitDepths.back() > maxBitDepth )
+    {
+      std::cerr << "Bit depth " << bitDepth << " not supported, the range is 8 to " << maxBitDepth << std::endl;
+      return false;
+    }
+  }
+  if( m_bitDepths.empty() )
+  {
+    std::cerr << "No bit depth specified, aborting" << std::endl;
+    return false;
+  }
+
+  if( m_iterations < 0 )
+  {
+    std::cerr << "The number of iterations must not be negative" << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+KernelBenchCfg::KernelBenchCfg()
+: m_kernelFilter()
+, m_bitDepths()
+, m_simd()
+, m_iterations( 0 )
+, m_seed( 1 )
+, m_checkOnly( false )
+{
+}
+
+KernelBenchCfg::~KernelBenchCfg()
+{
+}
+
+//! \}
@@ -84,22 +84,17 @@ uint32_t SEIRemovalApp::decode()
 //  int                 poc;
 //  PicList* pcListPic = NULL;
 
-  ifstream bitstreamFileIn(m_bitstreamFileNameIn.c_str(), ifstream::in | ifstream::binary);
-  if (!bitstreamFileIn)
+  InputByteBuffer bytestream;
+  if (!bytestream.open(m_bitstreamFileNameIn))
   {
     EXIT( "failed to open bitstream file " << m_bitstreamFileNameIn.c_str() << " for reading" ) ;
   }
 
   ofstream bitstreamFileOut(m_bitstreamFileNameOut.c_str(), ifstream::out | ifstream::binary);
 
-  InputByteStream bytestream(bitstreamFileIn);
-
-  bitstreamFileIn.clear();
-  bitstreamFileIn.seekg( 0, ios::beg );
-
   int unitCnt = 0;
 
-  while (!!bitstreamFileIn)
+  while (!bytestream.eof())
   {
     /* location serves to work around a design fault in the decoder, whereby
      * the process of reading a new slice that is the first slice of a new frame
@@ -51,11 +51,6 @@ constexpr int AdaptiveLoopFilter::AlfNumClippingValues[];
 AdaptiveLoopFilter::AdaptiveLoopFilter()
   : m_classifier( nullptr )
 {
-  for( int i = 0; i < NUM_DIRECTIONS; i++ )
-  {
-    m_laplacian[i] = nullptr;
-  }
-
   for( int compIdx = 0; compIdx < MAX_NUM_COMPONENT; compIdx++ )
   {
     m_ctuEnableFlag[compIdx] = nullptr;
@@ -237,13 +232,39 @@ void AdaptiveLoopFilter::ALFProcess(CodingStructure& cs)
 void AdaptiveLoopFilter::ALFProcess( CodingStructure& cs, AlfSliceParam& alfSliceParam )
 #endif
 {
+#if JVET_N0415_CTB_ALF
+  if( !initALFProcess( cs ) )
+#else
+  if( !initALFProcess( cs, alfSliceParam ) )
+#endif
+  {
+    return;
+  }
+
+  const PreCalcValues& pcv = *cs.pcv;
+  for( int ctuRow = 0; ctuRow < pcv.heightInCtus; ctuRow++ )
+  {
+    storeCtuRow( cs, ctuRow );
+  }
+  for( int ctuRow = 0; ctuRow < pcv.heightInCtus; ctuRow++ )
+  {
+    ALFProcessCtuRow( cs, ctuRow );
+  }
+}
+
+#if JVET_N0415_CTB_ALF
+bool AdaptiveLoopFilter::initALFProcess( CodingStructure& cs )
+#else
+bool AdaptiveLoopFilter::initALFProcess( CodingStructure& cs, AlfSliceParam& alfSliceParam )
+#endif
+{
 #if JVET_N0415_CTB_ALF
   if (!cs.slice->getTileGroupAlfEnabledFlag(COMPONENT_Y) && !cs.slice->getTileGroupAlfEnabledFlag(COMPONENT_Cb) && !cs.slice->getTileGroupAlfEnabledFlag(COMPONENT_Cr))
 #else
   if( !alfSliceParam.enabledFlag[COMPONENT_Y] && !alfSliceParam.enabledFlag[COMPONENT_Cb] && !alfSliceParam.enabledFlag[COMPONENT_Cr] )
 #endif
   {
-    return;
+    return false;
   }
 
 #if !JVET_N0415_CTB_ALF
@@ -261,7 +282,6 @@ void AdaptiveLoopFilter::ALFProcess( CodingStructure& cs, AlfSliceParam& alfSlic
   }
 #if JVET_N0415_CTB_ALF
   reconstructCoeffAPSs(cs, true, cs.slice->getTileGroupAlfEnabledFlag(COMPONENT_Cb) || cs.slice->getTileGroupAlfEnabledFlag(COMPONENT_Cr), false);
-  short* alfCtuFilterIndex = cs.slice->getPic()->getAlfCtbFilterIndex();
 #else
   reconstructCoeff( alfSliceParam, CHANNEL_TYPE_LUMA );
 #if JVET_N0242_NON_LINEAR_ALF
@@ -269,143 +289,158 @@ void AdaptiveLoopFilter::ALFProcess( CodingStructure& cs, AlfSliceParam& alfSlic
 #endif
   reconstructCoeff( alfSliceParam, CHANNEL_TYPE_CHROMA );
 #endif
+#if !JVET_N0415_CTB_ALF
+  m_alfSliceParam = &alfSliceParam;
+#endif
+  return true;
+}
+
+void AdaptiveLoopFilter::storeCtuRow( CodingStructure& cs, const int ctuRow )
+{
+  const UnitArea rowArea = CS::getCtuRowArea( cs, ctuRow );
+  PelUnitBuf     tmpRow  = m_tempBuf.subBuf( rowArea );
 
+  tmpRow.copyFrom( cs.getRecoBuf( rowArea ) );
+  tmpRow.extendBorderPel( MAX_ALF_FILTER_LENGTH >> 1, ctuRow == 0, ctuRow == cs.pcv->heightInCtus - 1 );
+}
+
+void AdaptiveLoopFilter::ALFProcessCtuRow( CodingStructure& cs, const int ctuRow )
+{
   PelUnitBuf recYuv = cs.getRecoBuf();
-  m_tempBuf.copyFrom( recYuv );
   PelUnitBuf tmpYuv = m_tempBuf.getBuf( cs.area );
-  tmpYuv.extendBorderPel( MAX_ALF_FILTER_LENGTH >> 1 );
+#if JVET_N0415_CTB_ALF
+  short* alfCtuFilterIndex = cs.slice->getPic()->getAlfCtbFilterIndex();
+#endif
 
   const PreCalcValues& pcv = *cs.pcv;
 
-  int ctuIdx = 0;
-  for( int yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight )
+  const int yPos = ctuRow * pcv.maxCUHeight;
+  int ctuIdx     = ctuRow * pcv.widthInCtus;
+  for( int xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
   {
-    for( int xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
+    const int width = ( xPos + pcv.maxCUWidth > pcv.lumaWidth ) ? ( pcv.lumaWidth - xPos ) : pcv.maxCUWidth;
+    const int height = ( yPos + pcv.maxCUHeight > pcv.lumaHeight ) ? ( pcv.lumaHeight - yPos ) : pcv.maxCUHeight;
+    const UnitArea area( cs.area.chromaFormat, Area( xPos, yPos, width, height ) );
+    if( m_ctuEnableFlag[COMPONENT_Y][ctuIdx] )
     {
-      const int width = ( xPos + pcv.maxCUWidth > pcv.lumaWidth ) ? ( pcv.lumaWidth - xPos ) : pcv.maxCUWidth;
-      const int height = ( yPos + pcv.maxCUHeight > pcv.lumaHeight ) ? ( pcv.lumaHeight - yPos ) : pcv.maxCUHeight;
-      const UnitArea area( cs.area.chromaFormat, Area( xPos, yPos, width, height ) );
-      if( m_ctuEnableFlag[COMPONENT_Y][ctuIdx] )
-      {
-        Area blk( xPos, yPos, width, height );
-        deriveClassification( m_classifier, tmpYuv.get( COMPONENT_Y ), blk );
-        Area blkPCM(xPos, yPos, width, height);
-        resetPCMBlkClassInfo(cs, m_classifier, tmpYuv.get(COMPONENT_Y), blkPCM);
+      Area blk( xPos, yPos, width, height );
+      deriveClassification( m_classifier, tmpYuv.get( COMPONENT_Y ), blk );
+      Area blkPCM(xPos, yPos, width, height);
+      resetPCMBlkClassInfo(cs, m_classifier, tmpYuv.get(COMPONENT_Y), blkPCM);
 #if JVET_N0415_CTB_ALF
-        short filterSetIndex = alfCtuFilterIndex[ctuIdx];
-        short *coeff;
+      short filterSetIndex = alfCtuFilterIndex[ctuIdx];
+      short *coeff;
 #if JVET_N0242_NON_LINEAR_ALF
-        short *clip;
+      short *clip;
 #endif
-        if (filterSetIndex >= NUM_FIXED_FILTER_SETS)
-        {
-          coeff = m_coeffApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
+      if (filterSetIndex >= NUM_FIXED_FILTER_SETS)
+      {
+        coeff = m_coeffApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
 #if JVET_N0242_NON_LINEAR_ALF
-          clip = m_clippApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
+        clip = m_clippApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
 #endif
-        }
-        else
-        {
-          coeff = m_fixedFilterSetCoeffDec[filterSetIndex];
+      }
+      else
+      {
+        coeff = m_fixedFilterSetCoeffDec[filterSetIndex];
 #if JVET_N0242_NON_LINEAR_ALF
-          clip = m_clipDefault;
+        clip = m_clipDefault;
 #endif
-        }
+      }
 #if JVET_N0180_ALF_LINE_BUFFER_REDUCTION
 #if JVET_N0242_NON_LINEAR_ALF
-        m_filter7x7Blk(m_classifier, recYuv, tmpYuv, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs
-          , m_alfVBLumaCTUHeight
-          , ((yPos + pcv.maxCUHeight >= pcv.lumaHeight) ? pcv.lumaHeight : m_alfVBLumaPos)
-        );
+      m_filter7x7Blk(m_classifier, recYuv, tmpYuv, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs
+        , m_alfVBLumaCTUHeight
+        , ((yPos + pcv.maxCUHeight >= pcv.lumaHeight) ? pcv.lumaHeight : m_alfVBLumaPos)
+      );
 #else
-        m_filter7x7Blk(m_classifier, recYuv, tmpYuv, blk, COMPONENT_Y, coeff, m_clpRngs.comp[COMPONENT_Y], cs
-          , m_alfVBLumaCTUHeight
-          , ((yPos + pcv.maxCUHeight >= pcv.lumaHeight) ? pcv.lumaHeight : m_alfVBLumaPos)
-        );
+      m_filter7x7Blk(m_classifier, recYuv, tmpYuv, blk, COMPONENT_Y, coeff, m_clpRngs.comp[COMPONENT_Y], cs
+        , m_alfVBLumaCTUHeight
+        , ((yPos + pcv.maxCUHeight >= pcv.lumaHeight) ? pcv.lumaHeight : m_alfVBLumaPos)
+      );
 #endif
 #else
 #if JVET_N0242_NON_LINEAR_ALF
-        m_filter7x7Blk(m_classifier, recYuv, tmpYuv, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs);
+      m_filter7x7Blk(m_classifier, recYuv, tmpYuv, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs);
 #else
-        m_filter7x7Blk(m_classifier, recYuv, tmpYuv, blk, COMPONENT_Y, coeff, m_clpRngs.comp[COMPONENT_Y], cs);
+      m_filter7x7Blk(m_classifier, recYuv, tmpYuv, blk, COMPONENT_Y, coeff, m_clpRngs.comp[COMPONENT_Y], cs);
 #endif
 #endif
 #else
 #if JVET_N0180_ALF_LINE_BUFFER_REDUCTION
 #if JVET_N0242_NON_LINEAR_ALF
-        m_filter7x7Blk(m_classifier, recYuv, tmpYuv, blk, COMPONENT_Y, m_coeffFinal, m_clippFinal, m_clpRngs.comp[COMPONENT_Y], cs
-          , m_alfVBLumaCTUHeight
-          , ((yPos + pcv.maxCUHeight >= pcv.lumaHeight) ? pcv.lumaHeight : m_alfVBLumaPos)
-        );
+      m_filter7x7Blk(m_classifier, recYuv, tmpYuv, blk, COMPONENT_Y, m_coeffFinal, m_clippFinal, m_clpRngs.comp[COMPONENT_Y], cs
+        , m_alfVBLumaCTUHeight
+        , ((yPos + pcv.maxCUHeight >= pcv.lumaHeight) ? pcv.lumaHeight : m_alfVBLumaPos)
+      );
 #else
-        m_filter7x7Blk(m_classifier, recYuv, tmpYuv, blk, COMPONENT_Y, m_coeffFinal, m_clpRngs.comp[COMPONENT_Y], cs
-          , m_alfVBLumaCTUHeight
-          , ((yPos + pcv.maxCUHeight >= pcv.lumaHeight) ? pcv.lumaHeight : m_alfVBLumaPos)
-        );
+      m_filter7x7Blk(m_classifier, recYuv, tmpYuv, blk, COMPONENT_Y, m_coeffFinal, m_clpRngs.comp[COMPONENT_Y], cs
+        , m_alfVBLumaCTUHeight
+        , ((yPos + pcv.maxCUHeight >= pcv.lumaHeight) ? pcv.lumaHeight : m_alfVBLumaPos)
+      );
 #endif
 #else
 #if JVET_N0242_NON_LINEAR_ALF
-        m_filter7x7Blk(m_classifier, recYuv, tmpYuv, blk, COMPONENT_Y, m_coeffFinal, m_clippFinal, m_clpRngs.comp[COMPONENT_Y], cs);
+      m_filter7x7Blk(m_classifier, recYuv, tmpYuv, blk, COMPONENT_Y, m_coeffFinal, m_clippFinal, m_clpRngs.comp[COMPONENT_Y], cs);
 #else
-        m_filter7x7Blk(m_classifier, recYuv, tmpYuv, blk, COMPONENT_Y, m_coeffFinal, m_clpRngs.comp[COMPONENT_Y], cs);
+      m_filter7x7Blk(m_classifier, recYuv, tmpYuv, blk, COMPONENT_Y, m_coeffFinal, m_clpRngs.comp[COMPONENT_Y], cs);
 #endif
 #endif
 #endif
-      }
+    }
 
-      for( int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++ )
-      {
-        ComponentID compID = ComponentID( compIdx );
-        const int chromaScaleX = getComponentScaleX( compID, tmpYuv.chromaFormat );
-        const int chromaScaleY = getComponentScaleY( compID, tmpYuv.chromaFormat );
+    for( int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++ )
+    {
+      ComponentID compID = ComponentID( compIdx );
+      const int chromaScaleX = getComponentScaleX( compID, tmpYuv.chromaFormat );
+      const int chromaScaleY = getComponentScaleY( compID, tmpYuv.chromaFormat );
 
-        if( m_ctuEnableFlag[compIdx][ctuIdx] )
-        {
-          Area blk( xPos >> chromaScaleX, yPos >> chromaScaleY, width >> chromaScaleX, height >> chromaScaleY );
+      if( m_ctuEnableFlag[compIdx][ctuIdx] )
+      {
+        Area blk( xPos >> chromaScaleX, yPos >> chromaScaleY, width >> chromaScaleX, height >> chromaScaleY );
 #if JVET_N0180_ALF_LINE_BUFFER_REDUCTION
 #if JVET_N0242_NON_LINEAR_ALF
 #if JVET_N0415_CTB_ALF
-          m_filter5x5Blk(m_classifier, recYuv, tmpYuv, blk, compID, m_chromaCoeffFinal, m_chromaClippFinal, m_clpRngs.comp[compIdx], cs, m_alfVBChmaCTUHeight
-            , ((yPos + pcv.maxCUHeight >= pcv.lumaHeight) ? pcv.lumaHeight : m_alfVBChmaPos));
+        m_filter5x5Blk(m_classifier, recYuv, tmpYuv, blk, compID, m_chromaCoeffFinal, m_chromaClippFinal, m_clpRngs.comp[compIdx], cs, m_alfVBChmaCTUHeight
+          , ((yPos + pcv.maxCUHeight >= pcv.lumaHeight) ? pcv.lumaHeight : m_alfVBChmaPos));
 #else
-          m_filter5x5Blk(m_classifier, recYuv, tmpYuv, blk, compID, alfSliceParam.chromaCoeff, m_chromaClippFinal, m_clpRngs.comp[compIdx], cs
-            , m_alfVBChmaCTUHeight
-            , ((yPos + pcv.maxCUHeight >= pcv.lumaHeight) ? pcv.lumaHeight : m_alfVBChmaPos)
-          );
+        m_filter5x5Blk(m_classifier, recYuv, tmpYuv, blk, compID, m_alfSliceParam->chromaCoeff, m_chromaClippFinal, m_clpRngs.comp[compIdx], cs
+          , m_alfVBChmaCTUHeight
+          , ((yPos + pcv.maxCUHeight >= pcv.lumaHeight) ? pcv.lumaHeight : m_alfVBChmaPos)
+        );
 #endif
 #else
 #if JVET_N0415_CTB_ALF
-          m_filter5x5Blk(m_classifier, recYuv, tmpYuv, blk, compID, m_chromaCoeffFinal, m_clpRngs.comp[compIdx], cs
-            , m_alfVBChmaCTUHeight
-            , ((yPos + pcv.maxCUHeight >= pcv.lumaHeight) ? pcv.lumaHeight : m_alfVBChmaPos)
-          );
+        m_filter5x5Blk(m_classifier, recYuv, tmpYuv, blk, compID, m_chromaCoeffFinal, m_clpRngs.comp[compIdx], cs
+          , m_alfVBChmaCTUHeight
+          , ((yPos + pcv.maxCUHeight >= pcv.lumaHeight) ? pcv.lumaHeight : m_alfVBChmaPos)
+        );
 #else
-          m_filter5x5Blk(m_classifier, recYuv, tmpYuv, blk, compID, alfSliceParam.chromaCoeff, m_clpRngs.comp[compIdx], cs
-            , m_alfVBChmaCTUHeight
-            , ((yPos + pcv.maxCUHeight >= pcv.lumaHeight) ? pcv.lumaHeight : m_alfVBChmaPos)
-          );
+        m_filter5x5Blk(m_classifier, recYuv, tmpYuv, blk, compID, m_alfSliceParam->chromaCoeff, m_clpRngs.comp[compIdx], cs
+          , m_alfVBChmaCTUHeight
+          , ((yPos + pcv.maxCUHeight >= pcv.lumaHeight) ? pcv.lumaHeight : m_alfVBChmaPos)
+        );
 #endif
 #endif
 #else
 
 #if JVET_N0242_NON_LINEAR_ALF
 #if JVET_N0415_CTB_ALF
-          m_filter5x5Blk(m_classifier, recYuv, tmpYuv, blk, compID, m_chromaCoeffFinal, m_chromaClippFinal, m_clpRngs.comp[compIdx], cs);
+        m_filter5x5Blk(m_classifier, recYuv, tmpYuv, blk, compID, m_chromaCoeffFinal, m_chromaClippFinal, m_clpRngs.comp[compIdx], cs);
 #else
-          m_filter5x5Blk( m_classifier, recYuv, tmpYuv, blk, compID, alfSliceParam.chromaCoeff, m_chromaClippFinal, m_clpRngs.comp[compIdx], cs );
+        m_filter5x5Blk( m_classifier, recYuv, tmpYuv, blk, compID, m_alfSliceParam->chromaCoeff, m_chromaClippFinal, m_clpRngs.comp[compIdx], cs );
 #endif
 #else
 #if JVET_N0415_CTB_ALF
-          m_filter5x5Blk(m_classifier, recYuv, tmpYuv, blk, compID, m_chromaCoeffFinal, m_clpRngs.comp[compIdx], cs);
+        m_filter5x5Blk(m_classifier, recYuv, tmpYuv, blk, compID, m_chromaCoeffFinal, m_clpRngs.comp[compIdx], cs);
 #else
-          m_filter5x5Blk( m_classifier, recYuv, tmpYuv, blk, compID, alfSliceParam.chromaCoeff, m_clpRngs.comp[compIdx], cs );
+        m_filter5x5Blk( m_classifier, recYuv, tmpYuv, blk, compID, m_alfSliceParam->chromaCoeff, m_clpRngs.comp[compIdx], cs );
 #endif
 #endif
 #endif
-        }
       }
-      ctuIdx++;
     }
+    ctuIdx++;
   }
 }
 
@@ -642,20 +677,6 @@ void AdaptiveLoopFilter::create( const int picWidth, const int picHeight, const
   m_tempBuf.destroy();
   m_tempBuf.create( format, Area( 0, 0, picWidth, picHeight ), maxCUWidth, MAX_ALF_FILTER_LENGTH >> 1, 0, false );
 
-  // Laplacian based activity
-  for( int i = 0; i < NUM_DIRECTIONS; i++ )
-  {
-    if ( m_laplacian[i] == nullptr )
-    {
-      m_laplacian[i] = new int*[m_CLASSIFICATION_BLK_SIZE + 5];
-
-      for( int y = 0; y < m_CLASSIFICATION_BLK_SIZE + 5; y++ )
-      {
-        m_laplacian[i][y] = new int[m_CLASSIFICATION_BLK_SIZE + 5];
-      }
-    }
-  }
-
   // Classification
   if ( m_classifier == nullptr )
   {
@@ -707,21 +728,6 @@ void AdaptiveLoopFilter::destroy()
     return;
   }
 #endif
-  for( int i = 0; i < NUM_DIRECTIONS; i++ )
-  {
-    if( m_laplacian[i] )
-    {
-      for( int y = 0; y < m_CLASSIFICATION_BLK_SIZE + 5; y++ )
-      {
-        delete[] m_laplacian[i][y];
-        m_laplacian[i][y] = nullptr;
-      }
-
-      delete[] m_laplacian[i];
-      m_laplacian[i] = nullptr;
-    }
-  }
-
   if( m_classifier )
   {
     for( int i = 0; i < m_picHeight; i++ )
@@ -746,6 +752,19 @@ void AdaptiveLoopFilter::deriveClassification( AlfClassifier** classifier, const
   int height = blk.pos().y + blk.height;
   int width = blk.pos().x + blk.width;
 
+  // Laplacian based activity, kept on the stack since the CTU rows of a picture are classified concurrently
+  int   laplacianBuf[NUM_DIRECTIONS][m_CLASSIFICATION_BLK_SIZE + 5][m_CLASSIFICATION_BLK_SIZE + 5];
+  int*  laplacianRows[NUM_DIRECTIONS][m_CLASSIFICATION_BLK_SIZE + 5];
+  int** laplacian[NUM_DIRECTIONS];
+  for( int dir = 0; dir < NUM_DIRECTIONS; dir++ )
+  {
+    for( int y = 0; y < m_CLASSIFICATION_BLK_SIZE + 5; y++ )
+    {
+      laplacianRows[dir][y] = laplacianBuf[dir][y];
+    }
+    laplacian[dir] = laplacianRows[dir];
+  }
+
   for( int i = blk.pos().y; i < height; i += m_CLASSIFICATION_BLK_SIZE )
   {
     int nHeight = std::min( i + m_CLASSIFICATION_BLK_SIZE, height ) - i;
@@ -754,12 +773,12 @@ void AdaptiveLoopFilter::deriveClassification( AlfClassifier** classifier, const
     {
       int nWidth = std::min( j + m_CLASSIFICATION_BLK_SIZE, width ) - j;
 #if JVET_N0180_ALF_LINE_BUFFER_REDUCTION   
-      m_deriveClassificationBlk(classifier, m_laplacian, srcLuma, Area(j, i, nWidth, nHeight), m_inputBitDepth[CHANNEL_TYPE_LUMA] + 4
+      m_deriveClassificationBlk(classifier, laplacian, srcLuma, Area(j, i, nWidth, nHeight), m_inputBitDepth[CHANNEL_TYPE_LUMA] + 4
         , m_alfVBLumaCTUHeight
         , ((i + nHeight >= m_picHeight) ? m_picHeight : m_alfVBLumaPos)
       );
 #else
-      m_deriveClassificationBlk(classifier, m_laplacian, srcLuma, Area(j, i, nWidth, nHeight), m_inputBitDepth[CHANNEL_TYPE_LUMA] + 4);
+      m_deriveClassificationBlk(classifier, laplacian, srcLuma, Area(j, i, nWidth, nHeight), m_inputBitDepth[CHANNEL_TYPE_LUMA] + 4);
 #endif
      
     }
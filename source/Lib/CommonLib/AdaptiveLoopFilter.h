@@ -88,10 +88,16 @@ public:
   void reconstructCoeffAPSs(CodingStructure& cs, bool luma, bool chroma, bool isRdo);
   void reconstructCoeff(AlfSliceParam& alfSliceParam, ChannelType channel, const bool isRdo, const bool isRedo = false);
   void ALFProcess(CodingStructure& cs);
+  bool initALFProcess(CodingStructure& cs);                                   ///< false if ALF is off in the picture
 #else
   void reconstructCoeff(AlfSliceParam& alfSliceParam, ChannelType channel, const bool isRedo = false);
   void ALFProcess( CodingStructure& cs, AlfSliceParam& alfSliceParam );
+  bool initALFProcess( CodingStructure& cs, AlfSliceParam& alfSliceParam );  ///< false if ALF is off in the picture, alfSliceParam has to outlive the rows
 #endif
+  // CTU row based processing after initALFProcess: a row is filtered once it and its neighbour rows are stored, the rows
+  // themselves can be stored and filtered concurrently
+  void storeCtuRow     ( CodingStructure& cs, const int ctuRow );             ///< copies the row to the ALF input buffer
+  void ALFProcessCtuRow( CodingStructure& cs, const int ctuRow );
   void create( const int picWidth, const int picHeight, const ChromaFormat format, const int maxCUWidth, const int maxCUHeight, const int maxCUDepth, const int inputBitDepth[MAX_NUM_CHANNEL_TYPE] );
   void destroy();
 #if JVET_N0180_ALF_LINE_BUFFER_REDUCTION
@@ -145,7 +151,7 @@ public:
 #endif
 
 #ifdef TARGET_SIMD_X86
-  void initAdaptiveLoopFilterX86();
+  void initAdaptiveLoopFilterX86( const X86_VEXT vext = read_x86_extension_flags() );
   template <X86_VEXT vext>
   void _initAdaptiveLoopFilterX86();
 #endif
@@ -173,7 +179,6 @@ protected:
   short                        m_clippFinal[MAX_NUM_ALF_CLASSES * MAX_NUM_ALF_LUMA_COEFF];
   short                        m_chromaClippFinal[MAX_NUM_ALF_LUMA_COEFF];
 #endif
-  int**                        m_laplacian[NUM_DIRECTIONS];
   uint8_t*                     m_ctuEnableFlag[MAX_NUM_COMPONENT];
   PelStorage                   m_tempBuf;
   int                          m_inputBitDepth[MAX_NUM_CHANNEL_TYPE];
@@ -193,6 +198,9 @@ protected:
 #endif
   ChromaFormat                 m_chromaFormat;
   ClpRngs                      m_clpRngs;
+#if !JVET_N0415_CTB_ALF
+  AlfSliceParam*               m_alfSliceParam;
+#endif
 };
 
 #endif
@@ -63,7 +63,7 @@ public:
   ~AffineGradientSearch() {}
 
 #ifdef TARGET_SIMD_X86
-  void initAffineGradientSearchX86();
+  void initAffineGradientSearchX86( const X86_VEXT vext = read_x86_extension_flags() );
   template <X86_VEXT vext>
   void _initAffineGradientSearchX86();
 #endif
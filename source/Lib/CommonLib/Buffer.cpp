@@ -200,7 +200,7 @@ void calcBlkGradientCore(int sx, int sy, int     *arraysGx2, int     *arraysGxGy
 }
 
 #if ENABLE_SIMD_OPT_GBI
-void removeWeightHighFreq(int16_t* dst, int dstStride, const int16_t* src, int srcStride, int width, int height, int shift, int gbiWeight)
+void removeWeightHighFreq(Pel* dst, int dstStride, const Pel* src, int srcStride, int width, int height, int shift, int gbiWeight)
 {
   int normalizer = ((1 << 16) + (gbiWeight > 0 ? (gbiWeight >> 1) : -(gbiWeight >> 1))) / gbiWeight;
   int weight0 = normalizer << g_GbiLog2WeightBase;
@@ -218,7 +218,7 @@ void removeWeightHighFreq(int16_t* dst, int dstStride, const int16_t* src, int s
 #undef REM_HF_OP_CLIP
 }
 
-void removeHighFreq(int16_t* dst, int dstStride, const int16_t* src, int srcStride, int width, int height)
+void removeHighFreq(Pel* dst, int dstStride, const Pel* src, int srcStride, int width, int height)
 {
 #define REM_HF_INC  \
   src += srcStride; \
@@ -282,6 +282,7 @@ PelBufferOps::PelBufferOps()
 
   copyBuffer = copyBufferCore;
   padding = paddingCore;
+  calcSSE = calcSSECore;
 #if ENABLE_SIMD_OPT_GBI
   removeWeightHighFreq8 = removeWeightHighFreq;
   removeWeightHighFreq4 = removeWeightHighFreq;
@@ -302,6 +303,22 @@ void copyBufferCore(Pel *src, int srcStride, Pel *dst, int dstStride, int width,
   }
 }
 
+uint64_t calcSSECore(const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, int width, int height, int shift)
+{
+  uint64_t sum = 0;
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      const Intermediate_Int diff = src0[x] - src1[x];
+      sum += uint64_t((diff * diff) >> shift);
+    }
+    src0 += src0Stride;
+    src1 += src1Stride;
+  }
+  return sum;
+}
+
 void paddingCore(Pel *ptr, int stride, int width, int height, int padSize)
 {
   /*left and right padding*/
@@ -56,7 +56,7 @@ struct PelBufferOps
   PelBufferOps();
 
 #if ENABLE_SIMD_OPT_BUFFER && defined(TARGET_SIMD_X86)
-  void initPelBufOpsX86();
+  void initPelBufOpsX86( const X86_VEXT vext = read_x86_extension_flags() );
   template<X86_VEXT vext>
   void _initPelBufOpsX86();
 #endif
@@ -73,6 +73,7 @@ struct PelBufferOps
   void(*calcBlkGradient)(int sx, int sy, int    *arraysGx2, int     *arraysGxGy, int     *arraysGxdI, int     *arraysGy2, int     *arraysGydI, int     &sGx2, int     &sGy2, int     &sGxGy, int     &sGxdI, int     &sGydI, int width, int height, int unitSize);
   void(*copyBuffer)(Pel *src, int srcStride, Pel *dst, int dstStride, int width, int height);
   void(*padding)(Pel *dst, int stride, int width, int height, int padSize);
+  uint64_t ( *calcSSE )    ( const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, int width, int height, int shift );
 #if ENABLE_SIMD_OPT_GBI
   void ( *removeWeightHighFreq8)  ( Pel* src0, int src0Stride, const Pel* src1, int src1Stride, int width, int height, int shift, int gbiWeight);
   void ( *removeWeightHighFreq4)  ( Pel* src0, int src0Stride, const Pel* src1, int src1Stride, int width, int height, int shift, int gbiWeight);
@@ -85,6 +86,7 @@ extern PelBufferOps g_pelBufOP;
 
 void paddingCore(Pel *ptr, int stride, int width, int height, int padSize);
 void copyBufferCore(Pel *src, int srcStride, Pel *Dst, int dstStride, int width, int height);
+uint64_t calcSSECore(const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, int width, int height, int shift);
 
 template<typename T>
 struct AreaBuf : public Size
@@ -116,7 +118,7 @@ struct AreaBuf : public Size
   void subtractAndHalve     ( const AreaBuf<const T> &other );
 #endif
   void extendSingleBorderPel();
-  void extendBorderPel      (  unsigned margin );
+  void extendBorderPel      (  unsigned margin, const bool top = true, const bool bottom = true );  ///< top/bottom: also extend above the first/below the last line
   void addWeightedAvg       ( const AreaBuf<const T> &other1, const AreaBuf<const T> &other2, const ClpRng& clpRng, const int8_t gbiIdx);
   void removeWeightHighFreq ( const AreaBuf<T>& other, const bool bClip, const ClpRng& clpRng, const int8_t iGbiWeight);
   void addAvg               ( const AreaBuf<const T> &other1, const AreaBuf<const T> &other2, const ClpRng& clpRng );
@@ -564,7 +566,7 @@ void AreaBuf<T>::updateHistogram( std::vector<int32_t>& hist ) const
 }
 
 template<typename T>
-void AreaBuf<T>::extendBorderPel( unsigned margin )
+void AreaBuf<T>::extendBorderPel( unsigned margin, const bool top, const bool bottom )
 {
   T*  p = buf;
   int h = height;
@@ -586,7 +588,7 @@ void AreaBuf<T>::extendBorderPel( unsigned margin )
   // p is now the (0,height) (bottom left of image within bigger picture
   p -= ( s + margin );
   // p is now the (-margin, height-1)
-  for( int y = 0; y < margin; y++ )
+  for( int y = 0; bottom && y < margin; y++ )
   {
     ::memcpy( p + ( y + 1 ) * s, p, sizeof( T ) * ( w + ( margin << 1 ) ) );
   }
@@ -594,7 +596,7 @@ void AreaBuf<T>::extendBorderPel( unsigned margin )
   // pi is still (-marginX, height-1)
   p -= ( ( h - 1 ) * s );
   // pi is now (-marginX, 0)
-  for( int y = 0; y < margin; y++ )
+  for( int y = 0; top && y < margin; y++ )
   {
     ::memcpy( p - ( y + 1 ) * s, p, sizeof( T ) * ( w + ( margin << 1 ) ) );
   }
@@ -730,7 +732,7 @@ struct UnitBuf
   void addWeightedAvg       ( const UnitBuf<const T> &other1, const UnitBuf<const T> &other2, const ClpRngs& clpRngs, const uint8_t gbiIdx = GBI_DEFAULT, const bool chromaOnly = false, const bool lumaOnly = false);
   void addAvg               ( const UnitBuf<const T> &other1, const UnitBuf<const T> &other2, const ClpRngs& clpRngs, const bool chromaOnly = false, const bool lumaOnly = false);
   void extendSingleBorderPel();
-  void extendBorderPel      ( unsigned margin );
+  void extendBorderPel      ( unsigned margin, const bool top = true, const bool bottom = true );
   void removeHighFreq       ( const UnitBuf<T>& other, const bool bClip, const ClpRngs& clpRngs
                             , const int8_t gbiWeight = g_GbiWeights[GBI_DEFAULT]
                             );
@@ -840,11 +842,11 @@ void UnitBuf<T>::extendSingleBorderPel()
 }
 
 template<typename T>
-void UnitBuf<T>::extendBorderPel( unsigned margin )
+void UnitBuf<T>::extendBorderPel( unsigned margin, const bool top, const bool bottom )
 {
   for( unsigned i = 0; i < bufs.size(); i++ )
   {
-    bufs[i].extendBorderPel( margin );
+    bufs[i].extendBorderPel( margin, top, bottom );
   }
 }
 
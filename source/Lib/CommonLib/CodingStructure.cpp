@@ -44,7 +44,10 @@
 #include "UnitPartitioner.h"
 
 
-XUCache g_globalUnitCache = XUCache();
+
+// substream state of the calling thread, bound to exactly one coding structure
+static thread_local const CodingStructure* t_substreamCS  = nullptr;
+static thread_local CSSubstreamCtx*        t_substreamCtx = nullptr;
 
 const UnitScale UnitScaleArray[NUM_CHROMA_FORMAT][MAX_NUM_COMPONENT] =
 {
@@ -54,19 +57,144 @@ const UnitScale UnitScaleArray[NUM_CHROMA_FORMAT][MAX_NUM_COMPONENT] =
   { {2,2}, {2,2}, {2,2} }   // 4:4:4
 };
 
+// ---------------------------------------------------------------------------
+// compressed motion field method definitions
+// ---------------------------------------------------------------------------
+
+void ColMotionField::create( const Size& lumaSize, const int _log2Scale )
+{
+  log2Scale = _log2Scale;
+  stride    = ( lumaSize.width  + ( 1 << log2Scale ) - 1 ) >> log2Scale;
+  height    = ( lumaSize.height + ( 1 << log2Scale ) - 1 ) >> log2Scale;
+
+  // one allocation, every array starts on its own cache line
+  const size_t numEntries = size_t( stride ) * height;
+  const size_t lineSize   = 64;
+  auto         alignSize  = [&]( size_t size ) { return ( size + lineSize - 1 ) & ~( lineSize - 1 ); };
+
+  const size_t isInterSize  = alignSize( numEntries * sizeof( bool ) );
+  const size_t sliceIdxSize = alignSize( numEntries * sizeof( uint16_t ) );
+  const size_t refIdxSize   = alignSize( numEntries * sizeof( int8_t ) );
+  const size_t mvSize       = alignSize( numEntries * sizeof( Mv ) );
+
+  m_mem = ( uint8_t* ) xMalloc( uint8_t, isInterSize + sliceIdxSize + NUM_REF_PIC_LIST_01 * ( refIdxSize + mvSize ) + lineSize );
+
+  uint8_t* ptr = ( uint8_t* ) alignSize( size_t( m_mem ) );
+
+  isInter  = ( bool*     ) ptr; ptr += isInterSize;
+  sliceIdx = ( uint16_t* ) ptr; ptr += sliceIdxSize;
+
+  for( int l = 0; l < NUM_REF_PIC_LIST_01; l++ )
+  {
+    mv    [l] = ( Mv*      ) ptr; ptr += mvSize;
+    refIdx[l] = ( int8_t*  ) ptr; ptr += refIdxSize;
+  }
+}
+
+void ColMotionField::destroy()
+{
+  if( m_mem )
+  {
+    xFree( m_mem );
+  }
+
+  m_mem    = nullptr;
+  isInter  = nullptr;
+  sliceIdx = nullptr;
+
+  for( int l = 0; l < NUM_REF_PIC_LIST_01; l++ )
+  {
+    mv    [l] = nullptr;
+    refIdx[l] = nullptr;
+  }
+}
+
+void ColMotionField::compress( const CMotionBuf& mb )
+{
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < stride; x++ )
+    {
+      // the top-left motion of each block represents the whole block
+      const Position   miPos = g_miScaling.scale( Position( x << log2Scale, y << log2Scale ) );
+      const MotionInfo &mi   = mb.at( miPos );
+      const unsigned    i    = y * stride + x;
+
+      isInter [i] = mi.isInter && !mi.isIBCmot;
+      sliceIdx[i] = mi.sliceIdx;
+
+      for( int l = 0; l < NUM_REF_PIC_LIST_01; l++ )
+      {
+        refIdx[l][i] = int8_t( mi.refIdx[l] );
+        mv    [l][i] = mi.mv[l];
+      }
+    }
+  }
+}
+
 // ---------------------------------------------------------------------------
 // coding structure method definitions
 // ---------------------------------------------------------------------------
 
-CodingStructure::CodingStructure(CUCache& cuCache, PUCache& puCache, TUCache& tuCache)
+template<typename T>
+static void xClearDirty( T* buf, const Size& mapSize, Area& dirty, const bool trackDirty )
+{
+  if( !trackDirty )
+  {
+    dirty = Area( Position( 0, 0 ), mapSize );
+  }
+
+  if( dirty.area() == 0 )
+  {
+    return;
+  }
+
+  T* dst = buf + dirty.y * mapSize.width + dirty.x;
+
+  if( dirty.width == mapSize.width )
+  {
+    ::memset( ( void* ) dst, 0, sizeof( T ) * dirty.width * dirty.height );
+  }
+  else
+  {
+    for( unsigned y = 0; y < dirty.height; y++, dst += mapSize.width )
+    {
+      ::memset( ( void* ) dst, 0, sizeof( T ) * dirty.width );
+    }
+  }
+
+  dirty = Area();
+}
+
+void CodingStructure::xMarkDirty( Area& dirty, const Position& pos, const Size& size )
+{
+  if( !m_trackDirty || size.area() == 0 )
+  {
+    return;
+  }
+
+  if( dirty.area() == 0 )
+  {
+    dirty = Area( pos, size );
+    return;
+  }
+
+  const PosType x0 = std::min( dirty.x, pos.x );
+  const PosType y0 = std::min( dirty.y, pos.y );
+  const PosType x1 = std::max<PosType>( dirty.x + dirty.width,  pos.x + size.width  );
+  const PosType y1 = std::max<PosType>( dirty.y + dirty.height, pos.y + size.height );
+
+  dirty = Area( x0, y0, x1 - x0, y1 - y0 );
+}
+
+CodingStructure::CodingStructure()
   : area      ()
   , picture   ( nullptr )
   , parent    ( nullptr )
   , bestCS    ( nullptr )
+  , m_parallelInsertion( false )
+  , m_lastSerialCU     ( nullptr )
   , m_isTuEnc ( false )
-  , m_cuCache ( cuCache )
-  , m_puCache ( puCache )
-  , m_tuCache ( tuCache )
 {
   for( uint32_t i = 0; i < MAX_NUM_COMPONENT; i++ )
   {
@@ -85,6 +213,8 @@ CodingStructure::CodingStructure(CUCache& cuCache, PUCache& puCache, TUCache& tu
   }
 
   m_motionBuf     = nullptr;
+  m_colMotionValid = false;
+  m_trackDirty     = false;
   features.resize( NUM_ENC_FEATURES );
 
 }
@@ -119,10 +249,17 @@ void CodingStructure::destroy()
   delete[] m_motionBuf;
   m_motionBuf = nullptr;
 
+  m_colMotion.destroy();
+  m_colMotionValid = false;
+
+
+  tus.clear();
+  pus.clear();
+  cus.clear();
 
-  m_tuCache.cache( tus );
-  m_puCache.cache( pus );
-  m_cuCache.cache( cus );
+  m_tuArena.deleteEntries();
+  m_puArena.deleteEntries();
+  m_cuArena.deleteEntries();
 }
 
 void CodingStructure::releaseIntermediateData()
@@ -173,6 +310,8 @@ void CodingStructure::setDecomp(const CompArea &_area, const bool _isCoded /*= t
                             _area.width                     >> scale.posx,
                             _area.height                    >> scale.posy);
   isCodedBlk.fill( _isCoded );
+
+  xMarkDirty( m_dirtyIsDecomp[toChannelType( _area.compID )], scale.scale( _area.pos() - area.blocks[_area.compID].pos() ), scale.scale( _area.size() ) );
 }
 
 void CodingStructure::setDecomp(const UnitArea &_area, const bool _isCoded /*= true*/)
@@ -347,7 +486,15 @@ const TransformUnit * CodingStructure::getTU( const Position &pos, const Channel
 
 CodingUnit& CodingStructure::addCU( const UnitArea &unit, const ChannelType chType )
 {
-  CodingUnit *cu = m_cuCache.get();
+  CSSubstreamCtx* substream = xGetSubstreamCtx();
+  std::unique_lock<std::mutex> lock( m_unitMutex, std::defer_lock );
+  if( substream )
+  {
+    lock.lock();
+    CHECK( cus.size() == cus.capacity(), "Picture level CU storage exhausted during parallel insertion" );
+  }
+
+  CodingUnit *cu = m_cuArena.get();
 
   cu->UnitArea::operator=( unit );
   cu->initData();
@@ -360,15 +507,18 @@ CodingUnit& CodingStructure::addCU( const UnitArea &unit, const ChannelType chTy
   cu->lastTU    = nullptr;
   cu->chType    = chType;
 
-  CodingUnit *prevCU = m_numCUs > 0 ? cus.back() : nullptr;
+  if( substream )
+  {
+    // other substreams can look the CU up as soon as it is indexed, before the parser sets up its slice and tile
+    cu->slice   = slice;
+    cu->tileIdx = picture->tileMap->getTileIdxMap( cu->lumaPos() );
+  }
+
+  CodingUnit *prevCU = substream ? substream->lastCU : ( m_numCUs > 0 ? cus.back() : nullptr );
 
   if( prevCU )
   {
     prevCU->next = cu;
-#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
-
-    CHECK( prevCU->cacheId != cu->cacheId, "Inconsintent cacheId between previous and current CU" );
-#endif
   }
 
   cus.push_back( cu );
@@ -376,6 +526,15 @@ CodingUnit& CodingStructure::addCU( const UnitArea &unit, const ChannelType chTy
   uint32_t idx = ++m_numCUs;
   cu->idx  = idx;
 
+  if( substream )
+  {
+    if( !substream->firstCU )
+    {
+      substream->firstCU = cu;
+    }
+    substream->lastCU = cu;
+  }
+
   uint32_t numCh = ::getNumberValidChannels( area.chromaFormat );
 
   for( uint32_t i = 0; i < numCh; i++ )
@@ -394,6 +553,7 @@ CodingUnit& CodingStructure::addCU( const UnitArea &unit, const ChannelType chTy
     unsigned *idxPtr       = m_cuIdx[i] + rsAddr( scaledBlk.pos(), scaledSelf.pos(), scaledSelf.width );
     CHECK( *idxPtr, "Overwriting a pre-existing value, should be '0'!" );
     AreaBuf<uint32_t>( idxPtr, scaledSelf.width, scaledBlk.size() ).fill( idx );
+    xMarkDirty( m_dirtyCuIdx[i], scaledBlk.pos() - scaledSelf.pos(), scaledBlk.size() );
   }
 
   return *cu;
@@ -401,7 +561,15 @@ CodingUnit& CodingStructure::addCU( const UnitArea &unit, const ChannelType chTy
 
 PredictionUnit& CodingStructure::addPU( const UnitArea &unit, const ChannelType chType )
 {
-  PredictionUnit *pu = m_puCache.get();
+  CSSubstreamCtx* substream = xGetSubstreamCtx();
+  std::unique_lock<std::mutex> lock( m_unitMutex, std::defer_lock );
+  if( substream )
+  {
+    lock.lock();
+    CHECK( pus.size() == pus.capacity(), "Picture level PU storage exhausted during parallel insertion" );
+  }
+
+  PredictionUnit *pu = m_puArena.get();
 
   pu->UnitArea::operator=( unit );
   pu->initData();
@@ -411,23 +579,23 @@ PredictionUnit& CodingStructure::addPU( const UnitArea &unit, const ChannelType
   pu->chType = chType;
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
 
-  CHECK( pu->cacheId != pu->cu->cacheId, "Inconsintent cacheId between the PU and assigned CU" );
   CHECK( pu->cu->firstPU != nullptr, "Without an RQT the firstPU should be null" );
 #endif
 
-  PredictionUnit *prevPU = m_numPUs > 0 ? pus.back() : nullptr;
+  PredictionUnit *prevPU = substream ? substream->lastPU : ( m_numPUs > 0 ? pus.back() : nullptr );
 
   if( prevPU && prevPU->cu == pu->cu )
   {
     prevPU->next = pu;
-#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
-
-    CHECK( prevPU->cacheId != pu->cacheId, "Inconsintent cacheId between previous and current PU" );
-#endif
   }
 
   pus.push_back( pu );
 
+  if( substream )
+  {
+    substream->lastPU = pu;
+  }
+
   if( pu->cu->firstPU == nullptr )
   {
     pu->cu->firstPU = pu;
@@ -454,6 +622,7 @@ PredictionUnit& CodingStructure::addPU( const UnitArea &unit, const ChannelType
     unsigned *idxPtr       = m_puIdx[i] + rsAddr( scaledBlk.pos(), scaledSelf.pos(), scaledSelf.width );
     CHECK( *idxPtr, "Overwriting a pre-existing value, should be '0'!" );
     AreaBuf<uint32_t>( idxPtr, scaledSelf.width, scaledBlk.size() ).fill( idx );
+    xMarkDirty( m_dirtyPuIdx[i], scaledBlk.pos() - scaledSelf.pos(), scaledBlk.size() );
   }
 
   return *pu;
@@ -461,7 +630,15 @@ PredictionUnit& CodingStructure::addPU( const UnitArea &unit, const ChannelType
 
 TransformUnit& CodingStructure::addTU( const UnitArea &unit, const ChannelType chType )
 {
-  TransformUnit *tu = m_tuCache.get();
+  CSSubstreamCtx* substream = xGetSubstreamCtx();
+  std::unique_lock<std::mutex> lock( m_unitMutex, std::defer_lock );
+  if( substream )
+  {
+    lock.lock();
+    CHECK( tus.size() == tus.capacity(), "Picture level TU storage exhausted during parallel insertion" );
+  }
+
+  TransformUnit *tu = m_tuArena.get();
 
   tu->UnitArea::operator=( unit );
   tu->initData();
@@ -470,27 +647,22 @@ TransformUnit& CodingStructure::addTU( const UnitArea &unit, const ChannelType c
   tu->cs     = this;
   tu->cu     = m_isTuEnc ? cus[0] : getCU( unit.blocks[chType].pos(), chType );
   tu->chType = chType;
-#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
 
-  if( tu->cu )
-    CHECK( tu->cacheId != tu->cu->cacheId, "Inconsintent cacheId between the TU and assigned CU" );
-#endif
-
-
-  TransformUnit *prevTU = m_numTUs > 0 ? tus.back() : nullptr;
+  TransformUnit *prevTU = substream ? substream->lastTU : ( m_numTUs > 0 ? tus.back() : nullptr );
 
   if( prevTU && prevTU->cu == tu->cu )
   {
     prevTU->next = tu;
     tu->prev     = prevTU;
-#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
-
-    CHECK( prevTU->cacheId != tu->cacheId, "Inconsintent cacheId between previous and current TU" );
-#endif
   }
 
   tus.push_back( tu );
 
+  if( substream )
+  {
+    substream->lastTU = tu;
+  }
+
   if( tu->cu )
   {
     if( tu->cu->firstTU == nullptr )
@@ -536,6 +708,7 @@ TransformUnit& CodingStructure::addTU( const UnitArea &unit, const ChannelType c
         unsigned *idxPtr       = m_tuIdx[i] + rsAddr( scaledBlk.pos(), scaledSelf.pos(), scaledSelf.width );
         CHECK( *idxPtr, "Overwriting a pre-existing value, should be '0'!" );
         AreaBuf<uint32_t>( idxPtr, scaledSelf.width, scaledBlk.size() ).fill( idx );
+        xMarkDirty( m_dirtyTuIdx[i], scaledBlk.pos() - scaledSelf.pos(), scaledBlk.size() );
       }
     }
 
@@ -681,7 +854,86 @@ void CodingStructure::createInternals( const UnitArea& _unit, const bool isTopLa
 
   unsigned _lumaAreaScaled = g_miScaling.scale( area.lumaSize() ).area();
   m_motionBuf       = new MotionInfo[_lumaAreaScaled];
+
+  // the freshly allocated maps are cleared completely once
+  m_trackDirty = false;
   initStructData();
+  m_trackDirty = !isTopLayer;
+}
+
+LutMotionCand& CodingStructure::getMotionLut()
+{
+  CSSubstreamCtx* substream = xGetSubstreamCtx();
+  return substream ? substream->motionLut : m_motionLut;
+}
+
+const LutMotionCand& CodingStructure::getMotionLut() const
+{
+  CSSubstreamCtx* substream = xGetSubstreamCtx();
+  return substream ? substream->motionLut : m_motionLut;
+}
+
+CSSubstreamCtx* CodingStructure::xGetSubstreamCtx() const
+{
+  return t_substreamCS == this ? t_substreamCtx : nullptr;
+}
+
+void CodingStructure::startParallelInsertion()
+{
+  CHECK( parent || m_parallelInsertion, "Parallel insertion is only supported on the picture level" );
+
+  allocateVectorsAtPicLevel();
+
+  m_lastSerialCU      = m_numCUs > 0 ? cus.back() : nullptr;
+  m_parallelInsertion = true;
+}
+
+void CodingStructure::finishParallelInsertion( const std::vector<CSSubstreamCtx>& substreams )
+{
+  CHECK( !m_parallelInsertion, "Parallel insertion has not been started" );
+
+  // chain the CUs of the substreams in coding order
+  CodingUnit *prevCU = m_lastSerialCU;
+
+  for( const auto &substream : substreams )
+  {
+    if( substream.firstCU )
+    {
+      if( prevCU )
+      {
+        prevCU->next = substream.firstCU;
+      }
+      prevCU = substream.lastCU;
+    }
+  }
+
+  if( !substreams.empty() )
+  {
+    m_motionLut = substreams.back().motionLut;
+  }
+
+  m_lastSerialCU      = nullptr;
+  m_parallelInsertion = false;
+}
+
+void CodingStructure::bindSubstreamCtx( CSSubstreamCtx* substream )
+{
+  CHECK( substream && !m_parallelInsertion, "Parallel insertion has not been started" );
+
+  t_substreamCS  = substream ? this : nullptr;
+  t_substreamCtx = substream;
+}
+
+PelStorage* CodingStructure::getSubstreamBuf( const PictureType &type ) const
+{
+  const CSSubstreamCtx* substream = xGetSubstreamCtx();
+
+  if( !substream )
+  {
+    return nullptr;
+  }
+
+  return type == PIC_PREDICTION ? substream->predBuf : ( type == PIC_RESIDUAL ? substream->resiBuf : nullptr );
 }
 
 void CodingStructure::addMiToLut(static_vector<MotionInfo, MAX_NUM_HMVP_CANDS> &lut, const MotionInfo &mi)
@@ -789,7 +1041,7 @@ void CodingStructure::initSubStructure( CodingStructure& subStruct, const Channe
 
   subStruct.m_isTuEnc = isTuEnc;
 
-  subStruct.motionLut = motionLut;
+  subStruct.getMotionLut() = getMotionLut();
 
   subStruct.initStructData( currQP[_chType], isLossless );
 
@@ -815,6 +1067,7 @@ void CodingStructure::initSubStructure( CodingStructure& subStruct, const Channe
     for( unsigned i = 0; i < numComp; i++)
     {
       ::memcpy( subStruct.m_isDecomp[i], m_isDecomp[i], (unitScale[i].scale( area.blocks[i].size() ).area() * sizeof( bool ) ) );
+      subStruct.xMarkDirty( subStruct.m_dirtyIsDecomp[i], Position( 0, 0 ), unitScale[i].scale( area.blocks[i].size() ) );
     }
   }
 }
@@ -849,83 +1102,24 @@ void CodingStructure::useSubStructure( const CodingStructure& subStruct, const C
     CMotionBuf subMB = subStruct.getMotionBuf( clippedArea );
 
     ownMB.copyFrom( subMB );
+    m_colMotionValid.store( false, std::memory_order_relaxed );
 
-    motionLut = subStruct.motionLut;
+    getMotionLut() = subStruct.getMotionLut();
   }
-#if ENABLE_WPP_PARALLELISM
 
-  if( nullptr == parent )
   {
-#pragma omp critical
+    // CTU rows encoded in parallel accumulate into the same picture level costs
+    std::unique_lock<std::mutex> lock( m_unitMutex, std::defer_lock );
+    if( m_parallelInsertion )
     {
-      fracBits += subStruct.fracBits;
-      dist     += subStruct.dist;
-      cost     += subStruct.cost;
-      costDbOffset += subStruct.costDbOffset;
-      if( parent )
-      {
-        // allow this to be false at the top level
-        CHECKD( !area.contains( subArea ), "Trying to use a sub-structure not contained in self" );
-      }
-
-      // copy the CUs over
-      if( subStruct.m_isTuEnc )
-      {
-        // don't copy if the substruct was created for encoding of the TUs
-      }
-      else
-      {
-        for( const auto &pcu : subStruct.cus )
-        {
-          // add an analogue CU into own CU store
-          const UnitArea &cuPatch = *pcu;
-
-          CodingUnit &cu = addCU( cuPatch, chType );
-
-          // copy the CU info from subPatch
-          cu = *pcu;
-        }
-      }
-
-      // copy the PUs over
-      if( subStruct.m_isTuEnc )
-      {
-        // don't copy if the substruct was created for encoding of the TUs
-      }
-      else
-      {
-        for( const auto &ppu : subStruct.pus )
-        {
-          // add an analogue PU into own PU store
-          const UnitArea &puPatch = *ppu;
-
-          PredictionUnit &pu = addPU( puPatch, chType );
-
-          // copy the PU info from subPatch
-          pu = *ppu;
-        }
-      }
-      // copy the TUs over
-      for( const auto &ptu : subStruct.tus )
-      {
-        // add an analogue TU into own TU store
-        const UnitArea &tuPatch = *ptu;
-
-        TransformUnit &tu = addTU( tuPatch, chType );
-
-        // copy the TU info from subPatch
-        tu = *ptu;
-      }
+      lock.lock();
     }
 
-    return;
+    fracBits += subStruct.fracBits;
+    dist     += subStruct.dist;
+    cost     += subStruct.cost;
+    costDbOffset += subStruct.costDbOffset;
   }
-#endif
-
-  fracBits += subStruct.fracBits;
-  dist     += subStruct.dist;
-  cost     += subStruct.cost;
-  costDbOffset += subStruct.costDbOffset;
   if( parent )
   {
     // allow this to be false at the top level
@@ -1031,8 +1225,9 @@ void CodingStructure::copyStructure( const CodingStructure& other, const Channel
     CMotionBuf subMB = other.getMotionBuf();
 
     ownMB.copyFrom( subMB );
+    m_colMotionValid.store( false, std::memory_order_relaxed );
 
-    motionLut = other.motionLut;
+    getMotionLut() = other.getMotionLut();
   }
 
   if( copyTUs )
@@ -1083,6 +1278,7 @@ void CodingStructure::copyStructure( const CodingStructure& other, const Channel
       const size_t _area = unitScale[i].scaleArea( area.blocks[i].area() );
 
       memcpy( m_isDecomp[i], other.m_isDecomp[i], sizeof( *m_isDecomp[0] ) * _area );
+      xMarkDirty( m_dirtyIsDecomp[i], Position( 0, 0 ), unitScale[i].scale( area.blocks[i].size() ) );
     }
   }
 }
@@ -1101,9 +1297,11 @@ void CodingStructure::initStructData( const int &QP, const bool &_isLosses, cons
 
   if (!skipMotBuf && (!parent || ((!slice->isIntra() || slice->getSPS()->getIBCFlag()) && !m_isTuEnc)))
   {
-    getMotionBuf()      .memset( 0 );
+    xClearDirty( m_motionBuf, g_miScaling.scale( area.lumaSize() ), m_dirtyMotion, m_trackDirty );
   }
 
+  m_colMotionValid = false;
+
   fracBits = 0;
   dist     = 0;
   cost     = MAX_DOUBLE;
@@ -1119,10 +1317,10 @@ void CodingStructure::clearTUs()
   int numCh = ::getNumberValidChannels( area.chromaFormat );
   for( int i = 0; i < numCh; i++ )
   {
-    size_t _area = ( area.blocks[i].area() >> unitScale[i].area );
+    const Size mapSize = unitScale[i].scale( area.blocks[i].size() );
 
-    memset( m_isDecomp[i], false, sizeof( *m_isDecomp[0] ) * _area );
-    memset( m_tuIdx   [i],     0, sizeof( *m_tuIdx   [0] ) * _area );
+    xClearDirty( m_isDecomp[i], mapSize, m_dirtyIsDecomp[i], m_trackDirty );
+    xClearDirty( m_tuIdx   [i], mapSize, m_dirtyTuIdx   [i], m_trackDirty );
   }
 
   numCh = getNumberValidComponents( area.chromaFormat );
@@ -1136,7 +1334,8 @@ void CodingStructure::clearTUs()
     pcu->firstTU = pcu->lastTU = nullptr;
   }
 
-  m_tuCache.cache( tus );
+  tus.clear();
+  m_tuArena.release();
   m_numTUs = 0;
 }
 
@@ -1145,10 +1344,11 @@ void CodingStructure::clearPUs()
   int numCh = ::getNumberValidChannels( area.chromaFormat );
   for( int i = 0; i < numCh; i++ )
   {
-    memset( m_puIdx[i], 0, sizeof( *m_puIdx[0] ) * unitScale[i].scaleArea( area.blocks[i].area() ) );
+    xClearDirty( m_puIdx[i], unitScale[i].scale( area.blocks[i].size() ), m_dirtyPuIdx[i], m_trackDirty );
   }
 
-  m_puCache.cache( pus );
+  pus.clear();
+  m_puArena.release();
   m_numPUs = 0;
 
   for( auto &pcu : cus )
@@ -1162,10 +1362,11 @@ void CodingStructure::clearCUs()
   int numCh = ::getNumberValidChannels( area.chromaFormat );
   for( int i = 0; i < numCh; i++ )
   {
-    memset( m_cuIdx[i], 0, sizeof( *m_cuIdx[0] ) * unitScale[i].scaleArea( area.blocks[i].area() ) );
+    xClearDirty( m_cuIdx[i], unitScale[i].scale( area.blocks[i].size() ), m_dirtyCuIdx[i], m_trackDirty );
   }
 
-  m_cuCache.cache( cus );
+  cus.clear();
+  m_cuArena.release();
   m_numCUs = 0;
 }
 
@@ -1178,6 +1379,9 @@ MotionBuf CodingStructure::getMotionBuf( const Area& _area )
   const Area miArea   = g_miScaling.scale( _area );
   const Area selfArea = g_miScaling.scale( _luma );
 
+  // the buffer may be written through, assume it is
+  xMarkDirty( m_dirtyMotion, miArea.pos() - selfArea.pos(), miArea.size() );
+
   return MotionBuf( m_motionBuf + rsAddr( miArea.pos(), selfArea.pos(), selfArea.width ), selfArea.width, miArea.size() );
 }
 
@@ -1202,6 +1406,8 @@ MotionInfo& CodingStructure::getMotionInfo( const Position& pos )
   const unsigned stride = g_miScaling.scaleHor( area.lumaSize().width );
   const Position miPos  = g_miScaling.scale( pos - area.lumaPos() );
 
+  xMarkDirty( m_dirtyMotion, miPos, Size( 1, 1 ) );
+
   return *( m_motionBuf + miPos.y * stride + miPos.x );
 }
 
@@ -1217,6 +1423,30 @@ const MotionInfo& CodingStructure::getMotionInfo( const Position& pos ) const
   return *( m_motionBuf + miPos.y * stride + miPos.x );
 }
 
+const ColMotionField& CodingStructure::getColMotionField() const
+{
+  // the field is only read once the picture is completely coded, but then possibly by several CTU rows at once
+  if( !m_colMotionValid.load( std::memory_order_acquire ) )
+  {
+    std::unique_lock<std::mutex> lock( m_colMotionMutex );
+
+    if( !m_colMotionValid.load( std::memory_order_relaxed ) )
+    {
+      if( !m_colMotion.isInter )
+      {
+        // same granularity as the compressed motion positions in PU::getColocatedMVP
+        const int scale = 4 * std::max<int>( 1, 4 * AMVP_DECIMATION_FACTOR / 4 );
+        m_colMotion.create( area.lumaSize(), g_aucLog2[scale] );
+      }
+
+      m_colMotion.compress( getMotionBuf() );
+      m_colMotionValid.store( true, std::memory_order_release );
+    }
+  }
+
+  return m_colMotion;
+}
+
 
 // data accessors
        PelBuf     CodingStructure::getPredBuf(const CompArea &blk)           { return getBuf(blk,  PIC_PREDICTION); }
@@ -1277,6 +1507,13 @@ PelBuf CodingStructure::getBuf( const CompArea &blk, const PictureType &type )
   {
     cFinal.x &= ( pcv->maxCUWidthMask  >> getComponentScaleX( blk.compID, blk.chromaFormat ) );
     cFinal.y &= ( pcv->maxCUHeightMask >> getComponentScaleY( blk.compID, blk.chromaFormat ) );
+
+    // the picture only holds one CTU, substreams decoded in parallel bring their own buffers
+    const CSSubstreamCtx* substream = xGetSubstreamCtx();
+    if( substream && substream->predBuf )
+    {
+      buf = type == PIC_PREDICTION ? substream->predBuf : substream->resiBuf;
+    }
   }
 #endif
 
@@ -1311,6 +1548,13 @@ const CPelBuf CodingStructure::getBuf( const CompArea &blk, const PictureType &t
   {
     cFinal.x &= ( pcv->maxCUWidthMask  >> getComponentScaleX( blk.compID, blk.chromaFormat ) );
     cFinal.y &= ( pcv->maxCUHeightMask >> getComponentScaleY( blk.compID, blk.chromaFormat ) );
+
+    // the picture only holds one CTU, substreams decoded in parallel bring their own buffers
+    const CSSubstreamCtx* substream = xGetSubstreamCtx();
+    if( substream && substream->predBuf )
+    {
+      buf = type == PIC_PREDICTION ? substream->predBuf : substream->resiBuf;
+    }
   }
 #endif
 
@@ -1343,12 +1587,61 @@ const CPelUnitBuf CodingStructure::getBuf( const UnitArea &unit, const PictureTy
   }
 }
 
+// Within a slice and tile the CTU rows are coded one after another, but with parallel substream decoding the unit
+// indices are only ordered within a CTU row (a row below can be indexed before the end of the current row).
+template<typename TUnit>
+static bool isCodedBefore( const TUnit& unit, const TUnit& curUnit )
+{
+  if( unit.cs != curUnit.cs )
+  {
+    return true; // from the parent CS in the RD search
+  }
+
+  const unsigned log2CtuHeight = unit.cs->pcv->maxCUHeightLog2;
+  const int      ctuRow        = unit   .blocks[unit   .chType].lumaPos().y >> log2CtuHeight;
+  const int      curCtuRow     = curUnit.blocks[curUnit.chType].lumaPos().y >> log2CtuHeight;
+
+  return ctuRow < curCtuRow || ( ctuRow == curCtuRow && unit.idx <= curUnit.idx );
+}
+
+// While substreams are decoded (or CTU rows encoded) in parallel, the units of other tiles and of the CTU rows below
+// (WPP) can still be under construction. They are excluded by their position, before the unit maps are accessed.
+// The encoder gets there through the structures of the RD search, hence the picture level structure decides.
+bool CodingStructure::xIsDecodedInParallel( const Position &pos, const unsigned curTileIdx, const int curCtuRow, const ChannelType _chType ) const
+{
+  const CodingStructure* picCS = this;
+
+  while( picCS->parent )
+  {
+    picCS = picCS->parent;
+  }
+
+  if( !picCS->m_parallelInsertion || !picCS->area.blocks[_chType].contains( pos ) )
+  {
+    return false;
+  }
+
+  const Position lumaPos = recalcPosition( picCS->area.chromaFormat, _chType, CHANNEL_TYPE_LUMA, pos );
+
+  return picCS->picture->tileMap->getTileIdxMap( lumaPos ) != curTileIdx || int( lumaPos.y >> picCS->pcv->maxCUHeightLog2 ) > curCtuRow;
+}
+
+static int getCtuRow( const CodingUnit& cu )
+{
+  return cu.blocks[cu.chType].lumaPos().y >> cu.cs->pcv->maxCUHeightLog2;
+}
+
 const CodingUnit* CodingStructure::getCURestricted( const Position &pos, const CodingUnit& curCu, const ChannelType _chType ) const
 {
+  if( xIsDecodedInParallel( pos, curCu.tileIdx, getCtuRow( curCu ), _chType ) )
+  {
+    return nullptr;
+  }
+
   const CodingUnit* cu = getCU( pos, _chType );
   // exists       same slice and tile                  cu precedes curCu in encoding order
   //                                                  (thus, is either from parent CS in RD-search or its index is lower)
-  if( cu && CU::isSameSliceAndTile( *cu, curCu ) && ( cu->cs != curCu.cs || cu->idx <= curCu.idx ) )
+  if( cu && CU::isSameSliceAndTile( *cu, curCu ) && isCodedBefore( *cu, curCu ) )
   {
     return cu;
   }
@@ -1358,18 +1651,35 @@ const CodingUnit* CodingStructure::getCURestricted( const Position &pos, const C
   }
 }
 
+const CodingUnit* CodingStructure::getDecompCURestricted( const Position &pos, const CodingUnit& curCu, const ChannelType _chType ) const
+{
+  // the restriction goes first, the decompression state of other substreams may be changing
+  const CodingUnit* cu = getCURestricted( pos, curCu, _chType );
+  return ( cu && isDecomp( pos, _chType ) ) ? cu : nullptr;
+}
+
 const CodingUnit* CodingStructure::getCURestricted( const Position &pos, const unsigned curSliceIdx, const unsigned curTileIdx, const ChannelType _chType ) const
 {
+  if( xIsDecodedInParallel( pos, curTileIdx, std::numeric_limits<int>::max(), _chType ) )
+  {
+    return nullptr;
+  }
+
   const CodingUnit* cu = getCU( pos, _chType );
   return ( cu && cu->slice->getIndependentSliceIdx() == curSliceIdx && cu->tileIdx == curTileIdx ) ? cu : nullptr;
 }
 
 const PredictionUnit* CodingStructure::getPURestricted( const Position &pos, const PredictionUnit& curPu, const ChannelType _chType ) const
 {
+  if( xIsDecodedInParallel( pos, curPu.cu->tileIdx, getCtuRow( *curPu.cu ), _chType ) )
+  {
+    return nullptr;
+  }
+
   const PredictionUnit* pu = getPU( pos, _chType );
   // exists       same slice and tile                  pu precedes curPu in encoding order
   //                                                  (thus, is either from parent CS in RD-search or its index is lower)
-  if( pu && CU::isSameSliceAndTile( *pu->cu, *curPu.cu ) && ( pu->cs != curPu.cs || pu->idx <= curPu.idx ) )
+  if( pu && CU::isSameSliceAndTile( *pu->cu, *curPu.cu ) && isCodedBefore( *pu, curPu ) )
   {
     return pu;
   }
@@ -1381,10 +1691,15 @@ const PredictionUnit* CodingStructure::getPURestricted( const Position &pos, con
 
 const TransformUnit* CodingStructure::getTURestricted( const Position &pos, const TransformUnit& curTu, const ChannelType _chType ) const
 {
+  if( xIsDecodedInParallel( pos, curTu.cu->tileIdx, getCtuRow( *curTu.cu ), _chType ) )
+  {
+    return nullptr;
+  }
+
   const TransformUnit* tu = getTU( pos, _chType );
   // exists       same slice and tile                  tu precedes curTu in encoding order
   //                                                  (thus, is either from parent CS in RD-search or its index is lower)
-  if( tu && CU::isSameSliceAndTile( *tu->cu, *curTu.cu ) && ( tu->cs != curTu.cs || tu->idx <= curTu.idx ) )
+  if( tu && CU::isSameSliceAndTile( *tu->cu, *curTu.cu ) && isCodedBefore( *tu, curTu ) )
   {
     return tu;
   }
@@ -44,6 +44,8 @@
 #include "UnitPartitioner.h"
 #include "Slice.h"
 #include <vector>
+#include <mutex>
+#include <atomic>
 
 
 struct Picture;
@@ -66,7 +68,49 @@ enum IbcLumaCoverage
   IBC_LUMA_COVERAGE_NONE,
   NUM_IBC_LUMA_COVERAGE,
 };
-extern XUCache g_globalUnitCache;
+
+// ---------------------------------------------------------------------------
+// per-thread state of a substream (WPP row or tile) while several threads
+// add units to the same picture-level coding structure
+// ---------------------------------------------------------------------------
+
+struct CSSubstreamCtx
+{
+  LutMotionCand   motionLut;
+  CodingUnit     *firstCU = nullptr;
+  CodingUnit     *lastCU  = nullptr;
+  PredictionUnit *lastPU  = nullptr;
+  TransformUnit  *lastTU  = nullptr;
+  PelStorage     *predBuf = nullptr;   ///< CTU sized prediction and residual buffers, replacing the ones of the picture
+  PelStorage     *resiBuf = nullptr;
+};
+
+// ---------------------------------------------------------------------------
+// compressed motion field of a coded picture, as read by temporal MV prediction
+// one entry per TMVP grid block, every field in its own cache line aligned array
+// ---------------------------------------------------------------------------
+
+struct ColMotionField
+{
+  int       log2Scale = 0;                          ///< log2 of the block size covered by one entry
+  int       stride    = 0;
+  int       height    = 0;
+  bool     *isInter   = nullptr;                    ///< inter motion, IBC block vectors excluded
+  uint16_t *sliceIdx  = nullptr;
+  int8_t   *refIdx[NUM_REF_PIC_LIST_01] = { nullptr, nullptr };
+  Mv       *mv    [NUM_REF_PIC_LIST_01] = { nullptr, nullptr };
+
+  ~ColMotionField() { destroy(); }
+
+  void create ( const Size& lumaSize, const int _log2Scale );
+  void destroy();
+  void compress( const CMotionBuf& mb );
+
+  unsigned idx( const Position& pos ) const { return ( pos.y >> log2Scale ) * stride + ( pos.x >> log2Scale ); }
+
+private:
+  uint8_t  *m_mem     = nullptr;
+};
 
 // ---------------------------------------------------------------------------
 // coding structure
@@ -104,7 +148,7 @@ public:
 #endif
   const PreCalcValues* pcv;
 
-  CodingStructure(CUCache&, PUCache&, TUCache&);
+  CodingStructure();
   void create( const UnitArea &_unit, const bool isTopLayer );
   void create( const ChromaFormat &_chromaFormat, const Area& _area, const bool isTopLayer );
   void destroy();
@@ -143,6 +187,7 @@ public:
 
   const CodingUnit     *getCURestricted(const Position &pos, const unsigned curSliceIdx, const unsigned curTileIdx, const ChannelType _chType) const;
   const CodingUnit     *getCURestricted(const Position &pos, const CodingUnit& curCu,                               const ChannelType _chType) const;
+  const CodingUnit     *getDecompCURestricted(const Position &pos, const CodingUnit& curCu,                         const ChannelType _chType) const;
   const PredictionUnit *getPURestricted(const Position &pos, const PredictionUnit& curPu,                           const ChannelType _chType) const;
   const TransformUnit  *getTURestricted(const Position &pos, const TransformUnit& curTu,                            const ChannelType _chType) const;
 
@@ -193,12 +238,32 @@ public:
   std::vector<PredictionUnit*> pus;
   std::vector< TransformUnit*> tus;
 
-  LutMotionCand motionLut;
+        LutMotionCand& getMotionLut();
+  const LutMotionCand& getMotionLut() const;
 
   void addMiToLut(static_vector<MotionInfo, MAX_NUM_HMVP_CANDS>& lut, const MotionInfo &mi);
 
+  // ---------------------------------------------------------------------------
+  // parallel unit insertion (one thread per substream)
+  // ---------------------------------------------------------------------------
+
+  void startParallelInsertion ();
+  void finishParallelInsertion( const std::vector<CSSubstreamCtx>& substreams );
+  void bindSubstreamCtx       ( CSSubstreamCtx* substream );   ///< binds the substream state to the calling thread, nullptr unbinds
+  PelStorage* getSubstreamBuf ( const PictureType &type ) const; ///< CTU sized buffer of the bound substream replacing the picture one, if any
+
 private:
 
+  CSSubstreamCtx* xGetSubstreamCtx() const;
+  bool            xIsDecodedInParallel( const Position &pos, const unsigned curTileIdx, const int curCtuRow, const ChannelType _chType ) const;
+
+  LutMotionCand m_motionLut;
+
+  bool        m_parallelInsertion;
+  std::mutex  m_unitMutex;
+  CodingUnit *m_lastSerialCU;
+
+
   // needed for TU encoding
   bool m_isTuEnc;
 
@@ -207,13 +272,25 @@ private:
   unsigned *m_tuIdx   [MAX_NUM_CHANNEL_TYPE];
   bool     *m_isDecomp[MAX_NUM_CHANNEL_TYPE];
 
+  // bounding boxes of the index maps and the motion buffer written since they were last cleared, in map units
+  // relative to the structure, so clearing a mostly untouched structure during mode decision is cheap
+  // the picture level structure is written by several threads and is always cleared completely
+  bool      m_trackDirty;
+  Area      m_dirtyCuIdx   [MAX_NUM_CHANNEL_TYPE];
+  Area      m_dirtyPuIdx   [MAX_NUM_CHANNEL_TYPE];
+  Area      m_dirtyTuIdx   [MAX_NUM_CHANNEL_TYPE];
+  Area      m_dirtyIsDecomp[MAX_NUM_CHANNEL_TYPE];
+  Area      m_dirtyMotion;
+
+  void xMarkDirty( Area& dirty, const Position& pos, const Size& size );
+
   unsigned m_numCUs;
   unsigned m_numPUs;
   unsigned m_numTUs;
 
-  CUCache& m_cuCache;
-  PUCache& m_puCache;
-  TUCache& m_tuCache;
+  CUArena m_cuArena;
+  PUArena m_puArena;
+  TUArena m_tuArena;
 
   std::vector<SAOBlkParam> m_sao;
 
@@ -242,6 +319,14 @@ public:
   MotionInfo& getMotionInfo( const Position& pos );
   const MotionInfo& getMotionInfo( const Position& pos ) const;
 
+  const ColMotionField& getColMotionField() const;   ///< compressed motion of a completely coded picture, built on first use
+
+private:
+
+  mutable ColMotionField    m_colMotion;
+  mutable std::atomic<bool> m_colMotionValid;
+  mutable std::mutex        m_colMotionMutex;
+
 
 public:
   // ---------------------------------------------------------------------------
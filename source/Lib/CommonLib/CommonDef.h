@@ -620,6 +620,7 @@ typedef enum{
 #endif
 
 #ifdef TARGET_SIMD_X86
+X86_VEXT _get_x86_extensions();
 X86_VEXT read_x86_extension_flags(const std::string &extStrId = std::string());
 const char* read_x86_extension(const std::string &extStrId);
 #endif
@@ -686,8 +687,6 @@ static inline int floorLog2(uint32_t x)
 #endif
 
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
-#include <omp.h>
-
 #define PARL_PARAM(DEF) , DEF
 #define PARL_PARAM0(DEF) DEF
 #else
@@ -128,6 +128,7 @@ namespace DQIntern
     Rom() : m_scansInitialized(false) {}
     ~Rom() { xUninitScanArrays(); }
     void                init        ()                       { xInitScanArrays(); }
+    void                uninit      ()                       { xUninitScanArrays(); }
 #if JVET_N0103_CGSIZE_HARMONIZATION
     const NbInfoSbb*    getNbInfoSbb( int hd, int vd ) const { return m_scanId2NbInfoSbbArray[hd][vd]; }
     const NbInfoOut*    getNbInfoOut( int hd, int vd ) const { return m_scanId2NbInfoOutArray[hd][vd]; }
@@ -344,10 +345,12 @@ namespace DQIntern
         if( sId2NbSbb )
         {
           delete [] sId2NbSbb;
+          sId2NbSbb = nullptr;
         }
         if( sId2NbOut )
         {
           delete [] sId2NbOut;
+          sId2NbOut = nullptr;
         }
         for( int chId = 0; chId < MAX_NUM_CHANNEL_TYPE; chId++ )
         {
@@ -355,6 +358,7 @@ namespace DQIntern
           if( tuPars )
           {
             delete tuPars;
+            tuPars = nullptr;
           }
         }
       }
@@ -372,14 +376,17 @@ namespace DQIntern
           if( sId2NbSbb )
           {
             delete [] sId2NbSbb;
+            sId2NbSbb = nullptr;
           }
           if( sId2NbOut )
           {
             delete [] sId2NbOut;
+            sId2NbOut = nullptr;
           }
           if( tuPars )
           {
             delete tuPars;
+            tuPars = nullptr;
           }
         }
       }
@@ -1773,6 +1780,11 @@ DepQuant::~DepQuant()
   delete static_cast<DQIntern::DepQuant*>(p);
 }
 
+void DepQuant::destroyRom()
+{
+  DQIntern::g_Rom.uninit();
+}
+
 void DepQuant::quant( TransformUnit &tu, const ComponentID &compID, const CCoeffBuf &pSrc, TCoeff &uiAbsSum, const QpParam &cQP, const Ctx& ctx )
 {
 #if JVET_N0280_RESIDUAL_CODING_TS
@@ -56,6 +56,9 @@ public:
   virtual void quant  ( TransformUnit &tu, const ComponentID &compID, const CCoeffBuf &pSrc, TCoeff &uiAbsSum, const QpParam &cQP, const Ctx& ctx );
   virtual void dequant( const TransformUnit &tu, CoeffBuf &dstCoeff, const ComponentID &compID, const QpParam &cQP );
 
+  /// frees the scan tables of the encoder, they point into the scan orders of the global ROM (called by destroyROM)
+  static void destroyRom();
+
 private:
   void* p;
 };
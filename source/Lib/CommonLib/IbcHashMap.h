@@ -87,7 +87,7 @@ public:
 #endif
 
 #ifdef TARGET_SIMD_X86
-  void    initIbcHashMapX86();
+  void    initIbcHashMapX86( const X86_VEXT vext = read_x86_extension_flags() );
   template <X86_VEXT vext>
   void    _initIbcHashMapX86();
 #endif
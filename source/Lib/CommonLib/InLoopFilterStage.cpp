@@ -0,0 +1,387 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     InLoopFilterStage.cpp
+    \brief    CTU row based scheduling of the in-loop filters on a thread pool
+*/
+
+#include "InLoopFilterStage.h"
+
+#include "CodingStructure.h"
+#include "Picture.h"
+#include "UnitTools.h"
+#include "dtrace_codingstruct.h"
+#include "dtrace_buffer.h"
+
+//! \ingroup CommonLib
+//! \{
+
+InLoopFilterStage::InLoopFilterStage()
+  : m_sao            ( nullptr )
+  , m_alf            ( nullptr )
+  , m_threadPool     ( nullptr )
+  , m_loopFilters    ( nullptr )
+  , m_numLoopFilters ( 0 )
+  , m_numPictures    ( 0 )
+{
+}
+
+InLoopFilterStage::~InLoopFilterStage()
+{
+  destroy();
+}
+
+void InLoopFilterStage::init( SampleAdaptiveOffset* sao, AdaptiveLoopFilter* alf, ThreadPool* threadPool )
+{
+  destroy();
+
+  m_sao        = sao;
+  m_alf        = alf;
+  m_threadPool = threadPool;
+
+  // at most one job per pool thread runs at any time
+  m_numLoopFilters = threadPool->getNumThreads();
+  m_loopFilters    = new LoopFilter[m_numLoopFilters];
+  for( int i = 0; i < m_numLoopFilters; i++ )
+  {
+    m_loopFilters[i].create( MAX_CU_DEPTH - MIN_CU_LOG2 );
+    m_freeLoopFilters.push_back( i );
+  }
+
+  m_progress.reset();
+  m_numPictures = 0;
+}
+
+void InLoopFilterStage::destroy()
+{
+  // the jobs of all pictures are done when the stage is destroyed
+  m_pictures.clear();
+
+  if( m_loopFilters )
+  {
+    for( int i = 0; i < m_numLoopFilters; i++ )
+    {
+      m_loopFilters[i].destroy();
+    }
+    delete[] m_loopFilters;
+    m_loopFilters = nullptr;
+  }
+  m_numLoopFilters = 0;
+  m_freeLoopFilters.clear();
+}
+
+void InLoopFilterStage::deblockPicture( CodingStructure& cs )
+{
+  JobCounter   jobs;
+  PictureJobs& pic = xCreatePictureJobs( cs );
+
+  xAddDeblockingJobs( pic, jobs );
+  m_threadPool->wait( jobs );
+
+  DTRACE_UPDATE( g_trace_ctx, ( std::make_pair( "poc", cs.slice->getPOC() ) ) );
+  DTRACE_PIC_COMP(D_REC_CB_LUMA_LF,   cs, cs.getRecoBuf(), COMPONENT_Y);
+  DTRACE_PIC_COMP(D_REC_CB_CHROMA_LF, cs, cs.getRecoBuf(), COMPONENT_Cb);
+  DTRACE_PIC_COMP(D_REC_CB_CHROMA_LF, cs, cs.getRecoBuf(), COMPONENT_Cr);
+
+  DTRACE    ( g_trace_ctx, D_CRC, "LoopFilter" );
+  DTRACE_CRC( g_trace_ctx, D_CRC, cs, cs.getRecoBuf() );
+}
+
+void InLoopFilterStage::addFilterJobs( CodingStructure& cs, const bool applySAO, const bool applyALF, const Reshape* reshaper, JobCounter& jobs )
+{
+  PictureJobs& pic     = xCreatePictureJobs( cs );
+  const int    numRows = cs.pcv->heightInCtus;
+
+  pic.picIdx = m_numPictures++;
+  // the reshaper state changes with the following slices, the jobs get their own copy
+  if( reshaper )
+  {
+    pic.reshaper = *reshaper;
+  }
+#if !JVET_N0415_CTB_ALF
+  if( applyALF )
+  {
+    pic.alfParam = cs.aps->getAlfAPSParam();
+  }
+#endif
+
+  xAddDeblockingJobs( pic, jobs );
+
+  // motion field for the temporal motion vector prediction of later pictures
+  xAddJob( pic, -1, STEP_NONE, [this, &pic, numRows]()
+  {
+    xWaitForRows( pic, 0, numRows - 1, STEP_DEBLOCK_HOR );
+    CS::setRefinedMotionField( *pic.cs );
+    pic.cs->picture->setMotionFieldFinal();
+    pic.motionFieldState.set( 1 );
+  }, jobs );
+
+  // the rows are final when deblocked by the row below, the lines they share are at most filtered by SAO and ALF next
+  FilterStep deblocked = STEP_DEBLOCK_HOR;
+  FilterStep filtered  = STEP_DEBLOCK_HOR;
+
+  if( applySAO )
+  {
+    xAddJob( pic, -1, STEP_NONE, [this, &pic]()
+    {
+      const CodingStructure& cs  = *pic.cs;
+      const SPS&             sps = *cs.sps;
+      const PPS&             pps = *cs.pps;
+
+      m_progress.wait( pic.picIdx - 1 );
+      m_sao->create( sps.getPicWidthInLumaSamples(), sps.getPicHeightInLumaSamples(), sps.getChromaFormatIdc(), sps.getMaxCUWidth(), sps.getMaxCUHeight(), sps.getMaxCodingDepth(), pps.getPpsRangeExtension().getLog2SaoOffsetScale(CHANNEL_TYPE_LUMA), pps.getPpsRangeExtension().getLog2SaoOffsetScale(CHANNEL_TYPE_CHROMA) );
+      m_sao->setReshaper( &pic.reshaper );
+      pic.saoState.set( m_sao->initSAOProcess( *pic.cs, pic.cs->picture->getSAO() ) ? 1 : 0 );
+    }, jobs );
+
+    for( int ctuRow = 0; ctuRow < numRows; ctuRow++ )
+    {
+      xAddJob( pic, ctuRow, STEP_SAO_STORE, [this, &pic, ctuRow, deblocked]()
+      {
+        pic.saoState.wait( 0 );
+        xWaitForRows( pic, ctuRow, ctuRow + 1, deblocked );
+        if( pic.saoState.get() > 0 )
+        {
+          m_sao->storeCtuRow( *pic.cs, ctuRow );
+        }
+      }, jobs );
+    }
+    for( int ctuRow = 0; ctuRow < numRows; ctuRow++ )
+    {
+      xAddJob( pic, ctuRow, STEP_SAO, [this, &pic, ctuRow]()
+      {
+        xWaitForRows( pic, ctuRow - 1, ctuRow + 1, STEP_SAO_STORE );
+        if( pic.saoState.get() > 0 )
+        {
+          m_sao->SAOProcessCtuRow( *pic.cs, ctuRow );
+        }
+      }, jobs );
+    }
+    filtered = STEP_SAO;
+  }
+
+  if( applyALF )
+  {
+    xAddJob( pic, -1, STEP_NONE, [this, &pic]()
+    {
+      const SPS& sps = *pic.cs->sps;
+
+      m_progress.wait( pic.picIdx - 1 );
+      m_alf->create( sps.getPicWidthInLumaSamples(), sps.getPicHeightInLumaSamples(), sps.getChromaFormatIdc(), sps.getMaxCUWidth(), sps.getMaxCUHeight(), sps.getMaxCodingDepth(), sps.getBitDepths().recon );
+#if JVET_N0415_CTB_ALF
+      pic.alfState.set( m_alf->initALFProcess( *pic.cs ) ? 1 : 0 );
+#else
+      pic.alfState.set( m_alf->initALFProcess( *pic.cs, pic.alfParam ) ? 1 : 0 );
+#endif
+    }, jobs );
+
+    for( int ctuRow = 0; ctuRow < numRows; ctuRow++ )
+    {
+      xAddJob( pic, ctuRow, STEP_ALF_STORE, [this, &pic, ctuRow, deblocked, filtered]()
+      {
+        pic.alfState.wait( 0 );
+        xWaitForRows( pic, ctuRow, ctuRow + 1, deblocked );
+        xWaitForRows( pic, ctuRow, ctuRow, filtered );
+        if( pic.alfState.get() > 0 )
+        {
+          m_alf->storeCtuRow( *pic.cs, ctuRow );
+        }
+      }, jobs );
+    }
+    for( int ctuRow = 0; ctuRow < numRows; ctuRow++ )
+    {
+      xAddJob( pic, ctuRow, STEP_ALF, [this, &pic, ctuRow]()
+      {
+        xWaitForRows( pic, ctuRow - 1, ctuRow + 1, STEP_ALF_STORE );
+        if( pic.alfState.get() > 0 )
+        {
+          m_alf->ALFProcessCtuRow( *pic.cs, ctuRow );
+        }
+      }, jobs );
+    }
+    filtered = STEP_ALF;
+  }
+
+  // publish the final rows in order
+  for( int ctuRow = 0; ctuRow < numRows; ctuRow++ )
+  {
+    xAddJob( pic, ctuRow, STEP_FINISHED, [this, &pic, ctuRow, numRows, deblocked, filtered]()
+    {
+      xWaitForRows( pic, ctuRow, ctuRow + 1, deblocked );
+      xWaitForRows( pic, ctuRow, ctuRow, filtered );
+      xWaitForRows( pic, ctuRow - 1, ctuRow - 1, STEP_FINISHED );
+      if( ctuRow + 1 < numRows )
+      {
+        pic.cs->picture->finishReconLines( ( ctuRow + 1 ) * pic.cs->pcv->maxCUHeight );
+      }
+      else
+      {
+        pic.motionFieldState.wait( 1 );
+        pic.cs->picture->finishReconstruction();
+        m_progress.set( pic.picIdx );
+      }
+    }, jobs );
+  }
+}
+
+InLoopFilterStage::PictureJobs& InLoopFilterStage::xCreatePictureJobs( CodingStructure& cs )
+{
+  // release the state of pictures without running jobs
+  while( !m_pictures.empty() && m_pictures.front().numPending == 0 )
+  {
+    m_pictures.pop_front();
+  }
+
+  m_pictures.emplace_back();
+  PictureJobs& pic = m_pictures.back();
+
+  pic.cs         = &cs;
+  pic.picIdx     = -1;
+  pic.failed     = false;
+  pic.numPending = 0;
+  pic.saoState        .reset();
+  pic.alfState        .reset();
+  pic.motionFieldState.reset( 0 );
+  for( int ctuRow = 0; ctuRow < cs.pcv->heightInCtus; ctuRow++ )
+  {
+    pic.rowStep.emplace_back( STEP_NONE );
+  }
+
+  return pic;
+}
+
+void InLoopFilterStage::xAddDeblockingJobs( PictureJobs& pic, JobCounter& jobs )
+{
+  const int numRows = pic.cs->pcv->heightInCtus;
+
+  // the vertical edges of a row only touch the row itself, the horizontal edges also the last lines of the row above;
+  // the long luma filters read lines filtered by the edges above them, so the horizontal edges go row by row
+  for( int ctuRow = 0; ctuRow < numRows; ctuRow++ )
+  {
+    xAddJob( pic, ctuRow, STEP_DEBLOCK_VER, [this, &pic, ctuRow]()
+    {
+      const int loopFilterId = xAcquireLoopFilter();
+      m_loopFilters[loopFilterId].loopFilterCtuRow( *pic.cs, EDGE_VER, ctuRow );
+      xReleaseLoopFilter( loopFilterId );
+    }, jobs );
+  }
+  for( int ctuRow = 0; ctuRow < numRows; ctuRow++ )
+  {
+    xAddJob( pic, ctuRow, STEP_DEBLOCK_HOR, [this, &pic, ctuRow]()
+    {
+      xWaitForRows( pic, ctuRow - 1, ctuRow - 1, STEP_DEBLOCK_HOR );
+      xWaitForRows( pic, ctuRow,     ctuRow,     STEP_DEBLOCK_VER );
+      const int loopFilterId = xAcquireLoopFilter();
+      m_loopFilters[loopFilterId].loopFilterCtuRow( *pic.cs, EDGE_HOR, ctuRow );
+      xReleaseLoopFilter( loopFilterId );
+    }, jobs );
+  }
+}
+
+void InLoopFilterStage::xAddJob( PictureJobs& pic, const int ctuRow, const FilterStep step, std::function<void()> func, JobCounter& jobs )
+{
+  PictureJobs* picJobs = &pic;
+
+  pic.numPending++;
+  m_threadPool->addJob( [this, picJobs, ctuRow, step, func]()
+  {
+    if( !picJobs->failed )
+    {
+      try
+      {
+        func();
+      }
+      catch( ... )
+      {
+        // do not leave the later jobs and pictures blocked, the error is reported by the job counter
+        xAbort( *picJobs );
+        picJobs->numPending--;
+        throw;
+      }
+    }
+    if( ctuRow >= 0 )
+    {
+      picJobs->rowStep[ctuRow].set( step );
+      // an abort in the meantime must not be undone
+      if( picJobs->failed )
+      {
+        picJobs->rowStep[ctuRow].set( STEP_FINISHED );
+      }
+    }
+    // the picture state may be released from here on
+    picJobs->numPending--;
+  }, jobs );
+}
+
+void InLoopFilterStage::xWaitForRows( PictureJobs& pic, const int firstRow, const int lastRow, const FilterStep step ) const
+{
+  const int numRows = int( pic.rowStep.size() );
+  for( int ctuRow = std::max( firstRow, 0 ); ctuRow <= std::min( lastRow, numRows - 1 ); ctuRow++ )
+  {
+    pic.rowStep[ctuRow].wait( step );
+  }
+}
+
+void InLoopFilterStage::xAbort( PictureJobs& pic )
+{
+  pic.failed = true;
+  for( auto& rowStep : pic.rowStep )
+  {
+    rowStep.set( STEP_FINISHED );
+  }
+  pic.saoState        .set( 0 );
+  pic.alfState        .set( 0 );
+  pic.motionFieldState.set( 1 );
+  if( pic.picIdx >= 0 )
+  {
+    pic.cs->picture->finishReconstruction();
+    m_progress.set( pic.picIdx );
+  }
+}
+
+int InLoopFilterStage::xAcquireLoopFilter()
+{
+  std::unique_lock<std::mutex> lock( m_loopFilterMutex );
+  CHECK( m_freeLoopFilters.empty(), "No free deblocking filter" );
+  const int loopFilterId = m_freeLoopFilters.back();
+  m_freeLoopFilters.pop_back();
+  return loopFilterId;
+}
+
+void InLoopFilterStage::xReleaseLoopFilter( const int loopFilterId )
+{
+  std::unique_lock<std::mutex> lock( m_loopFilterMutex );
+  m_freeLoopFilters.push_back( loopFilterId );
+}
+
+//! \}
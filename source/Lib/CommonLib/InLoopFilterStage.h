@@ -0,0 +1,132 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     InLoopFilterStage.h
+    \brief    CTU row based scheduling of the in-loop filters on a thread pool (header)
+*/
+
+#ifndef __INLOOPFILTERSTAGE__
+#define __INLOOPFILTERSTAGE__
+
+#include "CommonDef.h"
+#include "LoopFilter.h"
+#include "SampleAdaptiveOffset.h"
+#include "AdaptiveLoopFilter.h"
+#include "Reshape.h"
+#include "ThreadPool.h"
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+//! \ingroup CommonLib
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// runs deblocking, SAO and ALF of a picture as CTU row jobs on a thread pool
+/// Every filter step of a row only waits for the steps of the neighbouring rows it reads, so the rows and the filters
+/// overlap. SAO and ALF of a picture start after the previous picture is filtered completely, the filter objects are
+/// shared; the deblocking of a picture can overlap with the filters of the previous one.
+class InLoopFilterStage
+{
+public:
+  InLoopFilterStage();
+  ~InLoopFilterStage();
+
+  void init          ( SampleAdaptiveOffset* sao, AdaptiveLoopFilter* alf, ThreadPool* threadPool );
+  void destroy       ();
+
+  /// deblocks a picture, the CTU rows are filtered in parallel
+  void deblockPicture( CodingStructure& cs );
+  /// adds the jobs filtering a picture, the final lines are published to the picture row by row
+  void addFilterJobs ( CodingStructure& cs, const bool applySAO, const bool applyALF, const Reshape* reshaper, JobCounter& jobs );
+
+private:
+  enum FilterStep
+  {
+    STEP_NONE = 0,
+    STEP_DEBLOCK_VER,
+    STEP_DEBLOCK_HOR,
+    STEP_SAO_STORE,
+    STEP_SAO,
+    STEP_ALF_STORE,
+    STEP_ALF,
+    STEP_FINISHED
+  };
+
+  // state of the jobs of one picture
+  struct PictureJobs
+  {
+    CodingStructure*      cs;
+    int64_t               picIdx;
+    Reshape               reshaper;
+#if !JVET_N0415_CTB_ALF
+    AlfSliceParam         alfParam;
+#endif
+    std::deque<SyncValue> rowStep;                        ///< last finished filter step of each CTU row
+    SyncValue             saoState;                       ///< 1: SAO is initialised for the picture, 0: SAO is off
+    SyncValue             alfState;
+    SyncValue             motionFieldState;
+    std::atomic<bool>     failed;
+    std::atomic<int>      numPending;                     ///< jobs which did not return yet
+  };
+
+  PictureJobs& xCreatePictureJobs ( CodingStructure& cs );
+  void         xAddDeblockingJobs ( PictureJobs& pic, JobCounter& jobs );
+  void         xAddJob            ( PictureJobs& pic, const int ctuRow, const FilterStep step, std::function<void()> func, JobCounter& jobs );
+  void         xWaitForRows       ( PictureJobs& pic, const int firstRow, const int lastRow, const FilterStep step ) const;
+  void         xAbort             ( PictureJobs& pic );
+  int          xAcquireLoopFilter ();
+  void         xReleaseLoopFilter ( const int loopFilterId );
+
+  SampleAdaptiveOffset*   m_sao;
+  AdaptiveLoopFilter*     m_alf;
+  ThreadPool*             m_threadPool;
+
+  LoopFilter*             m_loopFilters;                  ///< one deblocking filter per thread, they keep state per CTU
+  int                     m_numLoopFilters;
+  std::vector<int>        m_freeLoopFilters;
+  std::mutex              m_loopFilterMutex;
+
+  std::deque<PictureJobs> m_pictures;                     ///< pictures with added jobs, in decoding order
+  SyncValue               m_progress;                     ///< index of the last completely filtered picture
+  int64_t                 m_numPictures;
+};
+
+//! \}
+
+#endif // __INLOOPFILTERSTAGE__
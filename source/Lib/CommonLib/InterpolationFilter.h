@@ -87,7 +87,7 @@ public:
 
   void initInterpolationFilter( bool enable );
 #ifdef TARGET_SIMD_X86
-  void initInterpolationFilterX86();
+  void initInterpolationFilterX86( const X86_VEXT vext = read_x86_extension_flags() );
   template <X86_VEXT vext>
   void _initInterpolationFilterX86();
 #endif
@@ -114,6 +114,167 @@ const TFilterCoeff g_intraGaussFilter[32][4] = {
   { 3, 17, 29, 15 }
 };
 
+// ====================================================================================================================
+// Prediction kernels
+// ====================================================================================================================
+
+/** Function for deriving planar intra prediction. This function derives the prediction samples for planar mode (intra coding).
+ */
+
+//NOTE: Bit-Limit - 24-bit source
+static void predIntraPlanar( const CPelBuf &pSrc, PelBuf &pDst )
+{
+  const uint32_t width  = pDst.width;
+  const uint32_t height = pDst.height;
+  const uint32_t log2W  = g_aucLog2[width  < 2 ? 2 : width];
+  const uint32_t log2H  = g_aucLog2[height < 2 ? 2 : height];
+
+  int leftColumn[MAX_CU_SIZE + 1], topRow[MAX_CU_SIZE + 1], bottomRow[MAX_CU_SIZE], rightColumn[MAX_CU_SIZE];
+  const uint32_t offset = 1 << (log2W + log2H);
+
+  // Get left and above reference column and row
+  for( int k = 0; k < width + 1; k++ )
+  {
+    topRow[k] = pSrc.at( k + 1, 0 );
+  }
+
+  for( int k = 0; k < height + 1; k++ )
+  {
+    leftColumn[k] = pSrc.at( 0, k + 1 );
+  }
+
+  // Prepare intermediate variables used in interpolation
+  int bottomLeft = leftColumn[height];
+  int topRight = topRow[width];
+
+  for( int k = 0; k < width; k++ )
+  {
+    bottomRow[k] = bottomLeft - topRow[k];
+    topRow[k]    = topRow[k] << log2H;
+  }
+
+  for( int k = 0; k < height; k++ )
+  {
+    rightColumn[k] = topRight - leftColumn[k];
+    leftColumn[k]  = leftColumn[k] << log2W;
+  }
+
+  const uint32_t finalShift = 1 + log2W + log2H;
+  const uint32_t stride     = pDst.stride;
+  Pel*       pred       = pDst.buf;
+  for( int y = 0; y < height; y++, pred += stride )
+  {
+    int horPred = leftColumn[y];
+
+    for( int x = 0; x < width; x++ )
+    {
+      horPred += rightColumn[y];
+      topRow[x] += bottomRow[x];
+
+      int vertPred = topRow[x];
+      pred[x]      = ( ( horPred << log2H ) + ( vertPred << log2W ) + offset ) >> finalShift;
+    }
+  }
+}
+
+static void predIntraAngLuma( Pel* pDst, const Pel* refMain, const int width, const TFilterCoeff* f, const bool useCubicFilter, const ClpRng& clpRng )
+{
+  Pel p[4];
+
+  for( int x = 0; x < width; x++ )
+  {
+    p[0] = refMain[x];
+    p[1] = refMain[x + 1];
+    p[2] = refMain[x + 2];
+    p[3] = f[3] != 0 ? refMain[x + 3] : 0;
+
+    pDst[x] = static_cast<Pel>((static_cast<int>(f[0] * p[0]) + static_cast<int>(f[1] * p[1]) + static_cast<int>(f[2] * p[2]) + static_cast<int>(f[3] * p[3]) + 32) >> 6);
+
+    if( useCubicFilter ) // only cubic filter has negative coefficients and requires clipping
+    {
+      pDst[x] = ClipPel( pDst[x], clpRng );
+    }
+  }
+}
+
+static void predIntraAngChroma( Pel* pDst, const Pel* refMain, const int width, const int deltaFract )
+{
+  // Do linear filtering
+  const Pel *pRM = refMain;
+  int lastRefMainPel = *pRM++;
+  for( int x = 0; x < width; pRM++, x++ )
+  {
+    int thisRefMainPel = *pRM;
+    pDst[x + 0] = ( Pel ) ( ( ( 32 - deltaFract )*lastRefMainPel + deltaFract*thisRefMainPel + 16 ) >> 5 );
+    lastRefMainPel = thisRefMainPel;
+  }
+}
+
+static void intraPdpcFilter( const CPelBuf &srcBuf, PelBuf &dstBuf, const uint32_t uiDirMode, const int scale, const ClpRng& clpRng )
+{
+  const int iWidth  = dstBuf.width;
+  const int iHeight = dstBuf.height;
+
+  if (uiDirMode == PLANAR_IDX)
+  {
+    for (int y = 0; y < iHeight; y++)
+    {
+      int wT = 32 >> std::min(31, ((y << 1) >> scale));
+      const Pel left = srcBuf.at(0, y + 1);
+      for (int x = 0; x < iWidth; x++)
+      {
+        const Pel top = srcBuf.at(x + 1, 0);
+        int wL = 32 >> std::min(31, ((x << 1) >> scale));
+        dstBuf.at(x, y) = ClipPel((wL * left + wT * top + (64 - wL - wT) * dstBuf.at(x, y) + 32) >> 6, clpRng);
+      }
+    }
+  }
+  else if (uiDirMode == DC_IDX)
+  {
+    const Pel topLeft = srcBuf.at(0, 0);
+    for (int y = 0; y < iHeight; y++)
+    {
+      int wT = 32 >> std::min(31, ((y << 1) >> scale));
+      const Pel left = srcBuf.at(0, y + 1);
+      for (int x = 0; x < iWidth; x++)
+      {
+        const Pel top = srcBuf.at(x + 1, 0);
+        int wL = 32 >> std::min(31, ((x << 1) >> scale));
+        int wTL = (wL >> 4) + (wT >> 4);
+        dstBuf.at(x, y) = ClipPel((wL * left + wT * top - wTL * topLeft + (64 - wL - wT + wTL) * dstBuf.at(x, y) + 32) >> 6, clpRng);
+      }
+    }
+  }
+  else if (uiDirMode == HOR_IDX)
+  {
+    const Pel topLeft = srcBuf.at(0, 0);
+    for (int y = 0; y < iHeight; y++)
+    {
+      int wT = 32 >> std::min(31, ((y << 1) >> scale));
+      for (int x = 0; x < iWidth; x++)
+      {
+        const Pel top = srcBuf.at(x + 1, 0);
+        int wTL = wT;
+        dstBuf.at(x, y) = ClipPel((wT * top - wTL * topLeft + (64 - wT + wTL) * dstBuf.at(x, y) + 32) >> 6, clpRng);
+      }
+    }
+  }
+  else if (uiDirMode == VER_IDX)
+  {
+    const Pel topLeft = srcBuf.at(0, 0);
+    for (int y = 0; y < iHeight; y++)
+    {
+      const Pel left = srcBuf.at(0, y + 1);
+      for (int x = 0; x < iWidth; x++)
+      {
+        int wL = 32 >> std::min(31, ((x << 1) >> scale));
+        int wTL = wL;
+        dstBuf.at(x, y) = ClipPel((wL * left - wTL * topLeft + (64 - wL + wTL) * dstBuf.at(x, y) + 32) >> 6, clpRng);
+      }
+    }
+  }
+}
+
 // ====================================================================================================================
 // Constructor / destructor / initialize
 // ====================================================================================================================
@@ -139,6 +300,17 @@ IntraPrediction::IntraPrediction()
 
   m_piTemp = nullptr;
   m_pMdlmTemp = nullptr;
+
+  m_predIntraPlanar    = predIntraPlanar;
+  m_predIntraAngLuma   = predIntraAngLuma;
+  m_predIntraAngChroma = predIntraAngChroma;
+  m_intraPdpcFilter    = intraPdpcFilter;
+
+#if ENABLE_SIMD_OPT_INTRAPRED
+#ifdef TARGET_SIMD_X86
+  initIntraPredictionX86();
+#endif
+#endif
 }
 
 IntraPrediction::~IntraPrediction()
@@ -315,7 +487,7 @@ void IntraPrediction::predIntraAng( const ComponentID compId, PelBuf &piPred, co
 
   switch (uiDirMode)
   {
-    case(PLANAR_IDX): xPredIntraPlanar(srcBuf, piPred); break;
+    case(PLANAR_IDX): m_predIntraPlanar(srcBuf, piPred); break;
     case(DC_IDX):     xPredIntraDc(srcBuf, piPred, channelType, false); break;
 #if JVET_N0413_RDPCM
     case(BDPCM_IDX):  xPredIntraBDPCM(srcBuf, piPred, pu.cu->bdpcmMode, clpRng); break;
@@ -325,67 +497,12 @@ void IntraPrediction::predIntraAng( const ComponentID compId, PelBuf &piPred, co
 
   if (m_ipaParam.applyPDPC)
   {
-    PelBuf dstBuf = piPred;
     const int scale = ((g_aucLog2[iWidth] - 2 + g_aucLog2[iHeight] - 2 + 2) >> 2);
     CHECK(scale < 0 || scale > 31, "PDPC: scale < 0 || scale > 31");
 
-    if (uiDirMode == PLANAR_IDX)
-    {
-      for (int y = 0; y < iHeight; y++)
-      {
-        int wT = 32 >> std::min(31, ((y << 1) >> scale));
-        const Pel left = srcBuf.at(0, y + 1);
-        for (int x = 0; x < iWidth; x++)
-        {
-          const Pel top = srcBuf.at(x + 1, 0);
-          int wL = 32 >> std::min(31, ((x << 1) >> scale));
-          dstBuf.at(x, y) = ClipPel((wL * left + wT * top + (64 - wL - wT) * dstBuf.at(x, y) + 32) >> 6, clpRng);
-        }
-      }
-    }
-    else if (uiDirMode == DC_IDX)
-    {
-      const Pel topLeft = srcBuf.at(0, 0);
-      for (int y = 0; y < iHeight; y++)
-      {
-        int wT = 32 >> std::min(31, ((y << 1) >> scale));
-        const Pel left = srcBuf.at(0, y + 1);
-        for (int x = 0; x < iWidth; x++)
-        {
-          const Pel top = srcBuf.at(x + 1, 0);
-          int wL = 32 >> std::min(31, ((x << 1) >> scale));
-          int wTL = (wL >> 4) + (wT >> 4);
-          dstBuf.at(x, y) = ClipPel((wL * left + wT * top - wTL * topLeft + (64 - wL - wT + wTL) * dstBuf.at(x, y) + 32) >> 6, clpRng);
-        }
-      }
-    }
-    else if (uiDirMode == HOR_IDX)
-    {
-      const Pel topLeft = srcBuf.at(0, 0);
-      for (int y = 0; y < iHeight; y++)
-      {
-        int wT = 32 >> std::min(31, ((y << 1) >> scale));
-        for (int x = 0; x < iWidth; x++)
-        {
-          const Pel top = srcBuf.at(x + 1, 0);
-          int wTL = wT;
-          dstBuf.at(x, y) = ClipPel((wT * top - wTL * topLeft + (64 - wT + wTL) * dstBuf.at(x, y) + 32) >> 6, clpRng);
-        }
-      }
-    }
-    else if (uiDirMode == VER_IDX)
+    if (uiDirMode == PLANAR_IDX || uiDirMode == DC_IDX || uiDirMode == HOR_IDX || uiDirMode == VER_IDX)
     {
-      const Pel topLeft = srcBuf.at(0, 0);
-      for (int y = 0; y < iHeight; y++)
-      {
-        const Pel left = srcBuf.at(0, y + 1);
-        for (int x = 0; x < iWidth; x++)
-        {
-          int wL = 32 >> std::min(31, ((x << 1) >> scale));
-          int wTL = wL;
-          dstBuf.at(x, y) = ClipPel((wL * left - wTL * topLeft + (64 - wL + wTL) * dstBuf.at(x, y) + 32) >> 6, clpRng);
-        }
-      }
+      m_intraPdpcFilter(srcBuf, piPred, uiDirMode, scale, clpRng);
     }
   }
 }
@@ -425,68 +542,6 @@ void IntraPrediction::xFilterGroup(Pel* pMulDst[], int i, Pel const * const piSr
 
 
 
-/** Function for deriving planar intra prediction. This function derives the prediction samples for planar mode (intra coding).
- */
-
-//NOTE: Bit-Limit - 24-bit source
-void IntraPrediction::xPredIntraPlanar( const CPelBuf &pSrc, PelBuf &pDst )
-{
-  const uint32_t width  = pDst.width;
-  const uint32_t height = pDst.height;
-  const uint32_t log2W  = g_aucLog2[width  < 2 ? 2 : width];
-  const uint32_t log2H  = g_aucLog2[height < 2 ? 2 : height];
-
-  int leftColumn[MAX_CU_SIZE + 1], topRow[MAX_CU_SIZE + 1], bottomRow[MAX_CU_SIZE], rightColumn[MAX_CU_SIZE];
-  const uint32_t offset = 1 << (log2W + log2H);
-
-  // Get left and above reference column and row
-  for( int k = 0; k < width + 1; k++ )
-  {
-    topRow[k] = pSrc.at( k + 1, 0 );
-  }
-
-  for( int k = 0; k < height + 1; k++ )
-  {
-    leftColumn[k] = pSrc.at( 0, k + 1 );
-  }
-
-  // Prepare intermediate variables used in interpolation
-  int bottomLeft = leftColumn[height];
-  int topRight = topRow[width];
-
-  for( int k = 0; k < width; k++ )
-  {
-    bottomRow[k] = bottomLeft - topRow[k];
-    topRow[k]    = topRow[k] << log2H;
-  }
-
-  for( int k = 0; k < height; k++ )
-  {
-    rightColumn[k] = topRight - leftColumn[k];
-    leftColumn[k]  = leftColumn[k] << log2W;
-  }
-
-  const uint32_t finalShift = 1 + log2W + log2H;
-  const uint32_t stride     = pDst.stride;
-  Pel*       pred       = pDst.buf;
-  for( int y = 0; y < height; y++, pred += stride )
-  {
-    int horPred = leftColumn[y];
-
-    for( int x = 0; x < width; x++ )
-    {
-      horPred += rightColumn[y];
-      topRow[x] += bottomRow[x];
-
-      int vertPred = topRow[x];
-      pred[x]      = ( ( horPred << log2H ) + ( vertPred << log2W ) + offset ) >> finalShift;
-    }
-  }
-}
-
-
-
-
 void IntraPrediction::xPredIntraDc( const CPelBuf &pSrc, PelBuf &pDst, const ChannelType channelType, const bool enableBoundaryFilter )
 {
   const Pel dcval = xGetPredValDc( pSrc, pDst );
@@ -752,38 +807,14 @@ void IntraPrediction::xPredIntraAng( const CPelBuf &pSrc, PelBuf &pDst, const Ch
       {
         if( isLuma(channelType) )
         {
-          Pel                        p[4];
           const bool                 useCubicFilter = !m_ipaParam.interpolationFlag;
           TFilterCoeff const * const f              = (useCubicFilter) ? InterpolationFilter::getChromaFilterTable(deltaFract) : g_intraGaussFilter[deltaFract];
 
-          int         refMainIndex   = deltaInt + 1;
-
-          for( int x = 0; x < width; x++, refMainIndex++ )
-          {
-            p[0] = refMain[refMainIndex - 1];
-            p[1] = refMain[refMainIndex];
-            p[2] = refMain[refMainIndex + 1];
-            p[3] = f[3] != 0 ? refMain[refMainIndex + 2] : 0;
-
-            pDstBuf[y*dstStride + x] = static_cast<Pel>((static_cast<int>(f[0] * p[0]) + static_cast<int>(f[1] * p[1]) + static_cast<int>(f[2] * p[2]) + static_cast<int>(f[3] * p[3]) + 32) >> 6);
-
-            if( useCubicFilter ) // only cubic filter has negative coefficients and requires clipping
-            {
-              pDstBuf[y*dstStride + x] = ClipPel( pDstBuf[y*dstStride + x], clpRng );
-            }
-          }
+          m_predIntraAngLuma( pDsty, refMain + deltaInt, width, f, useCubicFilter, clpRng );
         }
         else
         {
-          // Do linear filtering
-          const Pel *pRM = refMain + deltaInt + 1;
-          int lastRefMainPel = *pRM++;
-          for( int x = 0; x < width; pRM++, x++ )
-          {
-            int thisRefMainPel = *pRM;
-            pDsty[x + 0] = ( Pel ) ( ( ( 32 - deltaFract )*lastRefMainPel + deltaFract*thisRefMainPel + 16 ) >> 5 );
-            lastRefMainPel = thisRefMainPel;
-          }
+          m_predIntraAngChroma( pDsty, refMain + deltaInt + 1, width, deltaFract );
         }
       }
       else
@@ -1433,7 +1464,7 @@ bool isAboveLeftAvailable(const CodingUnit &cu, const ChannelType &chType, const
 {
   const CodingStructure& cs = *cu.cs;
   const Position refPos = posLT.offset(-1, -1);
-  const CodingUnit* pcCUAboveLeft = cs.isDecomp( refPos, chType ) ? cs.getCURestricted( refPos, cu, chType ) : nullptr;
+  const CodingUnit* pcCUAboveLeft = cs.getDecompCURestricted(refPos, cu, chType);
   const bool isConstrained = cs.pps->getConstrainedIntraPred();
   bool bAboveLeftFlag;
 
@@ -1461,7 +1492,7 @@ int isAboveAvailable(const CodingUnit &cu, const ChannelType &chType, const Posi
   {
     const Position refPos = posLT.offset(dx, -1);
 
-    const CodingUnit* pcCUAbove = cs.isDecomp(refPos, chType) ? cs.getCURestricted(refPos, cu, chType) : nullptr;
+    const CodingUnit* pcCUAbove = cs.getDecompCURestricted(refPos, cu, chType);
 
     if( pcCUAbove && ( ( isConstrained && CU::isIntra( *pcCUAbove ) ) || !isConstrained ) )
     {
@@ -1490,7 +1521,7 @@ int isLeftAvailable(const CodingUnit &cu, const ChannelType &chType, const Posit
   {
     const Position refPos = posLT.offset(-1, dy);
 
-    const CodingUnit* pcCULeft = cs.isDecomp(refPos, chType) ? cs.getCURestricted(refPos, cu, chType) : nullptr;
+    const CodingUnit* pcCULeft = cs.getDecompCURestricted(refPos, cu, chType);
 
     if( pcCULeft && ( ( isConstrained && CU::isIntra( *pcCULeft ) ) || !isConstrained ) )
     {
@@ -1521,7 +1552,7 @@ int isAboveRightAvailable(const CodingUnit &cu, const ChannelType &chType, const
   {
     const Position refPos = posRT.offset(unitWidth + dx, -1);
 
-    const CodingUnit* pcCUAbove = cs.isDecomp(refPos, chType) ? cs.getCURestricted(refPos, cu, chType) : nullptr;
+    const CodingUnit* pcCUAbove = cs.getDecompCURestricted(refPos, cu, chType);
 
     if( pcCUAbove && ( ( isConstrained && CU::isIntra( *pcCUAbove ) ) || !isConstrained ) )
     {
@@ -1551,7 +1582,7 @@ int isBelowLeftAvailable(const CodingUnit &cu, const ChannelType &chType, const
   {
     const Position refPos = posLB.offset(-1, unitHeight + dy);
 
-    const CodingUnit* pcCULeft = cs.isDecomp(refPos, chType) ? cs.getCURestricted(refPos, cu, chType) : nullptr;
+    const CodingUnit* pcCULeft = cs.getDecompCURestricted(refPos, cu, chType);
 
     if( pcCULeft && ( ( isConstrained && CU::isIntra( *pcCULeft ) ) || !isConstrained ) )
     {
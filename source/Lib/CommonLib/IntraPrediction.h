@@ -116,7 +116,6 @@ protected:
   int m_topRefLength;
   int m_leftRefLength;
   // prediction
-  void xPredIntraPlanar           ( const CPelBuf &pSrc, PelBuf &pDst );
   void xPredIntraDc               ( const CPelBuf &pSrc, PelBuf &pDst, const ChannelType channelType, const bool enableBoundaryFilter = true );
   void xPredIntraAng              ( const CPelBuf &pSrc, PelBuf &pDst, const ChannelType channelType, const ClpRng& clpRng);
 
@@ -153,6 +152,21 @@ public:
   IntraPrediction();
   virtual ~IntraPrediction();
 
+  /// planar prediction of the whole block
+  void (*m_predIntraPlanar)   ( const CPelBuf &pSrc, PelBuf &pDst );
+  /// one line of the angular luma prediction with the 4-tap filter f, refMain points to the sample left of the first tap
+  void (*m_predIntraAngLuma)  ( Pel* pDst, const Pel* refMain, const int width, const TFilterCoeff* f, const bool useCubicFilter, const ClpRng& clpRng );
+  /// one line of the angular chroma prediction with linear interpolation between refMain[x] and refMain[x + 1]
+  void (*m_predIntraAngChroma)( Pel* pDst, const Pel* refMain, const int width, const int deltaFract );
+  /// position dependent prediction combination for the planar, DC, horizontal and vertical modes
+  void (*m_intraPdpcFilter)   ( const CPelBuf &pSrc, PelBuf &pDst, const uint32_t dirMode, const int scale, const ClpRng& clpRng );
+
+#ifdef TARGET_SIMD_X86
+  void initIntraPredictionX86( const X86_VEXT vext = read_x86_extension_flags() );
+  template <X86_VEXT vext>
+  void _initIntraPredictionX86();
+#endif
+
   void init                       (ChromaFormat chromaFormatIDC, const unsigned bitDepthY);
 
   // Angular Intra
@@ -101,6 +101,15 @@ static bool isAvailableAbove( const CodingUnit& cu, const CodingUnit& cu2, const
 
 LoopFilter::LoopFilter()
 {
+  m_filterLumaBlk     = filterLumaBlk;
+  m_filterLumaLongBlk = filterLumaLongBlk;
+  m_filterChromaBlk   = filterChromaBlk;
+
+#if ENABLE_SIMD_OPT_DBF
+#ifdef TARGET_SIMD_X86
+  initLoopFilterX86();
+#endif
+#endif
 }
 
 LoopFilter::~LoopFilter()
@@ -148,10 +157,6 @@ void LoopFilter::loopFilterPic( CodingStructure& cs
                                 )
 {
   const PreCalcValues& pcv = *cs.pcv;
-#if JVET_N0473_DEBLOCK_INTERNAL_TRANSFORM_BOUNDARIES
-  m_shiftHor = ::getComponentScaleX( COMPONENT_Cb, cs.pcv->chrFormat );
-  m_shiftVer = ::getComponentScaleY( COMPONENT_Cb, cs.pcv->chrFormat );
-#endif
 
   DTRACE_UPDATE( g_trace_ctx, ( std::make_pair( "poc", cs.slice->getPOC() ) ) );
 #if ENABLE_TRACING
@@ -166,93 +171,82 @@ void LoopFilter::loopFilterPic( CodingStructure& cs
   }
 #endif
 
+  // Horizontal filtering
   for( int y = 0; y < pcv.heightInCtus; y++ )
   {
-    for( int x = 0; x < pcv.widthInCtus; x++ )
-    {
-      memset( m_aapucBS       [EDGE_VER].data(), 0,     m_aapucBS       [EDGE_VER].byte_size() );
-      memset( m_aapbEdgeFilter[EDGE_VER].data(), false, m_aapbEdgeFilter[EDGE_VER].byte_size() );
-#if JVET_N0473_DEBLOCK_INTERNAL_TRANSFORM_BOUNDARIES
-      memset( m_maxFilterLengthP, 0, sizeof(m_maxFilterLengthP) );
-      memset( m_maxFilterLengthQ, 0, sizeof(m_maxFilterLengthQ) );
-      memset( m_transformEdge, false, sizeof(m_transformEdge) );
-      m_ctuXLumaSamples = x << pcv.maxCUWidthLog2;
-      m_ctuYLumaSamples = y << pcv.maxCUHeightLog2;
-#endif
+    loopFilterCtuRow( cs, EDGE_VER, y );
+  }
 
-      const UnitArea ctuArea( pcv.chrFormat, Area( x << pcv.maxCUWidthLog2, y << pcv.maxCUHeightLog2, pcv.maxCUWidth, pcv.maxCUWidth ) );
+  // Vertical filtering
+  for( int y = 0; y < pcv.heightInCtus; y++ )
+  {
+    loopFilterCtuRow( cs, EDGE_HOR, y );
+  }
 
-      // CU-based deblocking
-      for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_L ), CH_L ) )
-      {
-        xDeblockCU( currCU, EDGE_VER );
-      }
+  DTRACE_PIC_COMP(D_REC_CB_LUMA_LF,   cs, cs.getRecoBuf(), COMPONENT_Y);
+  DTRACE_PIC_COMP(D_REC_CB_CHROMA_LF, cs, cs.getRecoBuf(), COMPONENT_Cb);
+  DTRACE_PIC_COMP(D_REC_CB_CHROMA_LF, cs, cs.getRecoBuf(), COMPONENT_Cr);
 
-      if( CS::isDualITree( cs ) )
-      {
-        memset( m_aapucBS       [EDGE_VER].data(), 0,     m_aapucBS       [EDGE_VER].byte_size() );
-        memset( m_aapbEdgeFilter[EDGE_VER].data(), false, m_aapbEdgeFilter[EDGE_VER].byte_size() );
+  DTRACE    ( g_trace_ctx, D_CRC, "LoopFilter" );
+  DTRACE_CRC( g_trace_ctx, D_CRC, cs, cs.getRecoBuf() );
+}
+
+/**
+ - filter the edges of one direction in a CTU row
+ .
+ The vertical edges of a row only modify samples of that row, the horizontal edges of a row also the last lines of the
+ row above. Different rows can be filtered concurrently by different LoopFilter objects as long as the horizontal edges
+ of a row are filtered after the vertical edges of the row itself and after the horizontal edges of the row above; the
+ long luma filters read lines which the edges of the row above modify.
+ \param  cs       coding structure of the picture
+ \param  edgeDir  direction of the edges to filter
+ \param  ctuRow   index of the CTU row
+ */
+void LoopFilter::loopFilterCtuRow( CodingStructure& cs, const DeblockEdgeDir edgeDir, const int ctuRow )
+{
+  const PreCalcValues& pcv = *cs.pcv;
 #if JVET_N0473_DEBLOCK_INTERNAL_TRANSFORM_BOUNDARIES
-        memset( m_maxFilterLengthP, 0, sizeof(m_maxFilterLengthP) );
-        memset( m_maxFilterLengthQ, 0, sizeof(m_maxFilterLengthQ) );
-        memset( m_transformEdge, false, sizeof(m_transformEdge) );
+  m_shiftHor = ::getComponentScaleX( COMPONENT_Cb, cs.pcv->chrFormat );
+  m_shiftVer = ::getComponentScaleY( COMPONENT_Cb, cs.pcv->chrFormat );
 #endif
 
-        for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_C ), CH_C ) )
-        {
-          xDeblockCU( currCU, EDGE_VER );
-        }
-      }
+  const int y = ctuRow;
+  for( int x = 0; x < pcv.widthInCtus; x++ )
+  {
+    memset( m_aapucBS       [edgeDir].data(), 0,     m_aapucBS       [edgeDir].byte_size() );
+    memset( m_aapbEdgeFilter[edgeDir].data(), false, m_aapbEdgeFilter[edgeDir].byte_size() );
+#if JVET_N0473_DEBLOCK_INTERNAL_TRANSFORM_BOUNDARIES
+    memset( m_maxFilterLengthP, 0, sizeof(m_maxFilterLengthP) );
+    memset( m_maxFilterLengthQ, 0, sizeof(m_maxFilterLengthQ) );
+    memset( m_transformEdge, false, sizeof(m_transformEdge) );
+    m_ctuXLumaSamples = x << pcv.maxCUWidthLog2;
+    m_ctuYLumaSamples = y << pcv.maxCUHeightLog2;
+#endif
+
+    const UnitArea ctuArea( pcv.chrFormat, Area( x << pcv.maxCUWidthLog2, y << pcv.maxCUHeightLog2, pcv.maxCUWidth, pcv.maxCUWidth ) );
+
+    // CU-based deblocking
+    for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_L ), CH_L ) )
+    {
+      xDeblockCU( currCU, edgeDir );
     }
-  }
 
-  // Vertical filtering
-  for( int y = 0; y < pcv.heightInCtus; y++ )
-  {
-    for( int x = 0; x < pcv.widthInCtus; x++ )
+    if( CS::isDualITree( cs ) )
     {
-      memset( m_aapucBS       [EDGE_HOR].data(), 0,     m_aapucBS       [EDGE_HOR].byte_size() );
-      memset( m_aapbEdgeFilter[EDGE_HOR].data(), false, m_aapbEdgeFilter[EDGE_HOR].byte_size() );
+      memset( m_aapucBS       [edgeDir].data(), 0,     m_aapucBS       [edgeDir].byte_size() );
+      memset( m_aapbEdgeFilter[edgeDir].data(), false, m_aapbEdgeFilter[edgeDir].byte_size() );
 #if JVET_N0473_DEBLOCK_INTERNAL_TRANSFORM_BOUNDARIES
       memset( m_maxFilterLengthP, 0, sizeof(m_maxFilterLengthP) );
       memset( m_maxFilterLengthQ, 0, sizeof(m_maxFilterLengthQ) );
       memset( m_transformEdge, false, sizeof(m_transformEdge) );
-      m_ctuXLumaSamples = x << pcv.maxCUWidthLog2;
-      m_ctuYLumaSamples = y << pcv.maxCUHeightLog2;
 #endif
 
-      const UnitArea ctuArea( pcv.chrFormat, Area( x << pcv.maxCUWidthLog2, y << pcv.maxCUHeightLog2, pcv.maxCUWidth, pcv.maxCUWidth ) );
-
-      // CU-based deblocking
-      for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_L ), CH_L ) )
+      for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_C ), CH_C ) )
       {
-        xDeblockCU( currCU, EDGE_HOR );
-      }
-
-      if( CS::isDualITree( cs ) )
-      {
-        memset( m_aapucBS       [EDGE_HOR].data(), 0,     m_aapucBS       [EDGE_HOR].byte_size() );
-        memset( m_aapbEdgeFilter[EDGE_HOR].data(), false, m_aapbEdgeFilter[EDGE_HOR].byte_size() );
-#if JVET_N0473_DEBLOCK_INTERNAL_TRANSFORM_BOUNDARIES
-        memset( m_maxFilterLengthP, 0, sizeof(m_maxFilterLengthP) );
-        memset( m_maxFilterLengthQ, 0, sizeof(m_maxFilterLengthQ) );
-        memset( m_transformEdge, false, sizeof(m_transformEdge) );
-#endif
-
-        for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_C ), CH_C ) )
-        {
-          xDeblockCU( currCU, EDGE_HOR );
-        }
+        xDeblockCU( currCU, edgeDir );
       }
     }
   }
-
-  DTRACE_PIC_COMP(D_REC_CB_LUMA_LF,   cs, cs.getRecoBuf(), COMPONENT_Y);
-  DTRACE_PIC_COMP(D_REC_CB_CHROMA_LF, cs, cs.getRecoBuf(), COMPONENT_Cb);
-  DTRACE_PIC_COMP(D_REC_CB_CHROMA_LF, cs, cs.getRecoBuf(), COMPONENT_Cr);
-
-  DTRACE    ( g_trace_ctx, D_CRC, "LoopFilter" );
-  DTRACE_CRC( g_trace_ctx, D_CRC, cs, cs.getRecoBuf() );
 }
 
 
@@ -1101,9 +1095,6 @@ void LoopFilter::xEdgeFilterLuma(const CodingUnit& cu, const DeblockEdgeDir edge
           int d0L = dp0L + dq0L;
           int d3L = dp3L + dq3L;
 
-          int dpL = dp0L + dp3L;
-          int dqL = dq0L + dq3L;
-
           int dL = d0L + d3L;
 
           bPartPNoFilter = bPartQNoFilter = false;
@@ -1122,9 +1113,6 @@ void LoopFilter::xEdgeFilterLuma(const CodingUnit& cu, const DeblockEdgeDir edge
 
           if (dL < iBeta)
           {
-            const bool filterP = (dpL < iSideThreshold);
-            const bool filterQ = (dqL < iSideThreshold);
-
             Pel* src0 = piTmpSrc + iSrcStep * (iIdx*pelsInPart + iBlkIdx * 4 + 0);
             Pel* src3 = piTmpSrc + iSrcStep * (iIdx*pelsInPart + iBlkIdx * 4 + 3);
 
@@ -1134,10 +1122,7 @@ void LoopFilter::xEdgeFilterLuma(const CodingUnit& cu, const DeblockEdgeDir edge
             if (swL)
             {
               useLongtapFilter = true;
-              for (int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++)
-              {
-                xPelFilterLuma(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + i), iOffset, iTc, swL, bPartPNoFilter, bPartQNoFilter, iThrCut, filterP, filterQ, clpRng, sidePisLarge, sideQisLarge, maxFilterLengthP, maxFilterLengthQ);
-              }
+              m_filterLumaLongBlk(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4), iOffset, iSrcStep, iTc, bPartPNoFilter, bPartQNoFilter, sidePisLarge ? maxFilterLengthP : 3, sideQisLarge ? maxFilterLengthQ : 3, clpRng);
             }
 
           }
@@ -1175,10 +1160,7 @@ void LoopFilter::xEdgeFilterLuma(const CodingUnit& cu, const DeblockEdgeDir edge
             sw = xUseStrongFiltering(piTmpSrc + iSrcStep * (iIdx*pelsInPart + iBlkIdx * 4 + 0), iOffset, 2 * d0, iBeta, iTc)
               && xUseStrongFiltering(piTmpSrc + iSrcStep * (iIdx*pelsInPart + iBlkIdx * 4 + 3), iOffset, 2 * d3, iBeta, iTc);
           }
-          for( int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++ )
-          {
-            xPelFilterLuma( piTmpSrc + iSrcStep*( iIdx*pelsInPart + iBlkIdx * 4 + i ), iOffset, iTc, sw, bPartPNoFilter, bPartQNoFilter, iThrCut, bFilterP, bFilterQ, clpRng );
-          }
+          m_filterLumaBlk( piTmpSrc + iSrcStep*( iIdx*pelsInPart + iBlkIdx * 4 ), iOffset, iSrcStep, iTc, sw, bPartPNoFilter, bPartQNoFilter, iThrCut, bFilterP, bFilterQ, clpRng );
         }
         }
       }
@@ -1375,18 +1357,12 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
             const bool sw = xUseStrongFiltering(piTmpSrcChroma + iSrcStep*(iIdx*uiLoopLength + 0), iOffset, 2 * d0, beta, iTc)
                 && xUseStrongFiltering(piTmpSrcChroma + iSrcStep*(iIdx*uiLoopLength + 1), iOffset, 2 * d1, beta, iTc);
 
-            for (unsigned step = 0; step < uiLoopLength; step++)
-            {
-              xPelFilterChroma(piTmpSrcChroma + iSrcStep*(step + iIdx*uiLoopLength), iOffset, iTc, sw, bPartPNoFilter, bPartQNoFilter, clpRng, largeBoundary);
-            }
+            m_filterChromaBlk(piTmpSrcChroma + iSrcStep*(iIdx*uiLoopLength), iOffset, iSrcStep, uiLoopLength, iTc, sw, bPartPNoFilter, bPartQNoFilter, clpRng, largeBoundary);
           }
         }
         if ( !useLongFilter )
         {
-          for (unsigned step = 0; step < uiLoopLength; step++)
-          {
-            xPelFilterChroma(piTmpSrcChroma + iSrcStep*(step + iIdx*uiLoopLength), iOffset, iTc, false, bPartPNoFilter, bPartQNoFilter, clpRng, largeBoundary);
-          }
+          m_filterChromaBlk(piTmpSrcChroma + iSrcStep*(iIdx*uiLoopLength), iOffset, iSrcStep, uiLoopLength, iTc, false, bPartPNoFilter, bPartQNoFilter, clpRng, largeBoundary);
         }
         }
       }
@@ -1410,7 +1386,7 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
  \param bFilterSecondQ  decision weak filter/no filter for partQ
  \param bitDepthLuma    luma bit depth
 */
-inline void LoopFilter::xBilinearFilter(Pel* srcP, Pel* srcQ, int offset, int refMiddle, int refP, int refQ, int numberPSide, int numberQSide, const int* dbCoeffsP, const int* dbCoeffsQ, int tc) const
+inline void LoopFilter::xBilinearFilter(Pel* srcP, Pel* srcQ, int offset, int refMiddle, int refP, int refQ, int numberPSide, int numberQSide, const int* dbCoeffsP, const int* dbCoeffsQ, int tc)
 {
     int src;
     const char tc7[7] = { 6, 5, 4, 3, 2, 1, 1};
@@ -1431,7 +1407,7 @@ inline void LoopFilter::xBilinearFilter(Pel* srcP, Pel* srcQ, int offset, int re
     }
 }
 
-inline void LoopFilter::xFilteringPandQ(Pel* src, int offset, int numberPSide, int numberQSide, int tc) const
+inline void LoopFilter::xFilteringPandQ(Pel* src, int offset, int numberPSide, int numberQSide, int tc)
 {
   CHECK(numberPSide <= 3 && numberQSide <= 3, "Short filtering in long filtering function");
   Pel* srcP = src-offset;
@@ -1505,7 +1481,7 @@ inline void LoopFilter::xFilteringPandQ(Pel* src, int offset, int numberPSide, i
   xBilinearFilter(srcP,srcQ,offset,refMiddle,refP,refQ,numberPSide,numberQSide,dbCoeffsP,dbCoeffsQ,tc);
 }
 
-inline void LoopFilter::xPelFilterLuma(Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng, bool sidePisLarge, bool sideQisLarge, int maxFilterLengthP, int maxFilterLengthQ) const
+inline void LoopFilter::xPelFilterLuma(Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng, bool sidePisLarge, bool sideQisLarge, int maxFilterLengthP, int maxFilterLengthQ)
 {
   int delta;
 
@@ -1605,7 +1581,7 @@ inline void LoopFilter::xPelFilterLuma(Pel* piSrc, const int iOffset, const int
  \param bPartQNoFilter  indicator to disable filtering on partQ
  \param bitDepthChroma  chroma bit depth
  */
-inline void LoopFilter::xPelFilterChroma( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng, const bool largeBoundary ) const
+inline void LoopFilter::xPelFilterChroma( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng, const bool largeBoundary )
 {
   int delta;
 
@@ -1655,6 +1631,30 @@ inline void LoopFilter::xPelFilterChroma( Pel* piSrc, const int iOffset, const i
   }
 }
 
+void LoopFilter::filterLumaBlk( Pel* src, const int offset, const int step, const int tc, const bool sw, const bool partPNoFilter, const bool partQNoFilter, const int thrCut, const bool filterSecondP, const bool filterSecondQ, const ClpRng& clpRng )
+{
+  for( int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++ )
+  {
+    xPelFilterLuma( src + step * i, offset, tc, sw, partPNoFilter, partQNoFilter, thrCut, filterSecondP, filterSecondQ, clpRng );
+  }
+}
+
+void LoopFilter::filterLumaLongBlk( Pel* src, const int offset, const int step, const int tc, const bool partPNoFilter, const bool partQNoFilter, const int numberPSide, const int numberQSide, const ClpRng& clpRng )
+{
+  for( int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++ )
+  {
+    xPelFilterLuma( src + step * i, offset, tc, true, partPNoFilter, partQNoFilter, 0, false, false, clpRng, numberPSide > 3, numberQSide > 3, numberPSide, numberQSide );
+  }
+}
+
+void LoopFilter::filterChromaBlk( Pel* src, const int offset, const int step, const int numLines, const int tc, const bool sw, const bool partPNoFilter, const bool partQNoFilter, const ClpRng& clpRng, const bool largeBoundary )
+{
+  for( int i = 0; i < numLines; i++ )
+  {
+    xPelFilterChroma( src + step * i, offset, tc, sw, partPNoFilter, partQNoFilter, clpRng, largeBoundary );
+  }
+}
+
 /**
  - Decision between strong and weak filter
  .
@@ -96,10 +96,15 @@ private:
   void xSetMaxFilterLengthPQForCodingSubBlocks( const DeblockEdgeDir edgeDir, const CodingUnit& cu, const PredictionUnit& currPU, const bool& mvSubBlocks, const int& subBlockSize, const Area& areaPu );
 #endif
 
-  inline void xBilinearFilter     ( Pel* srcP, Pel* srcQ, int offset, int refMiddle, int refP, int refQ, int numberPSide, int numberQSide, const int* dbCoeffsP, const int* dbCoeffsQ, int tc ) const;
-  inline void xFilteringPandQ     ( Pel* src, int offset, int numberPSide, int numberQSide, int tc ) const;
-  inline void xPelFilterLuma      ( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng, bool sidePisLarge = false, bool sideQisLarge = false, int maxFilterLengthP = 7, int maxFilterLengthQ = 7 ) const;
-  inline void xPelFilterChroma    ( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng, const bool largeBoundary ) const;
+  static inline void xBilinearFilter     ( Pel* srcP, Pel* srcQ, int offset, int refMiddle, int refP, int refQ, int numberPSide, int numberQSide, const int* dbCoeffsP, const int* dbCoeffsQ, int tc );
+  static inline void xFilteringPandQ     ( Pel* src, int offset, int numberPSide, int numberQSide, int tc );
+  static inline void xPelFilterLuma      ( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng, bool sidePisLarge = false, bool sideQisLarge = false, int maxFilterLengthP = 7, int maxFilterLengthQ = 7 );
+  static inline void xPelFilterChroma    ( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng, const bool largeBoundary );
+
+  // filtering of the lines of one edge segment, step is the distance between the lines
+  static void filterLumaBlk       ( Pel* src, const int offset, const int step, const int tc, const bool sw, const bool partPNoFilter, const bool partQNoFilter, const int thrCut, const bool filterSecondP, const bool filterSecondQ, const ClpRng& clpRng );
+  static void filterLumaLongBlk   ( Pel* src, const int offset, const int step, const int tc, const bool partPNoFilter, const bool partQNoFilter, const int numberPSide, const int numberQSide, const ClpRng& clpRng );
+  static void filterChromaBlk     ( Pel* src, const int offset, const int step, const int numLines, const int tc, const bool sw, const bool partPNoFilter, const bool partQNoFilter, const ClpRng& clpRng, const bool largeBoundary );
   inline bool xUseStrongFiltering ( Pel* piSrc, const int iOffset, const int d, const int beta, const int tc, bool sidePisLarge = false, bool sideQisLarge = false, int maxFilterLengthP = 7, int maxFilterLengthQ = 7 ) const;//move the computation outside the function
   inline unsigned BsSet(unsigned val, const ComponentID compIdx) const;
   inline unsigned BsGet(unsigned val, const ComponentID compIdx) const;
@@ -126,6 +131,21 @@ public:
   /// picture-level deblocking filter
   void loopFilterPic              ( CodingStructure& cs
                                     );
+  /// deblocking of the edges of one direction in a CTU row
+  void loopFilterCtuRow           ( CodingStructure& cs, const DeblockEdgeDir edgeDir, const int ctuRow );
+
+  /// weak or short strong luma filter of the DEBLOCK_SMALLEST_BLOCK / 2 lines of an edge segment
+  void (*m_filterLumaBlk)    ( Pel* src, const int offset, const int step, const int tc, const bool sw, const bool partPNoFilter, const bool partQNoFilter, const int thrCut, const bool filterSecondP, const bool filterSecondQ, const ClpRng& clpRng );
+  /// long luma filter of the DEBLOCK_SMALLEST_BLOCK / 2 lines of an edge segment, numberPSide/numberQSide samples are modified
+  void (*m_filterLumaLongBlk)( Pel* src, const int offset, const int step, const int tc, const bool partPNoFilter, const bool partQNoFilter, const int numberPSide, const int numberQSide, const ClpRng& clpRng );
+  /// chroma filter of the numLines lines of an edge segment
+  void (*m_filterChromaBlk)  ( Pel* src, const int offset, const int step, const int numLines, const int tc, const bool sw, const bool partPNoFilter, const bool partQNoFilter, const ClpRng& clpRng, const bool largeBoundary );
+
+#ifdef TARGET_SIMD_X86
+  void initLoopFilterX86( const X86_VEXT vext = read_x86_extension_flags() );
+  template <X86_VEXT vext>
+  void _initLoopFilterX86();
+#endif
 
   static int getBeta              ( const int qp )
   {
@@ -58,6 +58,15 @@ namespace Mip
     m_upsmpFactorHor( 0 ),
     m_upsmpFactorVer( 0 )
   {
+    m_doDownsampling             = doDownsampling;
+    m_predictionUpsampling1D     = predictionUpsampling1D;
+    m_computeMatrixTimesRedBndry = computeMatrixTimesRedBndry;
+
+#if ENABLE_SIMD_OPT_MIP
+#ifdef TARGET_SIMD_X86
+    initPredictorMipX86();
+#endif
+#endif
   }
 
 
@@ -265,7 +274,7 @@ namespace Mip
 
   void PredictorMIP::boundaryDownsampling1D( int* reducedDst, int* fullSrcAndIntermediateDst,
                                               const SizeType srcLen, const SizeType dstLen,
-                                              const bool saveIntermediate, const SizeType intermediateLen )
+                                              const bool saveIntermediate, const SizeType intermediateLen ) const
   {
     SizeType currLen = srcLen;
 
@@ -273,14 +282,14 @@ namespace Mip
     if( saveIntermediate && intermediateLen < srcLen )
     {
       CHECKD( intermediateLen < dstLen, "Intermediate length must not be less than target length." );
-      doDownsampling( fullSrcAndIntermediateDst, fullSrcAndIntermediateDst, currLen, intermediateLen );
+      m_doDownsampling( fullSrcAndIntermediateDst, fullSrcAndIntermediateDst, currLen, intermediateLen );
       currLen = intermediateLen;
     }
 
     if( dstLen < currLen )
     {
       // Create reduced boundary by downsampling.
-      doDownsampling( reducedDst, fullSrcAndIntermediateDst, currLen, dstLen );
+      m_doDownsampling( reducedDst, fullSrcAndIntermediateDst, currLen, dstLen );
     }
     else
     {
@@ -357,10 +366,10 @@ namespace Mip
         int* const     horDst       = dst + ( m_upsmpFactorVer - 1 ) * m_blockSize.width;
         const SizeType horDstStride = m_upsmpFactorVer * m_blockSize.width;
 
-        predictionUpsampling1D( horDst, src, m_boundaryForUpsamplingLeft.data(),
-                                m_reducedPredictionSize.width, m_reducedPredictionSize.height,
-                                horSrcStep, horSrcStride, 1, horDstStride,
-                                m_upsmpFactorHor );
+        m_predictionUpsampling1D( horDst, src, m_boundaryForUpsamplingLeft.data(),
+                                  m_reducedPredictionSize.width, m_reducedPredictionSize.height,
+                                  horSrcStep, horSrcStride, 1, horDstStride,
+                                  m_upsmpFactorHor );
 
         verSrc       = horDst;
         verSrcStep   = horDstStride;
@@ -372,10 +381,10 @@ namespace Mip
         verSrcStep   = transpose ? 1 : m_blockSize.width;
         verSrcStride = transpose ? m_reducedPredictionSize.height : 1;
       }
-      predictionUpsampling1D( dst, verSrc, m_boundaryForUpsamplingTop.data(),
-                              m_reducedPredictionSize.height, m_blockSize.width,
-                              verSrcStep, verSrcStride, m_blockSize.width, 1,
-                              m_upsmpFactorVer );
+      m_predictionUpsampling1D( dst, verSrc, m_boundaryForUpsamplingTop.data(),
+                                m_reducedPredictionSize.height, m_blockSize.width,
+                                verSrcStep, verSrcStride, m_blockSize.width, 1,
+                                m_upsmpFactorVer );
     }
     else
     {
@@ -391,10 +400,10 @@ namespace Mip
         const SizeType verDstStep   = m_blockSize.width;
         const SizeType verDstStride = m_upsmpFactorHor;
 
-        predictionUpsampling1D( verDst, src, m_boundaryForUpsamplingTop.data(),
-                                m_reducedPredictionSize.height, m_reducedPredictionSize.width,
-                                verSrcStep, verSrcStride, verDstStep, verDstStride,
-                                m_upsmpFactorVer );
+        m_predictionUpsampling1D( verDst, src, m_boundaryForUpsamplingTop.data(),
+                                  m_reducedPredictionSize.height, m_reducedPredictionSize.width,
+                                  verSrcStep, verSrcStride, verDstStep, verDstStride,
+                                  m_upsmpFactorVer );
 
         horSrc = verDst;
         horSrcStep = verDstStride;
@@ -406,10 +415,10 @@ namespace Mip
         horSrcStep   = transpose ? m_blockSize.height : 1;
         horSrcStride = transpose ? 1 : m_reducedPredictionSize.width;
       }
-      predictionUpsampling1D( dst, horSrc, m_boundaryForUpsamplingLeft.data(),
-                              m_reducedPredictionSize.width, m_blockSize.height,
-                              horSrcStep, horSrcStride, 1, m_blockSize.width,
-                              m_upsmpFactorHor );
+      m_predictionUpsampling1D( dst, horSrc, m_boundaryForUpsamplingLeft.data(),
+                                m_reducedPredictionSize.width, m_blockSize.height,
+                                horSrcStep, horSrcStride, 1, m_blockSize.width,
+                                m_upsmpFactorHor );
     }
   }
 
@@ -455,33 +464,18 @@ namespace Mip
     }
   }
 
-  void PredictorMIP::xComputeMatrixTimesRedBndryPlusBias( int*const result, const int* const input,
-                                                          const short*matrix, const short*bias,
-                                                          const bool leaveHorOut, const bool leaveVerOut, 
-                                                          const int shiftMatrix, const int shiftBias, 
-                                                          const bool transpose, const bool needUpsampling )
+  void PredictorMIP::computeMatrixTimesRedBndry( int* const result, const int* const input, const short* matrix, const short* bias,
+                                                 const int inputSize, const int outWidth, const int outHeight, const int xStep, const int yStep,
+                                                 const int shiftMatrix, const int shiftBias )
   {
-    const int inputSize = m_reducedBoundarySize.width + m_reducedBoundarySize.height;
-
-    // Use local buffer for transposed result if no upsampling will be done.
-    static_vector<int, MIP_MAX_REDUCED_OUTPUT_SAMPLES> resBufTransposed( m_reducedPredictionSize.area() );
-    int*const resPtr = (transpose && !needUpsampling) ? resBufTransposed.data() : result;
-
     const int offset = 1 << (shiftMatrix - 1);
-    CHECK(inputSize != 4 * (inputSize >> 2), "Error, input size not divisible by four");
-
     const short *weight = matrix;
 
-    const int intermediateWidth  = transpose ? m_reducedPredictionSize.height : m_reducedPredictionSize.width;
-    const int intermediateHeight = transpose ? m_reducedPredictionSize.width : m_reducedPredictionSize.height;
-    const int xStep = leaveHorOut ? 2 : 1;
-    const int yStep = leaveVerOut ? intermediateWidth : 0;
-    
     int posRes  = 0;
     int posBias = 0;
-    for (int y = 0; y < intermediateHeight; y++)
+    for (int y = 0; y < outHeight; y++)
     {
-      for (int x = 0; x < intermediateWidth; x++)
+      for (int x = 0; x < outWidth; x++)
       {
         int tmp0 = 0;
         int tmp1 = 0;
@@ -494,7 +488,7 @@ namespace Mip
           tmp2 += input[i + 2] * weight[i + 2];
           tmp3 += input[i + 3] * weight[i + 3];
         }
-        resPtr[posRes++] = ((tmp0 + tmp1 + tmp2 + tmp3) + (bias[posBias] << shiftBias) + offset) >> shiftMatrix;
+        result[posRes++] = ((tmp0 + tmp1 + tmp2 + tmp3) + (bias[posBias] << shiftBias) + offset) >> shiftMatrix;
 
         weight  += xStep * inputSize;
         posBias += xStep;
@@ -502,6 +496,28 @@ namespace Mip
       weight  += yStep * inputSize;
       posBias += yStep;
     }
+  }
+
+  void PredictorMIP::xComputeMatrixTimesRedBndryPlusBias( int*const result, const int* const input,
+                                                          const short*matrix, const short*bias,
+                                                          const bool leaveHorOut, const bool leaveVerOut, 
+                                                          const int shiftMatrix, const int shiftBias, 
+                                                          const bool transpose, const bool needUpsampling )
+  {
+    const int inputSize = m_reducedBoundarySize.width + m_reducedBoundarySize.height;
+
+    // Use local buffer for transposed result if no upsampling will be done.
+    static_vector<int, MIP_MAX_REDUCED_OUTPUT_SAMPLES> resBufTransposed( m_reducedPredictionSize.area() );
+    int*const resPtr = (transpose && !needUpsampling) ? resBufTransposed.data() : result;
+
+    CHECK(inputSize != 4 * (inputSize >> 2), "Error, input size not divisible by four");
+
+    const int intermediateWidth  = transpose ? m_reducedPredictionSize.height : m_reducedPredictionSize.width;
+    const int intermediateHeight = transpose ? m_reducedPredictionSize.width : m_reducedPredictionSize.height;
+    const int xStep = leaveHorOut ? 2 : 1;
+    const int yStep = leaveVerOut ? intermediateWidth : 0;
+
+    m_computeMatrixTimesRedBndry( resPtr, input, matrix, bias, inputSize, intermediateWidth, intermediateHeight, xStep, yStep, shiftMatrix, shiftBias );
 
     // Re-transpose if no upsampling will be done.
     if( transpose && !needUpsampling )
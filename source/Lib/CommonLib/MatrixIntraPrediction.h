@@ -55,6 +55,25 @@ namespace Mip
     void             deriveBoundaryData(const CPelBuf& src, const Area& block, const int bitDepth, const AvailableInfo &availInfo);
     void             getPrediction     (int* const result, const int modeIdx, const int bitDepth);
 
+    /// averages groups of srcLen / dstLen samples, dst may be equal to src
+    void (*m_doDownsampling)( int* dst, const int* src, const SizeType srcLen, const SizeType dstLen );
+    /// linear interpolation between the boundary and the reduced prediction along one dimension
+    void (*m_predictionUpsampling1D)( int* const dst, const int* const src, const int* const bndry,
+                                      const SizeType srcSizeUpsmpDim, const SizeType srcSizeOrthDim,
+                                      const SizeType srcStep, const SizeType srcStride,
+                                      const SizeType dstStep, const SizeType dstStride,
+                                      const unsigned int upsmpFactor );
+    /// reduced prediction of outWidth x outHeight samples, the weights of one sample are a matrix row of inputSize entries
+    void (*m_computeMatrixTimesRedBndry)( int* const result, const int* const input, const short* matrix, const short* bias,
+                                          const int inputSize, const int outWidth, const int outHeight, const int xStep, const int yStep,
+                                          const int shiftMatrix, const int shiftBias );
+
+#ifdef TARGET_SIMD_X86
+    void initPredictorMipX86( const X86_VEXT vext = read_x86_extension_flags() );
+    template <X86_VEXT vext>
+    void _initPredictorMipX86();
+#endif
+
   private:
     static_vector<int, MIP_MAX_INPUT_SIZE> m_reducedBoundary;           // downsampled             boundary of a block
     static_vector<int, MIP_MAX_INPUT_SIZE> m_reducedBoundaryTransposed; // downsampled, transposed boundary of a block
@@ -71,7 +90,7 @@ namespace Mip
 
     void initPredBlockParams(const Size& block);
 
-    static void boundaryDownsampling1D( int* reducedDst, int* fullSrcAndIntermediateDst, const SizeType srcLen, const SizeType dstLen, const bool saveIntermediate, const SizeType intermediateLen );
+    void boundaryDownsampling1D( int* reducedDst, int* fullSrcAndIntermediateDst, const SizeType srcLen, const SizeType dstLen, const bool saveIntermediate, const SizeType intermediateLen ) const;
     static void doDownsampling( int* dst, const int* src, const SizeType srcLen, const SizeType dstLen );
 
     void predictionUpsampling( int* const dst, const int* const src, const bool transpose ) const;
@@ -80,6 +99,9 @@ namespace Mip
                                         const SizeType srcStep, const SizeType srcStride,
                                         const SizeType dstStep, const SizeType dstStride,
                                         const unsigned int upsmpFactor );
+    static void computeMatrixTimesRedBndry( int* const result, const int* const input, const short* matrix, const short* bias,
+                                            const int inputSize, const int outWidth, const int outHeight, const int xStep, const int yStep,
+                                            const int shiftMatrix, const int shiftBias );
 
     void getMatrixBias( const short*& matrix, const short*& bias, const int modeIdx ) const;
     void getShifts( int &shiftMatrix, int &shiftBias, const int modeIdx, const int bitDepth ) const;
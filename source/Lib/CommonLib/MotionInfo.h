@@ -100,17 +100,18 @@ struct MvField
 
 struct MotionInfo
 {
+  // ordered by size to avoid padding, the motion buffers are copied in bulk
+  Mv      mv     [ NUM_REF_PIC_LIST_01 ];
+  Mv      bv;
+  uint16_t   sliceIdx;
+  int16_t   refIdx [ NUM_REF_PIC_LIST_01 ];
   bool     isInter;
   bool     isIBCmot;
   char     interDir;
-  uint16_t   sliceIdx;
-  Mv      mv     [ NUM_REF_PIC_LIST_01 ];
-  int16_t   refIdx [ NUM_REF_PIC_LIST_01 ];
   uint8_t         GBiIdx;
-  Mv      bv;
-  MotionInfo() : isInter(false), isIBCmot(false), interDir(0), sliceIdx(0), refIdx{ NOT_VALID, NOT_VALID }, GBiIdx(0) { }
+  MotionInfo() : sliceIdx(0), refIdx{ NOT_VALID, NOT_VALID }, isInter(false), isIBCmot(false), interDir(0), GBiIdx(0) { }
   // ensure that MotionInfo(0) produces '\x000....' bit pattern - needed to work with AreaBuf - don't use this constructor for anything else
-  MotionInfo(int i) : isInter(i != 0), isIBCmot(false), interDir(0), sliceIdx(0), refIdx{ 0,         0 }, GBiIdx(0) { CHECKD(i != 0, "The argument for this constructor has to be '0'"); }
+  MotionInfo(int i) : sliceIdx(0), refIdx{ 0,         0 }, isInter(i != 0), isIBCmot(false), interDir(0), GBiIdx(0) { CHECKD(i != 0, "The argument for this constructor has to be '0'"); }
 
   bool operator==( const MotionInfo& mi ) const
   {
@@ -35,92 +35,153 @@
 #include "SEI.h"
 #include "libmd5/MD5.h"
 
+#if defined( TARGET_SIMD_X86 ) && ( defined( __SSE2__ ) || defined( _M_X64 ) ) && !RExt__HIGH_BIT_DEPTH_SUPPORT
+#define PICHASH_SSE2 1
+#include <emmintrin.h>
+#else
+#define PICHASH_SSE2 0
+#endif
+
 //! \ingroup CommonLib
 //! \{
 
 /**
- * Update md5 using n samples from plane, each sample is adjusted to
- * OUTBIT_BITDEPTH_DIV8.
+ * Convert n samples from plane into unsigned chars in little endian byte
+ * order, using OUTPUT_BITDEPTH_DIV8 bytes per sample.
+ * NB, for 8bit data, data is truncated to 8bits.
  */
 template<uint32_t OUTPUT_BITDEPTH_DIV8>
-static void md5_block(MD5& md5, const Pel* plane, uint32_t n)
+static void md5_pack(uint8_t* buf, const Pel* plane, uint32_t n)
 {
-  /* create a 64 byte buffer for packing Pel's into */
-  uint8_t buf[64/OUTPUT_BITDEPTH_DIV8][OUTPUT_BITDEPTH_DIV8];
-  for (uint32_t i = 0; i < n; i++)
+  uint32_t i = 0;
+#if PICHASH_SSE2
+  if (OUTPUT_BITDEPTH_DIV8 == 1)
+  {
+    const __m128i vmask = _mm_set1_epi16(0xff);
+    for (; i + 16 <= n; i += 16)
+    {
+      const __m128i vlo = _mm_and_si128(_mm_loadu_si128((const __m128i*) &plane[i]),     vmask);
+      const __m128i vhi = _mm_and_si128(_mm_loadu_si128((const __m128i*) &plane[i + 8]), vmask);
+      _mm_storeu_si128((__m128i*) &buf[i], _mm_packus_epi16(vlo, vhi));
+    }
+  }
+  else
+  {
+    // 16 bit Pel on a little endian host
+    memcpy(buf, plane, n * sizeof(Pel));
+    i = n;
+  }
+#endif
+  for (; i < n; i++)
   {
     Pel pel = plane[i];
     /* perform bitdepth and endian conversion */
     for (uint32_t d = 0; d < OUTPUT_BITDEPTH_DIV8; d++)
     {
-      buf[i][d] = pel >> (d*8);
+      buf[i*OUTPUT_BITDEPTH_DIV8 + d] = pel >> (d*8);
     }
   }
-  md5.update((uint8_t*)buf, n * OUTPUT_BITDEPTH_DIV8);
 }
 
 /**
  * Update md5 with all samples in plane in raster order, each sample
- * is adjusted to OUTBIT_BITDEPTH_DIV8.
+ * is adjusted to OUTBIT_BITDEPTH_DIV8. Each line is packed and hashed
+ * at once.
  */
 template<uint32_t OUTPUT_BITDEPTH_DIV8>
 static void md5_plane(MD5& md5, const Pel* plane, uint32_t width, uint32_t height, uint32_t stride)
 {
-  /* N is the number of samples to process per md5 update.
-   * All N samples must fit in buf */
-  uint32_t N = 32;
-  uint32_t width_modN = width % N;
-  uint32_t width_less_modN = width - width_modN;
+  std::vector<uint8_t> buf(width * OUTPUT_BITDEPTH_DIV8);
 
   for (uint32_t y = 0; y < height; y++)
   {
-    /* convert pels into unsigned chars in little endian byte order.
-     * NB, for 8bit data, data is truncated to 8bits. */
-    for (uint32_t x = 0; x < width_less_modN; x += N)
-    {
-      md5_block<OUTPUT_BITDEPTH_DIV8>(md5, &plane[y*stride + x], N);
-    }
+    md5_pack<OUTPUT_BITDEPTH_DIV8>(buf.data(), &plane[y*stride], width);
+    md5.update(buf.data(), width * OUTPUT_BITDEPTH_DIV8);
+  }
+}
+
+uint32_t compMD5(int bitdepth, const Pel* plane, uint32_t width, uint32_t height, uint32_t stride, PictureHash &digest)
+{
+  MD5 md5;
+  uint8_t tmp_digest[MD5_DIGEST_STRING_LENGTH];
 
-    /* mop up any of the remaining line */
-    md5_block<OUTPUT_BITDEPTH_DIV8>(md5, &plane[y*stride + width_less_modN], width_modN);
+  /* choose an md5_plane packing function based on the system bitdepth */
+  if (bitdepth <= 8)
+  {
+    md5_plane<1>(md5, plane, width, height, stride);
+  }
+  else
+  {
+    md5_plane<2>(md5, plane, width, height, stride);
   }
+  md5.finalize(tmp_digest);
+  for(uint32_t i=0; i<MD5_DIGEST_STRING_LENGTH; i++)
+  {
+    digest.hash.push_back(tmp_digest[i]);
+  }
+  return 16;
 }
 
 
+/**
+ * The CRC register takes the picture data bits at its LSB, so shifting a
+ * byte in only feeds back the byte that leaves at the MSB. crcTable8[b]
+ * is the feedback of the MSB byte b over 8 shifts, crcTable16[b] the
+ * feedback of b over 16 shifts.
+ */
+struct CrcTables
+{
+  uint16_t crcTable8 [256];
+  uint16_t crcTable16[256];
+
+  CrcTables()
+  {
+    for (uint32_t b = 0; b < 256; b++)
+    {
+      uint32_t crcVal = b << 8;
+      for (uint32_t bitIdx = 0; bitIdx < 8; bitIdx++)
+      {
+        const uint32_t crcMsb = (crcVal >> 15) & 1;
+        crcVal = ((crcVal << 1) & 0xffff) ^ (crcMsb * 0x1021);
+      }
+      crcTable8[b] = crcVal;
+    }
+    for (uint32_t b = 0; b < 256; b++)
+    {
+      crcTable16[b] = ((crcTable8[b] << 8) & 0xffff) ^ crcTable8[crcTable8[b] >> 8];
+    }
+  }
+};
+
 uint32_t compCRC(int bitdepth, const Pel* plane, uint32_t width, uint32_t height, uint32_t stride, PictureHash &digest)
 {
-  uint32_t crcMsb;
-  uint32_t bitVal;
+  static const CrcTables tables;
+  const uint16_t* crcTable8  = tables.crcTable8;
+  const uint16_t* crcTable16 = tables.crcTable16;
+
   uint32_t crcVal = 0xffff;
-  uint32_t bitIdx;
   for (uint32_t y = 0; y < height; y++)
   {
-    for (uint32_t x = 0; x < width; x++)
+    const Pel* line = &plane[y*stride];
+    if (bitdepth > 8)
     {
-      // take CRC of first pictureData byte
-      for(bitIdx=0; bitIdx<8; bitIdx++)
+      // first pictureData byte, then second pictureData byte, sliced by two bytes
+      for (uint32_t x = 0; x < width; x++)
       {
-        crcMsb = (crcVal >> 15) & 1;
-        bitVal = (plane[y*stride+x] >> (7 - bitIdx)) & 1;
-        crcVal = (((crcVal << 1) + bitVal) & 0xffff) ^ (crcMsb * 0x1021);
+        const uint32_t bytes = ((line[x] & 0xff) << 8) | ((line[x] >> 8) & 0xff);
+        crcVal = crcTable16[crcVal >> 8] ^ crcTable8[crcVal & 0xff] ^ bytes;
       }
-      // take CRC of second pictureData byte if bit depth is greater than 8-bits
-      if(bitdepth > 8)
+    }
+    else
+    {
+      for (uint32_t x = 0; x < width; x++)
       {
-        for(bitIdx=0; bitIdx<8; bitIdx++)
-        {
-          crcMsb = (crcVal >> 15) & 1;
-          bitVal = (plane[y*stride+x] >> (15 - bitIdx)) & 1;
-          crcVal = (((crcVal << 1) + bitVal) & 0xffff) ^ (crcMsb * 0x1021);
-        }
+        crcVal = (((crcVal << 8) & 0xffff) | (line[x] & 0xff)) ^ crcTable8[crcVal >> 8];
       }
     }
   }
-  for(bitIdx=0; bitIdx<16; bitIdx++)
-  {
-    crcMsb = (crcVal >> 15) & 1;
-    crcVal = ((crcVal << 1) & 0xffff) ^ (crcMsb * 0x1021);
-  }
+  // 16 zero bits
+  crcVal = crcTable16[crcVal >> 8] ^ crcTable8[crcVal & 0xff];
 
   digest.hash.push_back((crcVal>>8)  & 0xff);
   digest.hash.push_back( crcVal      & 0xff);
@@ -143,18 +204,48 @@ uint32_t calcCRC(const CPelUnitBuf& pic, PictureHash &digest, const BitDepths &b
 uint32_t compChecksum(int bitdepth, const Pel* plane, uint32_t width, uint32_t height, uint32_t stride, PictureHash &digest, const BitDepths &/*bitDepths*/)
 {
   uint32_t checksum = 0;
-  uint8_t xor_mask;
+
+  // the xor mask is (x & 0xff) ^ (y & 0xff) ^ (x >> 8) ^ (y >> 8), the x part is the same for all lines
+  std::vector<uint16_t> xMask(width);
+  for (uint32_t x = 0; x < width; x++)
+  {
+    xMask[x] = uint8_t((x & 0xff) ^ (x >> 8));
+  }
 
   for (uint32_t y = 0; y < height; y++)
   {
-    for (uint32_t x = 0; x < width; x++)
+    const Pel*    line  = &plane[y*stride];
+    const uint8_t yMask = uint8_t((y & 0xff) ^ (y >> 8));
+    uint32_t      x     = 0;
+
+#if PICHASH_SSE2
+    const __m128i vyMask = _mm_set1_epi16(yMask);
+    const __m128i vlow   = _mm_set1_epi16(0xff);
+    const __m128i vone   = _mm_set1_epi16(1);
+    __m128i       vsum   = _mm_setzero_si128();
+    for (; x + 8 <= width; x += 8)
     {
-      xor_mask = (x & 0xff) ^ (y & 0xff) ^ (x >> 8) ^ (y >> 8);
-      checksum = (checksum + ((plane[y*stride+x] & 0xff) ^ xor_mask)) & 0xffffffff;
+      const __m128i vpel  = _mm_loadu_si128((const __m128i*) &line[x]);
+      const __m128i vmask = _mm_xor_si128(_mm_loadu_si128((const __m128i*) &xMask[x]), vyMask);
+      __m128i       vval  = _mm_xor_si128(_mm_and_si128(vpel, vlow), vmask);
+      if (bitdepth > 8)
+      {
+        vval = _mm_add_epi16(vval, _mm_xor_si128(_mm_srli_epi16(vpel, 8), vmask));
+      }
+      vsum = _mm_add_epi32(vsum, _mm_madd_epi16(vval, vone));
+    }
+    vsum = _mm_add_epi32(vsum, _mm_shuffle_epi32(vsum, 0x4e));
+    vsum = _mm_add_epi32(vsum, _mm_shuffle_epi32(vsum, 0xb1));
+    checksum += (uint32_t)_mm_cvtsi128_si32(vsum);
+#endif
+    for (; x < width; x++)
+    {
+      const uint8_t xor_mask = uint8_t(xMask[x] ^ yMask);
+      checksum = (checksum + ((line[x] & 0xff) ^ xor_mask)) & 0xffffffff;
 
       if(bitdepth > 8)
       {
-        checksum = (checksum + ((plane[y*stride+x]>>8) ^ xor_mask)) & 0xffffffff;
+        checksum = (checksum + ((line[x]>>8) ^ xor_mask)) & 0xffffffff;
       }
     }
   }
@@ -187,28 +278,109 @@ uint32_t calcChecksum(const CPelUnitBuf& pic, PictureHash &digest, const BitDept
  */
 uint32_t calcMD5(const CPelUnitBuf& pic, PictureHash &digest, const BitDepths &bitDepths)
 {
-  /* choose an md5_plane packing function based on the system bitdepth */
-  typedef void (*MD5PlaneFunc)(MD5&, const Pel*, uint32_t, uint32_t, uint32_t);
-  MD5PlaneFunc md5_plane_func;
-
-  MD5 md5[MAX_NUM_COMPONENT];
-
   digest.hash.clear();
 
   for (uint32_t chan = 0; chan< (uint32_t)pic.bufs.size(); chan++)
   {
     const ComponentID compID=ComponentID(chan);
     const CPelBuf area = pic.get(compID);
-    md5_plane_func = bitDepths.recon[toChannelType(compID)] <= 8 ? (MD5PlaneFunc)md5_plane<1> : (MD5PlaneFunc)md5_plane<2>;
-    uint8_t tmp_digest[MD5_DIGEST_STRING_LENGTH];
-    md5_plane_func(md5[compID], area.bufAt(0, 0), area.width, area.height, area.stride );
-    md5[compID].finalize(tmp_digest);
-    for(uint32_t i=0; i<MD5_DIGEST_STRING_LENGTH; i++)
+    compMD5(bitDepths.recon[toChannelType(compID)], area.bufAt(0, 0), area.width, area.height, area.stride, digest);
+  }
+  return 16;
+}
+
+// ====================================================================================================================
+// PictureHashJobs
+// ====================================================================================================================
+
+static uint32_t calcPlaneHash(const HashType method, const CPelBuf& area, const int bitdepth, PictureHash &digest, const BitDepths &bitDepths)
+{
+  switch (method)
+  {
+    case HASHTYPE_MD5:
+      return compMD5(bitdepth, area.bufAt(0, 0), area.width, area.height, area.stride, digest);
+    case HASHTYPE_CRC:
+      return compCRC(bitdepth, area.bufAt(0, 0), area.width, area.height, area.stride, digest);
+    case HASHTYPE_CHECKSUM:
+      return compChecksum(bitdepth, area.bufAt(0, 0), area.width, area.height, area.stride, digest, bitDepths);
+    default:
+      THROW("Unknown hash type");
+  }
+  return 0;
+}
+
+PictureHashJobs::PictureHashJobs()
+  : m_threadPool( nullptr )
+  , m_method    ( HASHTYPE_NONE )
+  , m_numPlanes ( 0 )
+{
+}
+
+PictureHashJobs::~PictureHashJobs()
+{
+  if( m_threadPool )
+  {
+    // the jobs write to this object
+    try
+    {
+      m_threadPool->wait( m_jobs );
+    }
+    catch( ... )
     {
-      digest.hash.push_back(tmp_digest[i]);
     }
   }
-  return 16;
+}
+
+void PictureHashJobs::start( const CPelUnitBuf& pic, const HashType method, const BitDepths& bitDepths, ThreadPool* threadPool, const Picture* waitPic )
+{
+  CHECK( m_threadPool, "The hash jobs of the previous picture are not finished" );
+
+  m_method    = method;
+  m_numPlanes = (int)pic.bufs.size();
+  m_bitDepths = bitDepths;
+
+  for( int chan = 0; chan < m_numPlanes; chan++ )
+  {
+    const ComponentID compID = ComponentID( chan );
+    const CPelBuf     area   = pic.get( compID );
+    const int         bitDepth = bitDepths.recon[toChannelType( compID )];
+
+    m_planeHash[chan].hash.clear();
+
+    if( !threadPool )
+    {
+      calcPlaneHash( method, area, bitDepth, m_planeHash[chan], m_bitDepths );
+      continue;
+    }
+
+    threadPool->addJob( [this, area, bitDepth, chan, waitPic]()
+    {
+      if( waitPic )
+      {
+        waitPic->waitForReconstruction();
+      }
+      calcPlaneHash( m_method, area, bitDepth, m_planeHash[chan], m_bitDepths );
+    }, m_jobs );
+  }
+
+  m_threadPool = threadPool;
+}
+
+uint32_t PictureHashJobs::finish( PictureHash& digest )
+{
+  if( m_threadPool )
+  {
+    ThreadPool* threadPool = m_threadPool;
+    m_threadPool = nullptr;
+    threadPool->wait( m_jobs );
+  }
+
+  digest.hash.clear();
+  for( int chan = 0; chan < m_numPlanes; chan++ )
+  {
+    digest.hash.insert( digest.hash.end(), m_planeHash[chan].hash.begin(), m_planeHash[chan].hash.end() );
+  }
+  return m_method == HASHTYPE_MD5 ? 16 : m_method == HASHTYPE_CRC ? 2 : 4;
 }
 
 std::string hashToString(const PictureHash &digest, int numChar)
@@ -229,9 +401,19 @@ std::string hashToString(const PictureHash &digest, int numChar)
   return result;
 }
 
-int calcAndPrintHashStatus(const CPelUnitBuf& pic, const SEIDecodedPictureHash* pictureHashSEI, const BitDepths &bitDepths, const MsgLevel msgl)
+int calcAndPrintHashStatus(const CPelUnitBuf& pic, const SEIDecodedPictureHash* pictureHashSEI, const BitDepths &bitDepths, const MsgLevel msgl, ThreadPool* threadPool)
+{
+  /* calculate MD5sum for entire reconstructed picture, the planes in parallel */
+  PictureHashJobs hashJobs;
+  if (pictureHashSEI)
+  {
+    hashJobs.start(pic, pictureHashSEI->method, bitDepths, threadPool);
+  }
+  return printHashStatus(hashJobs, pictureHashSEI, msgl);
+}
+
+int printHashStatus(PictureHashJobs& hashJobs, const SEIDecodedPictureHash* pictureHashSEI, const MsgLevel msgl)
 {
-  /* calculate MD5sum for entire reconstructed picture */
   PictureHash recon_digest;
   int numChar=0;
   const char* hashType = "\0";
@@ -243,19 +425,16 @@ int calcAndPrintHashStatus(const CPelUnitBuf& pic, const SEIDecodedPictureHash*
       case HASHTYPE_MD5:
         {
           hashType = "MD5";
-          numChar = calcMD5(pic, recon_digest, bitDepths);
           break;
         }
       case HASHTYPE_CRC:
         {
           hashType = "CRC";
-          numChar = calcCRC(pic, recon_digest, bitDepths);
           break;
         }
       case HASHTYPE_CHECKSUM:
         {
           hashType = "Checksum";
-          numChar = calcChecksum(pic, recon_digest, bitDepths);
           break;
         }
       default:
@@ -264,6 +443,7 @@ int calcAndPrintHashStatus(const CPelUnitBuf& pic, const SEIDecodedPictureHash*
           break;
         }
     }
+    numChar = hashJobs.finish(recon_digest);
   }
 
   /* compare digest against received version */
@@ -126,15 +126,11 @@ private:
 #endif
 #endif
 
-int g_wppThreadId( 0 );
-#pragma omp threadprivate(g_wppThreadId)
+thread_local int g_wppThreadId( 0 );
 
 #if ENABLE_SPLIT_PARALLELISM
-int g_splitThreadId( 0 );
-#pragma omp threadprivate(g_splitThreadId)
-
-int g_splitJobId( 0 );
-#pragma omp threadprivate(g_splitJobId)
+// split jobs run on any thread of the pool, all their data is selected by the job ID and not by the thread
+thread_local int g_splitJobId( 0 );
 #endif
 
 Scheduler::Scheduler() :
@@ -146,7 +142,8 @@ Scheduler::Scheduler() :
   ,
 #endif
 #if ENABLE_SPLIT_PARALLELISM
-  m_numSplitThreads( 1 )
+  m_numSplitThreads( 1 ),
+  m_hasParallelBuffer( false )
 #endif
 {
 }
@@ -177,20 +174,6 @@ unsigned Scheduler::getSplitDataId( int jobId ) const
   }
 }
 
-unsigned Scheduler::getSplitPicId( int tId /*= CURR_THREAD_ID */ ) const
-{
-  if( m_numSplitThreads > 1 && m_hasParallelBuffer )
-  {
-    int threadId = tId == CURR_THREAD_ID ? g_splitThreadId : tId;
-
-    return ( g_wppThreadId * m_numSplitThreads ) + threadId;
-  }
-  else
-  {
-    return 0;
-  }
-}
-
 unsigned Scheduler::getSplitJobId() const
 {
   if( m_numSplitThreads > 1 )
@@ -219,11 +202,6 @@ void Scheduler::finishParallel()
   m_hasParallelBuffer = false;
 }
 
-void Scheduler::setSplitThreadId( const int tId )
-{
-  g_splitThreadId = tId == CURR_THREAD_ID ? omp_get_thread_num() : tId;
-}
-
 #endif
 
 
@@ -253,7 +231,8 @@ unsigned Scheduler::getWppThreadId() const
 
 void Scheduler::setWppThreadId( const int tId )
 {
-  g_wppThreadId = tId == CURR_THREAD_ID ? omp_get_thread_num() : tId;
+  CHECK( tId < 0, "The WPP thread ID has to be set explicitly" );
+  g_wppThreadId = tId;
 
   CHECK( g_wppThreadId >= PARL_WPP_MAX_NUM_THREADS, "The WPP thread ID " << g_wppThreadId << " is invalid!" );
 }
@@ -329,20 +308,24 @@ int Scheduler::getNumPicInstances() const
 #if !ENABLE_SPLIT_PARALLELISM
   return 1;
 #elif !ENABLE_WPP_PARALLELISM
-  return ( m_numSplitThreads > 1 ? m_numSplitThreads : 1 );
+  return ( m_numSplitThreads > 1 ? NUM_RESERVERD_SPLIT_JOBS : 1 );
 #else
-  return m_numSplitThreads > 1 ? m_numWppDataInstances * m_numSplitThreads : 1;
+  return m_numSplitThreads > 1 ? m_numWppDataInstances * NUM_RESERVERD_SPLIT_JOBS : 1;
 #endif
 }
 
 #if ENABLE_WPP_PARALLELISM
+// a CTU waits for the CTU two positions to the right in the row above, since the multiple reference line intra
+// prediction of a CU at the right CTU border reaches past the above right CTU
+static const int WPP_CTU_LAG = 2;
+
 void Scheduler::wait( const int ctuPosX, const int ctuPosY )
 {
   if( m_numWppThreads == m_numWppDataInstances )
   {
     if( ctuPosY > 0 && ctuPosX+1 < m_ctuXsize)
     {
-      m_SyncObjs[ctuPosY-1]->wait( ctuPosX+1, ctuPosY-1 );
+      m_SyncObjs[ctuPosY-1]->wait( std::min( ctuPosX+WPP_CTU_LAG, m_ctuXsize-1 ), ctuPosY-1 );
     }
     return;
   }
@@ -417,7 +400,7 @@ bool Scheduler::getNextCtu( Position& pos, int ctuLine, int offset)
   int x = m_LineDone[ctuLine] + 1;
   if( ! m_LineProc[ctuLine] )
   {
-    int maxXOffset = x+offset >= m_ctuXsize ? m_ctuXsize-1 : x+offset;
+    int maxXOffset = x+offset+WPP_CTU_LAG-1 >= m_ctuXsize ? m_ctuXsize-1 : x+offset+WPP_CTU_LAG-1;
     if( (ctuLine == 0 || m_LineDone[ctuLine-1]>=maxXOffset) && (x==0 || m_LineDone[ctuLine]>=+x-1))
     {
       m_LineProc[ctuLine] = true;
@@ -730,6 +713,8 @@ Picture::Picture()
   }
   m_spliceIdx = NULL;
   m_ctuNums = 0;
+  m_reconLines.reset( std::numeric_limits<int64_t>::max() );
+  m_motionFieldFinal.reset( 1 );
 }
 
 void Picture::create(const ChromaFormat &_chromaFormat, const Size &size, const unsigned _maxCUSize, const unsigned _margin, const bool _decoder)
@@ -755,9 +740,9 @@ void Picture::destroy()
 {
 #if ENABLE_SPLIT_PARALLELISM
 #if ENABLE_WPP_PARALLELISM
-  for( int jId = 0; jId < ( PARL_SPLIT_MAX_NUM_THREADS * PARL_WPP_MAX_NUM_THREADS ); jId++ )
+  for( int jId = 0; jId < ( NUM_RESERVERD_SPLIT_JOBS * PARL_WPP_MAX_NUM_THREADS ); jId++ )
 #else
-  for( int jId = 0; jId < PARL_SPLIT_MAX_NUM_THREADS; jId++ )
+  for( int jId = 0; jId < NUM_RESERVERD_SPLIT_JOBS; jId++ )
 #endif
 #endif
   for (uint32_t t = 0; t < NUM_PIC_TYPES; t++)
@@ -868,8 +853,8 @@ const CPelBuf     Picture::getRecoBuf(const ComponentID compID) const { return g
 const CPelBuf     Picture::getRecoBuf(const CompArea &blk)      const { return getBuf(blk,                       PIC_RECONSTRUCTION); }
        PelUnitBuf Picture::getRecoBuf(const UnitArea &unit)           { return getBuf(unit,                      PIC_RECONSTRUCTION); }
 const CPelUnitBuf Picture::getRecoBuf(const UnitArea &unit)     const { return getBuf(unit,                      PIC_RECONSTRUCTION); }
-       PelUnitBuf Picture::getRecoBuf()                               { return M_BUFS(scheduler.getSplitPicId(), PIC_RECONSTRUCTION); }
-const CPelUnitBuf Picture::getRecoBuf()                         const { return M_BUFS(scheduler.getSplitPicId(), PIC_RECONSTRUCTION); }
+       PelUnitBuf Picture::getRecoBuf()                               { return M_BUFS(scheduler.getSplitDataId(), PIC_RECONSTRUCTION); }
+const CPelUnitBuf Picture::getRecoBuf()                         const { return M_BUFS(scheduler.getSplitDataId(), PIC_RECONSTRUCTION); }
 
 #if JVET_N0415_CTB_ALF
 void Picture::finalInit(const SPS& sps, const PPS& pps, APS** apss)
@@ -901,7 +886,7 @@ void Picture::finalInit(const SPS& sps, const PPS& pps, APS& aps)
   }
   else
   {
-    cs = new CodingStructure( g_globalUnitCache.cuCache, g_globalUnitCache.puCache, g_globalUnitCache.tuCache );
+    cs = new CodingStructure();
     cs->sps = &sps;
     cs->create( chromaFormatIDC, Area( 0, 0, iWidth, iHeight ), true );
   }
@@ -983,13 +968,13 @@ void Picture::clearSliceBuffer()
 void Picture::finishParallelPart( const UnitArea& area )
 {
   const UnitArea clipdArea = clipArea( area, *this );
-  const int      sourceID  = scheduler.getSplitPicId( 0 );
+  const int      sourceID  = scheduler.getSplitDataId( 0 );
   CHECK( scheduler.getSplitJobId() > 0, "Finish-CU cannot be called from within a mode- or split-parallelized block!" );
 
-  // distribute the reconstruction across all of the parallel workers
-  for( int tId = 1; tId < scheduler.getNumSplitThreads(); tId++ )
+  // distribute the reconstruction across all of the split jobs
+  for( int jId = 1; jId < NUM_RESERVERD_SPLIT_JOBS; jId++ )
   {
-    const int destID = scheduler.getSplitPicId( tId );
+    const int destID = scheduler.getSplitDataId( jId );
 
     M_BUFS( destID, PIC_RECONSTRUCTION ).subBuf( clipdArea ).copyFrom( M_BUFS( sourceID, PIC_RECONSTRUCTION ).subBuf( clipdArea ) );
   }
@@ -999,7 +984,7 @@ void Picture::finishParallelPart( const UnitArea& area )
 void Picture::finishCtuPart( const UnitArea& ctuArea )
 {
   const UnitArea clipdArea = clipArea( ctuArea, *this );
-  const int      sourceID  = scheduler.getSplitPicId( 0 );
+  const int      sourceID  = scheduler.getSplitDataId( 0 );
   // distribute the reconstruction across all of the parallel workers
   for( int dataId = 0; dataId < scheduler.getNumPicInstances(); dataId++ )
   {
@@ -1014,7 +999,71 @@ void Picture::finishCtuPart( const UnitArea& ctuArea )
 
 void Picture::extendPicBorder()
 {
-  if ( m_bIsBorderExtended )
+  // the border of a pending picture is extended when its reconstruction is finished
+  if ( isReconstructionPending() || m_bIsBorderExtended )
+  {
+    return;
+  }
+
+  xExtendPicBorder( 0, lheight() );
+  m_bIsBorderExtended = true;
+}
+
+void Picture::startReconstruction()
+{
+  m_bIsBorderExtended = false;
+  m_motionFieldFinal.reset( 0 );
+  m_reconLines      .reset( 0 );
+}
+
+void Picture::setMotionFieldFinal()
+{
+  m_motionFieldFinal.set( 1 );
+}
+
+void Picture::finishReconLines( const int numLumaLines )
+{
+  if( !isReconstructionPending() )
+  {
+    return;
+  }
+  if( numLumaLines >= int( lheight() ) )
+  {
+    finishReconstruction();
+    return;
+  }
+
+  // the border of the new lines is extended before they are published, later lines are still being filtered
+  xExtendPicBorder( int( m_reconLines.get() ), numLumaLines );
+  m_reconLines.set( numLumaLines );
+}
+
+void Picture::finishReconstruction()
+{
+  // without startReconstruction() the border is extended on demand by extendPicBorder()
+  if( !isReconstructionPending() )
+  {
+    return;
+  }
+  if( !m_bIsBorderExtended )
+  {
+    // lines published with finishReconLines() are already extended and may be read by now
+    xExtendPicBorder( int( m_reconLines.get() ), lheight() );
+    m_bIsBorderExtended = true;
+  }
+  m_motionFieldFinal.set( 1 );
+  m_reconLines      .set( std::numeric_limits<int64_t>::max() );
+}
+
+void Picture::waitForReconLines( const int numLumaLines ) const
+{
+  // lines outside of the picture area are only available after the border extension
+  m_reconLines.wait( numLumaLines < int( lheight() ) ? numLumaLines : std::numeric_limits<int64_t>::max() );
+}
+
+void Picture::xExtendPicBorder( const int firstLumaLine, const int endLumaLine )
+{
+  if( firstLumaLine >= endLumaLine )
   {
     return;
   }
@@ -1023,16 +1072,18 @@ void Picture::extendPicBorder()
   {
     ComponentID compID = ComponentID( comp );
     PelBuf p = M_BUFS( 0, PIC_RECONSTRUCTION ).get( compID );
-    Pel *piTxt = p.bufAt(0,0);
     int xmargin = margin >> getComponentScaleX( compID, cs->area.chromaFormat );
     int ymargin = margin >> getComponentScaleY( compID, cs->area.chromaFormat );
+    int yStart  = firstLumaLine >> getComponentScaleY( compID, cs->area.chromaFormat );
+    int yEnd    = std::min<int>( endLumaLine >> getComponentScaleY( compID, cs->area.chromaFormat ), p.height );
+    Pel *piTxt = p.bufAt(0,yStart);
 
     Pel*  pi = piTxt;
     // do left and right margins
     if (cs->sps->getWrapAroundEnabledFlag())
     {
       int xoffset = cs->sps->getWrapAroundOffset() >> getComponentScaleX( compID, cs->area.chromaFormat );
-      for (int y = 0; y < p.height; y++)
+      for (int y = yStart; y < yEnd; y++)
       {
         for (int x = 0; x < xmargin; x++ )
         {
@@ -1044,7 +1095,7 @@ void Picture::extendPicBorder()
     }
     else
     {
-      for (int y = 0; y < p.height; y++)
+      for (int y = yStart; y < yEnd; y++)
       {
         for (int x = 0; x < xmargin; x++ )
         {
@@ -1055,34 +1106,37 @@ void Picture::extendPicBorder()
       }
     }
 
-    // pi is now the (0,height) (bottom left of image within bigger picture
-    pi -= (p.stride + xmargin);
-    // pi is now the (-marginX, height-1)
-    for (int y = 0; y < ymargin; y++ )
+    if( yEnd == p.height )
     {
-      ::memcpy( pi + (y+1)*p.stride, pi, sizeof(Pel)*(p.width + (xmargin << 1)));
+      // pi is now the (0,height) (bottom left of image within bigger picture
+      pi -= (p.stride + xmargin);
+      // pi is now the (-marginX, height-1)
+      for (int y = 0; y < ymargin; y++ )
+      {
+        ::memcpy( pi + (y+1)*p.stride, pi, sizeof(Pel)*(p.width + (xmargin << 1)));
+      }
     }
 
-    // pi is still (-marginX, height-1)
-    pi -= ((p.height-1) * p.stride);
-    // pi is now (-marginX, 0)
-    for (int y = 0; y < ymargin; y++ )
+    if( yStart == 0 )
     {
-      ::memcpy( pi - (y+1)*p.stride, pi, sizeof(Pel)*(p.width + (xmargin<<1)) );
+      pi = p.bufAt( 0, 0 ) - xmargin;
+      // pi is now (-marginX, 0)
+      for (int y = 0; y < ymargin; y++ )
+      {
+        ::memcpy( pi - (y+1)*p.stride, pi, sizeof(Pel)*(p.width + (xmargin<<1)) );
+      }
     }
   }
-
-  m_bIsBorderExtended = true;
 }
 
 PelBuf Picture::getBuf( const ComponentID compID, const PictureType &type )
 {
-  return M_BUFS( ( type == PIC_ORIGINAL || type == PIC_TRUE_ORIGINAL ) ? 0 : scheduler.getSplitPicId(), type ).getBuf( compID );
+  return M_BUFS( ( type == PIC_ORIGINAL || type == PIC_TRUE_ORIGINAL ) ? 0 : scheduler.getSplitDataId(), type ).getBuf( compID );
 }
 
 const CPelBuf Picture::getBuf( const ComponentID compID, const PictureType &type ) const
 {
-  return M_BUFS( ( type == PIC_ORIGINAL || type == PIC_TRUE_ORIGINAL ) ? 0 : scheduler.getSplitPicId(), type ).getBuf( compID );
+  return M_BUFS( ( type == PIC_ORIGINAL || type == PIC_TRUE_ORIGINAL ) ? 0 : scheduler.getSplitDataId(), type ).getBuf( compID );
 }
 
 PelBuf Picture::getBuf( const CompArea &blk, const PictureType &type )
@@ -1093,7 +1147,7 @@ PelBuf Picture::getBuf( const CompArea &blk, const PictureType &type )
   }
 
 #if ENABLE_SPLIT_PARALLELISM
-  const int jId = ( type == PIC_ORIGINAL || type == PIC_TRUE_ORIGINAL ) ? 0 : scheduler.getSplitPicId();
+  const int jId = ( type == PIC_ORIGINAL || type == PIC_TRUE_ORIGINAL ) ? 0 : scheduler.getSplitDataId();
 
 #endif
 #if !KEEP_PRED_AND_RESI_SIGNALS
@@ -1103,6 +1157,17 @@ PelBuf Picture::getBuf( const CompArea &blk, const PictureType &type )
     localBlk.x &= ( cs->pcv->maxCUWidthMask  >> getComponentScaleX( blk.compID, blk.chromaFormat ) );
     localBlk.y &= ( cs->pcv->maxCUHeightMask >> getComponentScaleY( blk.compID, blk.chromaFormat ) );
 
+    // CTU rows encoded in parallel bring their own buffers, split jobs keep using the ones of their data instance
+#if ENABLE_SPLIT_PARALLELISM
+    PelStorage* substreamBuf = scheduler.getSplitJobId() == 0 ? cs->getSubstreamBuf( type ) : nullptr;
+#else
+    PelStorage* substreamBuf = cs->getSubstreamBuf( type );
+#endif
+    if( substreamBuf )
+    {
+      return substreamBuf->getBuf( localBlk );
+    }
+
     return M_BUFS( jId, type ).getBuf( localBlk );
   }
 #endif
@@ -1118,7 +1183,7 @@ const CPelBuf Picture::getBuf( const CompArea &blk, const PictureType &type ) co
   }
 
 #if ENABLE_SPLIT_PARALLELISM
-  const int jId = ( type == PIC_ORIGINAL || type == PIC_TRUE_ORIGINAL ) ? 0 : scheduler.getSplitPicId();
+  const int jId = ( type == PIC_ORIGINAL || type == PIC_TRUE_ORIGINAL ) ? 0 : scheduler.getSplitDataId();
 
 #endif
 #if !KEEP_PRED_AND_RESI_SIGNALS
@@ -1128,6 +1193,17 @@ const CPelBuf Picture::getBuf( const CompArea &blk, const PictureType &type ) co
     localBlk.x &= ( cs->pcv->maxCUWidthMask  >> getComponentScaleX( blk.compID, blk.chromaFormat ) );
     localBlk.y &= ( cs->pcv->maxCUHeightMask >> getComponentScaleY( blk.compID, blk.chromaFormat ) );
 
+    // CTU rows encoded in parallel bring their own buffers, split jobs keep using the ones of their data instance
+#if ENABLE_SPLIT_PARALLELISM
+    PelStorage* substreamBuf = scheduler.getSplitJobId() == 0 ? cs->getSubstreamBuf( type ) : nullptr;
+#else
+    PelStorage* substreamBuf = cs->getSubstreamBuf( type );
+#endif
+    if( substreamBuf )
+    {
+      return substreamBuf->getBuf( localBlk );
+    }
+
     return M_BUFS( jId, type ).getBuf( localBlk );
   }
 #endif
@@ -1162,7 +1238,7 @@ const CPelUnitBuf Picture::getBuf( const UnitArea &unit, const PictureType &type
 Pel* Picture::getOrigin( const PictureType &type, const ComponentID compID ) const
 {
 #if ENABLE_SPLIT_PARALLELISM
-  const int jId = ( type == PIC_ORIGINAL || type == PIC_TRUE_ORIGINAL ) ? 0 : scheduler.getSplitPicId();
+  const int jId = ( type == PIC_ORIGINAL || type == PIC_TRUE_ORIGINAL ) ? 0 : scheduler.getSplitDataId();
 #endif
   return M_BUFS( jId, type ).getOrigin( compID );
 
@@ -48,6 +48,7 @@
 #include "CodingStructure.h"
 #include "Hash.h"
 #include "MCTS.h"
+#include "ThreadPool.h"
 #include <deque>
 
 #if ENABLE_WPP_PARALLELISM || ENABLE_SPLIT_PARALLELISM
@@ -65,19 +66,17 @@ public:
   ~Scheduler();
 
 #if ENABLE_SPLIT_PARALLELISM
-  unsigned getSplitDataId( int jobId = CURR_THREAD_ID ) const;
-  unsigned getSplitPicId ( int tId   = CURR_THREAD_ID ) const;
+  unsigned getSplitDataId( int jobId = CURR_THREAD_ID ) const;   ///< data instance (CU encoder stack and picture buffers) of a split job
   unsigned getSplitJobId () const;
-  void     setSplitJobId ( const int jobId );
+  void     setSplitJobId ( const int jobId );                       ///< binds the calling thread to the split job, 0 for the merging job
   void     startParallel ();
   void     finishParallel();
-  void     setSplitThreadId( const int tId = CURR_THREAD_ID );
   unsigned getNumSplitThreads() const { return m_numSplitThreads; };
 #endif
 #if ENABLE_WPP_PARALLELISM
   unsigned getWppDataId  ( int lId = CURR_THREAD_ID ) const;
   unsigned getWppThreadId() const;
-  void     setWppThreadId( const int tId = CURR_THREAD_ID );
+  void     setWppThreadId( const int tId );                  ///< binds the calling thread to the data instance tId
 #endif
   unsigned getDataId     () const;
   bool init              ( const int ctuYsize, const int ctuXsize, const int numWppThreadsRunning, const int numWppExtraLines, const int numSplitThreads );
@@ -225,6 +224,16 @@ struct Picture : public UnitArea
   const CPelUnitBuf getBuf(const UnitArea &unit,     const PictureType &type) const;
 
   void extendPicBorder();
+
+  // reconstruction progress, used by the decoder while the in-loop filters of a picture run concurrently to later pictures
+  void startReconstruction     ();                        ///< the reconstruction becomes pending, nothing is final
+  void setMotionFieldFinal     ();                        ///< the motion field is final (used for temporal motion vector prediction)
+  void finishReconLines        ( const int numLumaLines ); ///< the first lines are final, their border is extended
+  void finishReconstruction    ();                        ///< the reconstruction is final and the border is extended
+  bool isReconstructionPending () const                   { return m_reconLines.get() != std::numeric_limits<int64_t>::max(); }
+  void waitForMotionField      () const                   { m_motionFieldFinal.wait( 1 ); }
+  void waitForReconLines       ( const int numLumaLines ) const;
+  void waitForReconstruction   () const                   { m_reconLines.wait( std::numeric_limits<int64_t>::max() ); }
 #if JVET_N0415_CTB_ALF
   void finalInit(const SPS& sps, const PPS& pps, APS** apss);
 #else
@@ -258,11 +267,19 @@ public:
   int* m_spliceIdx;
   int  m_ctuNums;
 
+private:
+  void xExtendPicBorder( const int firstLumaLine, const int endLumaLine );
+
+  SyncValue m_reconLines;                                 ///< number of final luma lines, maximum if the reconstruction is finished
+  SyncValue m_motionFieldFinal;
+
+public:
+
 #if ENABLE_SPLIT_PARALLELISM
 #if ENABLE_WPP_PARALLELISM
-  PelStorage m_bufs[( PARL_SPLIT_MAX_NUM_JOBS * PARL_WPP_MAX_NUM_THREADS )][NUM_PIC_TYPES];
+  PelStorage m_bufs[( NUM_RESERVERD_SPLIT_JOBS * PARL_WPP_MAX_NUM_THREADS )][NUM_PIC_TYPES];
 #else
-  PelStorage m_bufs[PARL_SPLIT_MAX_NUM_JOBS][NUM_PIC_TYPES];
+  PelStorage m_bufs[NUM_RESERVERD_SPLIT_JOBS][NUM_PIC_TYPES];
 #endif
 #else
   PelStorage m_bufs[NUM_PIC_TYPES];
@@ -342,7 +359,29 @@ public:
 #endif
 };
 
-int calcAndPrintHashStatus(const CPelUnitBuf& pic, const class SEIDecodedPictureHash* pictureHashSEI, const BitDepths &bitDepths, const MsgLevel msgl);
+/// computes the hash of each plane of a picture as a job on a thread pool, in parallel to the other planes and the caller
+class PictureHashJobs
+{
+public:
+  PictureHashJobs();
+  ~PictureHashJobs();
+
+  /// without thread pool the hash is computed here, with waitPic the jobs wait for the reconstruction of that picture
+  void     start ( const CPelUnitBuf& pic, const HashType method, const BitDepths& bitDepths, ThreadPool* threadPool, const Picture* waitPic = nullptr );
+  uint32_t finish( PictureHash& digest );               ///< waits for the jobs, returns the number of bytes per plane
+  bool     isStarted() const                            { return m_numPlanes > 0; }
+
+private:
+  ThreadPool*  m_threadPool;
+  JobCounter   m_jobs;
+  HashType     m_method;
+  BitDepths    m_bitDepths;
+  int          m_numPlanes;
+  PictureHash  m_planeHash[MAX_NUM_COMPONENT];
+};
+
+int calcAndPrintHashStatus(const CPelUnitBuf& pic, const class SEIDecodedPictureHash* pictureHashSEI, const BitDepths &bitDepths, const MsgLevel msgl, ThreadPool* threadPool = nullptr);
+int printHashStatus(PictureHashJobs& hashJobs, const class SEIDecodedPictureHash* pictureHashSEI, const MsgLevel msgl);  ///< finishes the started hash jobs
 
 
 typedef std::list<Picture*> PicList;
@@ -179,7 +179,7 @@ void RdCost::init()
 }
 
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
 
 void RdCost::copyState( const RdCost& other )
 {
@@ -3457,11 +3457,7 @@ Distortion RdCost::xGetSSE64_WTD( const DistParam &rcDtParam )
 #endif
 
 
-Pel orgCopy[MAX_CU_SIZE * MAX_CU_SIZE];
-
-#if _OPENMP
-#pragma omp threadprivate(orgCopy)
-#endif
+thread_local Pel orgCopy[MAX_CU_SIZE * MAX_CU_SIZE];
 
 Distortion RdCost::xGetMRHADs( const DistParam &rcDtParam )
 {
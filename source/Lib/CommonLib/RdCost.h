@@ -160,7 +160,7 @@ public:
   // Distortion Functions
   void          init();
 #ifdef TARGET_SIMD_X86
-  void          initRdCostX86();
+  void          initRdCostX86( const X86_VEXT vext = read_x86_extension_flags() );
   template <X86_VEXT vext>
   void          _initRdCostX86();
 #endif
@@ -285,7 +285,7 @@ public:
     return length;
   }
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   void copyState( const RdCost& other );
 #endif
 
@@ -37,6 +37,7 @@
 
 #include "Rom.h"
 #include "UnitTools.h"
+#include "DepQuant.h"
 
 #include <memory.h>
 #include <stdlib.h>
@@ -518,6 +519,9 @@ void initROM()
 
 void destroyROM()
 {
+  // the next encoder rebuilds them from the scan orders of initROM
+  DepQuant::destroyRom();
+
   unsigned numWidths = gp_sizeIdxInfo->numAllWidths();
   unsigned numHeights = gp_sizeIdxInfo->numAllHeights();
 
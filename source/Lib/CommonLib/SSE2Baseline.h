@@ -0,0 +1,72 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     SSE2Baseline.h
+    \brief    SSE2 helpers used without run-time dispatch, SSE2 being part of every x86-64 target
+*/
+
+#ifndef __SSE2BASELINE__
+#define __SSE2BASELINE__
+
+#include "CommonDef.h"
+
+#if defined( TARGET_SIMD_X86 ) && ( defined( __SSE2__ ) || defined( _M_X64 ) )
+#define ENABLE_SSE2_BASELINE 1
+#include <emmintrin.h>
+#else
+#define ENABLE_SSE2_BASELINE 0
+#endif
+
+#if ENABLE_SSE2_BASELINE
+/**
+ * returns a mask with bit i set if the byte p[i] and the byte p[i+1] are
+ * zero, for the 16 bytes at p, i.e. where an emulation prevention sequence
+ * or a start code might start (reads 17 bytes)
+ */
+static inline unsigned zeroBytePairMask( const uint8_t* p )
+{
+  const __m128i vzero = _mm_setzero_si128();
+  const __m128i vcur  = _mm_cmpeq_epi8( _mm_loadu_si128( ( const __m128i* ) p ),         vzero );
+  const __m128i vnext = _mm_cmpeq_epi8( _mm_loadu_si128( ( const __m128i* ) ( p + 1 ) ), vzero );
+
+  return ( unsigned ) _mm_movemask_epi8( _mm_and_si128( vcur, vnext ) );
+}
+
+/// returns true if one of the 16 bytes at p is a zero byte followed by a zero byte (reads 17 bytes)
+static inline bool hasZeroBytePair( const uint8_t* p )
+{
+  return zeroBytePairMask( p ) != 0;
+}
+#endif
+
+#endif // __SSE2BASELINE__
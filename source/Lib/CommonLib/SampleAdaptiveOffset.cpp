@@ -112,15 +112,21 @@ const SAOBlkParam& SAOBlkParam::operator= (const SAOBlkParam& src)
 
 SampleAdaptiveOffset::SampleAdaptiveOffset()
 {
+  m_offsetBlkEO = offsetBlkEO;
+  m_offsetBlkBO = offsetBlkBO;
+  m_calcStatsEO = calcStatsEO;
+
+#if ENABLE_SIMD_OPT_SAO
+#ifdef TARGET_SIMD_X86
+  initSampleAdaptiveOffsetX86();
+#endif
+#endif
 }
 
 
 SampleAdaptiveOffset::~SampleAdaptiveOffset()
 {
   destroy();
-
-  m_signLineBuf1.clear();
-  m_signLineBuf2.clear();
 }
 
 void SampleAdaptiveOffset::create( int picWidth, int picHeight, ChromaFormat format, uint32_t maxCUWidth, uint32_t maxCUHeight, uint32_t maxCUDepth, uint32_t lumaBitShift, uint32_t chromaBitShift )
@@ -289,215 +295,124 @@ void SampleAdaptiveOffset::xReconstructBlkSAOParams(CodingStructure& cs, SAOBlkP
 }
 
 
+void SampleAdaptiveOffset::offsetBlkEO( const Pel* src, Pel* res, const int srcStride, const int resStride, const int width, const int height, const int neighbour, const int* offset, const ClpRng& clpRng )
+{
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      const int edgeType = sgn( src[x] - src[x - neighbour] ) + sgn( src[x] - src[x + neighbour] );
+
+      res[x] = ClipPel<int>( src[x] + offset[edgeType + 2], clpRng );
+    }
+    src += srcStride;
+    res += resStride;
+  }
+}
+
+void SampleAdaptiveOffset::offsetBlkBO( const Pel* src, Pel* res, const int srcStride, const int resStride, const int width, const int height, const int shiftBits, const int* offset, const ClpRng& clpRng )
+{
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      res[x] = ClipPel<int>( src[x] + offset[src[x] >> shiftBits], clpRng );
+    }
+    src += srcStride;
+    res += resStride;
+  }
+}
+
+void SampleAdaptiveOffset::calcStatsEO( const Pel* src, const Pel* org, const int srcStride, const int orgStride, const int width, const int height, const int neighbour, int64_t* diff, int64_t* count )
+{
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      const int edgeType = sgn( src[x] - src[x - neighbour] ) + sgn( src[x] - src[x + neighbour] );
+
+      diff [edgeType + 2] += org[x] - src[x];
+      count[edgeType + 2] ++;
+    }
+    src += srcStride;
+    org += orgStride;
+  }
+}
+
 void SampleAdaptiveOffset::offsetBlock(const int channelBitDepth, const ClpRng& clpRng, int typeIdx, int* offset
                                           , const Pel* srcBlk, Pel* resBlk, int srcStride, int resStride,  int width, int height
                                           , bool isLeftAvail,  bool isRightAvail, bool isAboveAvail, bool isBelowAvail, bool isAboveLeftAvail, bool isAboveRightAvail, bool isBelowLeftAvail, bool isBelowRightAvail)
 {
-  int x,y, startX, startY, endX, endY, edgeType;
+  int startX, startY, endX, endY;
   int firstLineStartX, firstLineEndX, lastLineStartX, lastLineEndX;
-  int8_t signLeft, signRight, signDown;
 
-  const Pel* srcLine = srcBlk;
-        Pel* resLine = resBlk;
+  // offsets the samples [x0, x1) of the lines [y0, y1), the neighbours of a sample are at -neighbour and +neighbour
+  auto offsetEO = [&]( const int x0, const int x1, const int y0, const int y1, const int neighbour )
+  {
+    if( x1 > x0 && y1 > y0 )
+    {
+      m_offsetBlkEO( srcBlk + y0 * srcStride + x0, resBlk + y0 * resStride + x0, srcStride, resStride, x1 - x0, y1 - y0, neighbour, offset, clpRng );
+    }
+  };
 
   switch(typeIdx)
   {
   case SAO_TYPE_EO_0:
     {
-      offset += 2;
       startX = isLeftAvail ? 0 : 1;
       endX   = isRightAvail ? width : (width -1);
-      for (y=0; y< height; y++)
-      {
-        signLeft = (int8_t)sgn(srcLine[startX] - srcLine[startX-1]);
-        for (x=startX; x< endX; x++)
-        {
-          signRight = (int8_t)sgn(srcLine[x] - srcLine[x+1]);
-          edgeType =  signRight + signLeft;
-          signLeft  = -signRight;
-
-          resLine[x] = ClipPel<int>( srcLine[x] + offset[edgeType], clpRng);
-        }
-        srcLine  += srcStride;
-        resLine += resStride;
-      }
-
+      offsetEO( startX, endX, 0, height, 1 );
     }
     break;
   case SAO_TYPE_EO_90:
     {
-      offset += 2;
-      int8_t *signUpLine = &m_signLineBuf1[0];
-
       startY = isAboveAvail ? 0 : 1;
       endY   = isBelowAvail ? height : height-1;
-      if (!isAboveAvail)
-      {
-        srcLine += srcStride;
-        resLine += resStride;
-      }
-
-      const Pel* srcLineAbove= srcLine- srcStride;
-      for (x=0; x< width; x++)
-      {
-        signUpLine[x] = (int8_t)sgn(srcLine[x] - srcLineAbove[x]);
-      }
-
-      const Pel* srcLineBelow;
-      for (y=startY; y<endY; y++)
-      {
-        srcLineBelow= srcLine+ srcStride;
-
-        for (x=0; x< width; x++)
-        {
-          signDown  = (int8_t)sgn(srcLine[x] - srcLineBelow[x]);
-          edgeType = signDown + signUpLine[x];
-          signUpLine[x]= -signDown;
-
-          resLine[x] = ClipPel<int>(srcLine[x] + offset[edgeType], clpRng);
-        }
-        srcLine += srcStride;
-        resLine += resStride;
-      }
-
+      offsetEO( 0, width, startY, endY, srcStride );
     }
     break;
   case SAO_TYPE_EO_135:
     {
-      offset += 2;
-      int8_t *signUpLine, *signDownLine, *signTmpLine;
-
-      signUpLine  = &m_signLineBuf1[0];
-      signDownLine= &m_signLineBuf2[0];
-
       startX = isLeftAvail ? 0 : 1 ;
       endX   = isRightAvail ? width : (width-1);
 
-      //prepare 2nd line's upper sign
-      const Pel* srcLineBelow= srcLine+ srcStride;
-      for (x=startX; x< endX+1; x++)
-      {
-        signUpLine[x] = (int8_t)sgn(srcLineBelow[x] - srcLine[x- 1]);
-      }
-
       //1st line
-      const Pel* srcLineAbove= srcLine- srcStride;
       firstLineStartX = isAboveLeftAvail ? 0 : 1;
       firstLineEndX   = isAboveAvail? endX: 1;
-      for(x= firstLineStartX; x< firstLineEndX; x++)
-      {
-        edgeType  =  sgn(srcLine[x] - srcLineAbove[x- 1]) - signUpLine[x+1];
-
-        resLine[x] = ClipPel<int>( srcLine[x] + offset[edgeType], clpRng);
-      }
-      srcLine  += srcStride;
-      resLine  += resStride;
-
+      offsetEO( firstLineStartX, firstLineEndX, 0, 1, srcStride + 1 );
 
       //middle lines
-      for (y= 1; y< height-1; y++)
-      {
-        srcLineBelow= srcLine+ srcStride;
-
-        for (x=startX; x<endX; x++)
-        {
-          signDown =  (int8_t)sgn(srcLine[x] - srcLineBelow[x+ 1]);
-          edgeType =  signDown + signUpLine[x];
-          resLine[x] = ClipPel<int>( srcLine[x] + offset[edgeType], clpRng);
-
-          signDownLine[x+1] = -signDown;
-        }
-        signDownLine[startX] = (int8_t)sgn(srcLineBelow[startX] - srcLine[startX-1]);
-
-        signTmpLine  = signUpLine;
-        signUpLine   = signDownLine;
-        signDownLine = signTmpLine;
-
-        srcLine += srcStride;
-        resLine += resStride;
-      }
+      offsetEO( startX, endX, 1, height - 1, srcStride + 1 );
 
       //last line
-      srcLineBelow= srcLine+ srcStride;
       lastLineStartX = isBelowAvail ? startX : (width -1);
       lastLineEndX   = isBelowRightAvail ? width : (width -1);
-      for(x= lastLineStartX; x< lastLineEndX; x++)
-      {
-        edgeType =  sgn(srcLine[x] - srcLineBelow[x+ 1]) + signUpLine[x];
-        resLine[x] = ClipPel<int>( srcLine[x] + offset[edgeType], clpRng);
-
-      }
+      offsetEO( lastLineStartX, lastLineEndX, height - 1, height, srcStride + 1 );
     }
     break;
   case SAO_TYPE_EO_45:
     {
-      offset += 2;
-      int8_t *signUpLine = &m_signLineBuf1[1];
-
       startX = isLeftAvail ? 0 : 1;
       endX   = isRightAvail ? width : (width -1);
 
-      //prepare 2nd line upper sign
-      const Pel* srcLineBelow= srcLine+ srcStride;
-      for (x=startX-1; x< endX; x++)
-      {
-        signUpLine[x] = (int8_t)sgn(srcLineBelow[x] - srcLine[x+1]);
-      }
-
-
       //first line
-      const Pel* srcLineAbove= srcLine- srcStride;
       firstLineStartX = isAboveAvail ? startX : (width -1 );
       firstLineEndX   = isAboveRightAvail ? width : (width-1);
-      for(x= firstLineStartX; x< firstLineEndX; x++)
-      {
-        edgeType = sgn(srcLine[x] - srcLineAbove[x+1]) -signUpLine[x-1];
-        resLine[x] = ClipPel<int>(srcLine[x] + offset[edgeType], clpRng);
-      }
-      srcLine += srcStride;
-      resLine += resStride;
+      offsetEO( firstLineStartX, firstLineEndX, 0, 1, srcStride - 1 );
 
       //middle lines
-      for (y= 1; y< height-1; y++)
-      {
-        srcLineBelow= srcLine+ srcStride;
-
-        for(x= startX; x< endX; x++)
-        {
-          signDown =  (int8_t)sgn(srcLine[x] - srcLineBelow[x-1]);
-          edgeType =  signDown + signUpLine[x];
-          resLine[x] = ClipPel<int>(srcLine[x] + offset[edgeType], clpRng);
-          signUpLine[x-1] = -signDown;
-        }
-        signUpLine[endX-1] = (int8_t)sgn(srcLineBelow[endX-1] - srcLine[endX]);
-        srcLine  += srcStride;
-        resLine += resStride;
-      }
+      offsetEO( startX, endX, 1, height - 1, srcStride - 1 );
 
       //last line
-      srcLineBelow= srcLine+ srcStride;
       lastLineStartX = isBelowLeftAvail ? 0 : 1;
       lastLineEndX   = isBelowAvail ? endX : 1;
-      for(x= lastLineStartX; x< lastLineEndX; x++)
-      {
-        edgeType = sgn(srcLine[x] - srcLineBelow[x-1]) + signUpLine[x];
-        resLine[x] = ClipPel<int>(srcLine[x] + offset[edgeType], clpRng);
-
-      }
+      offsetEO( lastLineStartX, lastLineEndX, height - 1, height, srcStride - 1 );
     }
     break;
   case SAO_TYPE_BO:
     {
       const int shiftBits = channelBitDepth - NUM_SAO_BO_CLASSES_LOG2;
-      for (y=0; y< height; y++)
-      {
-        for (x=0; x< width; x++)
-        {
-          resLine[x] = ClipPel<int>(srcLine[x] + offset[srcLine[x] >> shiftBits], clpRng );
-        }
-        srcLine += srcStride;
-        resLine += resStride;
-      }
+      m_offsetBlkBO( srcBlk, resBlk, srcStride, resStride, width, height, shiftBits, offset, clpRng );
     }
     break;
   default:
@@ -528,13 +443,6 @@ void SampleAdaptiveOffset::offsetCTU( const UnitArea& area, const CPelUnitBuf& s
   //block boundary availability
   deriveLoopFilterBoundaryAvailibility(cs, area.Y(), isLeftAvail,isRightAvail,isAboveAvail,isBelowAvail,isAboveLeftAvail,isAboveRightAvail,isBelowLeftAvail,isBelowRightAvail);
 
-  const size_t lineBufferSize = area.Y().width + 1;
-  if (m_signLineBuf1.size() < lineBufferSize)
-  {
-    m_signLineBuf1.resize(lineBufferSize);
-    m_signLineBuf2.resize(lineBufferSize);
-  }
-
   for(int compIdx = 0; compIdx < numberOfComponents; compIdx++)
   {
     const ComponentID compID = ComponentID(compIdx);
@@ -563,70 +471,104 @@ void SampleAdaptiveOffset::offsetCTU( const UnitArea& area, const CPelUnitBuf& s
 
 void SampleAdaptiveOffset::SAOProcess( CodingStructure& cs, SAOBlkParam* saoBlkParams
                                       )
+{
+  if( !initSAOProcess( cs, saoBlkParams ) )
+  {
+    return;
+  }
+
+  const PreCalcValues& pcv = *cs.pcv;
+  for( int ctuRow = 0; ctuRow < pcv.heightInCtus; ctuRow++ )
+  {
+    storeCtuRow( cs, ctuRow );
+  }
+  for( int ctuRow = 0; ctuRow < pcv.heightInCtus; ctuRow++ )
+  {
+    xOffsetCtuRow( cs, ctuRow );
+  }
+
+  DTRACE_UPDATE(g_trace_ctx, (std::make_pair("poc", cs.slice->getPOC())));
+  DTRACE_PIC_COMP(D_REC_CB_LUMA_SAO, cs, cs.getRecoBuf(), COMPONENT_Y);
+  DTRACE_PIC_COMP(D_REC_CB_CHROMA_SAO, cs, cs.getRecoBuf(), COMPONENT_Cb);
+  DTRACE_PIC_COMP(D_REC_CB_CHROMA_SAO, cs, cs.getRecoBuf(), COMPONENT_Cr);
+
+  DTRACE    ( g_trace_ctx, D_CRC, "SAO" );
+  DTRACE_CRC( g_trace_ctx, D_CRC, cs, cs.getRecoBuf() );
+
+  xPCMLFDisableProcess(cs);
+}
+
+bool SampleAdaptiveOffset::initSAOProcess( CodingStructure& cs, SAOBlkParam* saoBlkParams )
 {
   CHECK(!saoBlkParams, "No parameters present");
 
   xReconstructBlkSAOParams(cs, saoBlkParams);
 
   const uint32_t numberOfComponents = getNumberValidComponents(cs.area.chromaFormat);
-  bool bAllDisabled = true;
   for (uint32_t compIdx = 0; compIdx < numberOfComponents; compIdx++)
   {
     if (m_picSAOEnabled[compIdx])
     {
-      bAllDisabled = false;
+      return true;
     }
   }
-  if (bAllDisabled)
-  {
-    return;
-  }
+  return false;
+}
+
+void SampleAdaptiveOffset::storeCtuRow( CodingStructure& cs, const int ctuRow )
+{
+  const UnitArea rowArea = CS::getCtuRowArea( cs, ctuRow );
+
+  m_tempBuf.subBuf( rowArea ).copyFrom( cs.getRecoBuf( rowArea ) );
+}
 
+void SampleAdaptiveOffset::SAOProcessCtuRow( CodingStructure& cs, const int ctuRow )
+{
+  xOffsetCtuRow( cs, ctuRow );
+  xPCMLFDisableCtuRow( cs, ctuRow );
+}
+
+void SampleAdaptiveOffset::xOffsetCtuRow( CodingStructure& cs, const int ctuRow )
+{
   const PreCalcValues& pcv = *cs.pcv;
   PelUnitBuf rec = cs.getRecoBuf();
-  m_tempBuf.copyFrom( rec );
 
-  int ctuRsAddr = 0;
-  for( uint32_t yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight )
+  const uint32_t yPos   = ctuRow * pcv.maxCUHeight;
+  const uint32_t height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
+  int ctuRsAddr = ctuRow * pcv.widthInCtus;
+
+  for( uint32_t xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
   {
-    for( uint32_t xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
-    {
-      const uint32_t width  = (xPos + pcv.maxCUWidth  > pcv.lumaWidth)  ? (pcv.lumaWidth - xPos)  : pcv.maxCUWidth;
-      const uint32_t height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
-      const UnitArea area( cs.area.chromaFormat, Area(xPos , yPos, width, height) );
+    const uint32_t width  = (xPos + pcv.maxCUWidth  > pcv.lumaWidth)  ? (pcv.lumaWidth - xPos)  : pcv.maxCUWidth;
+    const UnitArea area( cs.area.chromaFormat, Area(xPos , yPos, width, height) );
 
-      offsetCTU( area, m_tempBuf, rec, cs.picture->getSAO()[ctuRsAddr], cs);
-      ctuRsAddr++;
-    }
+    offsetCTU( area, m_tempBuf, rec, cs.picture->getSAO()[ctuRsAddr], cs);
+    ctuRsAddr++;
   }
-
-  DTRACE_UPDATE(g_trace_ctx, (std::make_pair("poc", cs.slice->getPOC())));
-  DTRACE_PIC_COMP(D_REC_CB_LUMA_SAO, cs, cs.getRecoBuf(), COMPONENT_Y);
-  DTRACE_PIC_COMP(D_REC_CB_CHROMA_SAO, cs, cs.getRecoBuf(), COMPONENT_Cb);
-  DTRACE_PIC_COMP(D_REC_CB_CHROMA_SAO, cs, cs.getRecoBuf(), COMPONENT_Cr);
-
-  DTRACE    ( g_trace_ctx, D_CRC, "SAO" );
-  DTRACE_CRC( g_trace_ctx, D_CRC, cs, cs.getRecoBuf() );
-
-  xPCMLFDisableProcess(cs);
 }
 
 void SampleAdaptiveOffset::xPCMLFDisableProcess(CodingStructure& cs)
+{
+  for( int ctuRow = 0; ctuRow < cs.pcv->heightInCtus; ctuRow++ )
+  {
+    xPCMLFDisableCtuRow( cs, ctuRow );
+  }
+}
+
+void SampleAdaptiveOffset::xPCMLFDisableCtuRow(CodingStructure& cs, const int ctuRow)
 {
   const PreCalcValues& pcv = *cs.pcv;
   const bool bPCMFilter = (cs.sps->getPCMEnabledFlag() && cs.sps->getPCMFilterDisableFlag()) ? true : false;
 
   if( bPCMFilter || cs.pps->getTransquantBypassEnabledFlag() )
   {
-    for( uint32_t yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight )
+    const uint32_t yPos = ctuRow * pcv.maxCUHeight;
+    for( uint32_t xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
     {
-      for( uint32_t xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
-      {
-        UnitArea ctuArea( cs.area.chromaFormat, Area( xPos, yPos, pcv.maxCUWidth, pcv.maxCUHeight ) );
+      UnitArea ctuArea( cs.area.chromaFormat, Area( xPos, yPos, pcv.maxCUWidth, pcv.maxCUHeight ) );
 
-        // CU-based deblocking
-        xPCMCURestoration(cs, ctuArea);
-      }
+      // CU-based deblocking
+      xPCMCURestoration(cs, ctuArea);
     }
   }
 }
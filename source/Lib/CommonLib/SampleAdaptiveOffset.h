@@ -67,10 +67,30 @@ public:
   virtual ~SampleAdaptiveOffset();
   void SAOProcess( CodingStructure& cs, SAOBlkParam* saoBlkParams
                    );
+
+  // CTU row based processing after initSAOProcess: a row is processed once it and its neighbour rows are stored, the rows
+  // themselves can be stored and processed concurrently
+  bool initSAOProcess  ( CodingStructure& cs, SAOBlkParam* saoBlkParams );  ///< false if SAO is off in the picture
+  void storeCtuRow     ( CodingStructure& cs, const int ctuRow );            ///< copies the row to the SAO input buffer
+  void SAOProcessCtuRow( CodingStructure& cs, const int ctuRow );            ///< includes the PCM/lossless sample restoration
   void create( int picWidth, int picHeight, ChromaFormat format, uint32_t maxCUWidth, uint32_t maxCUHeight, uint32_t maxCUDepth, uint32_t lumaBitShift, uint32_t chromaBitShift );
   void destroy();
   static int getMaxOffsetQVal(const int channelBitDepth) { return (1<<(std::min<int>(channelBitDepth,MAX_SAO_TRUNCATED_BITDEPTH)-5))-1; } //Table 9-32, inclusive
   void setReshaper(Reshape * p) { m_pcReshape = p; }
+
+  /// edge offset of a width x height block, the two neighbours of a sample are at -neighbour and +neighbour in src
+  void (*m_offsetBlkEO)( const Pel* src, Pel* res, const int srcStride, const int resStride, const int width, const int height, const int neighbour, const int* offset, const ClpRng& clpRng );
+  /// band offset of a width x height block, the band of a sample is src >> shiftBits
+  void (*m_offsetBlkBO)( const Pel* src, Pel* res, const int srcStride, const int resStride, const int width, const int height, const int shiftBits, const int* offset, const ClpRng& clpRng );
+  /// accumulates the edge offset class statistics ( sum of org - src and sample count per class ) of a width x height block
+  void (*m_calcStatsEO)( const Pel* src, const Pel* org, const int srcStride, const int orgStride, const int width, const int height, const int neighbour, int64_t* diff, int64_t* count );
+
+#ifdef TARGET_SIMD_X86
+  void initSampleAdaptiveOffsetX86( const X86_VEXT vext = read_x86_extension_flags() );
+  template <X86_VEXT vext>
+  void _initSampleAdaptiveOffsetX86();
+#endif
+
 protected:
   void deriveLoopFilterBoundaryAvailibility(CodingStructure& cs, const Position &pos,
     bool& isLeftAvail,
@@ -83,6 +103,10 @@ protected:
     bool& isBelowRightAvail
     ) const;
 
+  static void offsetBlkEO( const Pel* src, Pel* res, const int srcStride, const int resStride, const int width, const int height, const int neighbour, const int* offset, const ClpRng& clpRng );
+  static void offsetBlkBO( const Pel* src, Pel* res, const int srcStride, const int resStride, const int width, const int height, const int shiftBits, const int* offset, const ClpRng& clpRng );
+  static void calcStatsEO( const Pel* src, const Pel* org, const int srcStride, const int orgStride, const int width, const int height, const int neighbour, int64_t* diff, int64_t* count );
+
   void offsetBlock(const int channelBitDepth, const ClpRng& clpRng, int typeIdx, int* offset, const Pel* srcBlk, Pel* resBlk, int srcStride, int resStride,  int width, int height
                   , bool isLeftAvail, bool isRightAvail, bool isAboveAvail, bool isBelowAvail, bool isAboveLeftAvail, bool isAboveRightAvail, bool isBelowLeftAvail, bool isBelowRightAvail);
   void invertQuantOffsets(ComponentID compIdx, int typeIdc, int typeAuxInfo, int* dstOffsets, int* srcOffsets);
@@ -90,6 +114,8 @@ protected:
   int  getMergeList(CodingStructure& cs, int ctuRsAddr, SAOBlkParam* blkParams, SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES]);
   void offsetCTU(const UnitArea& area, const CPelUnitBuf& src, PelUnitBuf& res, SAOBlkParam& saoblkParam, CodingStructure& cs);
   void xPCMLFDisableProcess(CodingStructure& cs);
+  void xPCMLFDisableCtuRow(CodingStructure& cs, const int ctuRow);
+  void xOffsetCtuRow(CodingStructure& cs, const int ctuRow);
   void xPCMCURestoration(CodingStructure& cs, const UnitArea &ctuArea);
   void xPCMSampleRestoration(CodingUnit& cu, const ComponentID compID);
   void xReconstructBlkSAOParams(CodingStructure& cs, SAOBlkParam* saoBlkParams);
@@ -98,9 +124,6 @@ protected:
   uint32_t m_offsetStepLog2[MAX_NUM_COMPONENT]; //offset step
   PelStorage m_tempBuf;
   uint32_t m_numberOfComponents;
-
-  std::vector<int8_t> m_signLineBuf1;
-  std::vector<int8_t> m_signLineBuf2;
 private:
   bool m_picSAOEnabled[MAX_NUM_COMPONENT];
 };
@@ -0,0 +1,252 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     ThreadPool.cpp
+    \brief    portable thread pool and synchronization helpers
+*/
+
+#include "ThreadPool.h"
+
+#include "CommonDef.h"
+
+#include <algorithm>
+
+//! \ingroup CommonLib
+//! \{
+
+// ====================================================================================================================
+// SyncValue
+// ====================================================================================================================
+
+void SyncValue::reset( int64_t val )
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_val = val;
+}
+
+void SyncValue::set( int64_t val )
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_val = val;
+  m_cond.notify_all();
+}
+
+void SyncValue::wait( int64_t val ) const
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  while( m_val < val )
+  {
+    m_cond.wait( lock );
+  }
+}
+
+int64_t SyncValue::get() const
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  return m_val;
+}
+
+// ====================================================================================================================
+// JobCounter
+// ====================================================================================================================
+
+bool JobCounter::isDone() const
+{
+  return m_numPending == 0;
+}
+
+void JobCounter::rethrow()
+{
+  if( m_error )
+  {
+    std::exception_ptr error = m_error;
+    m_error = nullptr;
+    std::rethrow_exception( error );
+  }
+}
+
+// ====================================================================================================================
+// ThreadPool
+// ====================================================================================================================
+
+ThreadPool::ThreadPool()
+  : m_numThreads( 1 )
+  , m_exit      ( false )
+{
+}
+
+ThreadPool::~ThreadPool()
+{
+  destroy();
+}
+
+void ThreadPool::create( const int numThreads )
+{
+  CHECK( numThreads < 1, "A thread pool needs at least one thread" );
+
+  if( numThreads == m_numThreads && (int)m_threads.size() == numThreads - 1 )
+  {
+    return;
+  }
+
+  destroy();
+
+  m_numThreads = numThreads;
+  m_exit       = false;
+
+  for( int i = 1; i < m_numThreads; i++ )
+  {
+    m_threads.push_back( std::thread( &ThreadPool::xWorkerLoop, this ) );
+  }
+}
+
+void ThreadPool::destroy()
+{
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    CHECK( !m_jobs.empty(), "Destroying a thread pool with pending jobs" );
+    m_exit = true;
+    m_jobCond.notify_all();
+  }
+
+  for( auto &t : m_threads )
+  {
+    t.join();
+  }
+  m_threads.clear();
+  m_numThreads = 1;
+}
+
+void ThreadPool::addJob( std::function<void()> job, JobCounter& counter )
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+
+  counter.m_numPending++;
+  m_jobs.push_back( Job{ std::move( job ), &counter } );
+  m_jobCond.notify_one();
+}
+
+void ThreadPool::wait( JobCounter& counter )
+{
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+
+    while( !counter.isDone() )
+    {
+      if( !m_jobs.empty() )
+      {
+        Job job = std::move( m_jobs.front() );
+        m_jobs.pop_front();
+        xRunJob( job, lock );
+      }
+      else
+      {
+        m_doneCond.wait( lock );
+      }
+    }
+  }
+
+  counter.rethrow();
+}
+
+void ThreadPool::waitNested( JobCounter& counter )
+{
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+
+    while( !counter.isDone() )
+    {
+      auto it = std::find_if( m_jobs.begin(), m_jobs.end(), [&counter]( const Job& job ) { return job.counter == &counter; } );
+
+      if( it != m_jobs.end() )
+      {
+        Job job = std::move( *it );
+        m_jobs.erase( it );
+        xRunJob( job, lock );
+      }
+      else
+      {
+        m_doneCond.wait( lock );
+      }
+    }
+  }
+
+  counter.rethrow();
+}
+
+void ThreadPool::xWorkerLoop()
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+
+  while( true )
+  {
+    while( m_jobs.empty() && !m_exit )
+    {
+      m_jobCond.wait( lock );
+    }
+    if( m_jobs.empty() )
+    {
+      return;
+    }
+
+    Job job = std::move( m_jobs.front() );
+    m_jobs.pop_front();
+    xRunJob( job, lock );
+  }
+}
+
+void ThreadPool::xRunJob( Job& job, std::unique_lock<std::mutex>& lock )
+{
+  lock.unlock();
+
+  std::exception_ptr error;
+  try
+  {
+    job.func();
+  }
+  catch( ... )
+  {
+    error = std::current_exception();
+  }
+
+  lock.lock();
+
+  if( error && !job.counter->m_error )
+  {
+    job.counter->m_error = error;
+  }
+  job.counter->m_numPending--;
+  m_doneCond.notify_all();
+}
+
+//! \}
@@ -0,0 +1,131 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     ThreadPool.h
+    \brief    portable thread pool and synchronization helpers (header)
+*/
+
+#ifndef __THREADPOOL__
+#define __THREADPOOL__
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! \ingroup CommonLib
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// monotonically increasing value other threads can block on (e.g. the last finished CTU of a row)
+class SyncValue
+{
+public:
+  SyncValue( int64_t val = -1 ) : m_val( val ) {}
+
+  void    reset( int64_t val = -1 );
+  void    set  ( int64_t val );
+  void    wait ( int64_t val ) const;                   ///< blocks until the value is at least val
+  int64_t get  () const;
+
+private:
+  int64_t                         m_val;
+  mutable std::mutex              m_mutex;
+  mutable std::condition_variable m_cond;
+};
+
+/// number of outstanding jobs of one batch, several batches can share one pool
+class JobCounter
+{
+public:
+  JobCounter() : m_numPending( 0 ) {}
+
+  bool isDone() const;
+  void rethrow();                                       ///< rethrows the first exception thrown by a job of this batch
+
+private:
+  friend class ThreadPool;
+
+  int                     m_numPending;
+  std::exception_ptr      m_error;
+};
+
+/// fixed-size pool of worker threads processing jobs in FIFO order
+/// Jobs may block on jobs that were added before them, but never on later ones; the FIFO order then guarantees progress
+/// for any number of threads, including a pool without worker threads where all jobs run inside wait().
+/// A running job can add a nested batch of non-blocking jobs and wait for it with waitNested(), which never picks up
+/// the (possibly blocking) jobs queued in between. Idle workers help with the nested jobs like with any other job.
+class ThreadPool
+{
+public:
+  ThreadPool();
+  ~ThreadPool();
+
+  void create       ( const int numThreads );            ///< numThreads counts the calling thread, i.e. numThreads-1 workers are started
+  void destroy      ();
+
+  int  getNumThreads() const { return m_numThreads; }
+
+  void addJob       ( std::function<void()> job, JobCounter& counter );
+  void wait         ( JobCounter& counter );            ///< processes queued jobs on the calling thread until the batch is done
+  void waitNested   ( JobCounter& counter );            ///< as wait(), but only processes jobs of this batch on the calling thread
+
+private:
+  struct Job
+  {
+    std::function<void()> func;
+    JobCounter*           counter;
+  };
+
+  void xWorkerLoop  ();
+  void xRunJob      ( Job& job, std::unique_lock<std::mutex>& lock );
+
+  int                      m_numThreads;
+  bool                     m_exit;
+  std::vector<std::thread> m_threads;
+  std::deque<Job>          m_jobs;
+  std::mutex               m_mutex;
+  std::condition_variable  m_jobCond;
+  std::condition_variable  m_doneCond;
+};
+
+//! \}
+
+#endif // __THREADPOOL__
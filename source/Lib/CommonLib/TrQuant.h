@@ -84,8 +84,8 @@ public:
 #endif
 
 #if JVET_N0193_LFNST
-  void fwdLfnstNxN( int* src, int* dst, const uint32_t mode, const uint32_t index, const uint32_t size, int zeroOutSize );
-  void invLfnstNxN( int* src, int* dst, const uint32_t mode, const uint32_t index, const uint32_t size, int zeroOutSize );
+  void fwdLfnstNxN( TCoeff* src, TCoeff* dst, const uint32_t mode, const uint32_t index, const uint32_t size, int zeroOutSize );
+  void invLfnstNxN( TCoeff* src, TCoeff* dst, const uint32_t mode, const uint32_t index, const uint32_t size, int zeroOutSize );
 
   uint32_t getLFNSTIntraMode( int wideAngPredMode );
   bool     getTransposeFlag ( uint32_t intraMode  );
@@ -126,6 +126,16 @@ public:
   void    copyState( const TrQuant& other );
 #endif
 
+  /// one-dimensional forward/inverse transforms, indexed by transform type and log2( size ) - 1
+  FwdTrans* m_fwdTrans[NUM_TRANS_TYPE][g_numTransformMatrixSizes];
+  InvTrans* m_invTrans[NUM_TRANS_TYPE][g_numTransformMatrixSizes];
+
+#ifdef TARGET_SIMD_X86
+  void initTrQuantX86( const X86_VEXT vext = read_x86_extension_flags() );
+  template <X86_VEXT vext>
+  void _initTrQuantX86();
+#endif
+
 protected:
   TCoeff*  m_plTempCoeff;
   uint32_t     m_uiMaxTrSize;
@@ -43,6 +43,7 @@
 #endif
 
 #include <vector>
+#include <algorithm>
 #include <utility>
 #include <sstream>
 #include <cstddef>
@@ -223,7 +224,7 @@ typedef std::pair<int, int>  TrCost;
 #endif
 
 #ifndef ENABLE_WPP_PARALLELISM
-#define ENABLE_WPP_PARALLELISM                            0
+#define ENABLE_WPP_PARALLELISM                            1 ///< CTU row parallel encoding (NumWppThreads), runs on the thread pool
 #endif
 #if ENABLE_WPP_PARALLELISM
 #ifndef ENABLE_WPP_STATIC_LINK
@@ -233,13 +234,12 @@ typedef std::pair<int, int>  TrCost;
 
 #endif
 #ifndef ENABLE_SPLIT_PARALLELISM
-#define ENABLE_SPLIT_PARALLELISM                          0
+#define ENABLE_SPLIT_PARALLELISM                          1 ///< split parallel mode decision (NumSplitThreads), runs on the thread pool
 #endif
 #if ENABLE_SPLIT_PARALLELISM
 #define PARL_SPLIT_MAX_NUM_JOBS                           6                             // number of parallel jobs that can be defined and need memory allocated
 #define NUM_RESERVERD_SPLIT_JOBS                        ( PARL_SPLIT_MAX_NUM_JOBS + 1 )  // number of all data structures including the merge thread (0)
 #define PARL_SPLIT_MAX_NUM_THREADS                        PARL_SPLIT_MAX_NUM_JOBS
-#define NUM_SPLIT_THREADS_IF_MSVC                         4
 
 #endif
 
@@ -344,12 +344,17 @@ typedef std::pair<int, int>  TrCost;
 
 // SIMD optimizations
 #define SIMD_ENABLE                                       1
-#define ENABLE_SIMD_OPT                                 ( SIMD_ENABLE && !RExt__HIGH_BIT_DEPTH_SUPPORT )    ///< SIMD optimizations, no impact on RD performance
+#define ENABLE_SIMD_OPT                                 ( SIMD_ENABLE )                                     ///< SIMD optimizations, no impact on RD performance
 #define ENABLE_SIMD_OPT_MCIF                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the interpolation filter, no impact on RD performance
 #define ENABLE_SIMD_OPT_BUFFER                          ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the buffer operations, no impact on RD performance
 #define ENABLE_SIMD_OPT_DIST                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the distortion calculations(SAD,SSE,HADAMARD), no impact on RD performance
-#define ENABLE_SIMD_OPT_AFFINE_ME                       ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for affine ME, no impact on RD performance
+#define ENABLE_SIMD_OPT_AFFINE_ME                       ( 1 && ENABLE_SIMD_OPT && !RExt__HIGH_BIT_DEPTH_SUPPORT ) ///< SIMD optimization for affine ME, no impact on RD performance
 #define ENABLE_SIMD_OPT_ALF                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for ALF
+#define ENABLE_SIMD_OPT_DBF                             ( 1 && ENABLE_SIMD_OPT && !RExt__HIGH_BIT_DEPTH_SUPPORT ) ///< SIMD optimization for the deblocking filter, no impact on RD performance
+#define ENABLE_SIMD_OPT_SAO                             ( 1 && ENABLE_SIMD_OPT && !RExt__HIGH_BIT_DEPTH_SUPPORT ) ///< SIMD optimization for SAO filtering and statistics, no impact on RD performance
+#define ENABLE_SIMD_OPT_TRAFO                           ( 1 && ENABLE_SIMD_OPT && !RExt__HIGH_BIT_DEPTH_SUPPORT ) ///< SIMD optimization for the forward and inverse transforms, no impact on RD performance
+#define ENABLE_SIMD_OPT_INTRAPRED                       ( 1 && ENABLE_SIMD_OPT && !RExt__HIGH_BIT_DEPTH_SUPPORT ) ///< SIMD optimization for the planar, angular and PDPC intra prediction, no impact on RD performance
+#define ENABLE_SIMD_OPT_MIP                             ( 1 && ENABLE_SIMD_OPT && !RExt__HIGH_BIT_DEPTH_SUPPORT ) ///< SIMD optimization for the matrix-based intra prediction, no impact on RD performance
 #if ENABLE_SIMD_OPT_BUFFER
 #define ENABLE_SIMD_OPT_GBI                               1                                                 ///< SIMD optimization for GBi
 #endif
@@ -1566,17 +1571,82 @@ public:
   }
 };
 
-typedef dynamic_cache<struct CodingUnit    > CUCache;
-typedef dynamic_cache<struct PredictionUnit> PUCache;
-typedef dynamic_cache<struct TransformUnit > TUCache;
 
-struct XUCache
+// ---------------------------------------------------------------------------
+// unit arena
+// ---------------------------------------------------------------------------
+
+// Hands out units from contiguous slabs in allocation order and takes them all
+// back at once. Every arena has a single owner (a coding structure), so there
+// is no sharing between threads and no locking on the allocation path.
+template<typename T>
+class unit_arena
 {
-  CUCache cuCache;
-  PUCache puCache;
-  TUCache tuCache;
+  static const size_t MIN_SLAB_SIZE = 4;
+  static const size_t MAX_SLAB_SIZE = 1024;
+
+  struct Slab
+  {
+    T*     units;
+    size_t size;
+  };
+
+  std::vector<Slab> m_slabs;
+  size_t            m_slab;     ///< slab the next unit is taken from
+  size_t            m_pos;      ///< position of the next unit inside that slab
+
+  unit_arena( const unit_arena& ) = delete;
+  unit_arena& operator=( const unit_arena& ) = delete;
+
+public:
+
+  unit_arena() : m_slab( 0 ), m_pos( 0 ) { }
+
+  ~unit_arena()
+  {
+    deleteEntries();
+  }
+
+  void deleteEntries()
+  {
+    for( auto &slab : m_slabs )
+    {
+      delete[] slab.units;
+    }
+
+    m_slabs.clear();
+    m_slab = m_pos = 0;
+  }
+
+  T* get()
+  {
+    if( m_slab < m_slabs.size() && m_pos == m_slabs[m_slab].size )
+    {
+      m_slab++;
+      m_pos = 0;
+    }
+
+    if( m_slab == m_slabs.size() )
+    {
+      // slabs grow geometrically, so small coding structures stay small and large ones need few slabs
+      const size_t size = m_slabs.empty() ? MIN_SLAB_SIZE : std::min( 2 * m_slabs.back().size, MAX_SLAB_SIZE );
+      m_slabs.push_back( Slab{ new T[size], size } );
+    }
+
+    return m_slabs[m_slab].units + m_pos++;
+  }
+
+  /// returns all units handed out since the last release, the units are not destructed and are reused as they are
+  void release()
+  {
+    m_slab = m_pos = 0;
+  }
 };
 
+typedef unit_arena<struct CodingUnit    > CUArena;
+typedef unit_arena<struct PredictionUnit> PUArena;
+typedef unit_arena<struct TransformUnit > TUArena;
+
 #define SIGN(x) ( (x) >= 0 ? 1 : -1 )
 
 #define MAX_NUM_ALF_CLASSES             25
@@ -65,6 +65,16 @@ UnitArea CS::getArea( const CodingStructure &cs, const UnitArea &area, const Cha
 {
   return isDualITree( cs ) ? area.singleChan( chType ) : area;
 }
+
+UnitArea CS::getCtuRowArea( const CodingStructure &cs, const int ctuRow )
+{
+  const PreCalcValues& pcv = *cs.pcv;
+  const int yPos   = ctuRow * pcv.maxCUHeight;
+  const int height = std::min<int>( pcv.maxCUHeight, pcv.lumaHeight - yPos );
+
+  return UnitArea( pcv.chrFormat, Area( 0, yPos, pcv.lumaWidth, height ) );
+}
+
 void CS::setRefinedMotionField(CodingStructure &cs)
 {
   for (CodingUnit *cu : cs.cus)
@@ -976,7 +986,7 @@ AvailableInfo PU::getAvailableInfoLuma(const PredictionUnit &pu)
   for (int uX = 0; uX < numAboveUnits; uX++)
   {
     const Position topPos = puArea.offset(availInfo.maxPosTop, -1);
-    const CodingUnit* pcCUAbove = cs.isDecomp(topPos, CHANNEL_TYPE_LUMA) ? cs.getCURestricted(topPos, *(pu.cu), CHANNEL_TYPE_LUMA) : nullptr;
+    const CodingUnit* pcCUAbove = cs.getDecompCURestricted(topPos, *(pu.cu), CHANNEL_TYPE_LUMA);
     if (!pcCUAbove) { break; }
 
     availInfo.maxPosTop += unitWidth;
@@ -988,7 +998,7 @@ AvailableInfo PU::getAvailableInfoLuma(const PredictionUnit &pu)
   for (int uY = 0; uY < numLeftUnits; uY++)
   {
     const Position leftPos = puArea.offset(-1, availInfo.maxPosLeft);
-    const CodingUnit* pcCULeft = cs.isDecomp(leftPos, CHANNEL_TYPE_LUMA) ? cs.getCURestricted(leftPos, *(pu.cu), CHANNEL_TYPE_LUMA) : nullptr;
+    const CodingUnit* pcCULeft = cs.getDecompCURestricted(leftPos, *(pu.cu), CHANNEL_TYPE_LUMA);
     if (!pcCULeft) { break; }
 
     availInfo.maxPosLeft += unitHeight;
@@ -1329,9 +1339,9 @@ bool PU::addMergeHMVPCand(const CodingStructure &cs, MergeCtx& mrgCtx, bool isCa
     hasPruned[subPuMvpPos] = true;
   }
 #if JVET_N0266_SMALL_BLOCKS
-  auto &lut = ibcFlag ? ( isShared ? cs.motionLut.lutShareIbc : cs.motionLut.lutIbc ) : cs.motionLut.lut;
+  auto &lut = ibcFlag ? ( isShared ? cs.getMotionLut().lutShareIbc : cs.getMotionLut().lutIbc ) : cs.getMotionLut().lut;
 #else
-  auto &lut = ibcFlag ? ( isShared ? cs.motionLut.lutShareIbc : cs.motionLut.lutIbc ) : ( isShared ? cs.motionLut.lutShare : cs.motionLut.lut );
+  auto &lut = ibcFlag ? ( isShared ? cs.getMotionLut().lutShareIbc : cs.getMotionLut().lutIbc ) : ( isShared ? cs.getMotionLut().lutShare : cs.getMotionLut().lut );
 #endif
   int num_avai_candInLUT = (int) lut.size();
 
@@ -2443,13 +2453,10 @@ bool PU::getColocatedMVP(const PredictionUnit &pu, const RefPicList &eRefPicList
 
   RefPicList eColRefPicList = slice.getCheckLDC() ? eRefPicList : RefPicList(slice.getColFromL0Flag());
 
-  const MotionInfo& mi = pColPic->cs->getMotionInfo( pos );
+  const ColMotionField& colField = pColPic->cs->getColMotionField();
+  const unsigned        colIdx   = colField.idx( pos );
 
-  if( !mi.isInter )
-  {
-    return false;
-  }
-  if (mi.isIBCmot)
+  if( !colField.isInter[colIdx] )
   {
     return false;
   }
@@ -2457,12 +2464,12 @@ bool PU::getColocatedMVP(const PredictionUnit &pu, const RefPicList &eRefPicList
   {
     return false;
   }
-  int iColRefIdx = mi.refIdx[eColRefPicList];
+  int iColRefIdx = colField.refIdx[eColRefPicList][colIdx];
 
   if (iColRefIdx < 0)
   {
     eColRefPicList = RefPicList(1 - eColRefPicList);
-    iColRefIdx = mi.refIdx[eColRefPicList];
+    iColRefIdx = colField.refIdx[eColRefPicList][colIdx];
 
     if (iColRefIdx < 0)
     {
@@ -2474,7 +2481,7 @@ bool PU::getColocatedMVP(const PredictionUnit &pu, const RefPicList &eRefPicList
 
   for( const auto s : pColPic->slices )
   {
-    if( s->getIndependentSliceIdx() == mi.sliceIdx )
+    if( s->getIndependentSliceIdx() == colField.sliceIdx[colIdx] )
     {
       pColSlice = s;
       break;
@@ -2495,7 +2502,7 @@ bool PU::getColocatedMVP(const PredictionUnit &pu, const RefPicList &eRefPicList
 
 
   // Scale the vector.
-  Mv cColMv = mi.mv[eColRefPicList];
+  Mv cColMv = colField.mv[eColRefPicList][colIdx];
   cColMv.setHor(roundMvComp(cColMv.getHor()));
   cColMv.setVer(roundMvComp(cColMv.getVer()));
 
@@ -2623,10 +2630,10 @@ void PU::getIbcMVPsEncOnly(PredictionUnit &pu, Mv* MvPred, int& nbPred)
     }
   }
 
-  size_t numAvaiCandInLUT = pu.cs->motionLut.lutIbc.size();
+  size_t numAvaiCandInLUT = pu.cs->getMotionLut().lutIbc.size();
   for (uint32_t cand = 0; cand < numAvaiCandInLUT && nbPred < IBC_NUM_CANDIDATES; cand++)
   {
-    MotionInfo neibMi = pu.cs->motionLut.lutIbc[cand];
+    MotionInfo neibMi = pu.cs->getMotionLut().lutIbc[cand];
     if (isAddNeighborMv(neibMi.bv, mvPred, nbPred))
     {
       mvPred[nbPred++] = neibMi.bv;
@@ -3568,7 +3575,7 @@ void PU::addAMVPHMVPCand(const PredictionUnit &pu, const RefPicList eRefPicList,
   const Slice &slice = *(*pu.cs).slice;
 
   MotionInfo neibMi;
-  auto &lut = CU::isIBC(*pu.cu) ? pu.cs->motionLut.lutIbc : pu.cs->motionLut.lut;
+  auto &lut = CU::isIBC(*pu.cu) ? pu.cs->getMotionLut().lutIbc : pu.cs->getMotionLut().lut;
   int num_avai_candInLUT = (int) lut.size();
   int num_allowedCand = std::min(MAX_NUM_HMVP_AVMPCANDS, num_avai_candInLUT);
 
@@ -4303,12 +4310,13 @@ static bool deriveScaledMotionTemporal( const Slice&      slice,
                                         Mv&         cColMv,
                                         const RefPicList  eFetchRefPicList)
 {
-  const MotionInfo &mi = pColPic->cs->getMotionInfo(colPos);
+  const ColMotionField& colField = pColPic->cs->getColMotionField();
+  const unsigned        colIdx   = colField.idx( colPos );
   const Slice *pColSlice = nullptr;
 
   for (const auto &pSlice : pColPic->slices)
   {
-    if (pSlice->getIndependentSliceIdx() == mi.sliceIdx)
+    if (pSlice->getIndependentSliceIdx() == colField.sliceIdx[colIdx])
     {
       pColSlice = pSlice;
       break;
@@ -4332,12 +4340,12 @@ static bool deriveScaledMotionTemporal( const Slice&      slice,
   // Grab motion and do necessary scaling.{{
   iCurrPOC = slice.getPOC();
 
-  int iColRefIdx = mi.refIdx[eColRefPicList];
+  int iColRefIdx = colField.refIdx[eColRefPicList][colIdx];
 
   if (iColRefIdx < 0 && (slice.getCheckLDC() || bAllowMirrorMV))
   {
     eColRefPicList = RefPicList(1 - eColRefPicList);
-    iColRefIdx = mi.refIdx[eColRefPicList];
+    iColRefIdx = colField.refIdx[eColRefPicList][colIdx];
 
     if (iColRefIdx < 0)
     {
@@ -4356,7 +4364,7 @@ static bool deriveScaledMotionTemporal( const Slice&      slice,
     ///////////////////////////////////////////////////////////////
     iCurrRefPOC = slice.getRefPic(eCurrRefPicList, 0)->getPOC();
     // Scale the vector.
-    cColMv = mi.mv[eColRefPicList];
+    cColMv = colField.mv[eColRefPicList][colIdx];
     cColMv.setHor(roundMvComp(cColMv.getHor()));
     cColMv.setVer(roundMvComp(cColMv.getVer()));
     //pcMvFieldSP[2*iPartition + eCurrRefPicList].getMv();
@@ -4453,9 +4461,9 @@ bool PU::getInterMergeSubPuMvpCand(const PredictionUnit &pu, MergeCtx& mrgCtx, b
   centerPos = Position{ PosType(centerPos.x & mask), PosType(centerPos.y & mask) };
 
   // derivation of center motion parameters from the collocated CU
-  const MotionInfo &mi = pColPic->cs->getMotionInfo(centerPos);
+  const ColMotionField& colField = pColPic->cs->getColMotionField();
 
-  if (mi.isInter && mi.isIBCmot == false)
+  if (colField.isInter[colField.idx(centerPos)])
   {
     mrgCtx.interDirNeighbours[count] = 0;
 
@@ -4503,15 +4511,13 @@ bool PU::getInterMergeSubPuMvpCand(const PredictionUnit &pu, MergeCtx& mrgCtx, b
 
       colPos = Position{ PosType(colPos.x & mask), PosType(colPos.y & mask) };
 
-      const MotionInfo &colMi = pColPic->cs->getMotionInfo(colPos);
-
       MotionInfo mi;
 
       found = false;
       mi.isInter = true;
       mi.sliceIdx = slice.getIndependentSliceIdx();
       mi.isIBCmot = false;
-      if (colMi.isInter && colMi.isIBCmot == false)
+      if (colField.isInter[colField.idx(colPos)])
       {
         for (unsigned currRefListId = 0; currRefListId < (bBSlice ? 2 : 1); currRefListId++)
         {
@@ -48,6 +48,7 @@ namespace CS
 {
   uint64_t getEstBits                   ( const CodingStructure &cs );
   UnitArea getArea                    ( const CodingStructure &cs, const UnitArea &area, const ChannelType chType );
+  UnitArea getCtuRowArea              ( const CodingStructure &cs, const int ctuRow );
   bool   isDualITree                  ( const CodingStructure &cs );
   void   setRefinedMotionField(CodingStructure &cs);
 }
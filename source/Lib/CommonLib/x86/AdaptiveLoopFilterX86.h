@@ -47,6 +47,201 @@
 #include <immintrin.h>
 #endif
 
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+// ====================================================================================================================
+// High bit depth filter: Pel is a 32 bit type, a row of a 4x4 block is filtered in one register
+// ====================================================================================================================
+
+// the scalar clipping passes the samples as short values
+static inline __m128i simdAlfTrunc16( const __m128i& val )
+{
+  return _mm_srai_epi32( _mm_slli_epi32( val, 16 ), 16 );
+}
+
+template<X86_VEXT vext, AlfFilterType filtType>
+static void simdFilterBlk_HBD( AlfClassifier** classifier, const PelUnitBuf &recDst, const CPelUnitBuf& recSrc, const Area& blk, const ComponentID compId, short* filterSet, short* fClipSet, const ClpRng& clpRng, CodingStructure& cs, int vbCTUHeight, int vbPos )
+{
+  // taps as pairs of ( row, column offset ), rows 1, 3, 5 lie below and rows 2, 4, 6 above the current row
+  static const int tapsAlf7[12][4] = { { 5, 0, 6, 0 }, { 3, 1, 4, -1 }, { 3, 0, 4, 0 }, { 3, -1, 4, 1 }, { 1, 2, 2, -2 }, { 1, 1, 2, -1 },
+                                       { 1, 0, 2, 0 }, { 1, -1, 2, 1 }, { 1, -2, 2, 2 }, { 0, 3, 0, -3 }, { 0, 2, 0, -2 }, { 0, 1, 0, -1 } };
+  static const int tapsAlf5[6][4]  = { { 3, 0, 4, 0 }, { 1, 1, 2, -1 }, { 1, 0, 2, 0 }, { 1, -1, 2, 1 }, { 0, 2, 0, -2 }, { 0, 1, 0, -1 } };
+  static const int transposeAlf7[4][12] = { { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 }, { 9, 4, 10, 8, 1, 5, 11, 7, 3, 0, 2, 6 },
+                                            { 0, 3, 2, 1, 8, 7, 6, 5, 4, 9, 10, 11 }, { 9, 8, 10, 4, 3, 7, 11, 5, 1, 0, 2, 6 } };
+  static const int transposeAlf5[4][6]  = { { 0, 1, 2, 3, 4, 5 }, { 4, 1, 5, 3, 0, 2 }, { 0, 3, 2, 1, 4, 5 }, { 4, 3, 5, 1, 0, 2 } };
+
+  const int numTaps = filtType == ALF_FILTER_7 ? 12 : 6;
+  const int ( *taps )[4] = filtType == ALF_FILTER_7 ? tapsAlf7 : tapsAlf5;
+
+  const bool bChroma = isChroma( compId );
+  if( bChroma )
+  {
+    CHECK( filtType != 0, "Chroma needs to have filtType == 0" );
+  }
+
+  const SPS*     sps = cs.slice->getSPS();
+  bool isDualTree = CS::isDualITree( cs );
+  bool isPCMFilterDisabled = sps->getPCMFilterDisableFlag();
+  ChromaFormat nChromaFormat = sps->getChromaFormatIdc();
+  const CPelBuf srcLuma = recSrc.get( compId );
+  PelBuf dstLuma = recDst.get( compId );
+
+  const int srcStride = srcLuma.stride;
+  const int dstStride = dstLuma.stride;
+
+  const int startHeight = blk.y;
+  const int endHeight = blk.y + blk.height;
+  const int startWidth = blk.x;
+  const int endWidth = blk.x + blk.width;
+
+  const int shift = AdaptiveLoopFilter::m_NUM_BITS - 1;
+  const int clsSizeY = 4;
+  const int clsSizeX = 4;
+
+  CHECK( startHeight % clsSizeY, "Wrong startHeight in filtering" );
+  CHECK( startWidth % clsSizeX, "Wrong startWidth in filtering" );
+  CHECK( ( endHeight - startHeight ) % clsSizeY, "Wrong endHeight in filtering" );
+  CHECK( ( endWidth - startWidth ) % clsSizeX, "Wrong endWidth in filtering" );
+
+  const __m128i mmOffset = _mm_set1_epi32( 1 << ( shift - 1 ) );
+  const __m128i mmMin    = _mm_set1_epi32( clpRng.min );
+  const __m128i mmMax    = _mm_set1_epi32( clpRng.max );
+
+  short *coef = filterSet;
+  short *clip = fClipSet;
+  int transposeIdx = 0;
+  bool pcmFlags2x2[4] = { 0, 0, 0, 0 };
+  __m128i mmCoeff[12];
+  __m128i mmClip[12];
+
+  const Pel* srcRow = srcLuma.buf + startHeight * srcStride + startWidth;
+  Pel* dstRow = dstLuma.buf + startHeight * dstStride + startWidth;
+
+  for( int i = 0; i < endHeight - startHeight; i += clsSizeY )
+  {
+    AlfClassifier *pClass = bChroma ? nullptr : classifier[startHeight + i] + startWidth;
+
+    for( int j = 0; j < endWidth - startWidth; j += clsSizeX )
+    {
+      if( !bChroma )
+      {
+        AlfClassifier& cl = pClass[j];
+        transposeIdx = cl.transposeIdx;
+        if( isPCMFilterDisabled && cl.classIdx == AdaptiveLoopFilter::m_ALF_UNUSED_CLASSIDX && transposeIdx == AdaptiveLoopFilter::m_ALF_UNUSED_TRANSPOSIDX )
+        {
+          continue;
+        }
+        coef = filterSet + cl.classIdx * MAX_NUM_ALF_LUMA_COEFF;
+        clip = fClipSet + cl.classIdx * MAX_NUM_ALF_LUMA_COEFF;
+      }
+      else if( isPCMFilterDisabled )
+      {
+        bool *flags = pcmFlags2x2;
+        // check which chroma 2x2 blocks use PCM
+        // chroma PCM may not be aligned with 4x4 ALF processing grid
+        for( int blkY = 0; blkY < 4; blkY += 2 )
+        {
+          for( int blkX = 0; blkX < 4; blkX += 2 )
+          {
+            Position pos( j + startWidth + blkX, i + startHeight + blkY );
+            CodingUnit* cu = isDualTree ? cs.getCU( pos, CH_C ) : cs.getCU( recalcPosition( nChromaFormat, CH_C, CH_L, pos ), CH_L );
+            *flags++ = cu->ipcm ? 1 : 0;
+          }
+        }
+
+        // skip entire 4x4 if all chroma 2x2 blocks use PCM
+        if( pcmFlags2x2[0] && pcmFlags2x2[1] && pcmFlags2x2[2] && pcmFlags2x2[3] )
+        {
+          continue;
+        }
+      }
+
+      const int* transpose = filtType == ALF_FILTER_7 ? transposeAlf7[transposeIdx] : transposeAlf5[transposeIdx];
+      for( int k = 0; k < numTaps; k++ )
+      {
+        mmCoeff[k] = _mm_set1_epi32( coef[transpose[k]] );
+        mmClip [k] = _mm_set1_epi32( clip[transpose[k]] );
+      }
+
+      for( int ii = 0; ii < clsSizeY; ii++ )
+      {
+        const Pel* pImg[7];
+        pImg[0] = srcRow + j + ii * srcStride;
+        pImg[1] = pImg[0] + srcStride;
+        pImg[2] = pImg[0] - srcStride;
+        pImg[3] = pImg[1] + srcStride;
+        pImg[4] = pImg[2] - srcStride;
+        pImg[5] = pImg[3] + srcStride;
+        pImg[6] = pImg[4] - srcStride;
+
+        const int yVb = ( startHeight + i + ii ) % vbCTUHeight;
+        if( yVb < vbPos && yVb >= vbPos - ( bChroma ? 2 : 4 ) ) //above
+        {
+          pImg[1] = ( yVb == vbPos - 1 ) ? pImg[0] : pImg[1];
+          pImg[3] = ( yVb >= vbPos - 2 ) ? pImg[1] : pImg[3];
+          pImg[5] = ( yVb >= vbPos - 3 ) ? pImg[3] : pImg[5];
+
+          pImg[2] = ( yVb == vbPos - 1 ) ? pImg[0] : pImg[2];
+          pImg[4] = ( yVb >= vbPos - 2 ) ? pImg[2] : pImg[4];
+          pImg[6] = ( yVb >= vbPos - 3 ) ? pImg[4] : pImg[6];
+        }
+        else if( yVb >= vbPos && yVb <= vbPos + ( bChroma ? 1 : 3 ) ) //bottom
+        {
+          pImg[2] = ( yVb == vbPos ) ? pImg[0] : pImg[2];
+          pImg[4] = ( yVb <= vbPos + 1 ) ? pImg[2] : pImg[4];
+          pImg[6] = ( yVb <= vbPos + 2 ) ? pImg[4] : pImg[6];
+
+          pImg[1] = ( yVb == vbPos ) ? pImg[0] : pImg[1];
+          pImg[3] = ( yVb <= vbPos + 1 ) ? pImg[1] : pImg[3];
+          pImg[5] = ( yVb <= vbPos + 2 ) ? pImg[3] : pImg[5];
+        }
+
+        const __m128i mmCurr   = _mm_loadu_si128( ( const __m128i* ) pImg[0] );
+        const __m128i mmCurr16 = simdAlfTrunc16( mmCurr );
+        __m128i mmSum = _mm_setzero_si128();
+
+        for( int k = 0; k < numTaps; k++ )
+        {
+          const __m128i mmVal0 = simdAlfTrunc16( _mm_loadu_si128( ( const __m128i* ) ( pImg[taps[k][0]] + taps[k][1] ) ) );
+          const __m128i mmVal1 = simdAlfTrunc16( _mm_loadu_si128( ( const __m128i* ) ( pImg[taps[k][2]] + taps[k][3] ) ) );
+          const __m128i mmNegClip = _mm_sub_epi32( _mm_setzero_si128(), mmClip[k] );
+
+          __m128i mmDiff0 = _mm_min_epi32( mmClip[k], _mm_max_epi32( mmNegClip, _mm_sub_epi32( mmVal0, mmCurr16 ) ) );
+          __m128i mmDiff1 = _mm_min_epi32( mmClip[k], _mm_max_epi32( mmNegClip, _mm_sub_epi32( mmVal1, mmCurr16 ) ) );
+
+          mmSum = _mm_add_epi32( mmSum, _mm_mullo_epi32( mmCoeff[k], _mm_add_epi32( mmDiff0, mmDiff1 ) ) );
+        }
+
+        mmSum = _mm_srai_epi32( _mm_add_epi32( mmSum, mmOffset ), shift );
+        mmSum = _mm_add_epi32( mmSum, mmCurr );
+        mmSum = _mm_min_epi32( mmMax, _mm_max_epi32( mmMin, mmSum ) );
+
+        Pel* pRec = dstRow + j + ii * dstStride;
+        if( bChroma && isPCMFilterDisabled )
+        {
+          // skip 2x2 PCM chroma blocks
+          const bool* flags = &pcmFlags2x2[2 * ( ii >> 1 )];
+          const __m128i mmSkip = _mm_set_epi32( -flags[1], -flags[1], -flags[0], -flags[0] );
+          mmSum = _mm_blendv_epi8( mmSum, _mm_loadu_si128( ( const __m128i* ) pRec ), mmSkip );
+        }
+        _mm_storeu_si128( ( __m128i* ) pRec, mmSum );
+      }
+    }
+
+    srcRow += srcStride * clsSizeY;
+    dstRow += dstStride * clsSizeY;
+  }
+}
+
+template <X86_VEXT vext>
+void AdaptiveLoopFilter::_initAdaptiveLoopFilterX86()
+{
+  // the classification keeps its core function in the high bit depth build
+  m_filter5x5Blk = simdFilterBlk_HBD<vext, ALF_FILTER_5>;
+  m_filter7x7Blk = simdFilterBlk_HBD<vext, ALF_FILTER_7>;
+}
+
+#else
+
 template<X86_VEXT vext>
 #if JVET_N0180_ALF_LINE_BUFFER_REDUCTION  
 static void simdDeriveClassificationBlk(AlfClassifier** classifier, int** laplacian[NUM_DIRECTIONS], const CPelBuf& srcLuma, const Area& blk, const int shift, int vbCTUHeight, int vbPos)
@@ -69,7 +264,7 @@ static void simdDeriveClassificationBlk(AlfClassifier** classifier, int** laplac
   const int posY = blk.pos().y;
   const int start_height1 = posY - flplusOne;
 
-  static uint16_t _temp[( AdaptiveLoopFilter::m_CLASSIFICATION_BLK_SIZE + 4 ) >> 1][AdaptiveLoopFilter::m_CLASSIFICATION_BLK_SIZE + 4];
+  uint16_t _temp[( AdaptiveLoopFilter::m_CLASSIFICATION_BLK_SIZE + 4 ) >> 1][AdaptiveLoopFilter::m_CLASSIFICATION_BLK_SIZE + 4];
 
   for( int i = 0; i < imgHExtended - 2; i += 2 )
   {
@@ -1959,6 +2154,8 @@ void AdaptiveLoopFilter::_initAdaptiveLoopFilterX86()
   m_filter7x7Blk = simdFilter7x7Blk<vext>;
 }
 
+#endif //!RExt__HIGH_BIT_DEPTH_SUPPORT
+
 template void AdaptiveLoopFilter::_initAdaptiveLoopFilterX86<SIMDX86>();
 #endif //#ifdef TARGET_SIMD_X86
 //! \}
@@ -46,6 +46,7 @@
 //! \ingroup CommonLib
 //! \{
 
+#if ENABLE_SIMD_OPT_AFFINE_ME
 #ifdef TARGET_SIMD_X86
 
 #if defined _MSC_VER
@@ -319,4 +320,5 @@ void AffineGradientSearch::_initAffineGradientSearchX86()
 template void AffineGradientSearch::_initAffineGradientSearchX86<SIMDX86>();
 
 #endif //#ifdef TARGET_SIMD_X86
+#endif
 //! \}
@@ -48,12 +48,41 @@
 #if ENABLE_SIMD_OPT_BUFFER
 #ifdef TARGET_SIMD_X86
 
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
 template< X86_VEXT vext, int W >
 void addAvg_SSE( const int16_t* src0, int src0Stride, const int16_t* src1, int src1Stride, int16_t *dst, int dstStride, int width, int height, int shift, int offset, const ClpRng& clpRng )
 {
   if( W == 8 )
   {
-    // TODO: AVX2 impl
+    if( vext >= AVX512 && ( width & 15 ) == 0 )
+    {
+#ifdef USE_AVX512
+      __m512i voffset  = _mm512_set1_epi32( offset );
+      __m256i vibdimin = _mm256_set1_epi16( clpRng.min );
+      __m256i vibdimax = _mm256_set1_epi16( clpRng.max );
+
+      for( int row = 0; row < height; row++ )
+      {
+        for( int col = 0; col < width; col += 16 )
+        {
+          __m512i vsum = _mm512_cvtepi16_epi32( _mm256_loadu_si256( ( const __m256i * )&src0[col] ) );
+          __m512i vdst = _mm512_cvtepi16_epi32( _mm256_loadu_si256( ( const __m256i * )&src1[col] ) );
+          vsum = _mm512_add_epi32 ( vsum, vdst );
+          vsum = _mm512_add_epi32 ( vsum, voffset );
+          vsum = _mm512_srai_epi32( vsum, shift );
+
+          __m256i vres = _mm512_cvtsepi32_epi16( vsum );
+          vres = _mm256_min_epi16( vibdimax, _mm256_max_epi16( vibdimin, vres ) );
+          _mm256_storeu_si256( ( __m256i * )&dst[col], vres );
+        }
+
+        src0 += src0Stride;
+        src1 += src1Stride;
+        dst  +=  dstStride;
+      }
+#endif
+    }
+    else
     {
       __m128i vzero    = _mm_setzero_si128();
       __m128i voffset  = _mm_set1_epi32( offset );
@@ -173,6 +202,90 @@ void copyBufferSimd(Pel *src, int srcStride, Pel *dst, int dstStride, int width,
 }
 
 
+template<X86_VEXT vext>
+uint64_t calcSSE_SSE(const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, int width, int height, int shift)
+{
+  // the squared differences of 16 bit samples fit into 32 bits, they are widened to 64 bits before they are summed up
+  const __m128i vzero = _mm_setzero_si128();
+  __m128i vsum = vzero;
+#ifdef USE_AVX2
+  const __m256i vzero16 = _mm256_setzero_si256();
+  __m256i vsum16 = vzero16;
+#endif
+#ifdef USE_AVX512
+  const __m512i vzero32 = _mm512_setzero_si512();
+  __m512i vsum32 = vzero32;
+#endif
+  uint64_t sum = 0;
+
+  for (int y = 0; y < height; y++)
+  {
+    int x = 0;
+    if (shift == 0)
+    {
+#ifdef USE_AVX512
+      for (; x + 32 <= width; x += 32)
+      {
+        const __m512i vdiff = _mm512_sub_epi16(_mm512_loadu_si512((const __m512i*) &src0[x]), _mm512_loadu_si512((const __m512i*) &src1[x]));
+        const __m512i vsqr  = _mm512_madd_epi16(vdiff, vdiff);
+        vsum32 = _mm512_add_epi64(vsum32, _mm512_unpacklo_epi32(vsqr, vzero32));
+        vsum32 = _mm512_add_epi64(vsum32, _mm512_unpackhi_epi32(vsqr, vzero32));
+      }
+#endif
+#ifdef USE_AVX2
+      for (; x + 16 <= width; x += 16)
+      {
+        const __m256i vdiff = _mm256_sub_epi16(_mm256_loadu_si256((const __m256i*) &src0[x]), _mm256_loadu_si256((const __m256i*) &src1[x]));
+        const __m256i vsqr  = _mm256_madd_epi16(vdiff, vdiff);
+        vsum16 = _mm256_add_epi64(vsum16, _mm256_unpacklo_epi32(vsqr, vzero16));
+        vsum16 = _mm256_add_epi64(vsum16, _mm256_unpackhi_epi32(vsqr, vzero16));
+      }
+#endif
+      for (; x + 8 <= width; x += 8)
+      {
+        const __m128i vdiff = _mm_sub_epi16(_mm_loadu_si128((const __m128i*) &src0[x]), _mm_loadu_si128((const __m128i*) &src1[x]));
+        const __m128i vsqr  = _mm_madd_epi16(vdiff, vdiff);
+        vsum = _mm_add_epi64(vsum, _mm_unpacklo_epi32(vsqr, vzero));
+        vsum = _mm_add_epi64(vsum, _mm_unpackhi_epi32(vsqr, vzero));
+      }
+    }
+    else
+    {
+      for (; x + 8 <= width; x += 8)
+      {
+        const __m128i vdiff = _mm_sub_epi16(_mm_loadu_si128((const __m128i*) &src0[x]), _mm_loadu_si128((const __m128i*) &src1[x]));
+        const __m128i vlo   = _mm_mullo_epi16(vdiff, vdiff);
+        const __m128i vhi   = _mm_mulhi_epi16(vdiff, vdiff);
+        const __m128i vsqr0 = _mm_srli_epi32(_mm_unpacklo_epi16(vlo, vhi), shift);
+        const __m128i vsqr1 = _mm_srli_epi32(_mm_unpackhi_epi16(vlo, vhi), shift);
+        vsum = _mm_add_epi64(vsum, _mm_unpacklo_epi32(vsqr0, vzero));
+        vsum = _mm_add_epi64(vsum, _mm_unpackhi_epi32(vsqr0, vzero));
+        vsum = _mm_add_epi64(vsum, _mm_unpacklo_epi32(vsqr1, vzero));
+        vsum = _mm_add_epi64(vsum, _mm_unpackhi_epi32(vsqr1, vzero));
+      }
+    }
+    for (; x < width; x++)
+    {
+      const int diff = src0[x] - src1[x];
+      sum += uint64_t((diff * diff) >> shift);
+    }
+    src0 += src0Stride;
+    src1 += src1Stride;
+  }
+
+#ifdef USE_AVX512
+  vsum16 = _mm256_add_epi64(vsum16, _mm512_castsi512_si256(vsum32));
+  vsum16 = _mm256_add_epi64(vsum16, _mm512_extracti64x4_epi64(vsum32, 1));
+#endif
+#ifdef USE_AVX2
+  vsum = _mm_add_epi64(vsum, _mm256_castsi256_si128(vsum16));
+  vsum = _mm_add_epi64(vsum, _mm256_extracti128_si256(vsum16, 1));
+#endif
+  uint64_t lanes[2];
+  _mm_storeu_si128((__m128i*) lanes, vsum);
+  return sum + lanes[0] + lanes[1];
+}
+
 template<X86_VEXT vext>
 void paddingSimd(Pel *dst, int stride, int width, int height, int padSize)
 {
@@ -248,6 +361,30 @@ void paddingSimd(Pel *dst, int stride, int width, int height, int padSize)
 template< X86_VEXT vext >
 void addBIOAvg4_SSE(const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, Pel *dst, int dstStride, const Pel *gradX0, const Pel *gradX1, const Pel *gradY0, const Pel*gradY1, int gradStride, int width, int height, int tmpx, int tmpy, int shift, int offset, const ClpRng& clpRng)
 {
+#ifdef USE_AVX512
+  if( vext >= AVX512 && width == 4 && height == 4 )
+  {
+    // the whole 4x4 sub-block is processed at once, one row per 64 bit
+#define LOAD4x4( ptr, stride ) _mm256_set_epi64x( *( const int64_t* )( ptr + 3 * stride ), *( const int64_t* )( ptr + 2 * stride ), *( const int64_t* )( ptr + stride ), *( const int64_t* )( ptr ) )
+    __m256i vgx = _mm256_sub_epi16( LOAD4x4( gradX0, gradStride ), LOAD4x4( gradX1, gradStride ) );
+    __m256i vgy = _mm256_sub_epi16( LOAD4x4( gradY0, gradStride ), LOAD4x4( gradY1, gradStride ) );
+    __m512i vsum = _mm512_add_epi32( _mm512_mullo_epi32( _mm512_cvtepi16_epi32( vgx ), _mm512_set1_epi32( ( int16_t ) tmpx ) ),
+                                     _mm512_mullo_epi32( _mm512_cvtepi16_epi32( vgy ), _mm512_set1_epi32( ( int16_t ) tmpy ) ) );
+    vsum = _mm512_srai_epi32( _mm512_add_epi32( vsum, _mm512_set1_epi32( 1 ) ), 1 );
+    vsum = _mm512_add_epi32( vsum, _mm512_cvtepi16_epi32( LOAD4x4( src0, src0Stride ) ) );
+    vsum = _mm512_add_epi32( vsum, _mm512_cvtepi16_epi32( LOAD4x4( src1, src1Stride ) ) );
+    vsum = _mm512_srai_epi32( _mm512_add_epi32( vsum, _mm512_set1_epi32( offset ) ), shift );
+#undef LOAD4x4
+
+    __m256i vres = _mm512_cvtsepi32_epi16( vsum );
+    vres = _mm256_min_epi16( _mm256_set1_epi16( clpRng.max ), _mm256_max_epi16( _mm256_set1_epi16( clpRng.min ), vres ) );
+    _mm_storel_epi64( ( __m128i * )( dst ),                 _mm256_castsi256_si128( vres ) );
+    _mm_storeh_pd   ( ( double * )( dst + dstStride ),     _mm_castsi128_pd( _mm256_castsi256_si128( vres ) ) );
+    _mm_storel_epi64( ( __m128i * )( dst + 2 * dstStride ), _mm256_extracti128_si256( vres, 1 ) );
+    _mm_storeh_pd   ( ( double * )( dst + 3 * dstStride ), _mm_castsi128_pd( _mm256_extracti128_si256( vres, 1 ) ) );
+    return;
+  }
+#endif
   __m128i mm_tmpx = _mm_unpacklo_epi64(_mm_set1_epi16(tmpx), _mm_set1_epi16(tmpy));
   __m128i mm_boffset = _mm_set1_epi32(1);
   __m128i mm_offset = _mm_set1_epi32(offset);
@@ -493,6 +630,8 @@ void calcBIOPar_SSE(const Pel* srcY0Temp, const Pel* srcY1Temp, const Pel* gradX
   }
 }
 
+#endif
+
 template< X86_VEXT vext >
 void calcBlkGradient_SSE(int sx, int sy, int     *arraysGx2, int     *arraysGxGy, int     *arraysGxdI, int     *arraysGy2, int     *arraysGydI, int     &sGx2, int     &sGy2, int     &sGxGy, int     &sGxdI, int     &sGydI, int width, int height, int unitSize)
 {
@@ -557,6 +696,434 @@ void calcBlkGradient_SSE(int sx, int sy, int     *arraysGx2, int     *arraysGxGy
   sGydI = _mm_cvtsi128_si32(mmGydITotal);
 }
 
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+// ====================================================================================================================
+// High bit depth kernels: Pel is a 32 bit type, every sample occupies one 32 bit lane
+// ====================================================================================================================
+
+static inline __m128i rightShiftHBD( const __m128i& v, const int shift )
+{
+  return shift >= 0 ? _mm_sra_epi32( v, _mm_cvtsi32_si128( shift ) ) : _mm_sll_epi32( v, _mm_cvtsi32_si128( -shift ) );
+}
+
+template< X86_VEXT vext, int W >
+void addAvg_HBD( const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, Pel *dst, int dstStride, int width, int height, int shift, int offset, const ClpRng& clpRng )
+{
+  const __m128i vshift = _mm_cvtsi32_si128( shift );
+
+  if( W == 8 && vext >= AVX2 )
+  {
+#ifdef USE_AVX2
+    const __m256i voffset  = _mm256_set1_epi32( offset );
+    const __m256i vibdimin = _mm256_set1_epi32( clpRng.min );
+    const __m256i vibdimax = _mm256_set1_epi32( clpRng.max );
+
+    for( int row = 0; row < height; row++ )
+    {
+      for( int col = 0; col < width; col += 8 )
+      {
+        __m256i vsum = _mm256_loadu_si256( ( const __m256i * )&src0[col] );
+        vsum = _mm256_add_epi32( vsum, _mm256_loadu_si256( ( const __m256i * )&src1[col] ) );
+        vsum = _mm256_sra_epi32( _mm256_add_epi32( vsum, voffset ), vshift );
+        vsum = _mm256_min_epi32( vibdimax, _mm256_max_epi32( vibdimin, vsum ) );
+        _mm256_storeu_si256( ( __m256i * )&dst[col], vsum );
+      }
+
+      src0 += src0Stride;
+      src1 += src1Stride;
+      dst  +=  dstStride;
+    }
+#endif
+  }
+  else
+  {
+    const __m128i voffset  = _mm_set1_epi32( offset );
+    const __m128i vibdimin = _mm_set1_epi32( clpRng.min );
+    const __m128i vibdimax = _mm_set1_epi32( clpRng.max );
+
+    for( int row = 0; row < height; row++ )
+    {
+      for( int col = 0; col < width; col += 4 )
+      {
+        __m128i vsum = _mm_loadu_si128( ( const __m128i * )&src0[col] );
+        vsum = _mm_add_epi32( vsum, _mm_loadu_si128( ( const __m128i * )&src1[col] ) );
+        vsum = _mm_sra_epi32( _mm_add_epi32( vsum, voffset ), vshift );
+        vsum = _mm_min_epi32( vibdimax, _mm_max_epi32( vibdimin, vsum ) );
+        _mm_storeu_si128( ( __m128i * )&dst[col], vsum );
+      }
+
+      src0 += src0Stride;
+      src1 += src1Stride;
+      dst  +=  dstStride;
+    }
+  }
+}
+
+template< X86_VEXT vext, int W >
+void reco_HBD( const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, Pel *dst, int dstStride, int width, int height, const ClpRng& clpRng )
+{
+  if( W == 8 && vext >= AVX2 )
+  {
+#ifdef USE_AVX2
+    const __m256i vbdmin = _mm256_set1_epi32( clpRng.min );
+    const __m256i vbdmax = _mm256_set1_epi32( clpRng.max );
+
+    for( int row = 0; row < height; row++ )
+    {
+      for( int col = 0; col < width; col += 8 )
+      {
+        __m256i vdest = _mm256_loadu_si256( ( const __m256i * )&src0[col] );
+        vdest = _mm256_add_epi32( vdest, _mm256_loadu_si256( ( const __m256i * )&src1[col] ) );
+        vdest = _mm256_min_epi32( vbdmax, _mm256_max_epi32( vbdmin, vdest ) );
+        _mm256_storeu_si256( ( __m256i * )&dst[col], vdest );
+      }
+
+      src0 += src0Stride;
+      src1 += src1Stride;
+      dst  +=  dstStride;
+    }
+#endif
+  }
+  else
+  {
+    const __m128i vbdmin = _mm_set1_epi32( clpRng.min );
+    const __m128i vbdmax = _mm_set1_epi32( clpRng.max );
+
+    for( int row = 0; row < height; row++ )
+    {
+      for( int col = 0; col < width; col += 4 )
+      {
+        __m128i vdest = _mm_loadu_si128( ( const __m128i * )&src0[col] );
+        vdest = _mm_add_epi32( vdest, _mm_loadu_si128( ( const __m128i * )&src1[col] ) );
+        vdest = _mm_min_epi32( vbdmax, _mm_max_epi32( vbdmin, vdest ) );
+        _mm_storeu_si128( ( __m128i * )&dst[col], vdest );
+      }
+
+      src0 += src0Stride;
+      src1 += src1Stride;
+      dst  +=  dstStride;
+    }
+  }
+}
+
+template< X86_VEXT vext >
+void addBIOAvg4_HBD( const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, Pel *dst, int dstStride, const Pel *gradX0, const Pel *gradX1, const Pel *gradY0, const Pel*gradY1, int gradStride, int width, int height, int tmpx, int tmpy, int shift, int offset, const ClpRng& clpRng )
+{
+  const __m128i mmTmpx   = _mm_set1_epi32( tmpx );
+  const __m128i mmTmpy   = _mm_set1_epi32( tmpy );
+  const __m128i mmOne    = _mm_set1_epi32( 1 );
+  const __m128i mmOffset = _mm_set1_epi32( offset );
+  const __m128i vibdimin = _mm_set1_epi32( clpRng.min );
+  const __m128i vibdimax = _mm_set1_epi32( clpRng.max );
+
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x += 4 )
+    {
+      __m128i mmGradX = _mm_sub_epi32( _mm_loadu_si128( ( const __m128i * )( gradX0 + x ) ), _mm_loadu_si128( ( const __m128i * )( gradX1 + x ) ) );
+      __m128i mmGradY = _mm_sub_epi32( _mm_loadu_si128( ( const __m128i * )( gradY0 + x ) ), _mm_loadu_si128( ( const __m128i * )( gradY1 + x ) ) );
+      __m128i mmB     = _mm_add_epi32( _mm_mullo_epi32( mmTmpx, mmGradX ), _mm_mullo_epi32( mmTmpy, mmGradY ) );
+      mmB             = _mm_srai_epi32( _mm_add_epi32( mmB, mmOne ), 1 );
+
+      __m128i mmSum   = _mm_add_epi32( _mm_loadu_si128( ( const __m128i * )( src0 + x ) ), _mm_loadu_si128( ( const __m128i * )( src1 + x ) ) );
+      mmSum           = rightShiftHBD( _mm_add_epi32( _mm_add_epi32( mmSum, mmB ), mmOffset ), shift );
+      // the core function truncates the sum to 16 bits before clipping
+      mmSum           = _mm_srai_epi32( _mm_slli_epi32( mmSum, 16 ), 16 );
+      mmSum           = _mm_min_epi32( vibdimax, _mm_max_epi32( vibdimin, mmSum ) );
+      _mm_storeu_si128( ( __m128i * )( dst + x ), mmSum );
+    }
+
+    dst    += dstStride;
+    src0   += src0Stride;
+    src1   += src1Stride;
+    gradX0 += gradStride;
+    gradX1 += gradStride;
+    gradY0 += gradStride;
+    gradY1 += gradStride;
+  }
+}
+
+template< X86_VEXT vext >
+void gradFilter_HBD( Pel* src, int srcStride, int width, int height, int gradStride, Pel* gradX, Pel* gradY, const int bitDepth )
+{
+  Pel* srcTmp   = src + srcStride + 1;
+  Pel* gradXTmp = gradX + gradStride + 1;
+  Pel* gradYTmp = gradY + gradStride + 1;
+
+  int widthInside  = width - 2 * BIO_EXTEND_SIZE;
+  int heightInside = height - 2 * BIO_EXTEND_SIZE;
+#if JVET_N0325_BDOF
+  int shift1 = std::max<int>( 6, bitDepth - 6 );
+#else
+  int shift1 = std::max<int>( 2, ( 14 - bitDepth ) );
+#endif
+  const __m128i mmShift1 = _mm_cvtsi32_si128( shift1 );
+
+  assert( ( widthInside & 3 ) == 0 );
+
+  for( int y = 0; y < heightInside; y++ )
+  {
+    for( int x = 0; x < widthInside; x += 4 )
+    {
+      __m128i mmPixTop    = _mm_loadu_si128( ( __m128i* )( srcTmp + x - srcStride ) );
+      __m128i mmPixBottom = _mm_loadu_si128( ( __m128i* )( srcTmp + x + srcStride ) );
+      __m128i mmPixLeft   = _mm_loadu_si128( ( __m128i* )( srcTmp + x - 1 ) );
+      __m128i mmPixRight  = _mm_loadu_si128( ( __m128i* )( srcTmp + x + 1 ) );
+
+      _mm_storeu_si128( ( __m128i * )( gradYTmp + x ), _mm_sra_epi32( _mm_sub_epi32( mmPixBottom, mmPixTop ), mmShift1 ) );
+      _mm_storeu_si128( ( __m128i * )( gradXTmp + x ), _mm_sra_epi32( _mm_sub_epi32( mmPixRight, mmPixLeft ), mmShift1 ) );
+    }
+
+    gradXTmp += gradStride;
+    gradYTmp += gradStride;
+    srcTmp   += srcStride;
+  }
+
+  gradXTmp = gradX + gradStride + 1;
+  gradYTmp = gradY + gradStride + 1;
+  for( int y = 0; y < heightInside; y++ )
+  {
+    gradXTmp[-1]          = gradXTmp[0];
+    gradXTmp[widthInside] = gradXTmp[widthInside - 1];
+    gradXTmp += gradStride;
+
+    gradYTmp[-1]          = gradYTmp[0];
+    gradYTmp[widthInside] = gradYTmp[widthInside - 1];
+    gradYTmp += gradStride;
+  }
+
+  gradXTmp = gradX + gradStride;
+  gradYTmp = gradY + gradStride;
+  ::memcpy( gradXTmp - gradStride, gradXTmp, sizeof( Pel ) * ( width ) );
+  ::memcpy( gradXTmp + heightInside * gradStride, gradXTmp + ( heightInside - 1 ) * gradStride, sizeof( Pel ) * ( width ) );
+  ::memcpy( gradYTmp - gradStride, gradYTmp, sizeof( Pel ) * ( width ) );
+  ::memcpy( gradYTmp + heightInside * gradStride, gradYTmp + ( heightInside - 1 ) * gradStride, sizeof( Pel ) * ( width ) );
+}
+
+template< X86_VEXT vext >
+void calcBIOPar_HBD( const Pel* srcY0Temp, const Pel* srcY1Temp, const Pel* gradX0, const Pel* gradX1, const Pel* gradY0, const Pel* gradY1, int* dotProductTemp1, int* dotProductTemp2, int* dotProductTemp3, int* dotProductTemp5, int* dotProductTemp6, const int src0Stride, const int src1Stride, const int gradStride, const int widthG, const int heightG, const int bitDepth )
+{
+#if JVET_N0325_BDOF
+  int shift4 = std::max<int>( 4, ( bitDepth - 8 ) );
+  int shift5 = std::max<int>( 1, ( bitDepth - 11 ) );
+#else
+  int shift4 = std::min<int>( 8, ( bitDepth - 4 ) );
+  int shift5 = std::min<int>( 5, ( bitDepth - 7 ) );
+#endif
+  const __m128i mmShift4 = _mm_cvtsi32_si128( shift4 );
+  const __m128i mmShift5 = _mm_cvtsi32_si128( shift5 );
+
+  for( int y = 0; y < heightG; y++ )
+  {
+    int x = 0;
+    for( ; x < ( ( widthG >> 2 ) << 2 ); x += 4 )
+    {
+      __m128i mmSrcY0Temp = _mm_sra_epi32( _mm_loadu_si128( ( __m128i* )( srcY0Temp + x ) ), mmShift4 );
+      __m128i mmSrcY1Temp = _mm_sra_epi32( _mm_loadu_si128( ( __m128i* )( srcY1Temp + x ) ), mmShift4 );
+      __m128i mmGradX     = _mm_add_epi32( _mm_loadu_si128( ( __m128i* )( gradX0 + x ) ), _mm_loadu_si128( ( __m128i* )( gradX1 + x ) ) );
+      __m128i mmGradY     = _mm_add_epi32( _mm_loadu_si128( ( __m128i* )( gradY0 + x ) ), _mm_loadu_si128( ( __m128i* )( gradY1 + x ) ) );
+
+      __m128i mmTemp1 = _mm_sub_epi32( mmSrcY1Temp, mmSrcY0Temp );
+      __m128i mmTempX = _mm_sra_epi32( mmGradX, mmShift5 );
+      __m128i mmTempY = _mm_sra_epi32( mmGradY, mmShift5 );
+
+      _mm_storeu_si128( ( __m128i * )( dotProductTemp1 + x ), _mm_mullo_epi32( mmTempX, mmTempX ) );
+      _mm_storeu_si128( ( __m128i * )( dotProductTemp2 + x ), _mm_mullo_epi32( mmTempX, mmTempY ) );
+      _mm_storeu_si128( ( __m128i * )( dotProductTemp3 + x ), _mm_mullo_epi32( mmTempX, mmTemp1 ) );
+      _mm_storeu_si128( ( __m128i * )( dotProductTemp5 + x ), _mm_mullo_epi32( mmTempY, mmTempY ) );
+      _mm_storeu_si128( ( __m128i * )( dotProductTemp6 + x ), _mm_mullo_epi32( mmTempY, mmTemp1 ) );
+    }
+
+    for( ; x < widthG; x++ )
+    {
+      int temp  = ( srcY0Temp[x] >> shift4 ) - ( srcY1Temp[x] >> shift4 );
+      int tempX = ( gradX0[x] + gradX1[x] ) >> shift5;
+      int tempY = ( gradY0[x] + gradY1[x] ) >> shift5;
+      dotProductTemp1[x] = tempX * tempX;
+      dotProductTemp2[x] = tempX * tempY;
+      dotProductTemp3[x] = -tempX * temp;
+      dotProductTemp5[x] = tempY * tempY;
+      dotProductTemp6[x] = -tempY * temp;
+    }
+
+    srcY0Temp += src0Stride;
+    srcY1Temp += src1Stride;
+    gradX0 += gradStride;
+    gradX1 += gradStride;
+    gradY0 += gradStride;
+    gradY1 += gradStride;
+    dotProductTemp1 += widthG;
+    dotProductTemp2 += widthG;
+    dotProductTemp3 += widthG;
+    dotProductTemp5 += widthG;
+    dotProductTemp6 += widthG;
+  }
+}
+
+template<X86_VEXT vext>
+uint64_t calcSSE_HBD( const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, int width, int height, int shift )
+{
+  // the differences of the samples fit into 32 bits, they are squared into 64 bit products as in the core function
+  const __m128i vshift = _mm_cvtsi32_si128( shift );
+  __m128i vsum = _mm_setzero_si128();
+#ifdef USE_AVX2
+  __m256i vsum8 = _mm256_setzero_si256();
+#endif
+  uint64_t sum = 0;
+
+  for( int y = 0; y < height; y++ )
+  {
+    int x = 0;
+#ifdef USE_AVX2
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const __m256i vdiff = _mm256_sub_epi32( _mm256_loadu_si256( ( const __m256i* ) &src0[x] ), _mm256_loadu_si256( ( const __m256i* ) &src1[x] ) );
+      const __m256i vodd  = _mm256_srli_epi64( vdiff, 32 );
+      vsum8 = _mm256_add_epi64( vsum8, _mm256_srl_epi64( _mm256_mul_epi32( vdiff, vdiff ), vshift ) );
+      vsum8 = _mm256_add_epi64( vsum8, _mm256_srl_epi64( _mm256_mul_epi32( vodd,  vodd  ), vshift ) );
+    }
+#endif
+    for( ; x + 4 <= width; x += 4 )
+    {
+      const __m128i vdiff = _mm_sub_epi32( _mm_loadu_si128( ( const __m128i* ) &src0[x] ), _mm_loadu_si128( ( const __m128i* ) &src1[x] ) );
+      const __m128i vodd  = _mm_srli_epi64( vdiff, 32 );
+      vsum = _mm_add_epi64( vsum, _mm_srl_epi64( _mm_mul_epi32( vdiff, vdiff ), vshift ) );
+      vsum = _mm_add_epi64( vsum, _mm_srl_epi64( _mm_mul_epi32( vodd,  vodd  ), vshift ) );
+    }
+    for( ; x < width; x++ )
+    {
+      const Intermediate_Int diff = src0[x] - src1[x];
+      sum += uint64_t( ( diff * diff ) >> shift );
+    }
+    src0 += src0Stride;
+    src1 += src1Stride;
+  }
+
+#ifdef USE_AVX2
+  vsum = _mm_add_epi64( vsum, _mm256_castsi256_si128( vsum8 ) );
+  vsum = _mm_add_epi64( vsum, _mm256_extracti128_si256( vsum8, 1 ) );
+#endif
+  uint64_t lanes[2];
+  _mm_storeu_si128( ( __m128i* ) lanes, vsum );
+  return sum + lanes[0] + lanes[1];
+}
+
+#if ENABLE_SIMD_OPT_GBI
+template< X86_VEXT vext, int W >
+void removeWeightHighFreq_HBD( Pel* src0, int src0Stride, const Pel* src1, int src1Stride, int width, int height, int shift, int gbiWeight )
+{
+  const int normalizer = ( ( 1 << 16 ) + ( gbiWeight > 0 ? ( gbiWeight >> 1 ) : -( gbiWeight >> 1 ) ) ) / gbiWeight;
+  const int weight0    = normalizer << g_GbiLog2WeightBase;
+  const int weight1    = ( g_GbiWeightBase - gbiWeight ) * normalizer;
+  const int offset     = 1 << ( shift - 1 );
+
+  if( W == 8 && vext >= AVX2 )
+  {
+#ifdef USE_AVX2
+    const __m256i vw0     = _mm256_set1_epi32( weight0 );
+    const __m256i vw1     = _mm256_set1_epi32( weight1 );
+    const __m256i voffset = _mm256_set1_epi32( offset );
+
+    for( int row = 0; row < height; row++ )
+    {
+      for( int col = 0; col < width; col += 8 )
+      {
+        __m256i vsum = _mm256_mullo_epi32( _mm256_loadu_si256( ( const __m256i * )&src0[col] ), vw0 );
+        __m256i vdst = _mm256_mullo_epi32( _mm256_loadu_si256( ( const __m256i * )&src1[col] ), vw1 );
+        vsum = _mm256_srai_epi32( _mm256_add_epi32( _mm256_sub_epi32( vsum, vdst ), voffset ), shift );
+        _mm256_storeu_si256( ( __m256i * )&src0[col], vsum );
+      }
+
+      src0 += src0Stride;
+      src1 += src1Stride;
+    }
+#endif
+  }
+  else
+  {
+    const __m128i vw0     = _mm_set1_epi32( weight0 );
+    const __m128i vw1     = _mm_set1_epi32( weight1 );
+    const __m128i voffset = _mm_set1_epi32( offset );
+
+    for( int row = 0; row < height; row++ )
+    {
+      for( int col = 0; col < width; col += 4 )
+      {
+        __m128i vsum = _mm_mullo_epi32( _mm_loadu_si128( ( const __m128i * )&src0[col] ), vw0 );
+        __m128i vdst = _mm_mullo_epi32( _mm_loadu_si128( ( const __m128i * )&src1[col] ), vw1 );
+        vsum = _mm_srai_epi32( _mm_add_epi32( _mm_sub_epi32( vsum, vdst ), voffset ), shift );
+        _mm_storeu_si128( ( __m128i * )&src0[col], vsum );
+      }
+
+      src0 += src0Stride;
+      src1 += src1Stride;
+    }
+  }
+}
+
+template< X86_VEXT vext, int W >
+void removeHighFreq_HBD( Pel* src0, int src0Stride, const Pel* src1, int src1Stride, int width, int height )
+{
+  if( W == 8 && vext >= AVX2 )
+  {
+#ifdef USE_AVX2
+    for( int row = 0; row < height; row++ )
+    {
+      for( int col = 0; col < width; col += 8 )
+      {
+        __m256i vsrc0 = _mm256_loadu_si256( ( const __m256i * )&src0[col] );
+        __m256i vsrc1 = _mm256_loadu_si256( ( const __m256i * )&src1[col] );
+        _mm256_storeu_si256( ( __m256i * )&src0[col], _mm256_sub_epi32( _mm256_slli_epi32( vsrc0, 1 ), vsrc1 ) );
+      }
+
+      src0 += src0Stride;
+      src1 += src1Stride;
+    }
+#endif
+  }
+  else
+  {
+    for( int row = 0; row < height; row++ )
+    {
+      for( int col = 0; col < width; col += 4 )
+      {
+        __m128i vsrc0 = _mm_loadu_si128( ( const __m128i * )&src0[col] );
+        __m128i vsrc1 = _mm_loadu_si128( ( const __m128i * )&src1[col] );
+        _mm_storeu_si128( ( __m128i * )&src0[col], _mm_sub_epi32( _mm_slli_epi32( vsrc0, 1 ), vsrc1 ) );
+      }
+
+      src0 += src0Stride;
+      src1 += src1Stride;
+    }
+  }
+}
+#endif
+
+template<X86_VEXT vext>
+void PelBufferOps::_initPelBufOpsX86()
+{
+  // copyBuffer, padding and linTf keep their core functions in the high bit depth build
+  addAvg8 = addAvg_HBD<vext, 8>;
+  addAvg4 = addAvg_HBD<vext, 4>;
+
+  addBIOAvg4      = addBIOAvg4_HBD<vext>;
+  bioGradFilter   = gradFilter_HBD<vext>;
+  calcBIOPar      = calcBIOPar_HBD<vext>;
+  calcBlkGradient = calcBlkGradient_SSE<vext>;
+
+  calcSSE = calcSSE_HBD<vext>;
+  reco8 = reco_HBD<vext, 8>;
+  reco4 = reco_HBD<vext, 4>;
+#if ENABLE_SIMD_OPT_GBI
+  removeWeightHighFreq8 = removeWeightHighFreq_HBD<vext, 8>;
+  removeWeightHighFreq4 = removeWeightHighFreq_HBD<vext, 4>;
+  removeHighFreq8 = removeHighFreq_HBD<vext, 8>;
+  removeHighFreq4 = removeHighFreq_HBD<vext, 4>;
+#endif
+}
+
+#else
+
 template< X86_VEXT vext, int W >
 void reco_SSE( const int16_t* src0, int src0Stride, const int16_t* src1, int src1Stride, int16_t *dst, int dstStride, int width, int height, const ClpRng& clpRng )
 {
@@ -648,6 +1215,32 @@ void removeWeightHighFreq_SSE(int16_t* src0, int src0Stride, const int16_t* src1
   int weight0 = normalizer << g_GbiLog2WeightBase;
   int weight1 = (g_GbiWeightBase - gbiWeight)*normalizer;
   int offset = 1 << (shift - 1);
+#ifdef USE_AVX512
+  if (W == 8 && vext >= AVX512 && (width & 15) == 0)
+  {
+    __m512i voffset = _mm512_set1_epi32(offset);
+    __m512i vw0 = _mm512_set1_epi32(weight0);
+    __m512i vw1 = _mm512_set1_epi32(weight1);
+
+    for (int row = 0; row < height; row++)
+    {
+      for (int col = 0; col < width; col += 16)
+      {
+        __m512i vdst = _mm512_cvtepi16_epi32(_mm256_loadu_si256((const __m256i *)&src0[col]));
+        __m512i vsrc = _mm512_cvtepi16_epi32(_mm256_loadu_si256((const __m256i *)&src1[col]));
+        vdst = _mm512_mullo_epi32(vdst, vw0);
+        vsrc = _mm512_mullo_epi32(vsrc, vw1);
+        vdst = _mm512_add_epi32(_mm512_sub_epi32(vdst, vsrc), voffset);
+        vdst = _mm512_srai_epi32(vdst, shift);
+
+        _mm256_storeu_si256((__m256i *)&src0[col], _mm512_cvtsepi32_epi16(vdst));
+      }
+      src0 += src0Stride;
+      src1 += src1Stride;
+    }
+    return;
+  }
+#endif
   if (W == 8)
   {
     __m128i vzero = _mm_setzero_si128();
@@ -932,6 +1525,7 @@ void PelBufferOps::_initPelBufOpsX86()
 
   copyBuffer = copyBufferSimd<vext>;
   padding    = paddingSimd<vext>;
+  calcSSE    = calcSSE_SSE<vext>;
   reco8 = reco_SSE<vext, 8>;
   reco4 = reco_SSE<vext, 4>;
 
@@ -945,6 +1539,8 @@ void PelBufferOps::_initPelBufOpsX86()
 #endif
 }
 
+#endif
+
 template void PelBufferOps::_initPelBufOpsX86<SIMDX86>();
 
 #endif // TARGET_SIMD_X86
@@ -47,18 +47,24 @@
 #include "CommonLib/AffineGradientSearch.h"
 
 #include "CommonLib/AdaptiveLoopFilter.h"
+#include "CommonLib/LoopFilter.h"
+#include "CommonLib/SampleAdaptiveOffset.h"
+#include "CommonLib/IntraPrediction.h"
 
 #include "CommonLib/IbcHashMap.h"
 
 #ifdef TARGET_SIMD_X86
 
+// the instruction set level defaults to the detected or selected one ( read_x86_extension_flags ), kernel_bench passes
+// every level to check the kernels installed here against the C functions
 
 #if ENABLE_SIMD_OPT_MCIF
-void InterpolationFilter::initInterpolationFilterX86( /*int iBitDepthY, int iBitDepthC*/ )
+void InterpolationFilter::initInterpolationFilterX86( const X86_VEXT vext )
 {
-  auto vext = read_x86_extension_flags();
   switch (vext){
   case AVX512:
+    _initInterpolationFilterX86<AVX512>(/*iBitDepthY, iBitDepthC*/);
+    break;
   case AVX2:
     _initInterpolationFilterX86<AVX2>(/*iBitDepthY, iBitDepthC*/);
     break;
@@ -76,11 +82,12 @@ void InterpolationFilter::initInterpolationFilterX86( /*int iBitDepthY, int iBit
 #endif
 
 #if ENABLE_SIMD_OPT_BUFFER
-void PelBufferOps::initPelBufOpsX86()
+void PelBufferOps::initPelBufOpsX86( const X86_VEXT vext )
 {
-  auto vext = read_x86_extension_flags();
   switch (vext){
     case AVX512:
+      _initPelBufOpsX86<AVX512>();
+      break;
     case AVX2:
       _initPelBufOpsX86<AVX2>();
       break;
@@ -101,11 +108,12 @@ void PelBufferOps::initPelBufOpsX86()
 
 
 #if ENABLE_SIMD_OPT_DIST
-void RdCost::initRdCostX86()
+void RdCost::initRdCostX86( const X86_VEXT vext )
 {
-  auto vext = read_x86_extension_flags();
   switch (vext){
     case AVX512:
+      _initRdCostX86<AVX512>();
+      break;
     case AVX2:
       _initRdCostX86<AVX2>();
       break;
@@ -123,9 +131,8 @@ void RdCost::initRdCostX86()
 #endif
 
 #if ENABLE_SIMD_OPT_AFFINE_ME
-void AffineGradientSearch::initAffineGradientSearchX86()
+void AffineGradientSearch::initAffineGradientSearchX86( const X86_VEXT vext )
 {
-  auto vext = read_x86_extension_flags();
   switch ( vext ) {
   case AVX512:
   case AVX2:
@@ -145,9 +152,8 @@ void AffineGradientSearch::initAffineGradientSearchX86()
 #endif
 
 #if ENABLE_SIMD_OPT_ALF
-void AdaptiveLoopFilter::initAdaptiveLoopFilterX86()
+void AdaptiveLoopFilter::initAdaptiveLoopFilterX86( const X86_VEXT vext )
 {
-  auto vext = read_x86_extension_flags();
   switch ( vext )
   {
   case AVX512:
@@ -167,10 +173,119 @@ void AdaptiveLoopFilter::initAdaptiveLoopFilterX86()
 }
 #endif
 
+#if ENABLE_SIMD_OPT_DBF
+void LoopFilter::initLoopFilterX86( const X86_VEXT vext )
+{
+  switch ( vext )
+  {
+  case AVX512:
+  case AVX2:
+    _initLoopFilterX86<AVX2>();
+    break;
+  case AVX:
+    _initLoopFilterX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initLoopFilterX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_SAO
+void SampleAdaptiveOffset::initSampleAdaptiveOffsetX86( const X86_VEXT vext )
+{
+  switch ( vext )
+  {
+  case AVX512:
+  case AVX2:
+    _initSampleAdaptiveOffsetX86<AVX2>();
+    break;
+  case AVX:
+    _initSampleAdaptiveOffsetX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initSampleAdaptiveOffsetX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_TRAFO
+void TrQuant::initTrQuantX86( const X86_VEXT vext )
+{
+  switch ( vext )
+  {
+  case AVX512:
+  case AVX2:
+    _initTrQuantX86<AVX2>();
+    break;
+  case AVX:
+    _initTrQuantX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initTrQuantX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_INTRAPRED
+void IntraPrediction::initIntraPredictionX86( const X86_VEXT vext )
+{
+  switch ( vext )
+  {
+  case AVX512:
+  case AVX2:
+    _initIntraPredictionX86<AVX2>();
+    break;
+  case AVX:
+    _initIntraPredictionX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initIntraPredictionX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_MIP && JVET_N0217_MATRIX_INTRAPRED
+void Mip::PredictorMIP::initPredictorMipX86( const X86_VEXT vext )
+{
+  switch ( vext )
+  {
+  case AVX512:
+  case AVX2:
+    _initPredictorMipX86<AVX2>();
+    break;
+  case AVX:
+    _initPredictorMipX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initPredictorMipX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
 #if ENABLE_SIMD_OPT_IBC
-void IbcHashMap::initIbcHashMapX86()
+void IbcHashMap::initIbcHashMapX86( const X86_VEXT vext )
 {
-  auto vext = read_x86_extension_flags();
   switch (vext)
   {
   case AVX512:
@@ -193,9 +193,9 @@ static void fullPelCopyAVX2( const ClpRng& clpRng, const void*_src, int srcStrid
 
 
 template<X86_VEXT vext, bool isFirst, bool isLast>
-static void simdFilterCopy( const ClpRng& clpRng, const Pel* src, int srcStride, int16_t* dst, int dstStride, int width, int height, bool biMCForDMVR)
+static void simdFilterCopy( const ClpRng& clpRng, const Pel* src, int srcStride, Pel* dst, int dstStride, int width, int height, bool biMCForDMVR)
 {
-#if !HM_JEM_CLIP_PEL
+#if !HM_JEM_CLIP_PEL && !RExt__HIGH_BIT_DEPTH_SUPPORT
   if( vext >= AVX2 && ( width % 16 ) == 0 )
   {
     fullPelCopyAVX2<Pel, 16, isFirst, isLast >( clpRng, src, srcStride, dst, dstStride, width, height );
@@ -564,6 +564,61 @@ static void simdInterpolateHorM16_AVX2( const int16_t* src, int srcStride, int16
 }
 
 
+template<X86_VEXT vext, int N, bool shiftBack>
+static void simdInterpolateHorM16_AVX512( const int16_t* src, int srcStride, int16_t *dst, int dstStride, int width, int height, int shift, int offset, const ClpRng& clpRng, int16_t const *coeff )
+{
+#ifdef USE_AVX512
+  const int filterSpan = ( N-1 );
+  _mm_prefetch( (const char*)( src+srcStride ), _MM_HINT_T0 );
+  _mm_prefetch( (const char*)( src+width+filterSpan+srcStride ), _MM_HINT_T0 );
+
+  __m512i voffset    = _mm512_set1_epi32( offset );
+  __m256i vibdimin   = _mm256_set1_epi16( clpRng.min );
+  __m256i vibdimax   = _mm256_set1_epi16( clpRng.max );
+
+  // every 128 bit lane computes 4 output samples, lane k reads the source from sample 4*k (taps 0-3) and 4*k+4 (taps 4-7)
+  __m512i vperm0 = _mm512_set_epi64( 4, 3, 3, 2, 2, 1, 1, 0 );
+  __m512i vperm1 = _mm512_set_epi64( 5, 4, 4, 3, 3, 2, 2, 1 );
+  __m512i vshuf0 = _mm512_broadcast_i32x4( _mm_set_epi8( 0x9, 0x8, 0x7, 0x6, 0x7, 0x6, 0x5, 0x4, 0x5, 0x4, 0x3, 0x2, 0x3, 0x2, 0x1, 0x0 ) );
+  __m512i vshuf1 = _mm512_broadcast_i32x4( _mm_set_epi8( 0xd, 0xc, 0xb, 0xa, 0xb, 0xa, 0x9, 0x8, 0x9, 0x8, 0x7, 0x6, 0x7, 0x6, 0x5, 0x4 ) );
+  // only load the samples covered by the filter, masked out elements are not accessed
+  const __mmask32 vmask = N == 8 ? 0xffffff : 0xfffff;
+
+  __m512i vcoeff[N/2];
+  for( int i=0; i<N; i+=2 )
+  {
+    vcoeff[i/2] = _mm512_unpacklo_epi16( _mm512_set1_epi16( coeff[i] ), _mm512_set1_epi16( coeff[i+1] ) );
+  }
+
+  for( int row = 0; row < height; row++ )
+  {
+    _mm_prefetch( (const char*)( src+2*srcStride ), _MM_HINT_T0 );
+    _mm_prefetch( (const char*)( src+width+filterSpan + 2*srcStride ), _MM_HINT_T0 );
+    for( int col = 0; col < width; col+=16 )
+    {
+      __m512i vsrc  = _mm512_maskz_loadu_epi16( vmask, &src[col] );
+      __m512i vsrc0 = _mm512_permutexvar_epi64( vperm0, vsrc );
+      __m512i vsum  = _mm512_add_epi32( _mm512_madd_epi16( _mm512_shuffle_epi8( vsrc0, vshuf0 ), vcoeff[0] ), _mm512_madd_epi16( _mm512_shuffle_epi8( vsrc0, vshuf1 ), vcoeff[1] ) );
+      if( N==8 )
+      {
+        __m512i vsrc1 = _mm512_permutexvar_epi64( vperm1, vsrc );
+        vsum = _mm512_add_epi32( vsum, _mm512_add_epi32( _mm512_madd_epi16( _mm512_shuffle_epi8( vsrc1, vshuf0 ), vcoeff[2] ), _mm512_madd_epi16( _mm512_shuffle_epi8( vsrc1, vshuf1 ), vcoeff[3] ) ) );
+      }
+      vsum = _mm512_srai_epi32( _mm512_add_epi32( vsum, voffset ), shift );
+
+      __m256i vsump = _mm512_cvtsepi32_epi16( vsum );
+      if( shiftBack )
+      { //clip
+        vsump = _mm256_min_epi16( vibdimax, _mm256_max_epi16( vibdimin, vsump ) );
+      }
+      _mm256_storeu_si256( ( __m256i * )&dst[col], vsump );
+    }
+    src += srcStride;
+    dst += dstStride;
+  }
+#endif
+}
+
 template<X86_VEXT vext, int N, bool shiftBack>
 static void simdInterpolateVerM4( const int16_t *src, int srcStride, int16_t *dst, int dstStride, int width, int height, int shift, int offset, const ClpRng& clpRng, int16_t const *coeff )
 {
@@ -847,6 +902,65 @@ static void simdInterpolateVerM16_AVX2( const int16_t *src, int srcStride, int16
 }
 
 
+template<X86_VEXT vext, int N, bool shiftBack>
+static void simdInterpolateVerM16_AVX512( const int16_t *src, int srcStride, int16_t *dst, int dstStride, int width, int height, int shift, int offset, const ClpRng& clpRng, int16_t const *coeff )
+{
+#ifdef USE_AVX512
+  __m512i voffset    = _mm512_set1_epi32( offset );
+  __m256i vibdimin   = _mm256_set1_epi16( clpRng.min );
+  __m256i vibdimax   = _mm256_set1_epi16( clpRng.max );
+
+  // duplicate every 64 bit of a row, so that unpacklo pairs 4 samples of two rows per 128 bit lane
+  __m512i vperm = _mm512_set_epi64( 3, 3, 2, 2, 1, 1, 0, 0 );
+
+  __m512i vsum;
+  __m512i vsrc[N];
+  __m512i vcoeff[N/2];
+  for( int i=0; i<N; i+=2 )
+  {
+    vcoeff[i/2] = _mm512_unpacklo_epi16( _mm512_set1_epi16( coeff[i] ), _mm512_set1_epi16( coeff[i+1] ) );
+  }
+
+  const short *srcOrig = src;
+  int16_t *dstOrig = dst;
+
+  for( int col = 0; col < width; col+=16 )
+  {
+    for( int i=0; i<N-1; i++ )
+    {
+      vsrc[i] = _mm512_permutexvar_epi64( vperm, _mm512_castsi256_si512( _mm256_loadu_si256( ( const __m256i * )&src[col + i * srcStride] ) ) );
+    }
+    for( int row = 0; row < height; row++ )
+    {
+      vsrc[N-1] = _mm512_permutexvar_epi64( vperm, _mm512_castsi256_si512( _mm256_loadu_si256( ( const __m256i * )&src[col + ( N-1 ) * srcStride] ) ) );
+      vsum = _mm512_setzero_si512();
+      for( int i=0; i<N; i+=2 )
+      {
+        vsum = _mm512_add_epi32( vsum, _mm512_madd_epi16( _mm512_unpacklo_epi16( vsrc[i], vsrc[i+1] ), vcoeff[i/2] ) );
+      }
+      for( int i=0; i<N-1; i++ )
+      {
+        vsrc[i] = vsrc[i+1];
+      }
+
+      vsum = _mm512_srai_epi32( _mm512_add_epi32( vsum, voffset ), shift );
+
+      __m256i vsump = _mm512_cvtsepi32_epi16( vsum );
+      if( shiftBack )
+      { //clip
+        vsump = _mm256_min_epi16( vibdimax, _mm256_max_epi16( vibdimin, vsump ) );
+      }
+      _mm256_storeu_si256( ( __m256i * )&dst[col], vsump );
+
+      src += srcStride;
+      dst += dstStride;
+    }
+    src= srcOrig;
+    dst= dstOrig;
+  }
+#endif
+}
+
 template<int N, bool isLast>
 inline void interpolate( const int16_t* src, int cStride, int16_t *dst, int width, int shift, int offset, int bitdepth, int maxVal, int16_t const *c )
 {
@@ -1067,6 +1181,76 @@ static void simdInterpolateN2_10BIT_M4(const int16_t* src, int srcStride, int16_
   }
 }
 
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+// 32 bit sample variant of the N tap filter, used for any width that is a multiple of 4
+template<X86_VEXT vext, int N, bool isLast>
+static void simdInterpolateHBD( const Pel* src, int srcStride, Pel *dst, int dstStride, int cStride, int width, int height, int shift, int offset, const ClpRng& clpRng, Pel const *c )
+{
+  const __m128i mmShift  = _mm_cvtsi32_si128( shift );
+  const __m128i mmOffset = _mm_set1_epi32( offset );
+  const __m128i mmMin    = _mm_set1_epi32( clpRng.min );
+  const __m128i mmMax    = _mm_set1_epi32( clpRng.max );
+  __m128i mmCoeff[N];
+  for( int k = 0; k < N; k++ )
+  {
+    mmCoeff[k] = _mm_set1_epi32( c[k] );
+  }
+#ifdef USE_AVX2
+  const __m256i mm256Offset = _mm256_set1_epi32( offset );
+  const __m256i mm256Min    = _mm256_set1_epi32( clpRng.min );
+  const __m256i mm256Max    = _mm256_set1_epi32( clpRng.max );
+  __m256i mm256Coeff[N];
+  for( int k = 0; k < N; k++ )
+  {
+    mm256Coeff[k] = _mm256_set1_epi32( c[k] );
+  }
+#endif
+
+  for( int row = 0; row < height; row++ )
+  {
+    int col = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      for( ; col + 8 <= width; col += 8 )
+      {
+        __m256i mmSum = mm256Offset;
+        for( int k = 0; k < N; k++ )
+        {
+          __m256i mmSrc = _mm256_loadu_si256( ( const __m256i* ) &src[col + k * cStride] );
+          mmSum = _mm256_add_epi32( mmSum, _mm256_mullo_epi32( mmSrc, mm256Coeff[k] ) );
+        }
+        mmSum = _mm256_sra_epi32( mmSum, mmShift );
+        if( isLast )
+        {
+          mmSum = _mm256_min_epi32( mm256Max, _mm256_max_epi32( mm256Min, mmSum ) );
+        }
+        _mm256_storeu_si256( ( __m256i* ) &dst[col], mmSum );
+      }
+    }
+#endif
+    for( ; col < width; col += 4 )
+    {
+      __m128i mmSum = mmOffset;
+      for( int k = 0; k < N; k++ )
+      {
+        __m128i mmSrc = _mm_loadu_si128( ( const __m128i* ) &src[col + k * cStride] );
+        mmSum = _mm_add_epi32( mmSum, _mm_mullo_epi32( mmSrc, mmCoeff[k] ) );
+      }
+      mmSum = _mm_sra_epi32( mmSum, mmShift );
+      if( isLast )
+      {
+        mmSum = _mm_min_epi32( mmMax, _mm_max_epi32( mmMin, mmSum ) );
+      }
+      _mm_storeu_si128( ( __m128i* ) &dst[col], mmSum );
+    }
+
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
+#endif
 template<X86_VEXT vext, int N, bool isVertical, bool isFirst, bool isLast>
 static void simdFilter( const ClpRng& clpRng, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, TFilterCoeff const *coeff, bool biMCForDMVR)
 {
@@ -1127,9 +1311,24 @@ static void simdFilter( const ClpRng& clpRng, Pel const *src, int srcStride, Pel
       offset = 1 << (shift - 1);
     }
   }
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  if( !( width & 0x03 ) )
+  {
+    simdInterpolateHBD<vext, N, isLast>( src, srcStride, dst, dstStride, cStride, width, height, shift, offset, clpRng, c );
+    return;
+  }
+#else
   if( clpRng.bd <= 10 )
   {
-    if( N == 8 && !( width & 0x07 ) )
+    if( vext >= AVX512 && ( N == 8 || N == 4 ) && !( width & 0x0f ) )
+    {
+      if( !isVertical )
+        simdInterpolateHorM16_AVX512<vext, N, isLast>( src, srcStride, dst, dstStride, width, height, shift, offset, clpRng, c );
+      else
+        simdInterpolateVerM16_AVX512<vext, N, isLast>( src, srcStride, dst, dstStride, width, height, shift, offset, clpRng, c );
+      return;
+    }
+    else if( N == 8 && !( width & 0x07 ) )
     {
       if( !isVertical )
       {
@@ -1194,6 +1393,7 @@ static void simdFilter( const ClpRng& clpRng, Pel const *src, int srcStride, Pel
       return;
     }
   }
+#endif
 
   for( row = 0; row < height; row++ )
   {
@@ -0,0 +1,346 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     IntraPredictionX86.h
+    \brief    SIMD for IntraPrediction
+*/
+#include "CommonDefX86.h"
+#include "../IntraPrediction.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#if ENABLE_SIMD_OPT_INTRAPRED
+#ifdef TARGET_SIMD_X86
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <immintrin.h>
+#endif
+
+template<X86_VEXT vext>
+static void simdPredIntraPlanar( const CPelBuf &pSrc, PelBuf &pDst )
+{
+  const int width  = pDst.width;
+  const int height = pDst.height;
+  const int log2W  = g_aucLog2[width  < 2 ? 2 : width];
+  const int log2H  = g_aucLog2[height < 2 ? 2 : height];
+
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, int topRow   [MAX_CU_SIZE] );
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, int bottomRow[MAX_CU_SIZE] );
+
+  const int bottomLeft = pSrc.at( 0, height + 1 );
+  const int topRight   = pSrc.at( width + 1, 0 );
+
+  for( int k = 0; k < width; k++ )
+  {
+    const int top = pSrc.at( k + 1, 0 );
+    bottomRow[k] = bottomLeft - top;
+    topRow[k]    = top << log2H;
+  }
+
+  const int finalShift = 1 + log2W + log2H;
+  const int offset     = 1 << ( log2W + log2H );
+  Pel*      pred       = pDst.buf;
+
+  // pred[x] = ( ( horPred( x ) << log2H ) + ( vertPred( x ) << log2W ) + offset ) >> finalShift, where
+  // horPred( x ) = ( left << log2W ) + ( x + 1 ) * ( topRight - left ) and vertPred( x ) accumulates bottomRow[x] per line
+  for( int y = 0; y < height; y++, pred += pDst.stride )
+  {
+    const int left  = pSrc.at( 0, y + 1 );
+    const int right = topRight - left;
+    int x = 0;
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      const __m256i vHor0  = _mm256_set1_epi32( left << log2W );
+      const __m256i vRight = _mm256_set1_epi32( right );
+      const __m256i vOff   = _mm256_set1_epi32( offset );
+
+      for( ; x + 8 <= width; x += 8 )
+      {
+        __m256i vVer = _mm256_add_epi32( _mm256_loadu_si256( ( const __m256i* ) &topRow[x] ), _mm256_loadu_si256( ( const __m256i* ) &bottomRow[x] ) );
+        _mm256_storeu_si256( ( __m256i* ) &topRow[x], vVer );
+
+        const __m256i vX   = _mm256_setr_epi32( x + 1, x + 2, x + 3, x + 4, x + 5, x + 6, x + 7, x + 8 );
+        const __m256i vHor = _mm256_add_epi32( vHor0, _mm256_mullo_epi32( vX, vRight ) );
+
+        __m256i vRes = _mm256_add_epi32( _mm256_slli_epi32( vHor, log2H ), _mm256_slli_epi32( vVer, log2W ) );
+        vRes = _mm256_srai_epi32( _mm256_add_epi32( vRes, vOff ), finalShift );
+        vRes = _mm256_packs_epi32( vRes, vRes );
+        vRes = _mm256_permute4x64_epi64( vRes, 0x08 );
+        _mm_storeu_si128( ( __m128i* ) &pred[x], _mm256_castsi256_si128( vRes ) );
+      }
+    }
+#endif
+    const __m128i vHor0  = _mm_set1_epi32( left << log2W );
+    const __m128i vRight = _mm_set1_epi32( right );
+    const __m128i vOff   = _mm_set1_epi32( offset );
+
+    for( ; x + 4 <= width; x += 4 )
+    {
+      __m128i vVer = _mm_add_epi32( _mm_load_si128( ( const __m128i* ) &topRow[x] ), _mm_load_si128( ( const __m128i* ) &bottomRow[x] ) );
+      _mm_store_si128( ( __m128i* ) &topRow[x], vVer );
+
+      const __m128i vX   = _mm_setr_epi32( x + 1, x + 2, x + 3, x + 4 );
+      const __m128i vHor = _mm_add_epi32( vHor0, _mm_mullo_epi32( vX, vRight ) );
+
+      __m128i vRes = _mm_add_epi32( _mm_slli_epi32( vHor, log2H ), _mm_slli_epi32( vVer, log2W ) );
+      vRes = _mm_srai_epi32( _mm_add_epi32( vRes, vOff ), finalShift );
+      _mm_storel_epi64( ( __m128i* ) &pred[x], _mm_packs_epi32( vRes, vRes ) );
+    }
+
+    for( ; x < width; x++ )
+    {
+      topRow[x] += bottomRow[x];
+      const int horPred = ( left << log2W ) + ( x + 1 ) * right;
+      pred[x] = ( ( horPred << log2H ) + ( topRow[x] << log2W ) + offset ) >> finalShift;
+    }
+  }
+}
+
+// 16 bit coefficient pair ( c0, c1 ) in each 32 bit lane, for _mm_madd_epi16 with interleaved samples
+static inline int coeffPair( const int c0, const int c1 )
+{
+  return ( c0 & 0xffff ) | ( c1 << 16 );
+}
+
+template<X86_VEXT vext>
+static void simdPredIntraAngLuma( Pel* pDst, const Pel* refMain, const int width, const TFilterCoeff* f, const bool useCubicFilter, const ClpRng& clpRng )
+{
+  int x = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vC01 = _mm256_set1_epi32( coeffPair( f[0], f[1] ) );
+    const __m256i vC23 = _mm256_set1_epi32( coeffPair( f[2], f[3] ) );
+    const __m256i vRnd = _mm256_set1_epi32( 32 );
+    const __m256i vMin = _mm256_set1_epi16( clpRng.min );
+    const __m256i vMax = _mm256_set1_epi16( clpRng.max );
+
+    for( ; x + 16 <= width; x += 16 )
+    {
+      const __m256i r0 = _mm256_loadu_si256( ( const __m256i* ) &refMain[x] );
+      const __m256i r1 = _mm256_loadu_si256( ( const __m256i* ) &refMain[x + 1] );
+      const __m256i r2 = _mm256_loadu_si256( ( const __m256i* ) &refMain[x + 2] );
+      const __m256i r3 = _mm256_loadu_si256( ( const __m256i* ) &refMain[x + 3] );
+
+      __m256i lo = _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpacklo_epi16( r0, r1 ), vC01 ), _mm256_madd_epi16( _mm256_unpacklo_epi16( r2, r3 ), vC23 ) );
+      __m256i hi = _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpackhi_epi16( r0, r1 ), vC01 ), _mm256_madd_epi16( _mm256_unpackhi_epi16( r2, r3 ), vC23 ) );
+      lo = _mm256_srai_epi32( _mm256_add_epi32( lo, vRnd ), 6 );
+      hi = _mm256_srai_epi32( _mm256_add_epi32( hi, vRnd ), 6 );
+
+      __m256i vRes = _mm256_packs_epi32( lo, hi );
+      if( useCubicFilter )
+      {
+        vRes = _mm256_min_epi16( _mm256_max_epi16( vRes, vMin ), vMax );
+      }
+      _mm256_storeu_si256( ( __m256i* ) &pDst[x], vRes );
+    }
+  }
+#endif
+
+  const __m128i vC01 = _mm_set1_epi32( coeffPair( f[0], f[1] ) );
+  const __m128i vC23 = _mm_set1_epi32( coeffPair( f[2], f[3] ) );
+  const __m128i vRnd = _mm_set1_epi32( 32 );
+  const __m128i vMin = _mm_set1_epi16( clpRng.min );
+  const __m128i vMax = _mm_set1_epi16( clpRng.max );
+
+  for( ; x + 8 <= width; x += 8 )
+  {
+    const __m128i r0 = _mm_loadu_si128( ( const __m128i* ) &refMain[x] );
+    const __m128i r1 = _mm_loadu_si128( ( const __m128i* ) &refMain[x + 1] );
+    const __m128i r2 = _mm_loadu_si128( ( const __m128i* ) &refMain[x + 2] );
+    const __m128i r3 = _mm_loadu_si128( ( const __m128i* ) &refMain[x + 3] );
+
+    __m128i lo = _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( r0, r1 ), vC01 ), _mm_madd_epi16( _mm_unpacklo_epi16( r2, r3 ), vC23 ) );
+    __m128i hi = _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( r0, r1 ), vC01 ), _mm_madd_epi16( _mm_unpackhi_epi16( r2, r3 ), vC23 ) );
+    lo = _mm_srai_epi32( _mm_add_epi32( lo, vRnd ), 6 );
+    hi = _mm_srai_epi32( _mm_add_epi32( hi, vRnd ), 6 );
+
+    __m128i vRes = _mm_packs_epi32( lo, hi );
+    if( useCubicFilter )
+    {
+      vRes = _mm_min_epi16( _mm_max_epi16( vRes, vMin ), vMax );
+    }
+    _mm_storeu_si128( ( __m128i* ) &pDst[x], vRes );
+  }
+
+  for( ; x + 4 <= width; x += 4 )
+  {
+    const __m128i r0 = _mm_loadl_epi64( ( const __m128i* ) &refMain[x] );
+    const __m128i r1 = _mm_loadl_epi64( ( const __m128i* ) &refMain[x + 1] );
+    const __m128i r2 = _mm_loadl_epi64( ( const __m128i* ) &refMain[x + 2] );
+    const __m128i r3 = _mm_loadl_epi64( ( const __m128i* ) &refMain[x + 3] );
+
+    __m128i lo = _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( r0, r1 ), vC01 ), _mm_madd_epi16( _mm_unpacklo_epi16( r2, r3 ), vC23 ) );
+    lo = _mm_srai_epi32( _mm_add_epi32( lo, vRnd ), 6 );
+
+    __m128i vRes = _mm_packs_epi32( lo, lo );
+    if( useCubicFilter )
+    {
+      vRes = _mm_min_epi16( _mm_max_epi16( vRes, vMin ), vMax );
+    }
+    _mm_storel_epi64( ( __m128i* ) &pDst[x], vRes );
+  }
+
+  for( ; x < width; x++ )
+  {
+    const int val = ( f[0] * refMain[x] + f[1] * refMain[x + 1] + f[2] * refMain[x + 2] + ( f[3] != 0 ? f[3] * refMain[x + 3] : 0 ) + 32 ) >> 6;
+    pDst[x] = useCubicFilter ? ClipPel( val, clpRng ) : val;
+  }
+}
+
+template<X86_VEXT vext>
+static void simdPredIntraAngChroma( Pel* pDst, const Pel* refMain, const int width, const int deltaFract )
+{
+  const __m128i vC   = _mm_set1_epi32( coeffPair( 32 - deltaFract, deltaFract ) );
+  const __m128i vRnd = _mm_set1_epi32( 16 );
+  int x = 0;
+
+  for( ; x + 8 <= width; x += 8 )
+  {
+    const __m128i r0 = _mm_loadu_si128( ( const __m128i* ) &refMain[x] );
+    const __m128i r1 = _mm_loadu_si128( ( const __m128i* ) &refMain[x + 1] );
+
+    const __m128i lo = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( r0, r1 ), vC ), vRnd ), 5 );
+    const __m128i hi = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( r0, r1 ), vC ), vRnd ), 5 );
+    _mm_storeu_si128( ( __m128i* ) &pDst[x], _mm_packs_epi32( lo, hi ) );
+  }
+
+  for( ; x + 4 <= width; x += 4 )
+  {
+    const __m128i r0 = _mm_loadl_epi64( ( const __m128i* ) &refMain[x] );
+    const __m128i r1 = _mm_loadl_epi64( ( const __m128i* ) &refMain[x + 1] );
+
+    const __m128i lo = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( r0, r1 ), vC ), vRnd ), 5 );
+    _mm_storel_epi64( ( __m128i* ) &pDst[x], _mm_packs_epi32( lo, lo ) );
+  }
+
+  for( ; x < width; x++ )
+  {
+    pDst[x] = ( Pel ) ( ( ( 32 - deltaFract ) * refMain[x] + deltaFract * refMain[x + 1] + 16 ) >> 5 );
+  }
+}
+
+// all four modes are evaluated as ( wL * left + wT * top - wTL * topLeft + ( 64 - wL - wT + wTL ) * pred + 32 ) >> 6,
+// with wL = 0 for the horizontal mode, wT = 0 for the vertical mode and wTL = 0 for the planar mode
+template<X86_VEXT vext>
+static void simdIntraPdpcFilter( const CPelBuf &srcBuf, PelBuf &dstBuf, const uint32_t uiDirMode, const int scale, const ClpRng& clpRng )
+{
+  const int  iWidth  = dstBuf.width;
+  const int  iHeight = dstBuf.height;
+  const Pel* top     = srcBuf.buf + 1;
+  const Pel  topLeft = srcBuf.at( 0, 0 );
+
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, Pel weightL[MAX_CU_SIZE] );
+  for( int x = 0; x < iWidth; x++ )
+  {
+    weightL[x] = uiDirMode == HOR_IDX ? 0 : 32 >> std::min( 31, ( ( x << 1 ) >> scale ) );
+  }
+
+  const __m128i vTopLeft = _mm_set1_epi16( topLeft );
+  const __m128i vMin     = _mm_set1_epi16( clpRng.min );
+  const __m128i vMax     = _mm_set1_epi16( clpRng.max );
+  const __m128i vRnd     = _mm_set1_epi32( 32 );
+
+  for( int y = 0; y < iHeight; y++ )
+  {
+    const int wT   = uiDirMode == VER_IDX ? 0 : 32 >> std::min( 31, ( ( y << 1 ) >> scale ) );
+    const Pel left = srcBuf.at( 0, y + 1 );
+    Pel*      dst  = dstBuf.buf + y * dstBuf.stride;
+
+    const __m128i vLeft = _mm_set1_epi16( left );
+    const __m128i vWT   = _mm_set1_epi16( wT );
+    int x = 0;
+
+    for( ; x < iWidth - 3; x += 8 )
+    {
+      const bool    half = x + 8 > iWidth;
+      const __m128i vWL  = half ? _mm_loadl_epi64( ( const __m128i* ) &weightL[x] ) : _mm_load_si128( ( const __m128i* ) &weightL[x] );
+      const __m128i vTop = half ? _mm_loadl_epi64( ( const __m128i* ) &top[x] )     : _mm_loadu_si128( ( const __m128i* ) &top[x] );
+      const __m128i vDst = half ? _mm_loadl_epi64( ( const __m128i* ) &dst[x] )     : _mm_loadu_si128( ( const __m128i* ) &dst[x] );
+
+      __m128i vWTL;
+      switch( uiDirMode )
+      {
+      case DC_IDX:  vWTL = _mm_add_epi16( _mm_srai_epi16( vWL, 4 ), _mm_set1_epi16( wT >> 4 ) ); break;
+      case HOR_IDX: vWTL = vWT; break;
+      case VER_IDX: vWTL = vWL; break;
+      default:      vWTL = _mm_setzero_si128(); break;
+      }
+      const __m128i vWD = _mm_add_epi16( _mm_sub_epi16( _mm_sub_epi16( _mm_set1_epi16( 64 ), vWL ), vWT ), vWTL );
+      const __m128i vNegWTL = _mm_sub_epi16( _mm_setzero_si128(), vWTL );
+
+      __m128i lo = _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( vLeft, vTop ), _mm_unpacklo_epi16( vWL, vWT ) ),
+                                  _mm_madd_epi16( _mm_unpacklo_epi16( vTopLeft, vDst ), _mm_unpacklo_epi16( vNegWTL, vWD ) ) );
+      __m128i hi = _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( vLeft, vTop ), _mm_unpackhi_epi16( vWL, vWT ) ),
+                                  _mm_madd_epi16( _mm_unpackhi_epi16( vTopLeft, vDst ), _mm_unpackhi_epi16( vNegWTL, vWD ) ) );
+      lo = _mm_srai_epi32( _mm_add_epi32( lo, vRnd ), 6 );
+      hi = _mm_srai_epi32( _mm_add_epi32( hi, vRnd ), 6 );
+
+      const __m128i vRes = _mm_min_epi16( _mm_max_epi16( _mm_packs_epi32( lo, hi ), vMin ), vMax );
+      if( half )
+      {
+        _mm_storel_epi64( ( __m128i* ) &dst[x], vRes );
+      }
+      else
+      {
+        _mm_storeu_si128( ( __m128i* ) &dst[x], vRes );
+      }
+    }
+
+    for( ; x < iWidth; x++ )
+    {
+      const int wL  = weightL[x];
+      const int wTL = uiDirMode == DC_IDX ? ( wL >> 4 ) + ( wT >> 4 ) : uiDirMode == HOR_IDX ? wT : uiDirMode == VER_IDX ? wL : 0;
+      dst[x] = ClipPel( ( wL * left + wT * top[x] - wTL * topLeft + ( 64 - wL - wT + wTL ) * dst[x] + 32 ) >> 6, clpRng );
+    }
+  }
+}
+
+template <X86_VEXT vext>
+void IntraPrediction::_initIntraPredictionX86()
+{
+  m_predIntraPlanar    = simdPredIntraPlanar<vext>;
+  m_predIntraAngLuma   = simdPredIntraAngLuma<vext>;
+  m_predIntraAngChroma = simdPredIntraAngChroma<vext>;
+  m_intraPdpcFilter    = simdIntraPdpcFilter<vext>;
+}
+
+template void IntraPrediction::_initIntraPredictionX86<SIMDX86>();
+#endif //#ifdef TARGET_SIMD_X86
+#endif
+//! \}
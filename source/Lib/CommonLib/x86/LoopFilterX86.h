@@ -0,0 +1,476 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     LoopFilterX86.h
+    \brief    SIMD kernels of the deblocking filter
+*/
+#include "CommonDefX86.h"
+#include "../LoopFilter.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#if ENABLE_SIMD_OPT_DBF
+#ifdef TARGET_SIMD_X86
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <immintrin.h>
+#endif
+
+// The kernels process the lines of an edge segment in the 32 bit lanes of a register:
+// tap[k] holds sample ( first + k ) across the edge for each of the (up to) four lines.
+
+static inline void transpose4x4( __m128i& a, __m128i& b, __m128i& c, __m128i& d )
+{
+  const __m128i ab0 = _mm_unpacklo_epi32( a, b );
+  const __m128i ab1 = _mm_unpackhi_epi32( a, b );
+  const __m128i cd0 = _mm_unpacklo_epi32( c, d );
+  const __m128i cd1 = _mm_unpackhi_epi32( c, d );
+
+  a = _mm_unpacklo_epi64( ab0, cd0 );
+  b = _mm_unpackhi_epi64( ab0, cd0 );
+  c = _mm_unpacklo_epi64( ab1, cd1 );
+  d = _mm_unpackhi_epi64( ab1, cd1 );
+}
+
+template<X86_VEXT vext>
+static inline void loadTaps( const Pel* src, const int offset, const int step, const int numLines, const int first, const int numTaps, __m128i* tap )
+{
+  if( offset == 1 )
+  {
+    // vertical edge, the lines are rows: load eight samples per row and transpose
+    for( int k = 0; k < numTaps; k += 8 )
+    {
+      __m128i lo[4], hi[4];
+
+      for( int l = 0; l < 4; l++ )
+      {
+        const __m128i row = l < numLines ? _mm_loadu_si128( ( const __m128i* ) ( src + l * step + first + k ) ) : _mm_setzero_si128();
+        lo[l] = _mm_cvtepi16_epi32( row );
+        hi[l] = _mm_cvtepi16_epi32( _mm_unpackhi_epi64( row, row ) );
+      }
+
+      transpose4x4( lo[0], lo[1], lo[2], lo[3] );
+      transpose4x4( hi[0], hi[1], hi[2], hi[3] );
+
+      for( int l = 0; l < 4; l++ )
+      {
+        tap[k + l]     = lo[l];
+        tap[k + l + 4] = hi[l];
+      }
+    }
+  }
+  else
+  {
+    // horizontal edge, the lines are columns: each tap is a contiguous run of samples
+    for( int k = 0; k < numTaps; k++ )
+    {
+      const Pel* pos = src + ( first + k ) * offset;
+      tap[k] = _mm_cvtepi16_epi32( numLines == 4 ? _mm_loadl_epi64( ( const __m128i* ) pos ) : _mm_cvtsi32_si128( *( const int32_t* ) pos ) );
+    }
+  }
+}
+
+template<X86_VEXT vext>
+static inline void storeTaps( Pel* dst, const int offset, const int step, const int numLines, const int first, const int numTaps, const __m128i* tap )
+{
+  if( offset == 1 )
+  {
+    for( int k = 0; k < numTaps; k += 8 )
+    {
+      __m128i lo[4] = { tap[k + 0], tap[k + 1], tap[k + 2], tap[k + 3] };
+      __m128i hi[4] = { tap[k + 4], tap[k + 5], tap[k + 6], tap[k + 7] };
+
+      transpose4x4( lo[0], lo[1], lo[2], lo[3] );
+      transpose4x4( hi[0], hi[1], hi[2], hi[3] );
+
+      for( int l = 0; l < numLines; l++ )
+      {
+        _mm_storeu_si128( ( __m128i* ) ( dst + l * step + first + k ), _mm_packs_epi32( lo[l], hi[l] ) );
+      }
+    }
+  }
+  else
+  {
+    for( int k = 0; k < numTaps; k++ )
+    {
+      Pel* pos = dst + ( first + k ) * offset;
+      const __m128i val = _mm_packs_epi32( tap[k], tap[k] );
+
+      if( numLines == 4 )
+      {
+        _mm_storel_epi64( ( __m128i* ) pos, val );
+      }
+      else
+      {
+        *( int32_t* ) pos = _mm_cvtsi128_si32( val );
+      }
+    }
+  }
+}
+
+static inline __m128i clip3( const __m128i minVal, const __m128i maxVal, const __m128i val )
+{
+  return _mm_min_epi32( _mm_max_epi32( val, minVal ), maxVal );
+}
+
+// Clip3( val - c, val + c, filt )
+static inline __m128i clipDelta( const __m128i val, const __m128i c, const __m128i filt )
+{
+  return clip3( _mm_sub_epi32( val, c ), _mm_add_epi32( val, c ), filt );
+}
+
+// ( sum + rnd ) >> shift
+static inline __m128i roundShift( const __m128i sum, const int rnd, const int shift )
+{
+  return _mm_srai_epi32( _mm_add_epi32( sum, _mm_set1_epi32( rnd ) ), shift );
+}
+
+template<X86_VEXT vext>
+static void simdFilterLumaBlk( Pel* src, const int offset, const int step, const int tc, const bool sw, const bool partPNoFilter, const bool partQNoFilter, const int thrCut, const bool filterSecondP, const bool filterSecondQ, const ClpRng& clpRng )
+{
+  // m[0] .. m[3] are p3 .. p0, m[4] .. m[7] are q0 .. q3
+  __m128i m[8];
+  loadTaps<vext>( src, offset, step, 4, -4, 8, m );
+
+  __m128i f[8];
+  for( int k = 0; k < 8; k++ )
+  {
+    f[k] = m[k];
+  }
+
+  if( sw )
+  {
+    const __m128i tc1 = _mm_set1_epi32( 3 * tc );
+    const __m128i tc2 = _mm_set1_epi32( 2 * tc );
+    const __m128i tc3 = _mm_set1_epi32( tc );
+
+    const __m128i m34 = _mm_add_epi32( m[3], m[4] );
+    const __m128i m1234 = _mm_add_epi32( _mm_add_epi32( m[1], m[2] ), m34 );
+    const __m128i m3456 = _mm_add_epi32( _mm_add_epi32( m[5], m[6] ), m34 );
+
+    // p0: m1 + 2 * m2 + 2 * m3 + 2 * m4 + m5, q0: m2 + 2 * m3 + 2 * m4 + 2 * m5 + m6
+    const __m128i m25 = _mm_add_epi32( m[2], m[5] );
+    __m128i sum = _mm_add_epi32( _mm_add_epi32( m1234, m34 ), m25 );
+    f[3] = clipDelta( m[3], tc1, roundShift( sum, 4, 3 ) );
+    sum = _mm_add_epi32( _mm_add_epi32( m3456, m34 ), m25 );
+    f[4] = clipDelta( m[4], tc1, roundShift( sum, 4, 3 ) );
+
+    // p1, q1
+    f[2] = clipDelta( m[2], tc2, roundShift( m1234, 2, 2 ) );
+    f[5] = clipDelta( m[5], tc2, roundShift( m3456, 2, 2 ) );
+
+    // p2: ( 2 * m0 + 3 * m1 + m2 + m3 + m4 + 4 ) >> 3, q2: ( m3 + m4 + m5 + 3 * m6 + 2 * m7 + 4 ) >> 3
+    sum = _mm_add_epi32( m1234, _mm_slli_epi32( _mm_add_epi32( m[0], m[1] ), 1 ) );
+    f[1] = clipDelta( m[1], tc3, roundShift( sum, 4, 3 ) );
+    sum = _mm_add_epi32( m3456, _mm_slli_epi32( _mm_add_epi32( m[6], m[7] ), 1 ) );
+    f[6] = clipDelta( m[6], tc3, roundShift( sum, 4, 3 ) );
+  }
+  else
+  {
+    const __m128i vtc  = _mm_set1_epi32( tc );
+    const __m128i vntc = _mm_set1_epi32( -tc );
+    const __m128i vmin = _mm_set1_epi32( clpRng.min );
+    const __m128i vmax = _mm_set1_epi32( clpRng.max );
+
+    // delta = ( 9 * ( m4 - m3 ) - 3 * ( m5 - m2 ) + 8 ) >> 4
+    const __m128i d43 = _mm_sub_epi32( m[4], m[3] );
+    const __m128i d52 = _mm_sub_epi32( m[5], m[2] );
+    __m128i delta = _mm_sub_epi32( _mm_add_epi32( _mm_slli_epi32( d43, 3 ), d43 ), _mm_add_epi32( _mm_slli_epi32( d52, 1 ), d52 ) );
+    delta = roundShift( delta, 8, 4 );
+
+    const __m128i mask = _mm_cmplt_epi32( _mm_abs_epi32( delta ), _mm_set1_epi32( thrCut ) );
+    if( _mm_movemask_epi8( mask ) == 0 )
+    {
+      return;
+    }
+
+    delta = clip3( vntc, vtc, delta );
+    f[3] = _mm_blendv_epi8( m[3], clip3( vmin, vmax, _mm_add_epi32( m[3], delta ) ), mask );
+    f[4] = _mm_blendv_epi8( m[4], clip3( vmin, vmax, _mm_sub_epi32( m[4], delta ) ), mask );
+
+    const __m128i vtc2  = _mm_set1_epi32( tc >> 1 );
+    const __m128i vntc2 = _mm_set1_epi32( -( tc >> 1 ) );
+    if( filterSecondP )
+    {
+      // delta1 = Clip3( -tc2, tc2, ( ( ( ( m1 + m3 + 1 ) >> 1 ) - m2 + delta ) >> 1 ) )
+      __m128i delta1 = _mm_sub_epi32( roundShift( _mm_add_epi32( m[1], m[3] ), 1, 1 ), m[2] );
+      delta1 = clip3( vntc2, vtc2, _mm_srai_epi32( _mm_add_epi32( delta1, delta ), 1 ) );
+      f[2] = _mm_blendv_epi8( m[2], clip3( vmin, vmax, _mm_add_epi32( m[2], delta1 ) ), mask );
+    }
+    if( filterSecondQ )
+    {
+      // delta2 = Clip3( -tc2, tc2, ( ( ( ( m6 + m4 + 1 ) >> 1 ) - m5 - delta ) >> 1 ) )
+      __m128i delta2 = _mm_sub_epi32( roundShift( _mm_add_epi32( m[6], m[4] ), 1, 1 ), m[5] );
+      delta2 = clip3( vntc2, vtc2, _mm_srai_epi32( _mm_sub_epi32( delta2, delta ), 1 ) );
+      f[5] = _mm_blendv_epi8( m[5], clip3( vmin, vmax, _mm_add_epi32( m[5], delta2 ) ), mask );
+    }
+  }
+
+  if( partPNoFilter )
+  {
+    f[1] = m[1];
+    f[2] = m[2];
+    f[3] = m[3];
+  }
+  if( partQNoFilter )
+  {
+    f[4] = m[4];
+    f[5] = m[5];
+    f[6] = m[6];
+  }
+
+  if( offset == 1 )
+  {
+    storeTaps<vext>( src, offset, step, 4, -4, 8, f );
+  }
+  else
+  {
+    storeTaps<vext>( src, offset, step, 4, -3, 6, f + 1 );
+  }
+}
+
+template<X86_VEXT vext>
+static void simdFilterLumaLongBlk( Pel* src, const int offset, const int step, const int tc, const bool partPNoFilter, const bool partQNoFilter, const int numberPSide, const int numberQSide, const ClpRng& clpRng )
+{
+  CHECK( numberPSide <= 3 && numberQSide <= 3, "Short filtering in long filtering function" );
+
+  static const int dbCoeffs7[7] = { 59, 50, 41, 32, 23, 14, 5 };
+  static const int dbCoeffs5[5] = { 58, 45, 32, 19, 6 };
+  static const int dbCoeffs3[3] = { 53, 32, 11 };
+  static const int tc7[7]       = { 6, 5, 4, 3, 2, 1, 1 };
+  static const int tc3[3]       = { 6, 4, 2 };
+
+  // v[0] .. v[7] are p7 .. p0, v[8] .. v[15] are q0 .. q7
+  __m128i v[16];
+  loadTaps<vext>( src, offset, step, 4, -8, 16, v );
+
+  __m128i p[8], q[8];
+  for( int k = 0; k < 8; k++ )
+  {
+    p[k] = v[7 - k];
+    q[k] = v[8 + k];
+  }
+
+  // sum of p[0] .. p[n - 1] and q[0] .. q[n - 1]
+  auto sumPQ = [&]( const int n )
+  {
+    __m128i sum = _mm_add_epi32( p[0], q[0] );
+    for( int k = 1; k < n; k++ )
+    {
+      sum = _mm_add_epi32( sum, _mm_add_epi32( p[k], q[k] ) );
+    }
+    return sum;
+  };
+
+  const __m128i refP = roundShift( _mm_add_epi32( p[numberPSide - 1], p[numberPSide] ), 1, 1 );
+  const __m128i refQ = roundShift( _mm_add_epi32( q[numberQSide - 1], q[numberQSide] ), 1, 1 );
+  __m128i refMiddle;
+
+  if( numberPSide == numberQSide )
+  {
+    if( numberPSide == 5 )
+    {
+      refMiddle = roundShift( _mm_add_epi32( sumPQ( 5 ), sumPQ( 3 ) ), 8, 4 );
+    }
+    else
+    {
+      refMiddle = roundShift( _mm_add_epi32( sumPQ( 7 ), _mm_add_epi32( p[0], q[0] ) ), 8, 4 );
+    }
+  }
+  else
+  {
+    const int newNumberPSide = std::max( numberPSide, numberQSide );
+    const int newNumberQSide = std::min( numberPSide, numberQSide );
+    const __m128i* pt = numberQSide > numberPSide ? q : p;
+    const __m128i* qt = numberQSide > numberPSide ? p : q;
+
+    if( newNumberPSide == 7 && newNumberQSide == 5 )
+    {
+      refMiddle = roundShift( _mm_add_epi32( sumPQ( 6 ), sumPQ( 2 ) ), 8, 4 );
+    }
+    else if( newNumberPSide == 7 && newNumberQSide == 3 )
+    {
+      // 2 * ( pt0 + qt0 ) + qt0 + 2 * ( qt1 + qt2 ) + pt1 + qt1 + pt2 + pt3 + pt4 + pt5 + pt6
+      __m128i sum = _mm_slli_epi32( _mm_add_epi32( _mm_add_epi32( pt[0], qt[0] ), _mm_add_epi32( qt[1], qt[2] ) ), 1 );
+      sum = _mm_add_epi32( sum, _mm_add_epi32( qt[0], qt[1] ) );
+      for( int k = 1; k < 7; k++ )
+      {
+        sum = _mm_add_epi32( sum, pt[k] );
+      }
+      refMiddle = roundShift( sum, 8, 4 );
+    }
+    else
+    {
+      refMiddle = roundShift( sumPQ( 4 ), 4, 3 );
+    }
+  }
+
+  auto bilinear = [&]( __m128i* side, const __m128i ref, const int numberSide )
+  {
+    const int* dbCoeffs = numberSide == 7 ? dbCoeffs7 : numberSide == 5 ? dbCoeffs5 : dbCoeffs3;
+    const int* tcSide   = numberSide == 3 ? tc3 : tc7;
+
+    for( int pos = 0; pos < numberSide; pos++ )
+    {
+      const __m128i filt = _mm_add_epi32( _mm_mullo_epi32( refMiddle, _mm_set1_epi32( dbCoeffs[pos] ) ), _mm_mullo_epi32( ref, _mm_set1_epi32( 64 - dbCoeffs[pos] ) ) );
+      side[pos] = clipDelta( side[pos], _mm_set1_epi32( ( tc * tcSide[pos] ) >> 1 ), roundShift( filt, 32, 6 ) );
+    }
+  };
+
+  if( !partPNoFilter )
+  {
+    bilinear( p, refP, numberPSide );
+  }
+  if( !partQNoFilter )
+  {
+    bilinear( q, refQ, numberQSide );
+  }
+
+  for( int k = 0; k < 8; k++ )
+  {
+    v[7 - k] = p[k];
+    v[8 + k] = q[k];
+  }
+
+  if( offset == 1 )
+  {
+    storeTaps<vext>( src, offset, step, 4, -8, 16, v );
+  }
+  else
+  {
+    storeTaps<vext>( src, offset, step, 4, -numberPSide, numberPSide + numberQSide, v + 8 - numberPSide );
+  }
+}
+
+template<X86_VEXT vext>
+static void simdFilterChromaBlk( Pel* src, const int offset, const int step, const int numLines, const int tc, const bool sw, const bool partPNoFilter, const bool partQNoFilter, const ClpRng& clpRng, const bool largeBoundary )
+{
+  CHECK( numLines != 2 && numLines != 4, "Unsupported chroma edge segment length" );
+
+  // m[0] .. m[3] are p3 .. p0, m[4] .. m[7] are q0 .. q3
+  __m128i m[8];
+  loadTaps<vext>( src, offset, step, numLines, -4, 8, m );
+
+  __m128i f[8];
+  for( int k = 0; k < 8; k++ )
+  {
+    f[k] = m[k];
+  }
+
+  const __m128i vtc = _mm_set1_epi32( tc );
+
+  if( sw )
+  {
+    const __m128i m012 = _mm_add_epi32( _mm_add_epi32( m[0], m[1] ), m[2] );
+    const __m128i m567 = _mm_add_epi32( _mm_add_epi32( m[5], m[6] ), m[7] );
+    const __m128i m34  = _mm_add_epi32( m[3], m[4] );
+
+    // p2: 3 * m0 + 2 * m1 + m2 + m3 + m4
+    __m128i sum = _mm_add_epi32( _mm_add_epi32( m012, m34 ), _mm_add_epi32( _mm_slli_epi32( m[0], 1 ), m[1] ) );
+    f[1] = clipDelta( m[1], vtc, roundShift( sum, 4, 3 ) );
+    // p1: 2 * m0 + m1 + 2 * m2 + m3 + m4 + m5
+    sum = _mm_add_epi32( _mm_add_epi32( m012, m34 ), _mm_add_epi32( _mm_add_epi32( m[0], m[2] ), m[5] ) );
+    f[2] = clipDelta( m[2], vtc, roundShift( sum, 4, 3 ) );
+    // p0: m0 + m1 + m2 + 2 * m3 + m4 + m5 + m6
+    sum = _mm_add_epi32( _mm_add_epi32( m012, m34 ), _mm_add_epi32( _mm_add_epi32( m[3], m[5] ), m[6] ) );
+    f[3] = clipDelta( m[3], vtc, roundShift( sum, 4, 3 ) );
+    // q0: m1 + m2 + m3 + 2 * m4 + m5 + m6 + m7
+    sum = _mm_add_epi32( _mm_add_epi32( m567, m34 ), _mm_add_epi32( _mm_add_epi32( m[1], m[2] ), m[4] ) );
+    f[4] = clipDelta( m[4], vtc, roundShift( sum, 4, 3 ) );
+    // q1: m2 + m3 + m4 + 2 * m5 + m6 + 2 * m7
+    sum = _mm_add_epi32( _mm_add_epi32( m567, m34 ), _mm_add_epi32( _mm_add_epi32( m[2], m[5] ), m[7] ) );
+    f[5] = clipDelta( m[5], vtc, roundShift( sum, 4, 3 ) );
+    // q2: m3 + m4 + m5 + 2 * m6 + 3 * m7
+    sum = _mm_add_epi32( _mm_add_epi32( m567, m34 ), _mm_add_epi32( _mm_slli_epi32( m[7], 1 ), m[6] ) );
+    f[6] = clipDelta( m[6], vtc, roundShift( sum, 4, 3 ) );
+  }
+  else
+  {
+    const __m128i vmin = _mm_set1_epi32( clpRng.min );
+    const __m128i vmax = _mm_set1_epi32( clpRng.max );
+
+    // delta = Clip3( -tc, tc, ( ( ( m4 - m3 ) << 2 ) + m2 - m5 + 4 ) >> 3 )
+    __m128i delta = _mm_add_epi32( _mm_slli_epi32( _mm_sub_epi32( m[4], m[3] ), 2 ), _mm_sub_epi32( m[2], m[5] ) );
+    delta = clip3( _mm_set1_epi32( -tc ), vtc, roundShift( delta, 4, 3 ) );
+
+    f[3] = clip3( vmin, vmax, _mm_add_epi32( m[3], delta ) );
+    f[4] = clip3( vmin, vmax, _mm_sub_epi32( m[4], delta ) );
+  }
+
+  if( partPNoFilter )
+  {
+    if( largeBoundary )
+    {
+      f[1] = m[1];
+      f[2] = m[2];
+    }
+    f[3] = m[3];
+  }
+  if( partQNoFilter )
+  {
+    if( largeBoundary )
+    {
+      f[5] = m[5];
+      f[6] = m[6];
+    }
+    f[4] = m[4];
+  }
+
+  if( offset == 1 )
+  {
+    storeTaps<vext>( src, offset, step, numLines, -4, 8, f );
+  }
+  else if( sw )
+  {
+    storeTaps<vext>( src, offset, step, numLines, -3, 6, f + 1 );
+  }
+  else
+  {
+    storeTaps<vext>( src, offset, step, numLines, -1, 2, f + 3 );
+  }
+}
+
+template <X86_VEXT vext>
+void LoopFilter::_initLoopFilterX86()
+{
+  m_filterLumaBlk     = simdFilterLumaBlk<vext>;
+  m_filterLumaLongBlk = simdFilterLumaLongBlk<vext>;
+  m_filterChromaBlk   = simdFilterChromaBlk<vext>;
+}
+
+template void LoopFilter::_initLoopFilterX86<SIMDX86>();
+#endif //#ifdef TARGET_SIMD_X86
+#endif
+//! \}
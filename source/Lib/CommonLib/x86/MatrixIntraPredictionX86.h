@@ -0,0 +1,319 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     MatrixIntraPredictionX86.h
+    \brief    SIMD for the matrix-based intra prediction
+*/
+#include "CommonDefX86.h"
+#include "../MatrixIntraPrediction.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#if JVET_N0217_MATRIX_INTRAPRED
+#if ENABLE_SIMD_OPT_MIP
+#ifdef TARGET_SIMD_X86
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <immintrin.h>
+#endif
+
+namespace Mip
+{
+
+// ( v + ( 1 << ( log2Factor - 1 ) ) - ( v < 0 ? 1 : 0 ) ) >> log2Factor
+static inline __m128i mipRound( const __m128i v, const int log2Factor )
+{
+  const __m128i vRnd = _mm_set1_epi32( 1 << ( log2Factor - 1 ) );
+  const __m128i vNeg = _mm_cmpgt_epi32( _mm_setzero_si128(), v );
+
+  return _mm_sra_epi32( _mm_add_epi32( _mm_add_epi32( v, vRnd ), vNeg ), _mm_cvtsi32_si128( log2Factor ) );
+}
+
+template<X86_VEXT vext>
+static void simdDoDownsampling( int* dst, const int* src, const SizeType srcLen, const SizeType dstLen )
+{
+  const SizeType downsmpFactor     = srcLen / dstLen;
+  const int      log2DownsmpFactor = g_aucLog2[downsmpFactor];
+  CHECKD( srcLen != dstLen * downsmpFactor, "Need integer downsampling factor." );
+  CHECKD( ( downsmpFactor & ( downsmpFactor - 1 ) ) != 0, "Need power of two downsampling factor." );
+
+  // four output samples per iteration, dst may be equal to src since all samples of an iteration are read before they are written
+  SizeType dstIdx = 0;
+  for( ; dstIdx + 4 <= dstLen; dstIdx += 4 )
+  {
+    const int* s = src + dstIdx * downsmpFactor;
+    __m128i vSum;
+
+    if( downsmpFactor == 2 )
+    {
+      vSum = _mm_hadd_epi32( _mm_loadu_si128( ( const __m128i* ) s ), _mm_loadu_si128( ( const __m128i* ) ( s + 4 ) ) );
+    }
+    else
+    {
+      __m128i vAcc[4];
+      for( int k = 0; k < 4; k++, s += downsmpFactor )
+      {
+        if( downsmpFactor == 4 )
+        {
+          vAcc[k] = _mm_loadu_si128( ( const __m128i* ) s );
+          continue;
+        }
+        vAcc[k] = _mm_setzero_si128();
+        for( SizeType i = 0; i < downsmpFactor; i += 4 )
+        {
+          vAcc[k] = _mm_add_epi32( vAcc[k], _mm_loadu_si128( ( const __m128i* ) ( s + i ) ) );
+        }
+      }
+      vSum = _mm_hadd_epi32( _mm_hadd_epi32( vAcc[0], vAcc[1] ), _mm_hadd_epi32( vAcc[2], vAcc[3] ) );
+    }
+
+    _mm_storeu_si128( ( __m128i* ) ( dst + dstIdx ), mipRound( vSum, log2DownsmpFactor ) );
+  }
+
+  const int roundingOffsetPositive = ( 1 << ( log2DownsmpFactor - 1 ) );
+  for( SizeType srcIdx = dstIdx * downsmpFactor; dstIdx < dstLen; ++dstIdx )
+  {
+    int sum = 0;
+    for( SizeType blockIdx = 0; blockIdx < downsmpFactor; ++blockIdx, ++srcIdx )
+    {
+      sum += src[srcIdx];
+    }
+    dst[dstIdx] = ( sum + roundingOffsetPositive - ( sum < 0 ? 1 : 0 ) ) >> log2DownsmpFactor;
+  }
+}
+
+template<X86_VEXT vext>
+static void simdPredictionUpsampling1D( int* const dst, const int* const src, const int* const bndry,
+                                        const SizeType srcSizeUpsmpDim, const SizeType srcSizeOrthDim,
+                                        const SizeType srcStep, const SizeType srcStride,
+                                        const SizeType dstStep, const SizeType dstStride,
+                                        const unsigned int upsmpFactor )
+{
+  const int log2UpsmpFactor = g_aucLog2[upsmpFactor];
+  CHECKD( upsmpFactor <= 1, "Upsampling factor must be at least 2." );
+
+  if( dstStep == 1 )
+  {
+    // upsampling along the lines: the upsmpFactor samples between two input samples are computed at once with the
+    // weights ( upsmpFactor - pos, pos ), pos = 1..upsmpFactor; for upsmpFactor 2 two input samples are processed at once
+    const __m128i vPos     = _mm_setr_epi32( 1, 2, 3, 4 );
+    const __m128i vPos2    = _mm_setr_epi32( 1, 2, 1, 2 );
+    const __m128i vPos2Inv = _mm_setr_epi32( 1, 0, 1, 0 );
+
+    for( SizeType idxOrthDim = 0; idxOrthDim < srcSizeOrthDim; idxOrthDim++ )
+    {
+      const int* behind  = src + idxOrthDim * srcStride;
+      int*       currDst = dst + idxOrthDim * dstStride;
+      int        before  = bndry[idxOrthDim];
+
+      for( SizeType idxUpsmpDim = 0; idxUpsmpDim < srcSizeUpsmpDim; )
+      {
+        if( upsmpFactor == 2 && idxUpsmpDim + 2 <= srcSizeUpsmpDim )
+        {
+          const int behind0 = behind[0];
+          const int behind1 = behind[srcStep];
+          const __m128i vBefore = _mm_setr_epi32( before,  before,  behind0, behind0 );
+          const __m128i vBehind = _mm_setr_epi32( behind0, behind0, behind1, behind1 );
+
+          const __m128i v = _mm_add_epi32( _mm_mullo_epi32( vBefore, vPos2Inv ), _mm_mullo_epi32( vBehind, vPos2 ) );
+          _mm_storeu_si128( ( __m128i* ) currDst, mipRound( v, 1 ) );
+
+          before       = behind1;
+          behind      += 2 * srcStep;
+          currDst     += 4;
+          idxUpsmpDim += 2;
+          continue;
+        }
+
+        if( upsmpFactor == 2 )
+        {
+          currDst[0] = ( before + *behind + 1 - ( before + *behind < 0 ? 1 : 0 ) ) >> 1;
+          currDst[1] = *behind;
+
+          before       = *behind;
+          behind      += srcStep;
+          currDst     += 2;
+          idxUpsmpDim += 1;
+          continue;
+        }
+
+        const __m128i vBefore = _mm_set1_epi32( before );
+        const __m128i vBehind = _mm_set1_epi32( *behind );
+        for( unsigned int pos = 0; pos < upsmpFactor; pos += 4 )
+        {
+          const __m128i vP = _mm_add_epi32( vPos, _mm_set1_epi32( pos ) );
+          const __m128i vQ = _mm_sub_epi32( _mm_set1_epi32( upsmpFactor ), vP );
+
+          const __m128i v = _mm_add_epi32( _mm_mullo_epi32( vBefore, vQ ), _mm_mullo_epi32( vBehind, vP ) );
+          _mm_storeu_si128( ( __m128i* ) ( currDst + pos ), mipRound( v, log2UpsmpFactor ) );
+        }
+
+        before       = *behind;
+        behind      += srcStep;
+        currDst     += upsmpFactor;
+        idxUpsmpDim += 1;
+      }
+    }
+    return;
+  }
+
+  // upsampling across the lines: four neighbouring lines are computed at once, with the same incremental weights as the
+  // scalar version
+  SizeType idxOrthDim = 0;
+  for( ; idxOrthDim + 4 <= srcSizeOrthDim; idxOrthDim += 4 )
+  {
+    const int* behind  = src + idxOrthDim * srcStride;
+    int*       currDst = dst + idxOrthDim * dstStride;
+    __m128i    vBefore = _mm_loadu_si128( ( const __m128i* ) ( bndry + idxOrthDim ) );
+
+    for( SizeType idxUpsmpDim = 0; idxUpsmpDim < srcSizeUpsmpDim; idxUpsmpDim++, behind += srcStep )
+    {
+      const __m128i vBehind = srcStride == 1 ? _mm_loadu_si128( ( const __m128i* ) behind )
+                                             : _mm_setr_epi32( behind[0], behind[srcStride], behind[2 * srcStride], behind[3 * srcStride] );
+
+      __m128i vScaledBefore = _mm_slli_epi32( vBefore, log2UpsmpFactor );
+      __m128i vScaledBehind = _mm_setzero_si128();
+      for( unsigned int pos = 1; pos <= upsmpFactor; pos++, currDst += dstStep )
+      {
+        vScaledBefore = _mm_sub_epi32( vScaledBefore, vBefore );
+        vScaledBehind = _mm_add_epi32( vScaledBehind, vBehind );
+
+        const __m128i v = mipRound( _mm_add_epi32( vScaledBefore, vScaledBehind ), log2UpsmpFactor );
+        if( dstStride == 1 )
+        {
+          _mm_storeu_si128( ( __m128i* ) currDst, v );
+        }
+        else
+        {
+          currDst[0]             = _mm_extract_epi32( v, 0 );
+          currDst[dstStride]     = _mm_extract_epi32( v, 1 );
+          currDst[2 * dstStride] = _mm_extract_epi32( v, 2 );
+          currDst[3 * dstStride] = _mm_extract_epi32( v, 3 );
+        }
+      }
+      vBefore = vBehind;
+    }
+  }
+
+  for( ; idxOrthDim < srcSizeOrthDim; idxOrthDim++ )
+  {
+    const int* before  = bndry + idxOrthDim;
+    const int* behind  = src + idxOrthDim * srcStride;
+    int*       currDst = dst + idxOrthDim * dstStride;
+
+    for( SizeType idxUpsmpDim = 0; idxUpsmpDim < srcSizeUpsmpDim; idxUpsmpDim++ )
+    {
+      int scaledBefore = ( *before ) << log2UpsmpFactor;
+      int scaledBehind = 0;
+      for( unsigned int pos = 1; pos <= upsmpFactor; pos++, currDst += dstStep )
+      {
+        scaledBefore -= *before;
+        scaledBehind += *behind;
+        const int v = scaledBefore + scaledBehind;
+        *currDst = ( v + ( 1 << ( log2UpsmpFactor - 1 ) ) - ( v < 0 ? 1 : 0 ) ) >> log2UpsmpFactor;
+      }
+      before  = behind;
+      behind += srcStep;
+    }
+  }
+}
+
+template<X86_VEXT vext>
+static void simdComputeMatrixTimesRedBndry( int* const result, const int* const input, const short* matrix, const short* bias,
+                                            const int inputSize, const int outWidth, const int outHeight, const int xStep, const int yStep,
+                                            const int shiftMatrix, const int shiftBias )
+{
+  CHECKD( outWidth & 3, "Output width must be a multiple of four" );
+
+  // the reduced boundary fits into 16 bit, so that four products of a matrix row are summed by each _mm_madd_epi16
+  const __m128i vIn = inputSize == 8 ? _mm_packs_epi32( _mm_loadu_si128( ( const __m128i* ) input ), _mm_loadu_si128( ( const __m128i* ) ( input + 4 ) ) )
+                                     : _mm_packs_epi32( _mm_loadu_si128( ( const __m128i* ) input ), _mm_loadu_si128( ( const __m128i* ) input ) );
+  const __m128i vOffset     = _mm_set1_epi32( 1 << ( shiftMatrix - 1 ) );
+  const __m128i vShiftBias  = _mm_cvtsi32_si128( shiftBias );
+  const __m128i vShiftMat   = _mm_cvtsi32_si128( shiftMatrix );
+  const int     weightStep  = xStep * inputSize;
+
+  const short* weight  = matrix;
+  int          posRes  = 0;
+  int          posBias = 0;
+  for( int y = 0; y < outHeight; y++ )
+  {
+    for( int x = 0; x < outWidth; x += 4 )
+    {
+      __m128i vSum;
+      if( inputSize == 8 )
+      {
+        const __m128i m0 = _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) ( weight ) ),                  vIn );
+        const __m128i m1 = _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) ( weight + weightStep ) ),     vIn );
+        const __m128i m2 = _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) ( weight + 2 * weightStep ) ), vIn );
+        const __m128i m3 = _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) ( weight + 3 * weightStep ) ), vIn );
+        vSum = _mm_hadd_epi32( _mm_hadd_epi32( m0, m1 ), _mm_hadd_epi32( m2, m3 ) );
+      }
+      else
+      {
+        const __m128i w01 = _mm_unpacklo_epi64( _mm_loadl_epi64( ( const __m128i* ) ( weight ) ),                  _mm_loadl_epi64( ( const __m128i* ) ( weight + weightStep ) ) );
+        const __m128i w23 = _mm_unpacklo_epi64( _mm_loadl_epi64( ( const __m128i* ) ( weight + 2 * weightStep ) ), _mm_loadl_epi64( ( const __m128i* ) ( weight + 3 * weightStep ) ) );
+        vSum = _mm_hadd_epi32( _mm_madd_epi16( w01, vIn ), _mm_madd_epi16( w23, vIn ) );
+      }
+
+      const __m128i vBias = _mm_setr_epi32( bias[posBias], bias[posBias + xStep], bias[posBias + 2 * xStep], bias[posBias + 3 * xStep] );
+      vSum = _mm_add_epi32( _mm_add_epi32( vSum, _mm_sll_epi32( vBias, vShiftBias ) ), vOffset );
+      _mm_storeu_si128( ( __m128i* ) ( result + posRes ), _mm_sra_epi32( vSum, vShiftMat ) );
+
+      weight  += 4 * weightStep;
+      posRes  += 4;
+      posBias += 4 * xStep;
+    }
+    weight  += yStep * inputSize;
+    posBias += yStep;
+  }
+}
+
+template <X86_VEXT vext>
+void PredictorMIP::_initPredictorMipX86()
+{
+  m_doDownsampling             = simdDoDownsampling<vext>;
+  m_predictionUpsampling1D     = simdPredictionUpsampling1D<vext>;
+  m_computeMatrixTimesRedBndry = simdComputeMatrixTimesRedBndry<vext>;
+}
+
+template void PredictorMIP::_initPredictorMipX86<SIMDX86>();
+
+} // namespace Mip
+
+#endif //#ifdef TARGET_SIMD_X86
+#endif
+#endif //#if JVET_N0217_MATRIX_INTRAPRED
+//! \}
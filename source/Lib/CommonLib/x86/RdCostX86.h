@@ -43,6 +43,503 @@
 
 #ifdef TARGET_SIMD_X86
 
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+// ====================================================================================================================
+// High bit depth kernels: Pel is a 32 bit type, every sample occupies one 32 bit lane
+// ====================================================================================================================
+
+template< X86_VEXT vext >
+Distortion RdCost::xGetSAD_SIMD( const DistParam &rcDtParam )
+{
+  if( rcDtParam.org.width < 4 || ( rcDtParam.org.width & 3 ) || rcDtParam.applyWeight )
+    return RdCost::xGetSAD( rcDtParam );
+
+  const Pel* pSrc1      = rcDtParam.org.buf;
+  const Pel* pSrc2      = rcDtParam.cur.buf;
+  int  iRows            = rcDtParam.org.height;
+  int  iCols            = rcDtParam.org.width;
+  int  iSubShift        = rcDtParam.subShift;
+  int  iSubStep         = ( 1 << iSubShift );
+  const int iStrideSrc1 = rcDtParam.org.stride * iSubStep;
+  const int iStrideSrc2 = rcDtParam.cur.stride * iSubStep;
+
+  // a lane collects at most 32 * 128 absolute differences of up to 17 bits, which fits into 32 bits
+  __m128i vsum32 = _mm_setzero_si128();
+#ifdef USE_AVX2
+  __m256i vsum32x8 = _mm256_setzero_si256();
+#endif
+  for( int iY = 0; iY < iRows; iY += iSubStep )
+  {
+    int iX = 0;
+#ifdef USE_AVX2
+    for( ; iX + 8 <= iCols; iX += 8 )
+    {
+      __m256i vsrc1 = _mm256_loadu_si256( ( const __m256i* )( &pSrc1[iX] ) );
+      __m256i vsrc2 = _mm256_loadu_si256( ( const __m256i* )( &pSrc2[iX] ) );
+      vsum32x8 = _mm256_add_epi32( vsum32x8, _mm256_abs_epi32( _mm256_sub_epi32( vsrc1, vsrc2 ) ) );
+    }
+#endif
+    for( ; iX < iCols; iX += 4 )
+    {
+      __m128i vsrc1 = _mm_loadu_si128( ( const __m128i* )( &pSrc1[iX] ) );
+      __m128i vsrc2 = _mm_loadu_si128( ( const __m128i* )( &pSrc2[iX] ) );
+      vsum32 = _mm_add_epi32( vsum32, _mm_abs_epi32( _mm_sub_epi32( vsrc1, vsrc2 ) ) );
+    }
+    pSrc1 += iStrideSrc1;
+    pSrc2 += iStrideSrc2;
+  }
+#ifdef USE_AVX2
+  vsum32 = _mm_add_epi32( vsum32, _mm256_castsi256_si128( vsum32x8 ) );
+  vsum32 = _mm_add_epi32( vsum32, _mm256_extracti128_si256( vsum32x8, 1 ) );
+#endif
+  __m128i vsum64 = _mm_add_epi64( _mm_unpacklo_epi32( vsum32, _mm_setzero_si128() ), _mm_unpackhi_epi32( vsum32, _mm_setzero_si128() ) );
+  vsum64 = _mm_add_epi64( vsum64, _mm_unpackhi_epi64( vsum64, vsum64 ) );
+  Distortion uiSum = _mm_cvtsi128_si64( vsum64 );
+
+  uiSum <<= iSubShift;
+  return uiSum >> DISTORTION_PRECISION_ADJUSTMENT( rcDtParam.bitDepth );
+}
+
+template< typename Torg, typename Tcur, X86_VEXT vext >
+Distortion RdCost::xGetSSE_SIMD( const DistParam &rcDtParam )
+{
+  if( ( rcDtParam.org.width & 3 ) || rcDtParam.applyWeight )
+    return RdCost::xGetSSE( rcDtParam );
+
+  const Torg* pSrc1     = rcDtParam.org.buf;
+  const Tcur* pSrc2     = rcDtParam.cur.buf;
+  int  iRows            = rcDtParam.org.height;
+  int  iCols            = rcDtParam.org.width;
+  const int iStrideSrc1 = rcDtParam.org.stride;
+  const int iStrideSrc2 = rcDtParam.cur.stride;
+
+  // the squares are built as 64 bit products and shifted one by one, as in the scalar implementation
+  const __m128i vshift = _mm_cvtsi32_si128( DISTORTION_PRECISION_ADJUSTMENT( rcDtParam.bitDepth ) << 1 );
+  __m128i vsum = _mm_setzero_si128();
+#ifdef USE_AVX2
+  __m256i vsum8 = _mm256_setzero_si256();
+#endif
+
+  for( int iY = 0; iY < iRows; iY++ )
+  {
+    int iX = 0;
+#ifdef USE_AVX2
+    for( ; iX + 8 <= iCols; iX += 8 )
+    {
+      const __m256i vdiff = _mm256_sub_epi32( _mm256_loadu_si256( ( const __m256i* ) &pSrc1[iX] ), _mm256_loadu_si256( ( const __m256i* ) &pSrc2[iX] ) );
+      const __m256i vodd  = _mm256_srli_epi64( vdiff, 32 );
+      vsum8 = _mm256_add_epi64( vsum8, _mm256_srl_epi64( _mm256_mul_epi32( vdiff, vdiff ), vshift ) );
+      vsum8 = _mm256_add_epi64( vsum8, _mm256_srl_epi64( _mm256_mul_epi32( vodd,  vodd  ), vshift ) );
+    }
+#endif
+    for( ; iX < iCols; iX += 4 )
+    {
+      const __m128i vdiff = _mm_sub_epi32( _mm_loadu_si128( ( const __m128i* ) &pSrc1[iX] ), _mm_loadu_si128( ( const __m128i* ) &pSrc2[iX] ) );
+      const __m128i vodd  = _mm_srli_epi64( vdiff, 32 );
+      vsum = _mm_add_epi64( vsum, _mm_srl_epi64( _mm_mul_epi32( vdiff, vdiff ), vshift ) );
+      vsum = _mm_add_epi64( vsum, _mm_srl_epi64( _mm_mul_epi32( vodd,  vodd  ), vshift ) );
+    }
+    pSrc1 += iStrideSrc1;
+    pSrc2 += iStrideSrc2;
+  }
+
+#ifdef USE_AVX2
+  vsum = _mm_add_epi64( vsum, _mm256_castsi256_si128( vsum8 ) );
+  vsum = _mm_add_epi64( vsum, _mm256_extracti128_si256( vsum8, 1 ) );
+#endif
+  vsum = _mm_add_epi64( vsum, _mm_unpackhi_epi64( vsum, vsum ) );
+  return _mm_cvtsi128_si64( vsum );
+}
+
+// butterflies of the Hadamard transform along the registers r[0], r[s], r[2s], ...
+static inline void xHadVer4_HBD( __m128i* r, const int s )
+{
+  for( int k = 0; k < 2; k++ )
+  {
+    const __m128i a = r[k * s], b = r[( k + 2 ) * s];
+    r[k * s] = _mm_add_epi32( a, b ); r[( k + 2 ) * s] = _mm_sub_epi32( a, b );
+  }
+  for( int k = 0; k < 4; k += 2 )
+  {
+    const __m128i a = r[k * s], b = r[( k + 1 ) * s];
+    r[k * s] = _mm_add_epi32( a, b ); r[( k + 1 ) * s] = _mm_sub_epi32( a, b );
+  }
+}
+
+static inline void xHadVer8_HBD( __m128i* r, const int s )
+{
+  for( int k = 0; k < 4; k++ )
+  {
+    const __m128i a = r[k * s], b = r[( k + 4 ) * s];
+    r[k * s] = _mm_add_epi32( a, b ); r[( k + 4 ) * s] = _mm_sub_epi32( a, b );
+  }
+  for( int k = 0; k < 8; k += ( k & 1 ) ? 3 : 1 )
+  {
+    const __m128i a = r[k * s], b = r[( k + 2 ) * s];
+    r[k * s] = _mm_add_epi32( a, b ); r[( k + 2 ) * s] = _mm_sub_epi32( a, b );
+  }
+  for( int k = 0; k < 8; k += 2 )
+  {
+    const __m128i a = r[k * s], b = r[( k + 1 ) * s];
+    r[k * s] = _mm_add_epi32( a, b ); r[( k + 1 ) * s] = _mm_sub_epi32( a, b );
+  }
+}
+
+static inline uint32_t xHadSumAbs_HBD( const __m128i* r, const int num )
+{
+  __m128i vsum = _mm_abs_epi32( r[0] );
+  for( int k = 1; k < num; k++ )
+  {
+    vsum = _mm_add_epi32( vsum, _mm_abs_epi32( r[k] ) );
+  }
+  vsum = _mm_hadd_epi32( vsum, vsum );
+  vsum = _mm_hadd_epi32( vsum, vsum );
+  return _mm_cvtsi128_si32( vsum );
+}
+
+// sum of the absolute Hadamard coefficients of the 4x4 residual m[row]
+static inline uint32_t xHadAbs4x4_HBD( __m128i m[4] )
+{
+  xHadVer4_HBD( m, 1 );
+  TRANSPOSE4x4( m );
+  xHadVer4_HBD( m, 1 );
+  return xHadSumAbs_HBD( m, 4 );
+}
+
+// sum of the absolute Hadamard coefficients of the 8x8 residual m[2*row+half]
+static inline uint32_t xHadAbs8x8_HBD( __m128i m[16] )
+{
+  xHadVer8_HBD( m,     2 );
+  xHadVer8_HBD( m + 1, 2 );
+
+  __m128i t[4][4];
+  for( int k = 0; k < 4; k++ )
+  {
+    // 4x4 sub-blocks: top left, bottom left, top right, bottom right
+    for( int i = 0; i < 4; i++ ) t[k][i] = m[2 * ( i + ( k & 1 ) * 4 ) + ( k >> 1 )];
+    TRANSPOSE4x4( t[k] );
+  }
+  for( int i = 0; i < 4; i++ )
+  {
+    m[2 *   i       ] = t[0][i];
+    m[2 *   i     + 1] = t[1][i];
+    m[2 * ( i + 4 )    ] = t[2][i];
+    m[2 * ( i + 4 ) + 1] = t[3][i];
+  }
+
+  xHadVer8_HBD( m,     2 );
+  xHadVer8_HBD( m + 1, 2 );
+  return xHadSumAbs_HBD( m, 16 );
+}
+
+#ifdef USE_AVX2
+static inline uint32_t xHadAbs8x8_HBD_AVX2( __m256i m[8] )
+{
+  for( int pass = 0; pass < 2; pass++ )
+  {
+    for( int k = 0; k < 4; k++ )
+    {
+      const __m256i a = m[k], b = m[k + 4];
+      m[k] = _mm256_add_epi32( a, b ); m[k + 4] = _mm256_sub_epi32( a, b );
+    }
+    for( int k = 0; k < 8; k += ( k & 1 ) ? 3 : 1 )
+    {
+      const __m256i a = m[k], b = m[k + 2];
+      m[k] = _mm256_add_epi32( a, b ); m[k + 2] = _mm256_sub_epi32( a, b );
+    }
+    for( int k = 0; k < 8; k += 2 )
+    {
+      const __m256i a = m[k], b = m[k + 1];
+      m[k] = _mm256_add_epi32( a, b ); m[k + 1] = _mm256_sub_epi32( a, b );
+    }
+    if( pass == 0 )
+    {
+      // transpose the 8x8 matrix of 32 bit values
+      __m256i t[8];
+      for( int k = 0; k < 8; k += 2 )
+      {
+        t[k    ] = _mm256_unpacklo_epi32( m[k], m[k + 1] );
+        t[k + 1] = _mm256_unpackhi_epi32( m[k], m[k + 1] );
+      }
+      for( int k = 0; k < 8; k += 4 )
+      {
+        m[k    ] = _mm256_unpacklo_epi64( t[k    ], t[k + 2] );
+        m[k + 1] = _mm256_unpackhi_epi64( t[k    ], t[k + 2] );
+        m[k + 2] = _mm256_unpacklo_epi64( t[k + 1], t[k + 3] );
+        m[k + 3] = _mm256_unpackhi_epi64( t[k + 1], t[k + 3] );
+      }
+      for( int k = 0; k < 4; k++ )
+      {
+        t[k    ] = _mm256_permute2x128_si256( m[k], m[k + 4], 0x20 );
+        t[k + 4] = _mm256_permute2x128_si256( m[k], m[k + 4], 0x31 );
+      }
+      for( int k = 0; k < 8; k++ )
+      {
+        m[k] = t[k];
+      }
+    }
+  }
+
+  __m256i vsum = _mm256_abs_epi32( m[0] );
+  for( int k = 1; k < 8; k++ )
+  {
+    vsum = _mm256_add_epi32( vsum, _mm256_abs_epi32( m[k] ) );
+  }
+  __m128i vsum128 = _mm_add_epi32( _mm256_castsi256_si128( vsum ), _mm256_extracti128_si256( vsum, 1 ) );
+  vsum128 = _mm_hadd_epi32( vsum128, vsum128 );
+  vsum128 = _mm_hadd_epi32( vsum128, vsum128 );
+  return _mm_cvtsi128_si32( vsum128 );
+}
+#endif
+
+static inline __m128i xLoadDiff4_HBD( const Pel* piOrg, const Pel* piCur )
+{
+  return _mm_sub_epi32( _mm_loadu_si128( ( const __m128i* ) piOrg ), _mm_loadu_si128( ( const __m128i* ) piCur ) );
+}
+
+// sum of the absolute Hadamard coefficients of the 8x8 residual at ( offX, offY ), combined with the residual at
+// ( offX + dx, offY + dy ) as sum ( sign > 0 ) or difference ( sign < 0 ), which splits the 16 point transform of
+// the 16x8 and 8x16 blocks into two 8 point transforms
+template< X86_VEXT vext >
+static uint32_t xHadAbs8x8Pair_HBD( const Pel *piOrg, const Pel *piCur, const int iStrideOrg, const int iStrideCur, const int dx, const int dy, const int sign )
+{
+  const int offOrg = dy * iStrideOrg + dx;
+  const int offCur = dy * iStrideCur + dx;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    __m256i m[8];
+    for( int i = 0; i < 8; i++ )
+    {
+      m[i] = _mm256_sub_epi32( _mm256_loadu_si256( ( const __m256i* ) piOrg ), _mm256_loadu_si256( ( const __m256i* ) piCur ) );
+      if( sign )
+      {
+        const __m256i v = _mm256_sub_epi32( _mm256_loadu_si256( ( const __m256i* ) ( piOrg + offOrg ) ), _mm256_loadu_si256( ( const __m256i* ) ( piCur + offCur ) ) );
+        m[i] = sign > 0 ? _mm256_add_epi32( m[i], v ) : _mm256_sub_epi32( m[i], v );
+      }
+      piOrg += iStrideOrg;
+      piCur += iStrideCur;
+    }
+    return xHadAbs8x8_HBD_AVX2( m );
+  }
+#endif
+  __m128i m[16];
+  for( int i = 0; i < 8; i++ )
+  {
+    for( int h = 0; h < 2; h++ )
+    {
+      m[2 * i + h] = xLoadDiff4_HBD( piOrg + 4 * h, piCur + 4 * h );
+      if( sign )
+      {
+        const __m128i v = xLoadDiff4_HBD( piOrg + offOrg + 4 * h, piCur + offCur + 4 * h );
+        m[2 * i + h] = sign > 0 ? _mm_add_epi32( m[2 * i + h], v ) : _mm_sub_epi32( m[2 * i + h], v );
+      }
+    }
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+  }
+  return xHadAbs8x8_HBD( m );
+}
+
+// 4x4 counterpart of xHadAbs8x8Pair_HBD for the 4x4, 8x4 and 4x8 blocks
+static uint32_t xHadAbs4x4Pair_HBD( const Pel *piOrg, const Pel *piCur, const int iStrideOrg, const int iStrideCur, const int dx, const int dy, const int sign )
+{
+  const int offOrg = dy * iStrideOrg + dx;
+  const int offCur = dy * iStrideCur + dx;
+
+  __m128i m[4];
+  for( int i = 0; i < 4; i++ )
+  {
+    m[i] = xLoadDiff4_HBD( piOrg, piCur );
+    if( sign )
+    {
+      const __m128i v = xLoadDiff4_HBD( piOrg + offOrg, piCur + offCur );
+      m[i] = sign > 0 ? _mm_add_epi32( m[i], v ) : _mm_sub_epi32( m[i], v );
+    }
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+  }
+  return xHadAbs4x4_HBD( m );
+}
+
+template< X86_VEXT vext >
+static Distortion xCalcHAD8x8_HBD( const Pel *piOrg, const Pel *piCur, const int iStrideOrg, const int iStrideCur )
+{
+  Distortion sad = xHadAbs8x8Pair_HBD<vext>( piOrg, piCur, iStrideOrg, iStrideCur, 0, 0, 0 );
+  return ( sad + 2 ) >> 2;
+}
+
+static Distortion xCalcHAD4x4_HBD( const Pel *piOrg, const Pel *piCur, const int iStrideOrg, const int iStrideCur )
+{
+  Distortion satd = xHadAbs4x4Pair_HBD( piOrg, piCur, iStrideOrg, iStrideCur, 0, 0, 0 );
+  return ( satd + 1 ) >> 1;
+}
+
+template< X86_VEXT vext >
+static Distortion xCalcHAD16x8_HBD( const Pel *piOrg, const Pel *piCur, const int iStrideOrg, const int iStrideCur )
+{
+  int sad = xHadAbs8x8Pair_HBD<vext>( piOrg, piCur, iStrideOrg, iStrideCur, 8, 0, 1 ) + xHadAbs8x8Pair_HBD<vext>( piOrg, piCur, iStrideOrg, iStrideCur, 8, 0, -1 );
+  return ( int ) ( sad / sqrt( 16.0 * 8 ) * 2 );
+}
+
+template< X86_VEXT vext >
+static Distortion xCalcHAD8x16_HBD( const Pel *piOrg, const Pel *piCur, const int iStrideOrg, const int iStrideCur )
+{
+  int sad = xHadAbs8x8Pair_HBD<vext>( piOrg, piCur, iStrideOrg, iStrideCur, 0, 8, 1 ) + xHadAbs8x8Pair_HBD<vext>( piOrg, piCur, iStrideOrg, iStrideCur, 0, 8, -1 );
+  return ( int ) ( sad / sqrt( 16.0 * 8 ) * 2 );
+}
+
+static Distortion xCalcHAD8x4_HBD( const Pel *piOrg, const Pel *piCur, const int iStrideOrg, const int iStrideCur )
+{
+  int sad = xHadAbs4x4Pair_HBD( piOrg, piCur, iStrideOrg, iStrideCur, 4, 0, 1 ) + xHadAbs4x4Pair_HBD( piOrg, piCur, iStrideOrg, iStrideCur, 4, 0, -1 );
+  return ( int ) ( sad / sqrt( 4.0 * 8 ) * 2 );
+}
+
+static Distortion xCalcHAD4x8_HBD( const Pel *piOrg, const Pel *piCur, const int iStrideOrg, const int iStrideCur )
+{
+  int sad = xHadAbs4x4Pair_HBD( piOrg, piCur, iStrideOrg, iStrideCur, 0, 4, 1 ) + xHadAbs4x4Pair_HBD( piOrg, piCur, iStrideOrg, iStrideCur, 0, 4, -1 );
+  return ( int ) ( sad / sqrt( 4.0 * 8 ) * 2 );
+}
+
+template< typename Torg, typename Tcur, X86_VEXT vext >
+Distortion RdCost::xGetHADs_SIMD( const DistParam &rcDtParam )
+{
+  if( rcDtParam.applyWeight || rcDtParam.step != 1 )
+  {
+    return RdCost::xGetHADs( rcDtParam );
+  }
+
+  const Torg*  piOrg = rcDtParam.org.buf;
+  const Tcur*  piCur = rcDtParam.cur.buf;
+  const int iRows = rcDtParam.org.height;
+  const int iCols = rcDtParam.org.width;
+  const int iStrideCur = rcDtParam.cur.stride;
+  const int iStrideOrg = rcDtParam.org.stride;
+
+  int  x, y;
+  Distortion uiSum = 0;
+
+  if( iCols > iRows && ( iRows & 7 ) == 0 && ( iCols & 15 ) == 0 )
+  {
+    for( y = 0; y < iRows; y += 8 )
+    {
+      for( x = 0; x < iCols; x += 16 )
+      {
+        uiSum += xCalcHAD16x8_HBD<vext>( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur );
+      }
+      piOrg += iStrideOrg * 8;
+      piCur += iStrideCur * 8;
+    }
+  }
+  else if( iCols < iRows && ( iCols & 7 ) == 0 && ( iRows & 15 ) == 0 )
+  {
+    for( y = 0; y < iRows; y += 16 )
+    {
+      for( x = 0; x < iCols; x += 8 )
+      {
+        uiSum += xCalcHAD8x16_HBD<vext>( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur );
+      }
+      piOrg += iStrideOrg * 16;
+      piCur += iStrideCur * 16;
+    }
+  }
+  else if( iCols > iRows && ( iRows & 3 ) == 0 && ( iCols & 7 ) == 0 )
+  {
+    for( y = 0; y < iRows; y += 4 )
+    {
+      for( x = 0; x < iCols; x += 8 )
+      {
+        uiSum += xCalcHAD8x4_HBD( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur );
+      }
+      piOrg += iStrideOrg * 4;
+      piCur += iStrideCur * 4;
+    }
+  }
+  else if( iCols < iRows && ( iCols & 3 ) == 0 && ( iRows & 7 ) == 0 )
+  {
+    for( y = 0; y < iRows; y += 8 )
+    {
+      for( x = 0; x < iCols; x += 4 )
+      {
+        uiSum += xCalcHAD4x8_HBD( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur );
+      }
+      piOrg += iStrideOrg * 8;
+      piCur += iStrideCur * 8;
+    }
+  }
+  else if( ( iRows % 8 == 0 ) && ( iCols % 8 == 0 ) )
+  {
+    for( y = 0; y < iRows; y += 8 )
+    {
+      for( x = 0; x < iCols; x += 8 )
+      {
+        uiSum += xCalcHAD8x8_HBD<vext>( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur );
+      }
+      piOrg += iStrideOrg << 3;
+      piCur += iStrideCur << 3;
+    }
+  }
+  else if( ( iRows % 4 == 0 ) && ( iCols % 4 == 0 ) )
+  {
+    for( y = 0; y < iRows; y += 4 )
+    {
+      for( x = 0; x < iCols; x += 4 )
+      {
+        uiSum += xCalcHAD4x4_HBD( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur );
+      }
+      piOrg += iStrideOrg << 2;
+      piCur += iStrideCur << 2;
+    }
+  }
+  else
+  {
+    return RdCost::xGetHADs( rcDtParam );
+  }
+
+  return uiSum >> DISTORTION_PRECISION_ADJUSTMENT( rcDtParam.bitDepth );
+}
+
+template <X86_VEXT vext>
+void RdCost::_initRdCostX86()
+{
+  // the 32 bit kernels build the squared errors exactly like the scalar implementation
+  m_afpDistortFunc[DF_SSE    ] = xGetSSE_SIMD<Pel, Pel, vext>;
+  m_afpDistortFunc[DF_SSE2   ] = xGetSSE_SIMD<Pel, Pel, vext>;
+  m_afpDistortFunc[DF_SSE4   ] = xGetSSE_SIMD<Pel, Pel, vext>;
+  m_afpDistortFunc[DF_SSE8   ] = xGetSSE_SIMD<Pel, Pel, vext>;
+  m_afpDistortFunc[DF_SSE16  ] = xGetSSE_SIMD<Pel, Pel, vext>;
+  m_afpDistortFunc[DF_SSE32  ] = xGetSSE_SIMD<Pel, Pel, vext>;
+  m_afpDistortFunc[DF_SSE64  ] = xGetSSE_SIMD<Pel, Pel, vext>;
+  m_afpDistortFunc[DF_SSE16N ] = xGetSSE_SIMD<Pel, Pel, vext>;
+
+  m_afpDistortFunc[DF_SAD    ] = xGetSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_SAD2   ] = xGetSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_SAD4   ] = xGetSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_SAD8   ] = xGetSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_SAD16  ] = xGetSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_SAD32  ] = xGetSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_SAD64  ] = xGetSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_SAD16N ] = xGetSAD_SIMD<vext>;
+
+  m_afpDistortFunc[DF_SAD12  ] = xGetSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_SAD24  ] = xGetSAD_SIMD<vext>;
+  m_afpDistortFunc[DF_SAD48  ] = xGetSAD_SIMD<vext>;
+
+  m_afpDistortFunc[DF_HAD]     = xGetHADs_SIMD<Pel, Pel, vext>;
+  m_afpDistortFunc[DF_HAD2]    = xGetHADs_SIMD<Pel, Pel, vext>;
+  m_afpDistortFunc[DF_HAD4]    = xGetHADs_SIMD<Pel, Pel, vext>;
+  m_afpDistortFunc[DF_HAD8]    = xGetHADs_SIMD<Pel, Pel, vext>;
+  m_afpDistortFunc[DF_HAD16]   = xGetHADs_SIMD<Pel, Pel, vext>;
+  m_afpDistortFunc[DF_HAD32]   = xGetHADs_SIMD<Pel, Pel, vext>;
+  m_afpDistortFunc[DF_HAD64]   = xGetHADs_SIMD<Pel, Pel, vext>;
+  m_afpDistortFunc[DF_HAD16N]  = xGetHADs_SIMD<Pel, Pel, vext>;
+
+  m_afpDistortFunc[DF_SAD_INTERMEDIATE_BITDEPTH] = xGetSAD_SIMD<vext>;
+}
+
+#else
+
 template< typename Torg, typename Tcur, X86_VEXT vext >
 Distortion RdCost::xGetSSE_SIMD( const DistParam &rcDtParam )
 {
@@ -220,7 +717,30 @@ Distortion RdCost::xGetSAD_SIMD( const DistParam &rcDtParam )
   const int iStrideSrc2 = rcDtParam.cur.stride * iSubStep;
 
   uint32_t uiSum = 0;
-  if( vext >= AVX2 && ( iCols & 15 ) == 0 )
+  if( vext >= AVX512 && ( iCols & 31 ) == 0 )
+  {
+#ifdef USE_AVX512
+    // Do for width that multiple of 32
+    __m512i vzero = _mm512_setzero_si512();
+    __m512i vsum32 = vzero;
+    for( int iY = 0; iY < iRows; iY+=iSubStep )
+    {
+      __m512i vsum16 = vzero;
+      for( int iX = 0; iX < iCols; iX+=32 )
+      {
+        __m512i vsrc1 = _mm512_loadu_si512( ( const __m512i* )( &pSrc1[iX] ) );
+        __m512i vsrc2 = _mm512_loadu_si512( ( const __m512i* )( &pSrc2[iX] ) );
+        vsum16 = _mm512_add_epi16( vsum16, _mm512_abs_epi16( _mm512_sub_epi16( vsrc1, vsrc2 ) ) );
+      }
+      __m512i vsumtemp = _mm512_add_epi32( _mm512_unpacklo_epi16( vsum16, vzero ), _mm512_unpackhi_epi16( vsum16, vzero ) );
+      vsum32 = _mm512_add_epi32( vsum32, vsumtemp );
+      pSrc1   += iStrideSrc1;
+      pSrc2   += iStrideSrc2;
+    }
+    uiSum = _mm512_reduce_add_epi32( vsum32 );
+#endif
+  }
+  else if( vext >= AVX2 && ( iCols & 15 ) == 0 )
   {
 #ifdef USE_AVX2
     // Do for width that multiple of 16
@@ -305,8 +825,8 @@ Distortion RdCost::xGetSAD_IBD_SIMD(const DistParam &rcDtParam)
 
   const short* src0 = (const short*)rcDtParam.org.buf;
   const short* src1 = (const short*)rcDtParam.cur.buf;
-  int  width = rcDtParam.org.height;
-  int  height = rcDtParam.org.width;
+  int  width = rcDtParam.org.width;
+  int  height = rcDtParam.org.height;
   int  subShift = rcDtParam.subShift;
   int  subStep = (1 << subShift);
   const int src0Stride = rcDtParam.org.stride * subStep;
@@ -398,7 +918,30 @@ Distortion RdCost::xGetSAD_NxN_SIMD( const DistParam &rcDtParam )
   }
   else
   {
-    if( vext >= AVX2 && iWidth >= 16 )
+    if( vext >= AVX512 && iWidth >= 32 )
+    {
+#ifdef USE_AVX512
+      // Do for width that multiple of 32
+      __m512i vzero = _mm512_setzero_si512();
+      __m512i vsum32 = vzero;
+      for( int iY = 0; iY < iRows; iY+=iSubStep )
+      {
+        __m512i vsum16 = vzero;
+        for( int iX = 0; iX < iWidth; iX+=32 )
+        {
+          __m512i vsrc1 = _mm512_loadu_si512( ( const __m512i* )( &pSrc1[iX] ) );
+          __m512i vsrc2 = _mm512_loadu_si512( ( const __m512i* )( &pSrc2[iX] ) );
+          vsum16 = _mm512_add_epi16( vsum16, _mm512_abs_epi16( _mm512_sub_epi16( vsrc1, vsrc2 ) ) );
+        }
+        __m512i vsumtemp = _mm512_add_epi32( _mm512_unpacklo_epi16( vsum16, vzero ), _mm512_unpackhi_epi16( vsum16, vzero ) );
+        vsum32 = _mm512_add_epi32( vsum32, vsumtemp );
+        pSrc1   += iStrideSrc1;
+        pSrc2   += iStrideSrc2;
+      }
+      uiSum = _mm512_reduce_add_epi32( vsum32 );
+#endif
+    }
+    else if( vext >= AVX2 && iWidth >= 16 )
     {
 #ifdef USE_AVX2
       // Do for width that multiple of 16
@@ -1778,6 +2321,198 @@ static uint32_t xCalcHAD16x16_AVX2( const Torg *piOrg, const Tcur *piCur, const
   return ( sad );
 }
 
+template< typename Torg, typename Tcur/*, bool bHorDownsampling*/ >
+static uint32_t xCalcHAD32x8_AVX512( const Torg *piOrg, const Tcur *piCur, const int iStrideOrg, const int iStrideCur, const int iBitDepth )
+{
+  uint32_t sad = 0;
+
+#ifdef USE_AVX512
+  __m512i m1[8], m2[8];
+
+  for( int k = 0; k < 8; k++ )
+  {
+    __m512i r0 = ( sizeof( Torg ) > 1 ) ? ( _mm512_loadu_si512( ( const __m512i* )piOrg ) ) : ( _mm512_cvtepu8_epi16( _mm256_loadu_si256( ( const __m256i* )piOrg ) ) );
+    __m512i r1 = ( sizeof( Tcur ) > 1 ) ? ( _mm512_loadu_si512( ( const __m512i* )piCur ) ) : ( _mm512_cvtepu8_epi16( _mm256_loadu_si256( ( const __m256i* )piCur ) ) );
+    m2[k] = _mm512_sub_epi16( r0, r1 );
+    piCur += iStrideCur;
+    piOrg += iStrideOrg;
+  }
+
+  // horizontal
+
+  m1[0] = _mm512_add_epi16( m2[0], m2[4] );
+  m1[1] = _mm512_add_epi16( m2[1], m2[5] );
+  m1[2] = _mm512_add_epi16( m2[2], m2[6] );
+  m1[3] = _mm512_add_epi16( m2[3], m2[7] );
+  m1[4] = _mm512_sub_epi16( m2[0], m2[4] );
+  m1[5] = _mm512_sub_epi16( m2[1], m2[5] );
+  m1[6] = _mm512_sub_epi16( m2[2], m2[6] );
+  m1[7] = _mm512_sub_epi16( m2[3], m2[7] );
+
+  m2[0] = _mm512_add_epi16( m1[0], m1[2] );
+  m2[1] = _mm512_add_epi16( m1[1], m1[3] );
+  m2[2] = _mm512_sub_epi16( m1[0], m1[2] );
+  m2[3] = _mm512_sub_epi16( m1[1], m1[3] );
+  m2[4] = _mm512_add_epi16( m1[4], m1[6] );
+  m2[5] = _mm512_add_epi16( m1[5], m1[7] );
+  m2[6] = _mm512_sub_epi16( m1[4], m1[6] );
+  m2[7] = _mm512_sub_epi16( m1[5], m1[7] );
+
+  m1[0] = _mm512_add_epi16( m2[0], m2[1] );
+  m1[1] = _mm512_sub_epi16( m2[0], m2[1] );
+  m1[2] = _mm512_add_epi16( m2[2], m2[3] );
+  m1[3] = _mm512_sub_epi16( m2[2], m2[3] );
+  m1[4] = _mm512_add_epi16( m2[4], m2[5] );
+  m1[5] = _mm512_sub_epi16( m2[4], m2[5] );
+  m1[6] = _mm512_add_epi16( m2[6], m2[7] );
+  m1[7] = _mm512_sub_epi16( m2[6], m2[7] );
+
+  // transpose 4 8x8 blocks in parallel
+
+  m2[0] = _mm512_unpacklo_epi16( m1[0], m1[1] );
+  m2[1] = _mm512_unpacklo_epi16( m1[2], m1[3] );
+  m2[2] = _mm512_unpacklo_epi16( m1[4], m1[5] );
+  m2[3] = _mm512_unpacklo_epi16( m1[6], m1[7] );
+  m2[4] = _mm512_unpackhi_epi16( m1[0], m1[1] );
+  m2[5] = _mm512_unpackhi_epi16( m1[2], m1[3] );
+  m2[6] = _mm512_unpackhi_epi16( m1[4], m1[5] );
+  m2[7] = _mm512_unpackhi_epi16( m1[6], m1[7] );
+
+  m1[0] = _mm512_unpacklo_epi32( m2[0], m2[1] );
+  m1[1] = _mm512_unpackhi_epi32( m2[0], m2[1] );
+  m1[2] = _mm512_unpacklo_epi32( m2[2], m2[3] );
+  m1[3] = _mm512_unpackhi_epi32( m2[2], m2[3] );
+  m1[4] = _mm512_unpacklo_epi32( m2[4], m2[5] );
+  m1[5] = _mm512_unpackhi_epi32( m2[4], m2[5] );
+  m1[6] = _mm512_unpacklo_epi32( m2[6], m2[7] );
+  m1[7] = _mm512_unpackhi_epi32( m2[6], m2[7] );
+
+  m2[0] = _mm512_unpacklo_epi64( m1[0], m1[2] );
+  m2[1] = _mm512_unpackhi_epi64( m1[0], m1[2] );
+  m2[2] = _mm512_unpacklo_epi64( m1[1], m1[3] );
+  m2[3] = _mm512_unpackhi_epi64( m1[1], m1[3] );
+  m2[4] = _mm512_unpacklo_epi64( m1[4], m1[6] );
+  m2[5] = _mm512_unpackhi_epi64( m1[4], m1[6] );
+  m2[6] = _mm512_unpacklo_epi64( m1[5], m1[7] );
+  m2[7] = _mm512_unpackhi_epi64( m1[5], m1[7] );
+
+  // vertical
+  if( iBitDepth >= 10 )
+  {
+    __m512i n1[8][2];
+    __m512i n2[8][2];
+
+    // widen the first and the second half of every 128 bit lane, the lanes stay in place
+    const __m512i vperm0 = _mm512_set_epi64( 7, 5, 3, 1, 6, 4, 2, 0 );
+    const __m512i vperm1 = _mm512_set_epi64( 6, 4, 2, 0, 7, 5, 3, 1 );
+
+    for( int i = 0; i < 8; i++ )
+    {
+      n2[i][0] = _mm512_cvtepi16_epi32( _mm512_castsi512_si256( _mm512_permutexvar_epi64( vperm0, m2[i] ) ) );
+      n2[i][1] = _mm512_cvtepi16_epi32( _mm512_castsi512_si256( _mm512_permutexvar_epi64( vperm1, m2[i] ) ) );
+    }
+
+    for( int i = 0; i < 2; i++ )
+    {
+      n1[0][i] = _mm512_add_epi32( n2[0][i], n2[4][i] );
+      n1[1][i] = _mm512_add_epi32( n2[1][i], n2[5][i] );
+      n1[2][i] = _mm512_add_epi32( n2[2][i], n2[6][i] );
+      n1[3][i] = _mm512_add_epi32( n2[3][i], n2[7][i] );
+      n1[4][i] = _mm512_sub_epi32( n2[0][i], n2[4][i] );
+      n1[5][i] = _mm512_sub_epi32( n2[1][i], n2[5][i] );
+      n1[6][i] = _mm512_sub_epi32( n2[2][i], n2[6][i] );
+      n1[7][i] = _mm512_sub_epi32( n2[3][i], n2[7][i] );
+
+      n2[0][i] = _mm512_add_epi32( n1[0][i], n1[2][i] );
+      n2[1][i] = _mm512_add_epi32( n1[1][i], n1[3][i] );
+      n2[2][i] = _mm512_sub_epi32( n1[0][i], n1[2][i] );
+      n2[3][i] = _mm512_sub_epi32( n1[1][i], n1[3][i] );
+      n2[4][i] = _mm512_add_epi32( n1[4][i], n1[6][i] );
+      n2[5][i] = _mm512_add_epi32( n1[5][i], n1[7][i] );
+      n2[6][i] = _mm512_sub_epi32( n1[4][i], n1[6][i] );
+      n2[7][i] = _mm512_sub_epi32( n1[5][i], n1[7][i] );
+
+      n1[0][i] = _mm512_abs_epi32( _mm512_add_epi32( n2[0][i], n2[1][i] ) );
+      n1[1][i] = _mm512_abs_epi32( _mm512_sub_epi32( n2[0][i], n2[1][i] ) );
+      n1[2][i] = _mm512_abs_epi32( _mm512_add_epi32( n2[2][i], n2[3][i] ) );
+      n1[3][i] = _mm512_abs_epi32( _mm512_sub_epi32( n2[2][i], n2[3][i] ) );
+      n1[4][i] = _mm512_abs_epi32( _mm512_add_epi32( n2[4][i], n2[5][i] ) );
+      n1[5][i] = _mm512_abs_epi32( _mm512_sub_epi32( n2[4][i], n2[5][i] ) );
+      n1[6][i] = _mm512_abs_epi32( _mm512_add_epi32( n2[6][i], n2[7][i] ) );
+      n1[7][i] = _mm512_abs_epi32( _mm512_sub_epi32( n2[6][i], n2[7][i] ) );
+    }
+    for( int i = 0; i < 8; i++ )
+    {
+      m1[i] = _mm512_add_epi32( n1[i][0], n1[i][1] );
+    }
+  }
+  else
+  {
+    m1[0] = _mm512_add_epi16( m2[0], m2[4] );
+    m1[1] = _mm512_add_epi16( m2[1], m2[5] );
+    m1[2] = _mm512_add_epi16( m2[2], m2[6] );
+    m1[3] = _mm512_add_epi16( m2[3], m2[7] );
+    m1[4] = _mm512_sub_epi16( m2[0], m2[4] );
+    m1[5] = _mm512_sub_epi16( m2[1], m2[5] );
+    m1[6] = _mm512_sub_epi16( m2[2], m2[6] );
+    m1[7] = _mm512_sub_epi16( m2[3], m2[7] );
+
+    m2[0] = _mm512_add_epi16( m1[0], m1[2] );
+    m2[1] = _mm512_add_epi16( m1[1], m1[3] );
+    m2[2] = _mm512_sub_epi16( m1[0], m1[2] );
+    m2[3] = _mm512_sub_epi16( m1[1], m1[3] );
+    m2[4] = _mm512_add_epi16( m1[4], m1[6] );
+    m2[5] = _mm512_add_epi16( m1[5], m1[7] );
+    m2[6] = _mm512_sub_epi16( m1[4], m1[6] );
+    m2[7] = _mm512_sub_epi16( m1[5], m1[7] );
+
+    m1[0] = _mm512_abs_epi16( _mm512_add_epi16( m2[0], m2[1] ) );
+    m1[1] = _mm512_abs_epi16( _mm512_sub_epi16( m2[0], m2[1] ) );
+    m1[2] = _mm512_abs_epi16( _mm512_add_epi16( m2[2], m2[3] ) );
+    m1[3] = _mm512_abs_epi16( _mm512_sub_epi16( m2[2], m2[3] ) );
+    m1[4] = _mm512_abs_epi16( _mm512_add_epi16( m2[4], m2[5] ) );
+    m1[5] = _mm512_abs_epi16( _mm512_sub_epi16( m2[4], m2[5] ) );
+    m1[6] = _mm512_abs_epi16( _mm512_add_epi16( m2[6], m2[7] ) );
+    m1[7] = _mm512_abs_epi16( _mm512_sub_epi16( m2[6], m2[7] ) );
+
+    __m512i ma1, ma2;
+    __m512i vzero = _mm512_setzero_si512();
+
+    for( int i = 0; i < 8; i++ )
+    {
+      ma1 = _mm512_unpacklo_epi16( m1[i], vzero );
+      ma2 = _mm512_unpackhi_epi16( m1[i], vzero );
+      m1[i] = _mm512_add_epi32( ma1, ma2 );
+    }
+  }
+
+  m1[0] = _mm512_add_epi32( m1[0], m1[1] );
+  m1[2] = _mm512_add_epi32( m1[2], m1[3] );
+  m1[4] = _mm512_add_epi32( m1[4], m1[5] );
+  m1[6] = _mm512_add_epi32( m1[6], m1[7] );
+
+  m1[0] = _mm512_add_epi32( m1[0], m1[2] );
+  m1[4] = _mm512_add_epi32( m1[4], m1[6] );
+
+  // sum up every 128 bit lane, each one holds an 8x8 block
+  __m512i iSum = _mm512_add_epi32( m1[0], m1[4] );
+  iSum = _mm512_add_epi32( iSum, _mm512_shuffle_epi32( iSum, _MM_PERM_BADC ) );
+  iSum = _mm512_add_epi32( iSum, _mm512_shuffle_epi32( iSum, _MM_PERM_CDAB ) );
+
+  uint32_t tmp;
+  tmp = _mm_cvtsi128_si32( _mm512_castsi512_si128( iSum ) );
+  sad += ( ( tmp + 2 ) >> 2 );
+  tmp = _mm_cvtsi128_si32( _mm512_extracti32x4_epi32( iSum, 1 ) );
+  sad += ( ( tmp + 2 ) >> 2 );
+  tmp = _mm_cvtsi128_si32( _mm512_extracti32x4_epi32( iSum, 2 ) );
+  sad += ( ( tmp + 2 ) >> 2 );
+  tmp = _mm_cvtsi128_si32( _mm512_extracti32x4_epi32( iSum, 3 ) );
+  sad += ( ( tmp + 2 ) >> 2 );
+
+#endif
+  return ( sad );
+}
+
 template< typename Torg, typename Tcur/*, bool bHorDownsampling*/ >
 static uint32_t xCalcHAD16x8_AVX2( const Torg *piOrg, const Tcur *piCur, const int iStrideOrg, const int iStrideCur, const int iBitDepth )
 {
@@ -2359,6 +3094,20 @@ Distortion RdCost::xGetHADs_SIMD( const DistParam &rcDtParam )
       piCur += iStrideCur * 8;
     }
   }
+  else if( vext >= AVX512 && ( ( ( iRows | iCols ) & 31 ) == 0 ) && ( iRows == iCols ) )
+  {
+    int  iOffsetOrg = iStrideOrg << 3;
+    int  iOffsetCur = iStrideCur << 3;
+    for( y = 0; y < iRows; y += 8 )
+    {
+      for( x = 0; x < iCols; x += 32 )
+      {
+        uiSum += xCalcHAD32x8_AVX512<Torg, Tcur>( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur, iBitDepth );
+      }
+      piOrg += iOffsetOrg;
+      piCur += iOffsetCur;
+    }
+  }
   else if( vext >= AVX2 && ( ( ( iRows | iCols ) & 15 ) == 0 ) && ( iRows == iCols ) )
   {
     int  iOffsetOrg = iStrideOrg << 4;
@@ -2463,6 +3212,8 @@ void RdCost::_initRdCostX86()
   m_afpDistortFunc[DF_SAD_INTERMEDIATE_BITDEPTH] = RdCost::xGetSAD_IBD_SIMD<vext>;
 }
 
+#endif //!RExt__HIGH_BIT_DEPTH_SUPPORT
+
 template void RdCost::_initRdCostX86<SIMDX86>();
 
 #endif //#if TARGET_SIMD_X86
@@ -0,0 +1,243 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     SampleAdaptiveOffsetX86.h
+    \brief    SAO filter class
+*/
+#include "CommonDefX86.h"
+#include "../SampleAdaptiveOffset.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#if ENABLE_SIMD_OPT_SAO
+#ifdef TARGET_SIMD_X86
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <immintrin.h>
+#endif
+
+// sgn( a - b ) of eight samples
+static inline __m128i sgnDiff( const __m128i a, const __m128i b )
+{
+  return _mm_sub_epi16( _mm_cmpgt_epi16( b, a ), _mm_cmpgt_epi16( a, b ) );
+}
+
+// byte indices of the 16 bit table entry idx for _mm_shuffle_epi8
+static inline __m128i tableIdx( const __m128i idx )
+{
+  return _mm_add_epi16( _mm_mullo_epi16( idx, _mm_set1_epi16( 0x0202 ) ), _mm_set1_epi16( 0x0100 ) );
+}
+
+// edge class ( edgeType + 2 ) of eight samples
+static inline __m128i edgeClass( const Pel* src, const int neighbour )
+{
+  const __m128i c = _mm_loadu_si128( ( const __m128i* ) src );
+  const __m128i a = _mm_loadu_si128( ( const __m128i* ) ( src - neighbour ) );
+  const __m128i b = _mm_loadu_si128( ( const __m128i* ) ( src + neighbour ) );
+
+  return _mm_add_epi16( _mm_add_epi16( sgnDiff( c, a ), sgnDiff( c, b ) ), _mm_set1_epi16( 2 ) );
+}
+
+#ifdef USE_AVX2
+static inline __m256i sgnDiff( const __m256i a, const __m256i b )
+{
+  return _mm256_sub_epi16( _mm256_cmpgt_epi16( b, a ), _mm256_cmpgt_epi16( a, b ) );
+}
+
+static inline __m256i tableIdx( const __m256i idx )
+{
+  return _mm256_add_epi16( _mm256_mullo_epi16( idx, _mm256_set1_epi16( 0x0202 ) ), _mm256_set1_epi16( 0x0100 ) );
+}
+
+static inline __m256i edgeClass16( const Pel* src, const int neighbour )
+{
+  const __m256i c = _mm256_loadu_si256( ( const __m256i* ) src );
+  const __m256i a = _mm256_loadu_si256( ( const __m256i* ) ( src - neighbour ) );
+  const __m256i b = _mm256_loadu_si256( ( const __m256i* ) ( src + neighbour ) );
+
+  return _mm256_add_epi16( _mm256_add_epi16( sgnDiff( c, a ), sgnDiff( c, b ) ), _mm256_set1_epi16( 2 ) );
+}
+#endif
+
+template<X86_VEXT vext>
+static void simdOffsetBlkEO( const Pel* src, Pel* res, const int srcStride, const int resStride, const int width, const int height, const int neighbour, const int* offset, const ClpRng& clpRng )
+{
+  // the five edge class offsets as a 16 bit table for the byte shuffle
+  const __m128i table = _mm_setr_epi16( offset[0], offset[1], offset[2], offset[3], offset[4], 0, 0, 0 );
+  const __m128i vmin  = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax  = _mm_set1_epi16( clpRng.max );
+#ifdef USE_AVX2
+  const __m256i table256 = _mm256_broadcastsi128_si256( table );
+  const __m256i vmin256  = _mm256_set1_epi16( clpRng.min );
+  const __m256i vmax256  = _mm256_set1_epi16( clpRng.max );
+#endif
+
+  for( int y = 0; y < height; y++ )
+  {
+    int x = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      for( ; x + 16 <= width; x += 16 )
+      {
+        const __m256i off = _mm256_shuffle_epi8( table256, tableIdx( edgeClass16( src + x, neighbour ) ) );
+        const __m256i val = _mm256_adds_epi16( _mm256_loadu_si256( ( const __m256i* ) ( src + x ) ), off );
+
+        _mm256_storeu_si256( ( __m256i* ) ( res + x ), _mm256_min_epi16( _mm256_max_epi16( val, vmin256 ), vmax256 ) );
+      }
+    }
+#endif
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const __m128i off = _mm_shuffle_epi8( table, tableIdx( edgeClass( src + x, neighbour ) ) );
+      const __m128i val = _mm_adds_epi16( _mm_loadu_si128( ( const __m128i* ) ( src + x ) ), off );
+
+      _mm_storeu_si128( ( __m128i* ) ( res + x ), _mm_min_epi16( _mm_max_epi16( val, vmin ), vmax ) );
+    }
+    for( ; x < width; x++ )
+    {
+      const int edgeType = sgn( src[x] - src[x - neighbour] ) + sgn( src[x] - src[x + neighbour] );
+
+      res[x] = ClipPel<int>( src[x] + offset[edgeType + 2], clpRng );
+    }
+    src += srcStride;
+    res += resStride;
+  }
+}
+
+template<X86_VEXT vext>
+static void simdOffsetBlkBO( const Pel* src, Pel* res, const int srcStride, const int resStride, const int width, const int height, const int shiftBits, const int* offset, const ClpRng& clpRng )
+{
+  // the 32 band offsets as four 16 bit tables of eight bands each
+  __m128i table[4];
+  for( int i = 0; i < 4; i++ )
+  {
+    const int* o = offset + 8 * i;
+    table[i] = _mm_setr_epi16( o[0], o[1], o[2], o[3], o[4], o[5], o[6], o[7] );
+  }
+  const __m128i vmin  = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax  = _mm_set1_epi16( clpRng.max );
+  const __m128i seven = _mm_set1_epi16( 7 );
+
+  for( int y = 0; y < height; y++ )
+  {
+    int x = 0;
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const __m128i val  = _mm_loadu_si128( ( const __m128i* ) ( src + x ) );
+      const __m128i band = _mm_srai_epi16( val, shiftBits );
+      const __m128i idx  = tableIdx( _mm_and_si128( band, seven ) );
+      const __m128i grp  = _mm_srai_epi16( band, 3 );
+
+      __m128i off = _mm_setzero_si128();
+      for( int i = 0; i < 4; i++ )
+      {
+        const __m128i sel = _mm_cmpeq_epi16( grp, _mm_set1_epi16( i ) );
+        off = _mm_or_si128( off, _mm_and_si128( sel, _mm_shuffle_epi8( table[i], idx ) ) );
+      }
+
+      _mm_storeu_si128( ( __m128i* ) ( res + x ), _mm_min_epi16( _mm_max_epi16( _mm_adds_epi16( val, off ), vmin ), vmax ) );
+    }
+    for( ; x < width; x++ )
+    {
+      res[x] = ClipPel<int>( src[x] + offset[src[x] >> shiftBits], clpRng );
+    }
+    src += srcStride;
+    res += resStride;
+  }
+}
+
+template<X86_VEXT vext>
+static void simdCalcStatsEO( const Pel* src, const Pel* org, const int srcStride, const int orgStride, const int width, const int height, const int neighbour, int64_t* diff, int64_t* count )
+{
+  // per class sums of org - src and sample counts in 32 bit lanes, flushed after each line
+  const __m128i ones = _mm_set1_epi16( 1 );
+
+  for( int y = 0; y < height; y++ )
+  {
+    __m128i vdiff[5], vcount[5];
+    for( int k = 0; k < 5; k++ )
+    {
+      vdiff[k]  = _mm_setzero_si128();
+      vcount[k] = _mm_setzero_si128();
+    }
+
+    int x = 0;
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const __m128i cls = edgeClass( src + x, neighbour );
+      const __m128i d   = _mm_sub_epi16( _mm_loadu_si128( ( const __m128i* ) ( org + x ) ), _mm_loadu_si128( ( const __m128i* ) ( src + x ) ) );
+
+      for( int k = 0; k < 5; k++ )
+      {
+        const __m128i sel = _mm_cmpeq_epi16( cls, _mm_set1_epi16( k ) );
+        vdiff[k]  = _mm_add_epi32( vdiff[k], _mm_madd_epi16( _mm_and_si128( sel, d ), ones ) );
+        vcount[k] = _mm_sub_epi32( vcount[k], _mm_madd_epi16( sel, ones ) );
+      }
+    }
+    if( x > 0 )
+    {
+      for( int k = 0; k < 5; k++ )
+      {
+        __m128i sum = _mm_hadd_epi32( vdiff[k], vcount[k] );
+        sum = _mm_hadd_epi32( sum, sum );
+        diff [k] += _mm_cvtsi128_si32( sum );
+        count[k] += _mm_extract_epi32( sum, 1 );
+      }
+    }
+    for( ; x < width; x++ )
+    {
+      const int edgeType = sgn( src[x] - src[x - neighbour] ) + sgn( src[x] - src[x + neighbour] );
+
+      diff [edgeType + 2] += org[x] - src[x];
+      count[edgeType + 2] ++;
+    }
+    src += srcStride;
+    org += orgStride;
+  }
+}
+
+template <X86_VEXT vext>
+void SampleAdaptiveOffset::_initSampleAdaptiveOffsetX86()
+{
+  m_offsetBlkEO = simdOffsetBlkEO<vext>;
+  m_offsetBlkBO = simdOffsetBlkBO<vext>;
+  m_calcStatsEO = simdCalcStatsEO<vext>;
+}
+
+template void SampleAdaptiveOffset::_initSampleAdaptiveOffsetX86<SIMDX86>();
+#endif //#ifdef TARGET_SIMD_X86
+#endif
+//! \}
@@ -0,0 +1,312 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TrQuantX86.h
+    \brief    transform and quantization class
+*/
+#include "CommonDefX86.h"
+#include "../TrQuant.h"
+#include "../Rom.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#if ENABLE_SIMD_OPT_TRAFO
+#ifdef TARGET_SIMD_X86
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <immintrin.h>
+#endif
+
+// The one-dimensional transforms are computed as matrix multiplications in 32 bit lanes. This gives the same results as
+// the partial butterflies, which only exploit the symmetries of the integer transform matrices.
+
+struct TrVec128
+{
+  typedef __m128i T;
+  static const int num = 4;
+
+  static inline T    zero   ()                           { return _mm_setzero_si128(); }
+  static inline T    set1   ( const int v )              { return _mm_set1_epi32( v ); }
+  static inline T    load   ( const TCoeff* p )          { return _mm_loadu_si128( ( const __m128i* ) p ); }
+  static inline T    loadMat( const TMatrixCoeff* p )    { return _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) p ) ); }
+  static inline void store  ( TCoeff* p, const T v )     { _mm_storeu_si128( ( __m128i* ) p, v ); }
+  static inline T    add    ( const T a, const T b )     { return _mm_add_epi32( a, b ); }
+  static inline T    sub    ( const T a, const T b )     { return _mm_sub_epi32( a, b ); }
+  static inline T    mul    ( const T a, const T b )     { return _mm_mullo_epi32( a, b ); }
+  static inline T    sra    ( const T a, const int s )   { return _mm_sra_epi32( a, _mm_cvtsi32_si128( s ) ); }
+  static inline T    clip   ( const T a, const T lo, const T hi ) { return _mm_min_epi32( _mm_max_epi32( a, lo ), hi ); }
+};
+
+#ifdef USE_AVX2
+struct TrVec256
+{
+  typedef __m256i T;
+  static const int num = 8;
+
+  static inline T    zero   ()                           { return _mm256_setzero_si256(); }
+  static inline T    set1   ( const int v )              { return _mm256_set1_epi32( v ); }
+  static inline T    load   ( const TCoeff* p )          { return _mm256_loadu_si256( ( const __m256i* ) p ); }
+  static inline T    loadMat( const TMatrixCoeff* p )    { return _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) p ) ); }
+  static inline void store  ( TCoeff* p, const T v )     { _mm256_storeu_si256( ( __m256i* ) p, v ); }
+  static inline T    add    ( const T a, const T b )     { return _mm256_add_epi32( a, b ); }
+  static inline T    sub    ( const T a, const T b )     { return _mm256_sub_epi32( a, b ); }
+  static inline T    mul    ( const T a, const T b )     { return _mm256_mullo_epi32( a, b ); }
+  static inline T    sra    ( const T a, const int s )   { return _mm256_sra_epi32( a, _mm_cvtsi32_si128( s ) ); }
+  static inline T    clip   ( const T a, const T lo, const T hi ) { return _mm256_min_epi32( _mm256_max_epi32( a, lo ), hi ); }
+};
+#endif
+
+// forward transform of V::num lines at once, the lines are transposed so that each lane holds one line;
+// for symmetric transforms ( DCT-II ) the even and odd rows are computed from the sums and differences of the mirrored inputs
+template<typename V, int trSize, bool symmetric>
+static inline void fwdTransLines( const TCoeff* src, TCoeff* dst, const int shift, const int line, const int cutoff, const TMatrixCoeff* tm )
+{
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, TCoeff blk[trSize * V::num] );
+
+  for( int l = 0; l < V::num; l++ )
+  {
+    for( int n = 0; n < trSize; n++ )
+    {
+      blk[n * V::num + l] = src[l * trSize + n];
+    }
+  }
+
+  typename V::T in[trSize];
+  for( int n = 0; n < trSize; n++ )
+  {
+    in[n] = V::load( blk + n * V::num );
+  }
+
+  const typename V::T add = V::set1( shift > 0 ? 1 << ( shift - 1 ) : 0 );
+
+  if( symmetric )
+  {
+    typename V::T even[trSize / 2], odd[trSize / 2];
+    for( int n = 0; n < trSize / 2; n++ )
+    {
+      even[n] = V::add( in[n], in[trSize - 1 - n] );
+      odd [n] = V::sub( in[n], in[trSize - 1 - n] );
+    }
+
+    for( int k = 0; k < cutoff; k++ )
+    {
+      const typename V::T* part = ( k & 1 ) ? odd : even;
+      const TMatrixCoeff*  row  = tm + k * trSize;
+      typename V::T sum = add;
+
+      for( int n = 0; n < trSize / 2; n++ )
+      {
+        sum = V::add( sum, V::mul( V::set1( row[n] ), part[n] ) );
+      }
+      V::store( dst + k * line, V::sra( sum, shift ) );
+    }
+  }
+  else
+  {
+    for( int k = 0; k < cutoff; k++ )
+    {
+      const TMatrixCoeff* row = tm + k * trSize;
+      typename V::T sum = add;
+
+      for( int n = 0; n < trSize; n++ )
+      {
+        sum = V::add( sum, V::mul( V::set1( row[n] ), in[n] ) );
+      }
+      V::store( dst + k * line, V::sra( sum, shift ) );
+    }
+  }
+}
+
+template<X86_VEXT vext, int trSize, bool symmetric>
+static void simdFwdTrans( const TCoeff* src, TCoeff* dst, int shift, int line, int iSkipLine, int iSkipLine2, const TMatrixCoeff* tm )
+{
+  const int reducedLine = line - iSkipLine;
+  const int cutoff      = trSize - iSkipLine2;
+  int i = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    for( ; i + TrVec256::num <= reducedLine; i += TrVec256::num )
+    {
+      fwdTransLines<TrVec256, trSize, symmetric>( src + i * trSize, dst + i, shift, line, cutoff, tm );
+    }
+  }
+#endif
+  for( ; i + TrVec128::num <= reducedLine; i += TrVec128::num )
+  {
+    fwdTransLines<TrVec128, trSize, symmetric>( src + i * trSize, dst + i, shift, line, cutoff, tm );
+  }
+
+  const TCoeff add = shift > 0 ? 1 << ( shift - 1 ) : 0;
+  for( ; i < reducedLine; i++ )
+  {
+    const TCoeff* in = src + i * trSize;
+
+    for( int k = 0; k < cutoff; k++ )
+    {
+      const TMatrixCoeff* row = tm + k * trSize;
+      TCoeff sum = add;
+
+      for( int n = 0; n < trSize; n++ )
+      {
+        sum += row[n] * in[n];
+      }
+      dst[k * line + i] = sum >> shift;
+    }
+  }
+
+  if( iSkipLine )
+  {
+    for( int k = 0; k < cutoff; k++ )
+    {
+      memset( dst + k * line + reducedLine, 0, sizeof( TCoeff ) * iSkipLine );
+    }
+  }
+  if( iSkipLine2 )
+  {
+    memset( dst + cutoff * line, 0, sizeof( TCoeff ) * line * iSkipLine2 );
+  }
+}
+
+// inverse transform of one line, the output samples are computed V::num at once and all-zero input rows are skipped
+template<typename V, int trSize>
+static inline void invTransLine( const TCoeff* src, TCoeff* dst, const int shift, const int line, const int cutoff, const TCoeff outputMinimum, const TCoeff outputMaximum, const TMatrixCoeff* tm )
+{
+  static const int numVec = trSize / V::num;
+
+  typename V::T sum[numVec];
+  for( int j = 0; j < numVec; j++ )
+  {
+    sum[j] = V::set1( 1 << ( shift - 1 ) );
+  }
+
+  for( int k = 0; k < cutoff; k++ )
+  {
+    const TCoeff coeff = src[k * line];
+    if( coeff == 0 )
+    {
+      continue;
+    }
+
+    const typename V::T     vc  = V::set1( coeff );
+    const TMatrixCoeff*     row = tm + k * trSize;
+    for( int j = 0; j < numVec; j++ )
+    {
+      sum[j] = V::add( sum[j], V::mul( vc, V::loadMat( row + j * V::num ) ) );
+    }
+  }
+
+  const typename V::T vmin = V::set1( outputMinimum );
+  const typename V::T vmax = V::set1( outputMaximum );
+  for( int j = 0; j < numVec; j++ )
+  {
+    V::store( dst + j * V::num, V::clip( V::sra( sum[j], shift ), vmin, vmax ) );
+  }
+}
+
+template<X86_VEXT vext, int trSize>
+static void simdInvTrans( const TCoeff* src, TCoeff* dst, int shift, int line, int iSkipLine, int iSkipLine2, const TCoeff outputMinimum, const TCoeff outputMaximum, const TMatrixCoeff* tm )
+{
+  const int reducedLine = line - iSkipLine;
+  // only the 64-point DCT-II skips the zeroed-out input rows, the other sizes read all of them
+  const int cutoff      = trSize == 64 && iSkipLine2 >= 32 ? 32 : trSize;
+
+  for( int i = 0; i < reducedLine; i++ )
+  {
+#ifdef USE_AVX2
+    if( vext >= AVX2 && trSize >= TrVec256::num )
+    {
+      invTransLine<TrVec256, trSize>( src + i, dst + i * trSize, shift, line, cutoff, outputMinimum, outputMaximum, tm );
+      continue;
+    }
+#endif
+    invTransLine<TrVec128, trSize>( src + i, dst + i * trSize, shift, line, cutoff, outputMinimum, outputMaximum, tm );
+  }
+
+  if( iSkipLine )
+  {
+    memset( dst + reducedLine * trSize, 0, sizeof( TCoeff ) * trSize * iSkipLine );
+  }
+}
+
+template<X86_VEXT vext, int trSize, const TMatrixCoeff ( &tm )[TRANSFORM_NUMBER_OF_DIRECTIONS][trSize][trSize], bool symmetric>
+static void simdForward( const TCoeff* src, TCoeff* dst, int shift, int line, int iSkipLine, int iSkipLine2 )
+{
+  simdFwdTrans<vext, trSize, symmetric>( src, dst, shift, line, iSkipLine, iSkipLine2, tm[TRANSFORM_FORWARD][0] );
+}
+
+template<X86_VEXT vext, int trSize, const TMatrixCoeff ( &tm )[TRANSFORM_NUMBER_OF_DIRECTIONS][trSize][trSize]>
+static void simdInverse( const TCoeff* src, TCoeff* dst, int shift, int line, int iSkipLine, int iSkipLine2, const TCoeff outputMinimum, const TCoeff outputMaximum )
+{
+  simdInvTrans<vext, trSize>( src, dst, shift, line, iSkipLine, iSkipLine2, outputMinimum, outputMaximum, tm[TRANSFORM_INVERSE][0] );
+}
+
+template <X86_VEXT vext>
+void TrQuant::_initTrQuantX86()
+{
+  m_fwdTrans[DCT2][1] = simdForward<vext,  4, g_trCoreDCT2P4,  true>;
+  m_fwdTrans[DCT2][2] = simdForward<vext,  8, g_trCoreDCT2P8,  true>;
+  m_fwdTrans[DCT2][3] = simdForward<vext, 16, g_trCoreDCT2P16, true>;
+  m_fwdTrans[DCT2][4] = simdForward<vext, 32, g_trCoreDCT2P32, true>;
+  m_fwdTrans[DCT2][5] = simdForward<vext, 64, g_trCoreDCT2P64, true>;
+  m_fwdTrans[DCT8][1] = simdForward<vext,  4, g_trCoreDCT8P4,  false>;
+  m_fwdTrans[DCT8][2] = simdForward<vext,  8, g_trCoreDCT8P8,  false>;
+  m_fwdTrans[DCT8][3] = simdForward<vext, 16, g_trCoreDCT8P16, false>;
+  m_fwdTrans[DCT8][4] = simdForward<vext, 32, g_trCoreDCT8P32, false>;
+  m_fwdTrans[DST7][1] = simdForward<vext,  4, g_trCoreDST7P4,  false>;
+  m_fwdTrans[DST7][2] = simdForward<vext,  8, g_trCoreDST7P8,  false>;
+  m_fwdTrans[DST7][3] = simdForward<vext, 16, g_trCoreDST7P16, false>;
+  m_fwdTrans[DST7][4] = simdForward<vext, 32, g_trCoreDST7P32, false>;
+
+  m_invTrans[DCT2][1] = simdInverse<vext,  4, g_trCoreDCT2P4 >;
+  m_invTrans[DCT2][2] = simdInverse<vext,  8, g_trCoreDCT2P8 >;
+  m_invTrans[DCT2][3] = simdInverse<vext, 16, g_trCoreDCT2P16>;
+  m_invTrans[DCT2][4] = simdInverse<vext, 32, g_trCoreDCT2P32>;
+  m_invTrans[DCT2][5] = simdInverse<vext, 64, g_trCoreDCT2P64>;
+  m_invTrans[DCT8][1] = simdInverse<vext,  4, g_trCoreDCT8P4 >;
+  m_invTrans[DCT8][2] = simdInverse<vext,  8, g_trCoreDCT8P8 >;
+  m_invTrans[DCT8][3] = simdInverse<vext, 16, g_trCoreDCT8P16>;
+  m_invTrans[DCT8][4] = simdInverse<vext, 32, g_trCoreDCT8P32>;
+  m_invTrans[DST7][1] = simdInverse<vext,  4, g_trCoreDST7P4 >;
+  m_invTrans[DST7][2] = simdInverse<vext,  8, g_trCoreDST7P8 >;
+  m_invTrans[DST7][3] = simdInverse<vext, 16, g_trCoreDST7P16>;
+  m_invTrans[DST7][4] = simdInverse<vext, 32, g_trCoreDST7P32>;
+}
+
+template void TrQuant::_initTrQuantX86<SIMDX86>();
+#endif //#ifdef TARGET_SIMD_X86
+#endif
+//! \}
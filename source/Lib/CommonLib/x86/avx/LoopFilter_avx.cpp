@@ -0,0 +1 @@
+#include "../LoopFilterX86.h"
@@ -0,0 +1 @@
+#include "../BufferX86.h"
@@ -0,0 +1 @@
+#include "../InterpolationFilterX86.h"
@@ -0,0 +1 @@
+#include "../IntraPredictionX86.h"
@@ -38,12 +38,25 @@
 
 
 #include <stdint.h>
+#include <string.h>
 #include <vector>
+#include <fstream>
 #include "AnnexBread.h"
+#include "CommonLib/SSE2Baseline.h"
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
 #include "CommonLib/CodingStatistics.h"
 #endif
 
+#ifdef _WIN32
+#define ANNEXB_MMAP 0
+#else
+#define ANNEXB_MMAP 1
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 using namespace std;
 
 //! \ingroup DecoderLib
@@ -195,4 +208,269 @@ byteStreamNALUnit(
   stats.m_numBytesInNALUnit = uint32_t(nalUnit.size());
   return eof;
 }
+
+InputByteBuffer::InputByteBuffer()
+: m_isOpen ( false )
+, m_data   ( nullptr )
+, m_size   ( 0 )
+, m_pos    ( 0 )
+, m_mapping( nullptr )
+{
+}
+
+InputByteBuffer::~InputByteBuffer()
+{
+  close();
+}
+
+bool InputByteBuffer::open( const std::string& fileName )
+{
+  close();
+
+#if ANNEXB_MMAP
+  const int fd = ::open( fileName.c_str(), O_RDONLY );
+  if( fd < 0 )
+  {
+    return false;
+  }
+
+  struct stat fileStat;
+  if( fstat( fd, &fileStat ) == 0 && S_ISREG( fileStat.st_mode ) )
+  {
+    m_size = size_t( fileStat.st_size );
+
+    if( m_size == 0 )
+    {
+      m_isOpen = true;
+    }
+    else
+    {
+      void* mapping = mmap( nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+      if( mapping != MAP_FAILED )
+      {
+        madvise( mapping, m_size, MADV_SEQUENTIAL );
+        m_mapping = mapping;
+        m_data    = ( const uint8_t* ) mapping;
+        m_isOpen  = true;
+      }
+    }
+  }
+  ::close( fd );
+
+  if( m_isOpen )
+  {
+    return true;
+  }
+  m_size = 0;
+#endif
+
+  // no regular file or no memory mapping available, read the whole file
+  std::ifstream file( fileName.c_str(), std::ifstream::in | std::ifstream::binary );
+  if( !file )
+  {
+    return false;
+  }
+
+  char chunk[1 << 16];
+  while( file.read( chunk, sizeof( chunk ) ) || file.gcount() > 0 )
+  {
+    m_storage.insert( m_storage.end(), chunk, chunk + file.gcount() );
+  }
+
+  m_data   = m_storage.data();
+  m_size   = m_storage.size();
+  m_isOpen = true;
+  return true;
+}
+
+void InputByteBuffer::open( const uint8_t* data, size_t size )
+{
+  close();
+
+  m_data   = data;
+  m_size   = size;
+  m_isOpen = true;
+}
+
+void InputByteBuffer::close()
+{
+#if ANNEXB_MMAP
+  if( m_mapping )
+  {
+    munmap( m_mapping, m_size );
+    m_mapping = nullptr;
+  }
+#endif
+  m_storage.clear();
+  m_storage.shrink_to_fit();
+
+  m_data   = nullptr;
+  m_size   = 0;
+  m_pos    = 0;
+  m_isOpen = false;
+}
+
+/**
+ * Find the first byte-aligned three-byte sequence equal to 0x000000,
+ * 0x000001 or 0x000002 in [begin,end), i.e. the end of the NAL unit,
+ * and return its position or end, if there is none.
+ *
+ * Emulation prevention guarantees two successive zero bytes to be rare
+ * inside of a NAL unit, so whole vectors are tested for a zero byte
+ * followed by a zero byte and the rest is scanned with memchr.
+ */
+static const uint8_t* findNalUnitEnd( const uint8_t* begin, const uint8_t* end )
+{
+  const uint8_t* p = begin;
+
+#if ENABLE_SSE2_BASELINE
+  // the third byte of each candidate has to be in range as well
+  while( end - p >= 18 )
+  {
+    unsigned mask = zeroBytePairMask( p );
+
+    for( int i = 0; mask; i++, mask >>= 1 )
+    {
+      if( ( mask & 1 ) && p[i + 2] <= 2 )
+      {
+        return p + i;
+      }
+    }
+    p += 16;
+  }
+#endif
+
+  while( end - p >= 3 )
+  {
+    const uint8_t* zero = ( const uint8_t* ) memchr( p, 0, end - p - 2 );
+    if( !zero )
+    {
+      break;
+    }
+    if( zero[1] == 0 && zero[2] <= 2 )
+    {
+      return zero;
+    }
+    p = zero + 1;
+  }
+
+  return end;
+}
+
+static inline bool isStartCode( const uint8_t* p, const uint8_t* end )
+{
+  return ( end - p >= 3 && p[0] == 0 && p[1] == 0 && p[2] == 1 )
+      || ( end - p >= 4 && p[0] == 0 && p[1] == 0 && p[2] == 0 && p[3] == 1 );
+}
+
+/**
+ * Extract the next NAL unit from the byte stream bs without copying it,
+ * nalUnit points to its first byte and nalUnitSize is its size in bytes.
+ * The bytestream statistics are accumulated into stats, the parsing
+ * follows the steps of _byteStreamNALUnit above.
+ *
+ * Returns true if the end of the byte stream was reached, a stream not
+ * following the syntax ends the NAL unit with the offending byte.
+ */
+bool
+byteStreamNALUnit(
+  InputByteBuffer& bs,
+  const uint8_t*& nalUnit,
+  size_t& nalUnitSize,
+  AnnexBStats& stats)
+{
+  const uint8_t* const end = bs.getData() + bs.getSize();
+  const uint8_t*       p   = bs.getData() + bs.getPos();
+
+  nalUnit     = p;
+  nalUnitSize = 0;
+
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+  CodingStatistics::SStat &statBits=CodingStatistics::GetStatisticEP(STATS__NAL_UNIT_PACKING);
+  CodingStatistics::SStat &bodyStats=CodingStatistics::GetStatisticEP(STATS__NAL_UNIT_TOTAL_BODY);
+#endif
+
+  /* leading_zero_8bits and zero_byte up to the start_code_prefix_one_3bytes */
+  uint32_t numZeros = 0;
+  while( p < end && !( end - p >= 3 && p[0] == 0 && p[1] == 0 && p[2] == 1 ) )
+  {
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+    statBits.bits+=8; statBits.count++;
+#endif
+    if( *p++ != 0 )
+    {
+      break;
+    }
+    numZeros++;
+  }
+
+  if( end - p < 3 || p[0] != 0 || p[1] != 0 || p[2] != 1 )
+  {
+    /* no further NAL unit or a leading byte not equal to zero */
+    stats.m_numLeadingZero8BitsBytes += numZeros;
+    bs.setPos( p - bs.getData() );
+    nalUnit = p;
+    return true;
+  }
+
+  if( numZeros > 0 )
+  {
+    stats.m_numLeadingZero8BitsBytes += numZeros - 1;
+    stats.m_numZeroByteBytes++;
+  }
+
+  p += 3;
+  stats.m_numStartCodePrefixBytes += 3;
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+  statBits.bits+=24; statBits.count+=3;
+#endif
+
+  /* the NAL unit ends before the next 0x000000, 0x000001 or 0x000002, or at the end of the byte stream */
+  const uint8_t* nalEnd = findNalUnitEnd( p, end );
+
+  nalUnit     = p;
+  nalUnitSize = size_t( nalEnd - p );
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+  bodyStats.bits += 8 * uint32_t( nalUnitSize ); bodyStats.count += uint32_t( nalUnitSize );
+#endif
+
+  /* trailing_zero_8bits up to the next start code */
+  p = nalEnd;
+  bool valid = true;
+  while( p < end && !isStartCode( p, end ) )
+  {
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+    statBits.bits+=8; statBits.count++;
+#endif
+    if( *p++ != 0 )
+    {
+      valid = false;
+      break;
+    }
+    stats.m_numTrailingZero8BitsBytes++;
+  }
+
+  stats.m_numBytesInNALUnit = uint32_t( nalUnitSize );
+  bs.setPos( p - bs.getData() );
+
+  return !valid || bs.eof();
+}
+
+/**
+ * Extract the next NAL unit from the byte stream bs into the buffer
+ * nalUnit, see above.
+ */
+bool
+byteStreamNALUnit(
+  InputByteBuffer& bs,
+  vector<uint8_t>& nalUnit,
+  AnnexBStats& stats)
+{
+  const uint8_t* nalUnitData = nullptr;
+  size_t         nalUnitSize = 0;
+
+  const bool eof = byteStreamNALUnit( bs, nalUnitData, nalUnitSize, stats );
+  nalUnit.assign( nalUnitData, nalUnitData + nalUnitSize );
+  return eof;
+}
 //! \}
@@ -43,6 +43,7 @@
 
 #include <stdint.h>
 #include <istream>
+#include <string>
 #include <vector>
 
 #include "CommonLib/CommonDef.h"
@@ -170,6 +171,56 @@ private:
   std::istream& m_Input; /* Input stream to read from */
 };
 
+/**
+ * Byte stream held in memory as a whole, either a memory mapped file
+ * or a span supplied by the caller. The NAL units are handed out as
+ * spans into this memory, the start codes are found by scanning whole
+ * vectors of bytes instead of peeking byte by byte.
+ */
+class InputByteBuffer
+{
+public:
+  InputByteBuffer();
+  ~InputByteBuffer();
+
+  /**
+   * Map the file fileName into memory (or read it, if it cannot be
+   * mapped). Returns false if the file cannot be opened.
+   */
+  bool open( const std::string& fileName );
+
+  /**
+   * Use the size bytes at data as byte stream. The memory is not
+   * copied and has to stay valid until close() is called.
+   */
+  void open( const uint8_t* data, size_t size );
+  void close();
+
+  bool           isOpen () const { return m_isOpen; }
+  const uint8_t* getData() const { return m_data; }
+  size_t         getSize() const { return m_size; }
+
+  /**
+   * Current position in the byte stream, it can be saved and restored
+   * to parse a NAL unit again.
+   */
+  size_t         getPos () const { return m_pos; }
+  void           setPos ( size_t pos ) { CHECK( pos > m_size, "Position beyond the end of the byte stream" ); m_pos = pos; }
+
+  bool           eof    () const { return m_pos >= m_size; }
+
+private:
+  InputByteBuffer( const InputByteBuffer& ) = delete;
+  InputByteBuffer& operator=( const InputByteBuffer& ) = delete;
+
+  bool                 m_isOpen;
+  const uint8_t*       m_data;
+  size_t               m_size;
+  size_t               m_pos;
+  void*                m_mapping;   /* start of the file mapping, if mapped */
+  std::vector<uint8_t> m_storage;   /* file content, if it could not be mapped */
+};
+
 /**
  * Statistics associated with AnnexB bytestreams
  */
@@ -193,6 +244,8 @@ struct AnnexBStats
 };
 
 bool byteStreamNALUnit(InputByteStream& bs, std::vector<uint8_t>& nalUnit, AnnexBStats& stats);
+bool byteStreamNALUnit(InputByteBuffer& bs, const uint8_t*& nalUnit, size_t& nalUnitSize, AnnexBStats& stats);
+bool byteStreamNALUnit(InputByteBuffer& bs, std::vector<uint8_t>& nalUnit, AnnexBStats& stats);
 
 //! \}
 
@@ -123,9 +123,9 @@ void DecCu::decompressCtu( CodingStructure& cs, const UnitArea& ctuArea )
         {
           m_shareStateDec = GEN_ON_SHARED_BOUND;
 #if !JVET_N0266_SMALL_BLOCKS
-          cs.motionLut.lutShare = cs.motionLut.lut;
+          cs.getMotionLut().lutShare = cs.getMotionLut().lut;
 #endif
-          cs.motionLut.lutShareIbc = cs.motionLut.lutIbc;
+          cs.getMotionLut().lutShareIbc = cs.getMotionLut().lutIbc;
         }
 
         if (currCU.shareParentPos.x < 0)
@@ -223,7 +223,7 @@ void DecCu::xIntraRecBlk( TransformUnit& tu, const ComponentID compID )
     const Area area = tu.Y().valid() ? tu.Y() : Area(recalcPosition(tu.chromaFormat, tu.chType, CHANNEL_TYPE_LUMA, tu.blocks[tu.chType].pos()), recalcSize(tu.chromaFormat, tu.chType, CHANNEL_TYPE_LUMA, tu.blocks[tu.chType].size()));
     const CompArea &areaY = CompArea(COMPONENT_Y, tu.chromaFormat, area);
     PelBuf piPredY;
-    piPredY = cs.picture->getPredBuf(areaY);
+    piPredY = cs.getPredBuf(areaY);
     const Pel avgLuma = piPredY.computeAvg();
     int adj = m_pcReshape->calculateChromaAdj(avgLuma);
     tu.setChromaAdj(adj);
@@ -433,8 +433,90 @@ void DecCu::xFillPCMBuffer(CodingUnit &cu)
 
 #include "CommonLib/dtrace_buffer.h"
 
+void DecCu::xWaitForRefLines( const CodingUnit& cu )
+{
+  // samples around the referenced block needed by the interpolation filter, the DMVR refinement and the BDOF padding
+  static const int refMargin = 16;
+
+  const Slice& slice    = *cu.slice;
+  const int    picWidth = slice.getSPS()->getPicWidthInLumaSamples();
+  const int    picLines = slice.getSPS()->getPicHeightInLumaSamples();
+  int neededLines[NUM_REF_PIC_LIST_01][MAX_NUM_REF] = { { 0 } };
+
+  auto addMotion = [&]( const RefPicList refList, const int refIdx, const Mv& mv, const Area& puArea )
+  {
+    if( refIdx < 0 )
+    {
+      return;
+    }
+    const int mvHor  = mv.getHor() >> MV_FRACTIONAL_BITS_INTERNAL;
+    const int mvVer  = mv.getVer() >> MV_FRACTIONAL_BITS_INTERNAL;
+    const int left   = puArea.x                 + mvHor - refMargin;
+    const int right  = puArea.x + puArea.width  + mvHor + refMargin;
+    const int top    = puArea.y                 + mvVer - refMargin;
+    const int bottom = puArea.y + puArea.height + mvVer + refMargin;
+
+    // the picture border is only extended after the whole picture is final
+    const bool inPic = left >= 0 && right <= picWidth && top >= 0;
+    neededLines[refList][refIdx] = std::max( neededLines[refList][refIdx], inPic ? bottom : picLines );
+  };
+
+  for( const auto &pu : CU::traversePUs( cu ) )
+  {
+    const Area& puArea = pu.Y();
+
+    if( cu.triangle )
+    {
+      // the motion of triangle partitions is stored after the motion compensation
+      for( const int candIdx : { pu.triangleMergeIdx0, pu.triangleMergeIdx1 } )
+      {
+        for( int refList = 0; refList < NUM_REF_PIC_LIST_01; refList++ )
+        {
+          const MvField& mvField = m_triangleMrgCtx.mvFieldNeighbours[( candIdx << 1 ) + refList];
+          addMotion( RefPicList( refList ), mvField.refIdx, mvField.mv, puArea );
+        }
+      }
+      continue;
+    }
+
+    // the motion buffer also covers the sub-block motion of affine and sub-block TMVP prediction units
+    const CMotionBuf mb = pu.getMotionBuf();
+    for( int y = 0; y < mb.height; y++ )
+    {
+      for( int x = 0; x < mb.width; x++ )
+      {
+        const MotionInfo& mi = mb.at( x, y );
+        for( int refList = 0; refList < NUM_REF_PIC_LIST_01; refList++ )
+        {
+          if( mi.interDir & ( 1 << refList ) )
+          {
+            addMotion( RefPicList( refList ), mi.refIdx[refList], mi.mv[refList], puArea );
+          }
+        }
+      }
+    }
+  }
+
+  for( int refList = 0; refList < NUM_REF_PIC_LIST_01; refList++ )
+  {
+    for( int refIdx = 0; refIdx < slice.getNumRefIdx( RefPicList( refList ) ); refIdx++ )
+    {
+      if( neededLines[refList][refIdx] > 0 )
+      {
+        slice.getRefPic( RefPicList( refList ), refIdx )->waitForReconLines( neededLines[refList][refIdx] );
+      }
+    }
+  }
+}
+
 void DecCu::xReconInter(CodingUnit &cu)
 {
+  if( !CU::isIBC( cu ) )
+  {
+    // references decoded in the frame pipeline might still be filtered
+    xWaitForRefLines( cu );
+  }
+
   if( cu.triangle )
   {
     const bool    splitDir = cu.firstPU->triangleSplitDir;
@@ -470,7 +552,7 @@ void DecCu::xReconInter(CodingUnit &cu)
     {
       MotionInfo mi = pu.getMotionInfo();
       mi.GBiIdx = (mi.interDir == 3) ? cu.GBiIdx : GBI_DEFAULT;
-      cu.cs->addMiToLut(CU::isIBC(cu) ? cu.cs->motionLut.lutIbc : cu.cs->motionLut.lut, mi );
+      cu.cs->addMiToLut(CU::isIBC(cu) ? cu.cs->getMotionLut().lutIbc : cu.cs->getMotionLut().lut, mi );
     }
   }
 
@@ -82,6 +82,7 @@ protected:
   void xIntraRecQT        ( CodingUnit&      cu, const ChannelType chType );
 
   void xReconInter        ( CodingUnit&      cu );
+  void xWaitForRefLines   ( const CodingUnit& cu );
   void xDecodeInterTexture( CodingUnit&      cu );
   void xReconIntraQT      ( CodingUnit&      cu );
   void xFillPCMBuffer     ( CodingUnit&      cu );
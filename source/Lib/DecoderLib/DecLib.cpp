@@ -65,8 +65,7 @@ bool tryDecodePicture( Picture* pcEncPic, const int expectedPoc, const std::stri
   static bool loopFiltered    = false;            /* TODO: MT */
   static int  iPOCLastDisplay = -MAX_INT;         /* TODO: MT */
 
-  static std::ifstream* bitstreamFile = nullptr;  /* TODO: MT */
-  static InputByteStream* bytestream  = nullptr;  /* TODO: MT */
+  static InputByteBuffer* bytestream  = nullptr;  /* TODO: MT */
   bool bRet = false;
 
   // create & initialize internal classes
@@ -76,10 +75,10 @@ bool tryDecodePicture( Picture* pcEncPic, const int expectedPoc, const std::stri
   {
     if( bFirstCall )
     {
-      bitstreamFile = new std::ifstream( bitstreamFileName.c_str(), std::ifstream::in | std::ifstream::binary );
-      bytestream    = new InputByteStream( *bitstreamFile );
+      bytestream    = new InputByteBuffer;
 
-      CHECK( !*bitstreamFile, "failed to open bitstream file " << bitstreamFileName.c_str() << " for reading" ) ;
+      const bool isOpen = bytestream->open( bitstreamFileName );
+      CHECK( !isOpen, "failed to open bitstream file " << bitstreamFileName.c_str() << " for reading" ) ;
       // create decoder class
       pcDecLib = new DecLib;
       pcDecLib->create();
@@ -102,13 +101,13 @@ bool tryDecodePicture( Picture* pcEncPic, const int expectedPoc, const std::stri
     bool goOn = true;
 
     // main decoder loop
-    while( !!*bitstreamFile && goOn )
+    while( !bytestream->eof() && goOn )
     {
       /* location serves to work around a design fault in the decoder, whereby
        * the process of reading a new slice that is the first slice of a new frame
        * requires the DecApp::decode() method to be called again with the same
        * nal unit. */
-      std::streampos location = bitstreamFile->tellg();
+      size_t location         = bytestream->getPos();
       AnnexBStats stats       = AnnexBStats();
 
       InputNALUnit nalu;
@@ -132,19 +131,14 @@ bool tryDecodePicture( Picture* pcEncPic, const int expectedPoc, const std::stri
         bNewPicture = pcDecLib->decode( nalu, iSkipFrame, iPOCLastDisplay );
         if( bNewPicture )
         {
-          bitstreamFile->clear();
-          /* location points to the current nalunit payload[1] due to the
-            * need for the annexB parser to read three extra bytes.
-            * [1] except for the first NAL unit in the file
-            *     (but bNewPicture doesn't happen then) */
-          bitstreamFile->seekg( location - std::streamoff( 3 ) );
-          bytestream->reset();
+          /* location points to the start of the current nalunit */
+          bytestream->setPos( location );
         }
       }
 
-      if( ( bNewPicture || !*bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS ) && !pcDecLib->getFirstSliceInSequence() )
+      if( ( bNewPicture || bytestream->eof() || nalu.m_nalUnitType == NAL_UNIT_EOS ) && !pcDecLib->getFirstSliceInSequence() )
       {
-        if( !loopFiltered || *bitstreamFile )
+        if( !loopFiltered || !bytestream->eof() )
         {
           pcDecLib->finishPictureLight( poc, pcListPic );
 
@@ -330,7 +324,7 @@ bool tryDecodePicture( Picture* pcEncPic, const int expectedPoc, const std::stri
         }
 
       }
-      else if( ( bNewPicture || !*bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS ) && pcDecLib->getFirstSliceInSequence() )
+      else if( ( bNewPicture || bytestream->eof() || nalu.m_nalUnitType == NAL_UNIT_EOS ) && pcDecLib->getFirstSliceInSequence() )
       {
         pcDecLib->setFirstSliceInPicture( true );
       }
@@ -356,12 +350,6 @@ bool tryDecodePicture( Picture* pcEncPic, const int expectedPoc, const std::stri
       delete bytestream;
       bytestream = nullptr;
     }
-
-    if( bitstreamFile )
-    {
-      delete bitstreamFile;
-      bitstreamFile = nullptr;
-    }
   }
 
   return bRet;
@@ -381,16 +369,20 @@ DecLib::DecLib()
   , m_parameterSetManager()
   , m_apcSlicePilot(NULL)
   , m_SEIs()
-  , m_cIntraPred()
-  , m_cInterPred()
-  , m_cTrQuant()
+  , m_numDecThreads(1)
+  , m_cIntraPred(nullptr)
+  , m_cInterPred(nullptr)
+  , m_cTrQuant(nullptr)
   , m_cSliceDecoder()
-  , m_cCuDecoder()
+  , m_cCuDecoder(nullptr)
   , m_HLSReader()
+  , m_CABACDecoder(nullptr)
   , m_seiReader()
-  , m_cLoopFilter()
   , m_cSAO()
+  , m_cInLoopFilter()
   , m_cReshaper()
+  , m_cRdCost(nullptr)
+  , m_maxPicsInFlight(1)
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   , m_cacheModel()
 #endif
@@ -431,14 +423,44 @@ void DecLib::create()
 {
   m_apcSlicePilot = new Slice;
   m_uiSliceSegmentIdx = 0;
+
+  CHECK( m_numDecThreads < 1, "Number of decoding threads has to be at least one" );
+
+  m_cIntraPred    = new IntraPrediction[m_numDecThreads];
+  m_cInterPred    = new InterPrediction[m_numDecThreads];
+  m_cTrQuant      = new TrQuant        [m_numDecThreads];
+  m_cCuDecoder    = new DecCu          [m_numDecThreads];
+  m_CABACDecoder  = new CABACDecoder   [m_numDecThreads];
+  m_cRdCost       = new RdCost         [m_numDecThreads];
+
+  m_threadPool.create( m_numDecThreads );
 }
 
 void DecLib::destroy()
 {
+  finishPendingPictures();
+
   delete m_apcSlicePilot;
   m_apcSlicePilot = NULL;
 
   m_cSliceDecoder.destroy();
+
+  m_threadPool.destroy();
+  m_cInLoopFilter.destroy();
+
+  delete[] m_cIntraPred;
+  delete[] m_cInterPred;
+  delete[] m_cTrQuant;
+  delete[] m_cCuDecoder;
+  delete[] m_CABACDecoder;
+  delete[] m_cRdCost;
+
+  m_cIntraPred    = nullptr;
+  m_cInterPred    = nullptr;
+  m_cTrQuant      = nullptr;
+  m_cCuDecoder    = nullptr;
+  m_CABACDecoder  = nullptr;
+  m_cRdCost       = nullptr;
 }
 
 void DecLib::init(
@@ -447,17 +469,20 @@ void DecLib::init(
 #endif
 )
 {
-  m_cSliceDecoder.init( &m_CABACDecoder, &m_cCuDecoder );
+  m_cSliceDecoder.init( m_CABACDecoder, m_cCuDecoder, m_numDecThreads, &m_threadPool );
+  m_cInLoopFilter.init( &m_cSAO, &m_cALF, &m_threadPool );
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   m_cacheModel.create( cacheCfgFileName );
   m_cacheModel.clear( );
-  m_cInterPred.cacheAssign( &m_cacheModel );
+  m_cInterPred[0].cacheAssign( &m_cacheModel );
 #endif
   DTRACE_UPDATE( g_trace_ctx, std::make_pair( "final", 1 ) );
 }
 
 void DecLib::deletePicBuffer ( )
 {
+  finishPendingPictures();
+
   PicList::iterator  iterPic   = m_cListPic.begin();
   int iSize = int( m_cListPic.size() );
 
@@ -471,12 +496,14 @@ void DecLib::deletePicBuffer ( )
   }
   m_cALF.destroy();
   m_cSAO.destroy();
-  m_cLoopFilter.destroy();
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   m_cacheModel.reportSequence( );
   m_cacheModel.destroy( );
 #endif
-  m_cCuDecoder.destoryDecCuReshaprBuf();
+  for( int jId = 0; jId < m_numDecThreads; jId++ )
+  {
+    m_cCuDecoder[jId].destoryDecCuReshaprBuf();
+  }
   m_cReshaper.destroy();
 }
 
@@ -499,6 +526,10 @@ Picture* DecLib::xGetNewPicBuffer ( const SPS &sps, const PPS &pps, const uint32
   for(auto * p: m_cListPic)
   {
     pcPic = p;  // workaround because range-based for-loops don't work with existing variables
+    if( xIsPendingPicture( pcPic ) )
+    {
+      continue;
+    }
     if ( pcPic->reconstructed == false && ! pcPic->neededForOutput )
     {
       pcPic->neededForOutput = false;
@@ -515,6 +546,13 @@ Picture* DecLib::xGetNewPicBuffer ( const SPS &sps, const PPS &pps, const uint32
     }
   }
 
+  if( ! bBufferIsAvailable && ! m_pendingPics.empty() )
+  {
+    // a picture still being filtered might become available, wait for it rather than extending the buffer
+    finishPendingPictures();
+    return xGetNewPicBuffer( sps, pps, temporalLayer );
+  }
+
   if( ! bBufferIsAvailable )
   {
     //There is no room for this picture, either because of faulty encoder or dropped NAL. Extend the buffer.
@@ -552,40 +590,63 @@ void DecLib::executeLoopFilters()
 
   CodingStructure& cs = *m_pcPic->cs;
 
-  if (cs.sps->getUseReshaper() && m_cReshaper.getSliceReshaperInfo().getUseSliceReshaper())
+  const bool useReshaper = cs.sps->getUseReshaper() && m_cReshaper.getSliceReshaperInfo().getUseSliceReshaper();
+  if (useReshaper)
   {
       CHECK((m_cReshaper.getRecReshaped() == false), "Rec picture is not reshaped!");
       m_pcPic->getRecoBuf(COMPONENT_Y).rspSignal(m_cReshaper.getInvLUT());
       m_cReshaper.setRecReshaped(false);
-      m_cSAO.setReshaper(&m_cReshaper);
-  }
-  // deblocking filter
-  m_cLoopFilter.loopFilterPic( cs );
-  CS::setRefinedMotionField(cs);
-  if( cs.sps->getSAOEnabledFlag() )
-  {
-    m_cSAO.SAOProcess( cs, cs.picture->getSAO() );
   }
 
-  if( cs.sps->getALFEnabledFlag() )
-  {
 #if JVET_N0415_CTB_ALF
-    if (cs.slice->getTileGroupAlfEnabledFlag(COMPONENT_Y))
+  const bool applyALF = cs.sps->getALFEnabledFlag() && cs.slice->getTileGroupAlfEnabledFlag( COMPONENT_Y );
 #else
-    if (cs.slice->getTileGroupAlfEnabledFlag())
+  const bool applyALF = cs.sps->getALFEnabledFlag() && cs.slice->getTileGroupAlfEnabledFlag();
 #endif
+
+  if( !xIsPipelined() )
+  {
+    JobCounter filterJobs;
+    m_cInLoopFilter.addFilterJobs( cs, cs.sps->getSAOEnabledFlag(), applyALF, useReshaper ? &m_cReshaper : nullptr, filterJobs );
+    m_threadPool.wait( filterJobs );
+    return;
+  }
+
+  m_pendingPics.emplace_back();
+  PendingPicture& pending = m_pendingPics.back();
+  pending.pic  = m_pcPic;
+  pending.msgl = INFO;
+
+  m_cInLoopFilter.addFilterJobs( cs, cs.sps->getSAOEnabledFlag(), applyALF, useReshaper ? &m_cReshaper : nullptr, pending.filterJobs );
+}
+
+bool DecLib::xIsPendingPicture( const Picture* pic ) const
+{
+  for( const auto& pending : m_pendingPics )
+  {
+    if( pending.pic == pic )
     {
-      // ALF decodes the differentially coded coefficients and stores them in the parameters structure.
-      // Code could be restructured to do directly after parsing. So far we just pass a fresh non-const
-      // copy in case the APS gets used more than once.
-#if JVET_N0415_CTB_ALF
-      m_cALF.ALFProcess(cs);
-#else
-      AlfSliceParam alfParamCopy = cs.aps->getAlfAPSParam();
-      m_cALF.ALFProcess(cs, alfParamCopy);
-#endif
+      return true;
     }
+  }
+  return false;
+}
+
+void DecLib::xFinishPendingPicture()
+{
+  PendingPicture& pending = m_pendingPics.front();
+
+  m_threadPool.wait( pending.filterJobs );
+  xFinalizePicture( pending.pic, pending.msgl, &pending.hashJobs );
+
+  m_pendingPics.pop_front();
+}
 
+void DecLib::finishPendingPictures()
+{
+  while( !m_pendingPics.empty() )
+  {
+    xFinishPendingPicture();
   }
 }
 
@@ -611,8 +672,42 @@ void DecLib::finishPicture(int& poc, PicList*& rpcListPic, MsgLevel msgl )
 
   Slice*  pcSlice = m_pcPic->cs->slice;
 
+  m_pcPic->neededForOutput = (pcSlice->getPicOutputFlag() ? true : false);
+  m_pcPic->reconstructed = true;
+
+
+  Slice::sortPicList( m_cListPic ); // sorting for application output
+  poc                 = pcSlice->getPOC();
+  rpcListPic          = &m_cListPic;
+  m_bFirstSliceInPicture  = true; // TODO: immer true? hier ist irgendwas faul
+
+  if( !m_pendingPics.empty() && m_pendingPics.back().pic == m_pcPic )
+  {
+    // the picture is reported once its in-loop filters are done, limit the number of pictures in flight
+    m_pendingPics.back().msgl = msgl;
+    // the hash SEI of the picture is known now, the planes are hashed as soon as the filters are finished
+    SEIMessages pictureHashes = getSeisByType( m_pcPic->SEIs, SEI::DECODED_PICTURE_HASH );
+    if( m_decodedPictureHashSEIEnabled && !pictureHashes.empty() )
+    {
+      const SEIDecodedPictureHash* hash = (SEIDecodedPictureHash*) *(pictureHashes.begin());
+      m_pendingPics.back().hashJobs.start( m_pcPic->getRecoBuf(), hash->method, pcSlice->getSPS()->getBitDepths(), &m_threadPool, m_pcPic );
+    }
+    while( int( m_pendingPics.size() ) >= m_maxPicsInFlight )
+    {
+      xFinishPendingPicture();
+    }
+    return;
+  }
+
+  xFinalizePicture( m_pcPic, msgl );
+}
+
+void DecLib::xFinalizePicture( Picture* pic, MsgLevel msgl, PictureHashJobs* hashJobs )
+{
+  Slice*  pcSlice = pic->cs->slice;
+
   char c = (pcSlice->isIntra() ? 'I' : pcSlice->isInterP() ? 'P' : 'B');
-  if (!m_pcPic->referenced)
+  if (!pic->referenced)
   {
     c += 32;  // tolower
   }
@@ -635,29 +730,27 @@ void DecLib::finishPicture(int& poc, PicList*& rpcListPic, MsgLevel msgl )
   }
   if (m_decodedPictureHashSEIEnabled)
   {
-    SEIMessages pictureHashes = getSeisByType(m_pcPic->SEIs, SEI::DECODED_PICTURE_HASH );
+    SEIMessages pictureHashes = getSeisByType(pic->SEIs, SEI::DECODED_PICTURE_HASH );
     const SEIDecodedPictureHash *hash = ( pictureHashes.size() > 0 ) ? (SEIDecodedPictureHash*) *(pictureHashes.begin()) : NULL;
     if (pictureHashes.size() > 1)
     {
       msg( WARNING, "Warning: Got multiple decoded picture hash SEI messages. Using first.");
     }
-    m_numberOfChecksumErrorsDetected += calcAndPrintHashStatus(((const Picture*) m_pcPic)->getRecoBuf(), hash, pcSlice->getSPS()->getBitDepths(), msgl);
+    if( hashJobs && hashJobs->isStarted() && hash )
+    {
+      m_numberOfChecksumErrorsDetected += printHashStatus( *hashJobs, hash, msgl );
+    }
+    else
+    {
+      m_numberOfChecksumErrorsDetected += calcAndPrintHashStatus(((const Picture*) pic)->getRecoBuf(), hash, pcSlice->getSPS()->getBitDepths(), msgl, &m_threadPool);
+    }
   }
 
   msg( msgl, "\n");
 
-  m_pcPic->neededForOutput = (pcSlice->getPicOutputFlag() ? true : false);
-  m_pcPic->reconstructed = true;
-
-
-  Slice::sortPicList( m_cListPic ); // sorting for application output
-  poc                 = pcSlice->getPOC();
-  rpcListPic          = &m_cListPic;
-  m_bFirstSliceInPicture  = true; // TODO: immer true? hier ist irgendwas faul
-
-  m_pcPic->destroyTempBuffers();
-  m_pcPic->cs->destroyCoeffs();
-  m_pcPic->cs->releaseIntermediateData();
+  pic->destroyTempBuffers();
+  pic->cs->destroyCoeffs();
+  pic->cs->releaseIntermediateData();
 }
 
 void DecLib::checkNoOutputPriorPics (PicList* pcListPic)
@@ -719,6 +812,7 @@ void DecLib::xCreateLostPicture(int iLostPoc)
     if(abs(rpcPic->getPOC() -iLostPoc)==closestPoc&&rpcPic->getPOC()!=m_apcSlicePilot->getPOC())
     {
       msg( INFO, "copying picture %d to %d (%d)\n",rpcPic->getPOC() ,iLostPoc,m_apcSlicePilot->getPOC());
+      rpcPic->waitForReconstruction();
       cFillPic->getRecoBuf().copyFrom( rpcPic->getRecoBuf() );
       break;
     }
@@ -822,6 +916,10 @@ void DecLib::xActivateParameterSets()
 
     //  Get a new picture buffer. This will also set up m_pcPic, and therefore give us a SPS and PPS pointer that we can use.
     m_pcPic = xGetNewPicBuffer (*sps, *pps, m_apcSlicePilot->getTLayer());
+    if( xIsPipelined() )
+    {
+      m_pcPic->startReconstruction();
+    }
 
     m_apcSlicePilot->applyReferencePictureSet(m_cListPic, m_apcSlicePilot->getRPS());
 #if JVET_N0415_CTB_ALF
@@ -861,11 +959,12 @@ void DecLib::xActivateParameterSets()
 #endif
     m_pcPic->cs->pcv   = pps->pcv;
 
-    // Initialise the various objects for the new set of settings
-    m_cSAO.create( sps->getPicWidthInLumaSamples(), sps->getPicHeightInLumaSamples(), sps->getChromaFormatIdc(), sps->getMaxCUWidth(), sps->getMaxCUHeight(), sps->getMaxCodingDepth(), pps->getPpsRangeExtension().getLog2SaoOffsetScale(CHANNEL_TYPE_LUMA), pps->getPpsRangeExtension().getLog2SaoOffsetScale(CHANNEL_TYPE_CHROMA) );
-    m_cLoopFilter.create( sps->getMaxCodingDepth() );
-    m_cIntraPred.init( sps->getChromaFormatIdc(), sps->getBitDepth( CHANNEL_TYPE_LUMA ) );
-    m_cInterPred.init( &m_cRdCost, sps->getChromaFormatIdc() );
+    // Initialise the various objects for the new set of settings (the in-loop filters are set up by the filter jobs)
+    for( int jId = 0; jId < m_numDecThreads; jId++ )
+    {
+      m_cIntraPred[jId].init( sps->getChromaFormatIdc(), sps->getBitDepth( CHANNEL_TYPE_LUMA ) );
+      m_cInterPred[jId].init( &m_cRdCost[jId], sps->getChromaFormatIdc() );
+    }
     if (sps->getUseReshaper())
     {
       m_cReshaper.createDec(sps->getBitDepth(CHANNEL_TYPE_LUMA));
@@ -894,27 +993,25 @@ void DecLib::xActivateParameterSets()
     m_pcPic->SEIs = m_SEIs;
     m_SEIs.clear();
 
-    // Recursive structure
-    m_cCuDecoder.init( &m_cTrQuant, &m_cIntraPred, &m_cInterPred );
-    if (sps->getUseReshaper())
+    for( int jId = 0; jId < m_numDecThreads; jId++ )
     {
-      m_cCuDecoder.initDecCuReshaper(&m_cReshaper, sps->getChromaFormatIdc());
-    }
+      // Recursive structure
+      m_cCuDecoder[jId].init( &m_cTrQuant[jId], &m_cIntraPred[jId], &m_cInterPred[jId] );
+      if (sps->getUseReshaper())
+      {
+        m_cCuDecoder[jId].initDecCuReshaper(&m_cReshaper, sps->getChromaFormatIdc());
+      }
 #if MAX_TB_SIZE_SIGNALLING
-    m_cTrQuant.init( nullptr, sps->getMaxTbSize(), false, false, false, false, false );
+      m_cTrQuant[jId].init( nullptr, sps->getMaxTbSize(), false, false, false, false, false );
 #else
-    m_cTrQuant.init( nullptr, MAX_TB_SIZEY, false, false, false, false, false );
+      m_cTrQuant[jId].init( nullptr, MAX_TB_SIZEY, false, false, false, false, false );
 #endif
 
-    // RdCost
-    m_cRdCost.setCostMode ( COST_STANDARD_LOSSY ); // not used in decoder side RdCost stuff -> set to default
+      // RdCost
+      m_cRdCost[jId].setCostMode ( COST_STANDARD_LOSSY ); // not used in decoder side RdCost stuff -> set to default
+    }
 
     m_cSliceDecoder.create();
-
-    if( sps->getALFEnabledFlag() )
-    {
-      m_cALF.create( sps->getPicWidthInLumaSamples(), sps->getPicHeightInLumaSamples(), sps->getChromaFormatIdc(), sps->getMaxCUWidth(), sps->getMaxCUHeight(), sps->getMaxCodingDepth(), sps->getBitDepths().recon );
-    }
   }
   else
   {
@@ -1385,8 +1482,6 @@ bool DecLib::xDecodeSlice(InputNALUnit &nalu, int &iSkipFrame, int iPOCLastDispl
 #endif
 
 #if HEVC_USE_SCALING_LISTS
-  Quant *quant = m_cTrQuant.getQuant();
-
   if(pcSlice->getSPS()->getScalingListFlag())
   {
     ScalingList scalingList;
@@ -1402,12 +1497,19 @@ bool DecLib::xDecodeSlice(InputNALUnit &nalu, int &iSkipFrame, int iPOCLastDispl
     {
       scalingList.setDefaultScalingList();
     }
-    quant->setScalingListDec(scalingList);
-    quant->setUseScalingList(true);
+    for( int jId = 0; jId < m_numDecThreads; jId++ )
+    {
+      Quant *quant = m_cTrQuant[jId].getQuant();
+      quant->setScalingListDec(scalingList);
+      quant->setUseScalingList(true);
+    }
   }
   else
   {
-    quant->setUseScalingList(false);
+    for( int jId = 0; jId < m_numDecThreads; jId++ )
+    {
+      m_cTrQuant[jId].getQuant()->setUseScalingList(false);
+    }
   }
 #endif
 
@@ -1448,6 +1550,12 @@ bool DecLib::xDecodeSlice(InputNALUnit &nalu, int &iSkipFrame, int iPOCLastDispl
     m_cReshaper.setRecReshaped(false);
   }
 
+  // the collocated motion field of a pipelined reference picture is final after its deblocking
+  if( pcSlice->getEnableTMVPFlag() && !pcSlice->isIntra() )
+  {
+    pcSlice->getRefPic( RefPicList( pcSlice->isInterB() ? 1 - pcSlice->getColFromL0Flag() : 0 ), pcSlice->getColRefIdx() )->waitForMotionField();
+  }
+
   //  Decode a picture
   m_cSliceDecoder.decompressSlice( pcSlice, &( nalu.getBitstream() ), ( m_pcPic->poc == getDebugPOC() ? getDebugCTU() : -1 ) );
 
@@ -1463,6 +1571,7 @@ void DecLib::xDecodeVPS( InputNALUnit& nalu )
   VPS* vps = new VPS();
   m_HLSReader.setBitstream( &nalu.getBitstream() );
   m_HLSReader.parseVPS( vps );
+  finishPendingPictures();
   m_parameterSetManager.storeVPS( vps, nalu.getBitstream().getFifo() );
 }
 #endif
@@ -1472,6 +1581,7 @@ void DecLib::xDecodeSPS( InputNALUnit& nalu )
   SPS* sps = new SPS();
   m_HLSReader.setBitstream( &nalu.getBitstream() );
   m_HLSReader.parseSPS( sps );
+  finishPendingPictures(); // pipelined pictures still refer to the stored parameter sets
   m_parameterSetManager.storeSPS( sps, nalu.getBitstream().getFifo() );
 
   DTRACE( g_trace_ctx, D_QP_PER_CTU, "CTU Size: %dx%d", sps->getMaxCUWidth(), sps->getMaxCUHeight() );
@@ -1482,6 +1592,7 @@ void DecLib::xDecodePPS( InputNALUnit& nalu )
   PPS* pps = new PPS();
   m_HLSReader.setBitstream( &nalu.getBitstream() );
   m_HLSReader.parsePPS( pps );
+  finishPendingPictures();
   m_parameterSetManager.storePPS( pps, nalu.getBitstream().getFifo() );
 }
 
@@ -1493,6 +1604,19 @@ void DecLib::xDecodeAPS(InputNALUnit& nalu)
 #if JVET_N0415_CTB_ALF
   aps->setTemporalId(nalu.m_temporalId);
 #endif
+  // the in-loop filters of pipelined pictures might still use the APS that gets replaced
+  for( const auto& pending : m_pendingPics )
+  {
+#if JVET_N0415_CTB_ALF
+    if( pending.pic->cs->apss[aps->getAPSId()] )
+#else
+    if( pending.pic->cs->aps && pending.pic->cs->aps->getAPSId() == aps->getAPSId() )
+#endif
+    {
+      finishPendingPictures();
+      break;
+    }
+  }
   m_parameterSetManager.storeAPS(aps, nalu.getBitstream().getFifo());
 }
 bool DecLib::decode(InputNALUnit& nalu, int& iSkipFrame, int& iPOCLastDisplay)
@@ -49,11 +49,11 @@
 #include "CommonLib/TrQuant.h"
 #include "CommonLib/InterPrediction.h"
 #include "CommonLib/IntraPrediction.h"
-#include "CommonLib/LoopFilter.h"
-#include "CommonLib/AdaptiveLoopFilter.h"
+#include "CommonLib/InLoopFilterStage.h"
 #include "CommonLib/SEI.h"
 #include "CommonLib/Unit.h"
 #include "CommonLib/Reshape.h"
+#include "CommonLib/ThreadPool.h"
 
 class InputNALUnit;
 
@@ -82,21 +82,34 @@ private:
 
   SEIMessages             m_SEIs; ///< List of SEI messages that have been received before the first slice and between slices, excluding prefix SEIs...
 
-  // functional classes
-  IntraPrediction         m_cIntraPred;
-  InterPrediction         m_cInterPred;
-  TrQuant                 m_cTrQuant;
+  // functional classes, one stack per CTU decoding thread
+  int                     m_numDecThreads;
+  IntraPrediction        *m_cIntraPred;
+  InterPrediction        *m_cInterPred;
+  TrQuant                *m_cTrQuant;
   DecSlice                m_cSliceDecoder;
-  DecCu                   m_cCuDecoder;
+  DecCu                  *m_cCuDecoder;
   HLSyntaxReader          m_HLSReader;
-  CABACDecoder            m_CABACDecoder;
+  CABACDecoder           *m_CABACDecoder;
   SEIReader               m_seiReader;
-  LoopFilter              m_cLoopFilter;
   SampleAdaptiveOffset    m_cSAO;
   AdaptiveLoopFilter      m_cALF;
+  InLoopFilterStage       m_cInLoopFilter;                ///< CTU row jobs of deblocking, SAO and ALF
   Reshape                 m_cReshaper;                        ///< reshaper class
   // decoder side RD cost computation
-  RdCost                  m_cRdCost;                      ///< RD cost computation class
+  RdCost                 *m_cRdCost;                      ///< RD cost computation class
+  ThreadPool              m_threadPool;                   ///< workers for parallel substream decoding and in-loop filtering
+
+  // frame pipelining: the in-loop filters of a picture run on the thread pool while the following pictures are decoded
+  struct PendingPicture
+  {
+    Picture*              pic;
+    MsgLevel              msgl;
+    JobCounter            filterJobs;
+    PictureHashJobs       hashJobs;                       ///< started when the picture is finished, wait for the in-loop filters
+  };
+  int                     m_maxPicsInFlight;              ///< pictures being decoded or filtered at the same time, 1 disables pipelining
+  std::deque<PendingPicture> m_pendingPics;               ///< pictures with pending in-loop filters, in decoding order
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   CacheModel              m_cacheModel;
 #endif
@@ -134,6 +147,10 @@ public:
   void  destroy ();
 
   void  setDecodedPictureHashSEIEnabled(int enabled) { m_decodedPictureHashSEIEnabled=enabled; }
+  void  setNumDecThreads      ( int n )        { m_numDecThreads = n; }   ///< has to be set before create()
+  int   getNumDecThreads      () const         { return m_numDecThreads; }
+  void  setMaxPicsInFlight    ( int n )        { m_maxPicsInFlight = n; }
+  int   getMaxPicsInFlight    () const         { return m_maxPicsInFlight; }
 
   void  init(
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
@@ -146,6 +163,7 @@ public:
   void  executeLoopFilters();
   void  finishPicture(int& poc, PicList*& rpcListPic, MsgLevel msgl = INFO);
   void  finishPictureLight(int& poc, PicList*& rpcListPic );
+  void  finishPendingPictures();                          ///< waits for the in-loop filters of all pipelined pictures
   void  checkNoOutputPriorPics (PicList* rpcListPic);
 
   bool  getNoOutputPriorPicsFlag () const   { return m_isNoOutputPriorPics; }
@@ -166,6 +184,11 @@ protected:
   Picture * xGetNewPicBuffer(const SPS &sps, const PPS &pps, const uint32_t temporalLayer);
   void  xCreateLostPicture (int iLostPOC);
 
+  bool  xIsPipelined          () const { return m_maxPicsInFlight > 1 && m_threadPool.getNumThreads() > 1; }
+  bool  xIsPendingPicture     ( const Picture* pic ) const;
+  void  xFinishPendingPicture ();
+  void  xFinalizePicture      ( Picture* pic, MsgLevel msgl, PictureHashJobs* hashJobs = nullptr );
+
   void      xActivateParameterSets();
   bool      xDecodeSlice(InputNALUnit &nalu, int &iSkipFrame, int iPOCLastDisplay);
 #if HEVC_VPS
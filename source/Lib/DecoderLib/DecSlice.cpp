@@ -49,6 +49,8 @@
 //////////////////////////////////////////////////////////////////////
 
 DecSlice::DecSlice()
+  : m_ctuPredBufs( nullptr )
+  , m_ctuResiBufs( nullptr )
 {
 }
 
@@ -62,12 +64,45 @@ void DecSlice::create()
 
 void DecSlice::destroy()
 {
+  delete[] m_ctuPredBufs;
+  delete[] m_ctuResiBufs;
+  m_ctuPredBufs = nullptr;
+  m_ctuResiBufs = nullptr;
 }
 
-void DecSlice::init( CABACDecoder* cabacDecoder, DecCu* pcCuDecoder )
+void DecSlice::init( CABACDecoder* cabacDecoder, DecCu* pcCuDecoder, int numDecStacks, ThreadPool* threadPool )
 {
   m_CABACDecoder    = cabacDecoder;
   m_pcCuDecoder     = pcCuDecoder;
+  m_numDecStacks    = numDecStacks;
+  m_threadPool      = threadPool;
+
+  m_freeStacks.clear();
+  for( int stackId = numDecStacks - 1; stackId >= 0; stackId-- )
+  {
+    m_freeStacks.push_back( stackId );
+  }
+
+  delete[] m_ctuPredBufs;
+  delete[] m_ctuResiBufs;
+  m_ctuPredBufs = new PelStorage[numDecStacks];
+  m_ctuResiBufs = new PelStorage[numDecStacks];
+}
+
+int DecSlice::xAcquireStack()
+{
+  std::unique_lock<std::mutex> lock( m_stackMutex );
+  // at most one job per pool thread runs at any time, so a free stack is always left
+  CHECK( m_freeStacks.empty(), "No free CTU decoding stack" );
+  const int stackId = m_freeStacks.back();
+  m_freeStacks.pop_back();
+  return stackId;
+}
+
+void DecSlice::xReleaseStack( const int stackId )
+{
+  std::unique_lock<std::mutex> lock( m_stackMutex );
+  m_freeStacks.push_back( stackId );
 }
 
 void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int debugCTU )
@@ -78,7 +113,6 @@ void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int deb
   const SPS*     sps          = slice->getSPS();
   Picture*       pic          = slice->getPic();
   const TileMap& tileMap      = *pic->tileMap;
-  CABACReader&   cabacReader  = *m_CABACDecoder->getCABACReader( 0 );
 
   // setup coding structure
   CodingStructure& cs = *pic->cs;
@@ -110,10 +144,10 @@ void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int deb
 
   // init each couple {EntropyDecoder, Substream}
   // Table of extracted substreams.
-  std::vector<InputBitstream*> ppcSubstreams( numSubstreams );
+  std::vector<SubstreamState> substreams( numSubstreams );
   for( unsigned idx = 0; idx < numSubstreams; idx++ )
   {
-    ppcSubstreams[idx] = bitstream->extractSubstream( idx+1 < numSubstreams ? ( slice->getSubstreamSize(idx) << 3 ) : bitstream->getNumBitsLeft() );
+    substreams[idx].bitstream = bitstream->extractSubstream( idx+1 < numSubstreams ? ( slice->getSubstreamSize(idx) << 3 ) : bitstream->getNumBitsLeft() );
   }
 
 #if HEVC_DEPENDENT_SLICES
@@ -127,14 +161,10 @@ void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int deb
   const int       startCtuRsAddr          = tileMap.getCtuTsToRsAddrMap(startCtuTsAddr);
 #endif
   const unsigned  numCtusInFrame          = cs.pcv->sizeInCtus;
-  const unsigned  widthInCtus             = cs.pcv->widthInCtus;
 #if HEVC_DEPENDENT_SLICES
   const bool      depSliceSegmentsEnabled = cs.pps->getDependentSliceSegmentsEnabledFlag();
-#endif
   const bool      wavefrontsEnabled       = cs.pps->getEntropyCodingSyncEnabledFlag();
-
-  cabacReader.initBitstream( ppcSubstreams[0] );
-  cabacReader.initCtxModels( *slice );
+#endif
 
   // Quantization parameter
 #if HEVC_DEPENDENT_SLICES
@@ -157,6 +187,7 @@ void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int deb
   const unsigned  subStreamOffset         = tileMap.getSubstreamForCtuAddr(startCtuRsAddr, true, slice);
 #endif
 
+  bool restoreSliceSegmentCtx = false;
 #if HEVC_DEPENDENT_SLICES
   if( depSliceSegmentsEnabled )
   {
@@ -168,132 +199,313 @@ void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int deb
     {
       if( currentTile.getTileWidthInCtus() >= 2 || !wavefrontsEnabled )
       {
-        cabacReader.getCtx() = m_lastSliceSegmentEndContextState;
+        restoreSliceSegmentCtx = true;
       }
     }
   }
 #endif
-  // for every CTU in the slice segment...
-  bool isLastCtuOfSliceSegment = false;
-  for( unsigned ctuTsAddr = startCtuTsAddr; !isLastCtuOfSliceSegment && ctuTsAddr < numCtusInFrame; ctuTsAddr++ )
+
+  // locate the first CTU of each substream, the end of the last one is only known from the end_of_slice_segment_flag
+  for( auto &substream : substreams )
   {
-    const unsigned  ctuRsAddr             = tileMap.getCtuTsToRsAddrMap(ctuTsAddr);
-    const Tile&     currentTile           = tileMap.tiles[ tileMap.getTileIdxMap(ctuRsAddr) ];
-    const unsigned  firstCtuRsAddrOfTile  = currentTile.getFirstCtuRsAddr();
-    const unsigned  tileXPosInCtus        = firstCtuRsAddrOfTile % widthInCtus;
-    const unsigned  tileYPosInCtus        = firstCtuRsAddrOfTile / widthInCtus;
-    const unsigned  ctuXPosInCtus         = ctuRsAddr % widthInCtus;
-    const unsigned  ctuYPosInCtus         = ctuRsAddr / widthInCtus;
-    const unsigned  subStrmId             = tileMap.getSubstreamForCtuAddr( ctuRsAddr, true, slice ) - subStreamOffset;
-    const unsigned  maxCUSize             = sps->getMaxCUWidth();
-    Position pos( ctuXPosInCtus*maxCUSize, ctuYPosInCtus*maxCUSize) ;
-    UnitArea ctuArea(cs.area.chromaFormat, Area( pos.x, pos.y, maxCUSize, maxCUSize ) );
+    substream.startCtuTsAddr = numCtusInFrame;
+    substream.prevQP[0]      = pic->m_prevQP[0];
+    substream.prevQP[1]      = pic->m_prevQP[1];
+    substream.syncCtxStored  = false;
+    substream.progress.reset();
+  }
+  for( unsigned ctuTsAddr = startCtuTsAddr, subStrmId = 0; ctuTsAddr < numCtusInFrame && subStrmId < numSubstreams; ctuTsAddr++ )
+  {
+    const unsigned ctuRsAddr = tileMap.getCtuTsToRsAddrMap( ctuTsAddr );
+    if( tileMap.getSubstreamForCtuAddr( ctuRsAddr, true, slice ) - subStreamOffset == subStrmId )
+    {
+      substreams[subStrmId].startCtuTsAddr = ctuTsAddr;
+      substreams[subStrmId].progress.reset( int( ctuRsAddr % cs.pcv->widthInCtus ) - 1 );
+      subStrmId++;
+    }
+  }
 
-    DTRACE_UPDATE( g_trace_ctx, std::make_pair( "ctu", ctuRsAddr ) );
+  if( cs.slice->getSliceType() == B_SLICE )
+  {
+    resetGbiCodingOrder( true, cs );
+  }
 
-    cabacReader.initBitstream( ppcSubstreams[subStrmId] );
+  // substreams can be decoded in parallel, unless picture level state is modified during the parsing
+  const bool decodeParallel = m_threadPool && m_threadPool->getNumThreads() > 1 && numSubstreams > 1 && debugCTU < 0
+                           && !cs.pps->getPpsRangeExtension().getChromaQpOffsetListEnabledFlag() && !g_mctsDecCheckEnabled;
 
-    // set up CABAC contexts' state for this CTU
-    if( ctuRsAddr == firstCtuRsAddrOfTile )
+  bool isLastCtuOfSliceSegment = false;
+
+  if( decodeParallel )
+  {
+    std::vector<CSSubstreamCtx> csCtx( numSubstreams );
+    std::vector<char>           isLastCtu( numSubstreams, 0 );
+    JobCounter                  jobs;
+
+    cs.startParallelInsertion();
+
+    // jobs only wait on substreams preceding them, which is safe with the FIFO order of the pool
+    for( unsigned subStrmId = 0; subStrmId < numSubstreams; subStrmId++ )
     {
-      if( ctuTsAddr != startCtuTsAddr ) // if it is the first CTU, then the entropy coder has already been reset
+      m_threadPool->addJob( [&, subStrmId]()
       {
-        cabacReader.initCtxModels( *slice );
-      }
-      pic->m_prevQP[0] = pic->m_prevQP[1] = slice->getSliceQp();
+        const int stackId = xAcquireStack();
+        try
+        {
+          isLastCtu[subStrmId] = xDecompressSubstream( cs, stackId, substreams, &csCtx, subStrmId, subStreamOffset, startCtuTsAddr, restoreSliceSegmentCtx, debugCTU );
+        }
+        catch( ... )
+        {
+          xReleaseStack( stackId );
+          throw;
+        }
+        xReleaseStack( stackId );
+      }, jobs );
     }
-    else if( ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled )
+
+    try
     {
-      // Synchronize cabac probabilities with upper-right CTU if it's available and at the start of a line.
-      if( ctuTsAddr != startCtuTsAddr ) // if it is the first CTU, then the entropy coder has already been reset
-      {
-        cabacReader.initCtxModels( *slice );
-      }
-      if( cs.getCURestricted( pos.offset(maxCUSize, -1), slice->getIndependentSliceIdx(), tileMap.getTileIdxMap( pos ), CH_L ) )
-      {
-        // Top-right is available, so use it.
-        cabacReader.getCtx() = m_entropyCodingSyncContextState;
-      }
-      pic->m_prevQP[0] = pic->m_prevQP[1] = slice->getSliceQp();
+      m_threadPool->wait( jobs );
     }
-
-    bool updateGbiCodingOrder = cs.slice->getSliceType() == B_SLICE && ctuTsAddr == startCtuTsAddr;
-    if(updateGbiCodingOrder)
+    catch( ... )
     {
-      resetGbiCodingOrder(true, cs);
+      cs.finishParallelInsertion( csCtx );
+      throw;
     }
 
-    if ((cs.slice->getSliceType() != I_SLICE || cs.sps->getIBCFlag()) && ctuXPosInCtus == 0)
+    cs.finishParallelInsertion( csCtx );
+
+    isLastCtuOfSliceSegment = isLastCtu.back() != 0;
+  }
+  else
+  {
+    for( unsigned subStrmId = 0; subStrmId < numSubstreams && !isLastCtuOfSliceSegment; subStrmId++ )
     {
-      cs.motionLut.lut.resize(0);
-      cs.motionLut.lutIbc.resize(0);
-#if !JVET_N0266_SMALL_BLOCKS
-      cs.motionLut.lutShare.resize(0);
-#endif
-      cs.motionLut.lutShareIbc.resize(0);
+      isLastCtuOfSliceSegment = xDecompressSubstream( cs, 0, substreams, nullptr, subStrmId, subStreamOffset, startCtuTsAddr, restoreSliceSegmentCtx, debugCTU );
     }
+  }
+  CHECK( !isLastCtuOfSliceSegment, "Last CTU of slice segment not signalled as such" );
 
-    if( !cs.slice->isIntra() )
+  for( const auto &substream : substreams )
+  {
+    if( substream.syncCtxStored )
     {
-      pic->mctsInfo.init( &cs, getCtuAddr( ctuArea.lumaPos(), *( cs.pcv ) ) );
+      m_entropyCodingSyncContextState = substream.syncCtxState;
     }
+  }
+  pic->m_prevQP[0] = substreams.back().prevQP[0];
+  pic->m_prevQP[1] = substreams.back().prevQP[1];
+
+#if HEVC_DEPENDENT_SLICES
+  if( depSliceSegmentsEnabled )
+  {
+    m_lastSliceSegmentEndContextState = substreams.back().endCtxState;  //ctx end of dep.slice
+  }
+#endif
+  // deallocate all created substreams, including internal buffers.
+  for( auto &substream : substreams )
+  {
+    delete substream.bitstream;
+  }
+  slice->stopProcessingTimer();
+}
+
+bool DecSlice::xDecompressSubstream( CodingStructure& cs, const int stackId, std::vector<SubstreamState>& substreams, std::vector<CSSubstreamCtx>* csCtx,
+                                     const unsigned subStrmId, const unsigned subStreamOffset, const unsigned startCtuTsAddr, const bool restoreSliceSegmentCtx, const int debugCTU )
+{
+  Slice*          slice             = cs.slice;
+  Picture*        pic               = cs.picture;
+  const TileMap&  tileMap           = *pic->tileMap;
+  CABACReader&    cabacReader       = *m_CABACDecoder[stackId].getCABACReader( 0 );
+  DecCu&          cuDecoder         = m_pcCuDecoder[stackId];
+  SubstreamState& substream         = substreams[subStrmId];
+  const unsigned  numCtusInFrame    = cs.pcv->sizeInCtus;
+  const unsigned  widthInCtus       = cs.pcv->widthInCtus;
+  const unsigned  maxCUSize         = cs.sps->getMaxCUWidth();
+  const bool      wavefrontsEnabled = cs.pps->getEntropyCodingSyncEnabledFlag();
+  const bool      useMotionLut      = cs.slice->getSliceType() != I_SLICE || cs.sps->getIBCFlag();
+
+  const unsigned  firstCtuRsAddr    = tileMap.getCtuTsToRsAddrMap( substream.startCtuTsAddr );
+  const Tile&     firstTile         = tileMap.tiles[ tileMap.getTileIdxMap( firstCtuRsAddr ) ];
+  const unsigned  firstTileXPos     = firstTile.getFirstCtuRsAddr() % widthInCtus;
+  const int       tileRightXPos     = int( firstTileXPos + firstTile.getTileWidthInCtus() ) - 1;
+  // a WPP row has to stay behind the substream of the row above (also when the above row is within this slice segment)
+  const bool      followsRowAbove   = csCtx && wavefrontsEnabled && subStrmId > 0 && firstCtuRsAddr != firstTile.getFirstCtuRsAddr();
+  SubstreamState* rowAbove          = followsRowAbove ? &substreams[subStrmId - 1] : nullptr;
 
-    if( ctuRsAddr == debugCTU )
+  bool isLastCtuOfSliceSegment = false;
+
+  try
+  {
+    if( csCtx )
     {
-      isLastCtuOfSliceSegment = true; // get out here
-      break;
+      CSSubstreamCtx& ctx = ( *csCtx )[subStrmId];
+
+      // the history based motion candidates are only reset at the left picture boundary
+      if( subStrmId == 0 )
+      {
+        ctx.motionLut = cs.getMotionLut();
+      }
+      else if( useMotionLut && firstCtuRsAddr % widthInCtus != 0 )
+      {
+        substreams[subStrmId - 1].progress.wait( std::numeric_limits<int64_t>::max() );
+        ctx.motionLut = ( *csCtx )[subStrmId - 1].motionLut;
+      }
+
+      const Area ctuArea( 0, 0, cs.pcv->maxCUWidth, cs.pcv->maxCUHeight );
+      for( PelStorage* buf : { &m_ctuPredBufs[stackId], &m_ctuResiBufs[stackId] } )
+      {
+        if( buf->bufs.empty() || buf->chromaFormat != cs.area.chromaFormat || buf->Y().width != ctuArea.width || buf->Y().height != ctuArea.height )
+        {
+          buf->destroy();
+          buf->create( cs.area.chromaFormat, ctuArea );
+        }
+      }
+      ctx.predBuf = &m_ctuPredBufs[stackId];
+      ctx.resiBuf = &m_ctuResiBufs[stackId];
+
+      cs.bindSubstreamCtx( &ctx );
     }
-    isLastCtuOfSliceSegment = cabacReader.coding_tree_unit( cs, ctuArea, pic->m_prevQP, ctuRsAddr );
 
-    m_pcCuDecoder->decompressCtu( cs, ctuArea );
+    cabacReader.initBitstream( substream.bitstream );
 
-    if( ctuXPosInCtus == tileXPosInCtus+1 && wavefrontsEnabled )
+    if( subStrmId == 0 )
     {
-      m_entropyCodingSyncContextState = cabacReader.getCtx();
+      cabacReader.initCtxModels( *slice );
+#if HEVC_DEPENDENT_SLICES
+      if( restoreSliceSegmentCtx )
+      {
+        cabacReader.getCtx() = m_lastSliceSegmentEndContextState;
+      }
+#endif
     }
 
-
-    if( isLastCtuOfSliceSegment )
+    // for every CTU in the substream...
+    for( unsigned ctuTsAddr = substream.startCtuTsAddr; !isLastCtuOfSliceSegment && ctuTsAddr < numCtusInFrame; ctuTsAddr++ )
     {
+      const unsigned  ctuRsAddr             = tileMap.getCtuTsToRsAddrMap(ctuTsAddr);
+      if( tileMap.getSubstreamForCtuAddr( ctuRsAddr, true, slice ) - subStreamOffset != subStrmId )
+      {
+        break;
+      }
+      const Tile&     currentTile           = tileMap.tiles[ tileMap.getTileIdxMap(ctuRsAddr) ];
+      const unsigned  firstCtuRsAddrOfTile  = currentTile.getFirstCtuRsAddr();
+      const unsigned  tileXPosInCtus        = firstCtuRsAddrOfTile % widthInCtus;
+      const unsigned  tileYPosInCtus        = firstCtuRsAddrOfTile / widthInCtus;
+      const unsigned  ctuXPosInCtus         = ctuRsAddr % widthInCtus;
+      const unsigned  ctuYPosInCtus         = ctuRsAddr / widthInCtus;
+      Position pos( ctuXPosInCtus*maxCUSize, ctuYPosInCtus*maxCUSize) ;
+      UnitArea ctuArea(cs.area.chromaFormat, Area( pos.x, pos.y, maxCUSize, maxCUSize ) );
+
+      DTRACE_UPDATE( g_trace_ctx, std::make_pair( "ctu", ctuRsAddr ) );
+
+      if( rowAbove )
+      {
+        // the above-right CTU has to be available
+        rowAbove->progress.wait( std::min<int>( ctuXPosInCtus + 1, tileRightXPos ) );
+      }
+
+      // set up CABAC contexts' state for this CTU
+      if( ctuRsAddr == firstCtuRsAddrOfTile )
+      {
+        if( ctuTsAddr != startCtuTsAddr ) // if it is the first CTU, then the entropy coder has already been reset
+        {
+          cabacReader.initCtxModels( *slice );
+        }
+        substream.prevQP[0] = substream.prevQP[1] = slice->getSliceQp();
+      }
+      else if( ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled )
+      {
+        // Synchronize cabac probabilities with upper-right CTU if it's available and at the start of a line.
+        if( ctuTsAddr != startCtuTsAddr ) // if it is the first CTU, then the entropy coder has already been reset
+        {
+          cabacReader.initCtxModels( *slice );
+        }
+        if( cs.getCURestricted( pos.offset(maxCUSize, -1), slice->getIndependentSliceIdx(), tileMap.getTileIdxMap( pos ), CH_L ) )
+        {
+          // Top-right is available, so use it.
+          const bool aboveInSegment = subStrmId > 0 && substreams[subStrmId - 1].syncCtxStored;
+          cabacReader.getCtx() = aboveInSegment ? substreams[subStrmId - 1].syncCtxState : m_entropyCodingSyncContextState;
+        }
+        substream.prevQP[0] = substream.prevQP[1] = slice->getSliceQp();
+      }
+
+      if ((cs.slice->getSliceType() != I_SLICE || cs.sps->getIBCFlag()) && ctuXPosInCtus == 0)
+      {
+        cs.getMotionLut().lut.resize(0);
+        cs.getMotionLut().lutIbc.resize(0);
+#if !JVET_N0266_SMALL_BLOCKS
+        cs.getMotionLut().lutShare.resize(0);
+#endif
+        cs.getMotionLut().lutShareIbc.resize(0);
+      }
+
+      if( !cs.slice->isIntra() && !csCtx )
+      {
+        pic->mctsInfo.init( &cs, getCtuAddr( ctuArea.lumaPos(), *( cs.pcv ) ) );
+      }
+
+      if( ctuRsAddr == debugCTU )
+      {
+        isLastCtuOfSliceSegment = true; // get out here
+        break;
+      }
+      isLastCtuOfSliceSegment = cabacReader.coding_tree_unit( cs, ctuArea, substream.prevQP, ctuRsAddr );
+
+      cuDecoder.decompressCtu( cs, ctuArea );
+
+      if( ctuXPosInCtus == tileXPosInCtus+1 && wavefrontsEnabled )
+      {
+        substream.syncCtxState  = cabacReader.getCtx();
+        substream.syncCtxStored = true;
+      }
+
+
+      if( isLastCtuOfSliceSegment )
+      {
 #if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
-      cabacReader.remaining_bytes( false );
+        cabacReader.remaining_bytes( false );
 #endif
 #if HEVC_DEPENDENT_SLICES
-      if( !slice->getDependentSliceSegmentFlag() )
-      {
+        if( !slice->getDependentSliceSegmentFlag() )
+        {
 #endif
-        slice->setSliceCurEndCtuTsAddr( ctuTsAddr+1 );
+          slice->setSliceCurEndCtuTsAddr( ctuTsAddr+1 );
 #if HEVC_DEPENDENT_SLICES
-      }
-      slice->setSliceSegmentCurEndCtuTsAddr( ctuTsAddr+1 );
+        }
+        slice->setSliceSegmentCurEndCtuTsAddr( ctuTsAddr+1 );
 #endif
-    }
-    else if( ( ctuXPosInCtus + 1 == tileXPosInCtus + currentTile.getTileWidthInCtus () ) &&
-             ( ctuYPosInCtus + 1 == tileYPosInCtus + currentTile.getTileHeightInCtus() || wavefrontsEnabled ) )
-    {
-      // The sub-stream/stream should be terminated after this CTU.
-      // (end of slice-segment, end of tile, end of wavefront-CTU-row)
-      unsigned binVal = cabacReader.terminating_bit();
-      CHECK( !binVal, "Expecting a terminating bit" );
+      }
+      else if( ( ctuXPosInCtus + 1 == tileXPosInCtus + currentTile.getTileWidthInCtus () ) &&
+               ( ctuYPosInCtus + 1 == tileYPosInCtus + currentTile.getTileHeightInCtus() || wavefrontsEnabled ) )
+      {
+        // The sub-stream/stream should be terminated after this CTU.
+        // (end of slice-segment, end of tile, end of wavefront-CTU-row)
+        unsigned binVal = cabacReader.terminating_bit();
+        CHECK( !binVal, "Expecting a terminating bit" );
 #if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
-      cabacReader.remaining_bytes( true );
+        cabacReader.remaining_bytes( true );
 #endif
+      }
+
+      substream.progress.set( ctuXPosInCtus );
     }
-  }
-  CHECK( !isLastCtuOfSliceSegment, "Last CTU of slice segment not signalled as such" );
+    CHECK( isLastCtuOfSliceSegment && subStrmId + 1 < substreams.size() && debugCTU < 0, "Slice segment ends before its last substream" );
 
-#if HEVC_DEPENDENT_SLICES
-  if( depSliceSegmentsEnabled )
-  {
-    m_lastSliceSegmentEndContextState = cabacReader.getCtx();  //ctx end of dep.slice
+    substream.endCtxState = cabacReader.getCtx();
   }
-#endif
-  // deallocate all created substreams, including internal buffers.
-  for( auto substr: ppcSubstreams )
+  catch( ... )
   {
-    delete substr;
+    // never leave the substreams depending on this one waiting
+    substream.progress.set( std::numeric_limits<int64_t>::max() );
+    cs.bindSubstreamCtx( nullptr );
+    throw;
   }
-  slice->stopProcessingTimer();
+
+  substream.progress.set( std::numeric_limits<int64_t>::max() );
+  cs.bindSubstreamCtx( nullptr );
+
+  return isLastCtuOfSliceSegment;
 }
 
 //! \}
@@ -44,9 +44,13 @@
 
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/BitStream.h"
+#include "CommonLib/ThreadPool.h"
 #include "DecCu.h"
 #include "CABACReader.h"
 
+#include <mutex>
+#include <vector>
+
 //! \ingroup DecoderLib
 //! \{
 
@@ -58,9 +62,27 @@
 class DecSlice
 {
 private:
-  // access channel
+  /// decoding state of one substream (tile or WPP CTU row) of the current slice segment
+  struct SubstreamState
+  {
+    InputBitstream* bitstream;
+    unsigned        startCtuTsAddr;
+    int             prevQP[MAX_NUM_CHANNEL_TYPE];
+    SyncValue       progress;                           ///< x position of the last decoded CTU, maximum once the substream is done
+    bool            syncCtxStored;
+    Ctx             syncCtxState;                       ///< context state after the second CTU of the row (WPP)
+    Ctx             endCtxState;
+  };
+
+  // access channel, one entry per CTU decoding stack
   CABACDecoder*   m_CABACDecoder;
   DecCu*          m_pcCuDecoder;
+  int             m_numDecStacks;
+  ThreadPool*     m_threadPool;
+  std::vector<int> m_freeStacks;
+  std::mutex      m_stackMutex;
+  PelStorage*     m_ctuPredBufs;                        ///< per stack, the picture level prediction and residual buffers only cover one CTU
+  PelStorage*     m_ctuResiBufs;
 
 #if HEVC_DEPENDENT_SLICES
   Ctx             m_lastSliceSegmentEndContextState;    ///< context storage for state at the end of the previous slice-segment (used for dependent slices only).
@@ -71,11 +93,17 @@ public:
   DecSlice();
   virtual ~DecSlice();
 
-  void  init              ( CABACDecoder* cabacDecoder, DecCu* pcMbDecoder );
+  void  init              ( CABACDecoder* cabacDecoder, DecCu* pcMbDecoder, int numDecStacks = 1, ThreadPool* threadPool = nullptr );
   void  create            ();
   void  destroy           ();
 
   void  decompressSlice   ( Slice* slice, InputBitstream* bitstream, int debugCTU );
+
+private:
+  bool  xDecompressSubstream( CodingStructure& cs, const int stackId, std::vector<SubstreamState>& substreams, std::vector<CSSubstreamCtx>* csCtx,
+                              const unsigned subStrmId, const unsigned subStreamOffset, const unsigned startCtuTsAddr, const bool restoreSliceSegmentCtx, const int debugCTU );
+  int   xAcquireStack     ();
+  void  xReleaseStack     ( const int stackId );
 };
 
 //! \}
@@ -39,6 +39,7 @@
 
 #include <vector>
 #include <algorithm>
+#include <string.h>
 #include <ostream>
 
 #include "NALread.h"
@@ -46,6 +47,7 @@
 #include "CommonLib/NAL.h"
 #include "CommonLib/BitStream.h"
 #include "CommonLib/Rom.h"
+#include "CommonLib/SSE2Baseline.h"
 #include "CommonLib/dtrace_next.h"
 
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
@@ -59,12 +61,29 @@ using namespace std;
 static void convertPayloadToRBSP(vector<uint8_t>& nalUnitBuf, InputBitstream *bitstream, bool isVclNalUnit)
 {
   uint32_t zeroCount = 0;
-  vector<uint8_t>::iterator it_read, it_write;
+  const uint8_t* const itEnd = nalUnitBuf.data() + nalUnitBuf.size();
+  const uint8_t* it_read  = nalUnitBuf.data();
+  uint8_t*       it_write = nalUnitBuf.data();
 
   uint32_t pos = 0;
   bitstream->clearEmulationPreventionByteLocation();
-  for (it_read = it_write = nalUnitBuf.begin(); it_read != nalUnitBuf.end(); it_read++, it_write++, pos++)
+  while (it_read != itEnd)
   {
+#if ENABLE_SSE2_BASELINE
+    if (zeroCount == 0 && itEnd - it_read > 16 && !hasZeroBytePair(it_read))
+    {
+      // no emulation prevention byte within the next 16 bytes, nothing to check
+      if (it_write != it_read)
+      {
+        memmove(it_write, it_read, 16);
+      }
+      zeroCount = (it_read[15] == 0x00) ? 1 : 0;
+      it_read  += 16;
+      it_write += 16;
+      pos      += 16;
+      continue;
+    }
+#endif
     CHECK(zeroCount >= 2 && *it_read < 0x03, "Zero count is '2' and read value is small than '3'");
     if (zeroCount == 2 && *it_read == 0x03)
     {
@@ -75,14 +94,15 @@ static void convertPayloadToRBSP(vector<uint8_t>& nalUnitBuf, InputBitstream *bi
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
       CodingStatistics::IncrementStatisticEP(STATS__EMULATION_PREVENTION_3_BYTES, 8, 0);
 #endif
-      if (it_read == nalUnitBuf.end())
+      if (it_read == itEnd)
       {
         break;
       }
       CHECK(*it_read > 0x03, "Read a value bigger than '3'");
     }
     zeroCount = (*it_read == 0x00) ? zeroCount+1 : 0;
-    *it_write = *it_read;
+    *it_write++ = *it_read++;
+    pos++;
   }
   CHECK(zeroCount != 0, "Zero count not '0'");
 
@@ -103,7 +123,7 @@ static void convertPayloadToRBSP(vector<uint8_t>& nalUnitBuf, InputBitstream *bi
     }
   }
 
-  nalUnitBuf.resize(it_write - nalUnitBuf.begin());
+  nalUnitBuf.resize(it_write - nalUnitBuf.data());
 }
 
 #if ENABLE_TRACING
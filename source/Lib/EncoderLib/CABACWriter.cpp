@@ -1493,11 +1493,6 @@ void CABACWriter::end_of_ctu( const CodingUnit& cu, CUCtx& cuCtx )
 
 void CABACWriter::prediction_unit( const PredictionUnit& pu )
 {
-#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
-  CHECK( pu.cacheUsed, "Processing a PU that should be in cache!" );
-  CHECK( pu.cu->cacheUsed, "Processing a CU that should be in cache!" );
-
-#endif
   if( pu.cu->skip )
   {
     CHECK( !pu.mergeFlag, "merge_flag must be true for skipped CUs" );
@@ -3439,7 +3434,7 @@ void CABACWriter::codeAlfCtuEnableFlags( CodingStructure& cs, ComponentID compID
 void CABACWriter::codeAlfCtuEnableFlag( CodingStructure& cs, uint32_t ctuRsAddr, const int compIdx, AlfSliceParam* alfParam)
 {
 #if JVET_N0415_CTB_ALF
-  static AlfSliceParam alfSliceParam;
+  thread_local AlfSliceParam alfSliceParam;
   if (alfParam)
   {
     alfSliceParam = *alfParam;
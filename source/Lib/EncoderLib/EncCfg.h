@@ -584,6 +584,8 @@ protected:
   bool        m_stopAfterFFtoPOC;                             ///<
   int         m_debugCTU;                                     ///< dbg ctu
   bool        m_bs2ModPOCAndType;
+  int         m_numThreads;                                   ///< threads of the in-loop filter stage
+  bool        m_modeProfile;                                  ///< measure the time of the CU test modes
 
 
 
@@ -1504,6 +1506,10 @@ public:
   bool         getBs2ModPOCAndType()                           const { return m_bs2ModPOCAndType; }
   void         setDebugCTU( int i )                                  { m_debugCTU = i; }
   int          getDebugCTU()                                   const { return m_debugCTU; }
+  void         setNumThreads( int n )                                { m_numThreads = n; }
+  int          getNumThreads()                                 const { return m_numThreads; }
+  void         setModeProfile( bool b )                              { m_modeProfile = b; }
+  bool         getModeProfile()                                const { return m_modeProfile; }
 
 #if ENABLE_SPLIT_PARALLELISM
   void         setNumSplitThreads( int n )                           { m_numSplitThreads = n; }
@@ -50,12 +50,9 @@
 #include "CommonLib/dtrace_buffer.h"
 
 #include <stdio.h>
+#include <chrono>
 #include <cmath>
 #include <algorithm>
-#if ENABLE_WPP_PARALLELISM
-#include <mutex>
-extern std::recursive_mutex g_cache_mutex;
-#endif
 
 
 
@@ -94,6 +91,7 @@ void EncCu::create( EncCfg* encCfg )
 
   unsigned      numWidths     = gp_sizeIdxInfo->numWidths();
   unsigned      numHeights    = gp_sizeIdxInfo->numHeights();
+  m_modeProfileNested = 0.0;
   m_pTempCS = new CodingStructure**  [numWidths];
   m_pBestCS = new CodingStructure**  [numWidths];
 
@@ -109,8 +107,8 @@ void EncCu::create( EncCfg* encCfg )
 
       if( gp_sizeIdxInfo->isCuSize( width ) && gp_sizeIdxInfo->isCuSize( height ) )
       {
-        m_pTempCS[w][h] = new CodingStructure( m_unitCache.cuCache, m_unitCache.puCache, m_unitCache.tuCache );
-        m_pBestCS[w][h] = new CodingStructure( m_unitCache.cuCache, m_unitCache.puCache, m_unitCache.tuCache );
+        m_pTempCS[w][h] = new CodingStructure();
+        m_pBestCS[w][h] = new CodingStructure();
 
         m_pTempCS[w][h]->create( chromaFormat, Area( 0, 0, width, height ), false );
         m_pBestCS[w][h]->create( chromaFormat, Area( 0, 0, width, height ), false );
@@ -632,7 +630,7 @@ void EncCu::xCompressCU( CodingStructure *&tempCS, CodingStructure *&bestCS, Par
     {
       for (int jId = 1; jId < NUM_RESERVERD_SPLIT_JOBS; jId++)
       {
-        auto slsSbt = dynamic_cast<SaveLoadEncInfoSbt *>(m_pcEncLib->getCuEncoder(jId)->m_modeCtrl);
+        auto slsSbt = dynamic_cast<SaveLoadEncInfoSbt *>(m_pcEncLib->getCuEncoder(tempCS->picture->scheduler.getSplitDataId(jId))->m_modeCtrl);
         slsSbt->resetSaveloadSbt(maxSLSize);
       }
     }
@@ -707,6 +705,17 @@ void EncCu::xCompressCU( CodingStructure *&tempCS, CodingStructure *&bestCS, Par
     }
 #endif
 
+    const bool profileMode = m_pcEncCfg->getModeProfile();
+    std::chrono::steady_clock::time_point profileStart;
+    double profileNested = 0.0;
+    if( profileMode )
+    {
+      // the nested time collects the mode tests of the sub-CUs, which are accounted to their own modes
+      profileNested       = m_modeProfileNested;
+      m_modeProfileNested = 0.0;
+      profileStart        = std::chrono::steady_clock::now();
+    }
+
     if( currTestMode.type == ETM_INTER_ME )
     {
       if( ( currTestMode.opts & ETO_IMV ) != 0 )
@@ -773,6 +782,13 @@ void EncCu::xCompressCU( CodingStructure *&tempCS, CodingStructure *&bestCS, Par
     {
       THROW( "Don't know how to handle mode: type = " << currTestMode.type << ", options = " << currTestMode.opts );
     }
+
+    if( profileMode )
+    {
+      const double seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - profileStart ).count();
+      m_modeProfile.add( currTestMode.type, tempCS->area.lwidth(), tempCS->area.lheight(), currTestMode.qp, slice.getTLayer(), seconds, seconds - m_modeProfileNested );
+      m_modeProfileNested = profileNested + seconds;
+    }
   } while( m_modeCtrl->nextMode( *tempCS, partitioner ) );
 
   if(startShareThisLevel == 1)
@@ -813,7 +829,7 @@ void EncCu::xCompressCU( CodingStructure *&tempCS, CodingStructure *&bestCS, Par
     {
       MotionInfo mi = pu.getMotionInfo();
       mi.GBiIdx = (mi.interDir == 3) ? cu.GBiIdx : GBI_DEFAULT;
-      cu.cs->addMiToLut(CU::isIBC(cu) ? cu.cs->motionLut.lutIbc : cu.cs->motionLut.lut, mi);
+      cu.cs->addMiToLut(CU::isIBC(cu) ? cu.cs->getMotionLut().lutIbc : cu.cs->getMotionLut().lut, mi);
     }
   }
   bestCS->picture->getPredBuf(currCsArea).copyFrom(bestCS->getPredBuf(currCsArea));
@@ -939,28 +955,19 @@ void EncCu::xCompressCUParallel( CodingStructure *&tempCS, CodingStructure *&bes
 
   int numJobs = m_modeCtrl->getNumParallelJobs( *bestCS, partitioner );
 
-  bool    jobUsed                            [NUM_RESERVERD_SPLIT_JOBS];
-  std::fill( jobUsed, jobUsed + NUM_RESERVERD_SPLIT_JOBS, false );
-
   const UnitArea currArea = CS::getArea( *tempCS, partitioner.currArea(), partitioner.chType );
 #if ENABLE_WPP_PARALLELISM
   const int      wppTId   = picture->scheduler.getWppThreadId();
 #endif
-  const bool doParallel   = !m_pcEncCfg->getForceSingleSplitThread();
-#if _MSC_VER && ENABLE_WPP_PARALLELISM
-#pragma omp parallel for schedule(dynamic,1) num_threads(NUM_SPLIT_THREADS_IF_MSVC) if(doParallel)
-#else
-  omp_set_num_threads( m_pcEncCfg->getNumSplitThreads() );
 
-#pragma omp parallel for schedule(dynamic,1) if(doParallel)
-#endif
-  for( int jId = 1; jId <= numJobs; jId++ )
+  // a job only works on the data instance of its ID, so the jobs can run on any thread in any order and the decision
+  // does not depend on the number of threads
+  auto compressJob = [&]( const int jId )
   {
-    // thread start
 #if ENABLE_WPP_PARALLELISM
+    const int prevWppTId = picture->scheduler.getWppThreadId();
     picture->scheduler.setWppThreadId( wppTId );
 #endif
-    picture->scheduler.setSplitThreadId();
     picture->scheduler.setSplitJobId( jId );
 
     Partitioner* jobPartitioner = PartitionerFactory::get( *tempCS->slice );
@@ -970,39 +977,93 @@ void EncCu::xCompressCUParallel( CodingStructure *&tempCS, CodingStructure *&bes
     auto*        jobBestCache   = dynamic_cast<BestEncInfoCache*>( jobCuEnc->m_modeCtrl );
 #endif
 
-    jobPartitioner->copyState( partitioner );
-    jobCuEnc      ->copyState( this, *jobPartitioner, currArea, true );
+    try
+    {
+      jobPartitioner->copyState( partitioner );
+      jobCuEnc      ->copyState( this, *jobPartitioner, currArea, true );
 
-    if( jobBlkCache  ) { jobBlkCache ->tick(); }
+      if( jobBlkCache  ) { jobBlkCache ->tick(); }
 #if REUSE_CU_RESULTS
-    if( jobBestCache ) { jobBestCache->tick(); }
+      if( jobBestCache ) { jobBestCache->tick(); }
 
 #endif
-    CodingStructure *&jobBest = jobCuEnc->m_pBestCS[wIdx][hIdx];
-    CodingStructure *&jobTemp = jobCuEnc->m_pTempCS[wIdx][hIdx];
-
-    jobUsed[jId] = true;
+      CodingStructure *&jobBest = jobCuEnc->m_pBestCS[wIdx][hIdx];
+      CodingStructure *&jobTemp = jobCuEnc->m_pTempCS[wIdx][hIdx];
 
-    jobCuEnc->xCompressCU( jobTemp, jobBest, *jobPartitioner );
+      jobCuEnc->m_modeProfileNested = 0.0;
+      jobCuEnc->xCompressCU( jobTemp, jobBest, *jobPartitioner );
+    }
+    catch( ... )
+    {
+      // the thread is reused by other jobs, the error is reported by the pool
+      delete jobPartitioner;
+      picture->scheduler.setSplitJobId( 0 );
+#if ENABLE_WPP_PARALLELISM
+      picture->scheduler.setWppThreadId( prevWppTId );
+#endif
+      throw;
+    }
 
     delete jobPartitioner;
 
     picture->scheduler.setSplitJobId( 0 );
-    // thread stop
+#if ENABLE_WPP_PARALLELISM
+    picture->scheduler.setWppThreadId( prevWppTId );
+#endif
+  };
+
+  const bool profileMode = m_pcEncCfg->getModeProfile();
+  std::chrono::steady_clock::time_point profileStart;
+  if( profileMode )
+  {
+    profileStart = std::chrono::steady_clock::now();
+  }
+
+  if( m_pcEncCfg->getForceSingleSplitThread() )
+  {
+    for( int jId = 1; jId <= numJobs; jId++ )
+    {
+      compressJob( jId );
+    }
+  }
+  else
+  {
+    // idle threads of the pool, e.g. the ones at the end of a WPP row, pick up the jobs, the calling thread only
+    // processes jobs of this split while waiting
+    ThreadPool* threadPool = m_pcEncLib->getThreadPool();
+    JobCounter  jobs;
+
+    for( int jId = 1; jId <= numJobs; jId++ )
+    {
+      threadPool->addJob( [&compressJob, jId]() { compressJob( jId ); }, jobs );
+    }
+
+    threadPool->waitNested( jobs );
   }
-  picture->scheduler.setSplitThreadId( 0 );
 
-  int    bestJId  = 0;
-  double bestCost = bestCS->cost;
+  int    bestJId    = 0;
+  double bestCost   = bestCS->cost;
+  double jobSeconds = 0.0;
   for( int jId = 1; jId <= numJobs; jId++ )
   {
     EncCu* jobCuEnc = m_pcEncLib->getCuEncoder( picture->scheduler.getSplitDataId( jId ) );
 
-    if( jobUsed[jId] && jobCuEnc->m_pBestCS[wIdx][hIdx]->cost < bestCost )
+    if( jobCuEnc->m_pBestCS[wIdx][hIdx]->cost < bestCost )
     {
       bestCost = jobCuEnc->m_pBestCS[wIdx][hIdx]->cost;
       bestJId  = jId;
     }
+
+    jobSeconds += jobCuEnc->m_modeProfileNested;
+  }
+
+  if( profileMode )
+  {
+    // the mode tests of the jobs are accounted in the profiles of the job encoders, so they are nested time of the
+    // parent split mode; jobs running on other threads can sum up to more than the elapsed time of this call, which
+    // is the most the parent spent in them
+    const double seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - profileStart ).count();
+    m_modeProfileNested += std::min( jobSeconds, seconds );
   }
 
   if( bestJId > 0 )
@@ -1025,7 +1086,7 @@ void EncCu::xCompressCUParallel( CodingStructure *&tempCS, CodingStructure *&bes
   {
     for( int jId = 1; jId <= numJobs; jId++ )
     {
-      if( !jobUsed[jId] || jId == bestJId ) continue;
+      if( jId == bestJId ) continue;
 
       auto *jobBlkCache = dynamic_cast<CacheBlkInfoCtrl*>( m_pcEncLib->getCuEncoder( picture->scheduler.getSplitDataId( jId ) )->m_modeCtrl );
       CHECK( !jobBlkCache, "If own mode controller has blk info cache capability so should all other mode controllers!" );
@@ -1040,7 +1101,7 @@ void EncCu::xCompressCUParallel( CodingStructure *&tempCS, CodingStructure *&bes
   {
     for( int jId = 1; jId <= numJobs; jId++ )
     {
-      if( !jobUsed[jId] || jId == bestJId ) continue;
+      if( jId == bestJId ) continue;
 
       auto *jobBlkCache = dynamic_cast<BestEncInfoCache*>( m_pcEncLib->getCuEncoder( picture->scheduler.getSplitDataId( jId ) )->m_modeCtrl );
       CHECK( !jobBlkCache, "If own mode controller has blk info cache capability so should all other mode controllers!" );
@@ -1110,7 +1171,7 @@ void EncCu::xCheckModeSplit(CodingStructure *&tempCS, CodingStructure *&bestCS,
   const Slice &slice          = *tempCS->slice;
   const bool bIsLosslessMode  = false; // False at this level. Next level down may set it to true.
   const int oldPrevQp         = tempCS->prevQP[partitioner.chType];
-  const auto oldMotionLut     = tempCS->motionLut;
+  const auto oldMotionLut     = tempCS->getMotionLut();
 #if ENABLE_QPA_SUB_CTU
   const PPS &pps              = *tempCS->pps;
   const uint32_t currDepth    = partitioner.currDepth;
@@ -1186,9 +1247,9 @@ void EncCu::xCheckModeSplit(CodingStructure *&tempCS, CodingStructure *&bestCS,
 #endif
   {
 #if !JVET_N0266_SMALL_BLOCKS
-    tempCS->motionLut.lutShare = tempCS->motionLut.lut;
+    tempCS->getMotionLut().lutShare = tempCS->getMotionLut().lut;
 #endif
-    tempCS->motionLut.lutShareIbc = tempCS->motionLut.lutIbc;
+    tempCS->getMotionLut().lutShareIbc = tempCS->getMotionLut().lutIbc;
     m_shareBndPosX = uiLPelX;
     m_shareBndPosY = uiTPelY;
     m_shareBndSizeW = tempCS->area.lwidth();
@@ -1358,7 +1419,7 @@ void EncCu::xCheckModeSplit(CodingStructure *&tempCS, CodingStructure *&bestCS,
   if (isAffMVInfoSaved)
     m_pcInterSearch->addAffMVInfo(tmpMVInfo);
 
-  tempCS->motionLut = oldMotionLut;
+  tempCS->getMotionLut() = oldMotionLut;
 
   tempCS->releaseIntermediateData();
 
@@ -100,8 +100,6 @@ private:
   //  Data : encoder control
   int                   m_cuChromaQpOffsetIdxPlus1; // if 0, then cu_chroma_qp_offset_flag will be 0, otherwise cu_chroma_qp_offset_flag will be 1.
 
-  XUCache               m_unitCache;
-
   CodingStructure    ***m_pTempCS;
   CodingStructure    ***m_pBestCS;
   //  Access channel
@@ -147,6 +145,9 @@ private:
 #endif
   double                m_sbtCostSave[2];
 
+  EncModeProfile        m_modeProfile;                ///< time of the test modes, collected with EncCfg::getModeProfile()
+  double                m_modeProfileNested;          ///< time of the mode tests nested in the current one
+
 public:
   /// copy parameters from encoder class
   void  init                ( EncLib* pcEncLib, const SPS& sps PARL_PARAM( const int jId = 0 ) );
@@ -163,6 +164,7 @@ public:
   int   updateCtuDataISlice ( const CPelBuf buf );
 
   EncModeCtrl* getModeCtrl  () { return m_modeCtrl; }
+  const EncModeProfile& getModeProfile() const { return m_modeProfile; }
 
 
   void   setMergeBestSATDCost(double cost) { m_mergeBestSATDCost = cost; }
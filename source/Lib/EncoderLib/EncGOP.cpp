@@ -60,6 +60,8 @@
 
 #define ENCODE_SUB_SET 0
 
+#define DISTORTION_BAND_HEIGHT 64   ///< number of lines per job of the PSNR computation
+
 using namespace std;
 
 //! \ingroup EncoderLib
@@ -168,7 +170,7 @@ void EncGOP::init ( EncLib* pcEncLib )
   m_pcSliceEncoder       = pcEncLib->getSliceEncoder();
   m_pcListPic            = pcEncLib->getListPic();
   m_HLSWriter            = pcEncLib->getHLSWriter();
-  m_pcLoopFilter         = pcEncLib->getLoopFilter();
+  m_pcInLoopFilter       = pcEncLib->getInLoopFilter();
   m_pcSAO                = pcEncLib->getSAO();
   m_pcALF = pcEncLib->getALF();
   m_pcRateCtrl           = pcEncLib->getRateCtrl();
@@ -2399,7 +2401,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
   #endif
       }
 
-      m_pcLoopFilter->loopFilterPic( cs );
+      m_pcInLoopFilter->deblockPicture( cs );
 
       CS::setRefinedMotionField(cs);
       DTRACE_UPDATE( g_trace_ctx, ( std::make_pair( "final", 1 ) ) );
@@ -2701,13 +2703,11 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
       auto elapsed = std::chrono::steady_clock::now() - beforeTime;
       auto encTime = std::chrono::duration_cast<std::chrono::seconds>( elapsed ).count();
 
-      std::string digestStr;
+      // the planes are hashed on the thread pool while the PSNR is computed
+      PictureHashJobs hashJobs;
       if (m_pcCfg->getDecodedPictureHashSEIType()!=HASHTYPE_NONE)
       {
-        SEIDecodedPictureHash *decodedPictureHashSei = new SEIDecodedPictureHash();
-        PelUnitBuf recoBuf = pcPic->cs->getRecoBuf();
-        m_seiEncoder.initDecodedPictureHashSEI(decodedPictureHashSei, recoBuf, digestStr, pcSlice->getSPS()->getBitDepths());
-        trailingSeiMessages.push_back(decodedPictureHashSei);
+        hashJobs.start(pcPic->cs->getRecoBuf(), m_pcCfg->getDecodedPictureHashSEIType(), pcSlice->getSPS()->getBitDepths(), m_pcEncLib->getThreadPool());
       }
 
       m_pcCfg->setEncodedFlag(iGOPid, true);
@@ -2717,6 +2717,14 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
                        , isEncodeLtRef
       );
 
+      std::string digestStr;
+      if (m_pcCfg->getDecodedPictureHashSEIType()!=HASHTYPE_NONE)
+      {
+        SEIDecodedPictureHash *decodedPictureHashSei = new SEIDecodedPictureHash();
+        m_seiEncoder.initDecodedPictureHashSEI(decodedPictureHashSei, hashJobs, digestStr);
+        trailingSeiMessages.push_back(decodedPictureHashSei);
+      }
+
       // Only produce the Green Metadata SEI message with the last picture.
       if( m_pcCfg->getSEIGreenMetadataInfoSEIEnable() && pcSlice->getPOC() == ( m_pcCfg->getFramesToBeEncoded() - 1 )  )
       {
@@ -2902,7 +2910,7 @@ void EncGOP::printOutSummary(uint32_t uiNumAllPicCoded, bool isField, const bool
 uint64_t EncGOP::preLoopFilterPicAndCalcDist( Picture* pcPic )
 {
   CodingStructure& cs = *pcPic->cs;
-  m_pcLoopFilter->loopFilterPic( cs );
+  m_pcInLoopFilter->deblockPicture( cs );
 
   const CPelUnitBuf picOrg = pcPic->getRecoBuf();
   const CPelUnitBuf picRec = cs.getRecoBuf();
@@ -3059,7 +3067,6 @@ uint64_t EncGOP::xFindDistortionPlane(const CPelBuf& pic0, const CPelBuf& pic1,
 #endif
                                       )
 {
-  uint64_t uiTotalDiff;
   const  Pel*  pSrc0 = pic0.bufAt(0, 0);
   const  Pel*  pSrc1 = pic1.bufAt(0, 0);
 
@@ -3081,18 +3088,7 @@ uint64_t EncGOP::xFindDistortionPlane(const CPelBuf& pic0, const CPelBuf& pic1,
 
       if (B < 4) // image is too small to use WPSNR, resort to traditional PSNR
       {
-        uiTotalDiff = 0;
-        for (y = 0; y < H; y++)
-        {
-          for (x = 0; x < W; x++)
-          {
-            const           int64_t iDiff = (int64_t)pSrc0[x] - (int64_t)pSrc1[x];
-            uiTotalDiff += uint64_t(iDiff * iDiff);
-          }
-          pSrc0 += pic0.stride;
-          pSrc1 += pic1.stride;
-        }
-        return uiTotalDiff;
+        return g_pelBufOP.calcSSE(pSrc0, pic0.stride, pSrc1, pic1.stride, W, H, 0);
       }
 
       double wmse = 0.0, sumAct = 0.0; // compute activity normalized SNR value
@@ -3115,34 +3111,38 @@ uint64_t EncGOP::xFindDistortionPlane(const CPelBuf& pic0, const CPelBuf& pic1,
       return (wmse <= 0.0) ? 0 : uint64_t(wmse * pow(sumAct, BETA) + 0.5);
     }
 #endif // ENABLE_QPA
-    uiTotalDiff = 0;
-    for (int y = 0; y < pic0.height; y++)
-    {
-      for (int x = 0; x < pic0.width; x++)
-      {
-        Intermediate_Int iTemp = pSrc0[x] - pSrc1[x];
-        uiTotalDiff += uint64_t((iTemp * iTemp) >> rshift);
-      }
-      pSrc0 += pic0.stride;
-      pSrc1 += pic1.stride;
-    }
   }
-  else
+
+  return g_pelBufOP.calcSSE(pSrc0, pic0.stride, pSrc1, pic1.stride, pic0.width, pic0.height, rshift);
+}
+
+void EncGOP::xAddDistortionPlaneJobs( const CPelBuf& pic0, const CPelBuf& pic1, const uint32_t rshift, const uint32_t chromaShift, std::vector<uint64_t>& bandDist, JobCounter& jobs )
+{
+  // the SSE of bands of lines is summed up in band order, the QPA weighting needs the whole plane
+#if ENABLE_QPA
+  const int bandHeight = rshift >= 8 ? std::max<int>( pic0.height, 1 ) : DISTORTION_BAND_HEIGHT;
+#else
+  const int bandHeight = DISTORTION_BAND_HEIGHT;
+#endif
+  const int numBands   = std::max<int>( ( pic0.height + bandHeight - 1 ) / bandHeight, 1 );
+
+  bandDist.assign( numBands, 0 );
+
+  for( int band = 0; band < numBands; band++ )
   {
-    uiTotalDiff = 0;
-    for (int y = 0; y < pic0.height; y++)
+    const int     bandY = band * bandHeight;
+    const CPelBuf band0( pic0.bufAt( 0, bandY ), pic0.stride, pic0.width, std::min<int>( bandHeight, pic0.height - bandY ) );
+    const CPelBuf band1( pic1.bufAt( 0, bandY ), pic1.stride, pic1.width, std::min<int>( bandHeight, pic1.height - bandY ) );
+
+    m_pcEncLib->getThreadPool()->addJob( [this, band0, band1, rshift, chromaShift, band, &bandDist]()
     {
-      for (int x = 0; x < pic0.width; x++)
-      {
-        Intermediate_Int iTemp = pSrc0[x] - pSrc1[x];
-        uiTotalDiff += uint64_t(iTemp * iTemp);
-      }
-      pSrc0 += pic0.stride;
-      pSrc1 += pic1.stride;
-    }
+#if ENABLE_QPA
+      bandDist[band] = xFindDistortionPlane( band0, band1, rshift, chromaShift );
+#else
+      bandDist[band] = xFindDistortionPlane( band0, band1, rshift );
+#endif
+    }, jobs );
   }
-
-  return uiTotalDiff;
 }
 #if WCG_WPSNR
 double EncGOP::xFindDistortionPlaneWPSNR(const CPelBuf& pic0, const CPelBuf& pic1, const uint32_t rshift, const CPelBuf& picLuma0,
@@ -3318,6 +3318,13 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
   const bool bPicIsField     = pcPic->fieldPic;
   const Slice*  pcSlice      = pcPic->slices[0];
 
+  // the distortions of all components are computed as jobs on the thread pool
+  JobCounter            distJobs;
+  std::vector<uint64_t> bandDist[MAX_NUM_COMPONENT];
+#if WCG_WPSNR
+  double                distWeighted[MAX_NUM_COMPONENT] = { 0, 0, 0 };
+#endif
+
   for (int comp = 0; comp < ::getNumberValidComponents(formatD); comp++)
   {
     const ComponentID compID = ComponentID(comp);
@@ -3333,19 +3340,47 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
     // create new buffers with correct dimensions
     const CPelBuf recPB(p.bufAt(0, 0), p.stride, width, height);
     const CPelBuf orgPB(o.bufAt(0, 0), o.stride, width, height);
-    const uint32_t    bitDepth = sps.getBitDepth(toChannelType(compID));
+#if WCG_WPSNR
+    if (useLumaWPSNR)
+    {
+      const CPelBuf orgLuma = org.get(COMPONENT_Y);
+      m_pcEncLib->getThreadPool()->addJob( [this, recPB, orgPB, orgLuma, compID, format, &distWeighted]()
+      {
+        distWeighted[compID] = xFindDistortionPlaneWPSNR(recPB, orgPB, 0, orgLuma, compID, format);
+      }, distJobs );
+    }
+#endif
 #if ENABLE_QPA
-    const uint64_t uiSSDtemp = xFindDistortionPlane(recPB, orgPB, useWPSNR ? bitDepth : 0, ::getComponentScaleX(compID, format));
+    const uint32_t    bitDepth = sps.getBitDepth(toChannelType(compID));
+    xAddDistortionPlaneJobs(recPB, orgPB, useWPSNR ? bitDepth : 0, ::getComponentScaleX(compID, format), bandDist[comp], distJobs);
 #else
-    const uint64_t uiSSDtemp = xFindDistortionPlane(recPB, orgPB, 0);
+    xAddDistortionPlaneJobs(recPB, orgPB, 0, 0, bandDist[comp], distJobs);
 #endif
+  }
+
+  m_pcEncLib->getThreadPool()->wait( distJobs );
+
+  for (int comp = 0; comp < ::getNumberValidComponents(formatD); comp++)
+  {
+    const ComponentID compID = ComponentID(comp);
+    const CPelBuf&    p = picC.get(compID);
+
+    const uint32_t   width  = p.width  - (m_pcEncLib->getPad(0) >> ::getComponentScaleX(compID, format));
+    const uint32_t   height = p.height - (m_pcEncLib->getPad(1) >> (!!bPicIsField+::getComponentScaleY(compID,format)));
+    const uint32_t    bitDepth = sps.getBitDepth(toChannelType(compID));
+
+    uint64_t uiSSDtemp = 0;
+    for (const auto& dist : bandDist[comp])
+    {
+      uiSSDtemp += dist;
+    }
     const uint32_t maxval = 255 << (bitDepth - 8);
     const uint32_t size   = width * height;
     const double fRefValue = (double)maxval * maxval * size;
     dPSNR[comp]       = uiSSDtemp ? 10.0 * log10(fRefValue / (double)uiSSDtemp) : 999.99;
     MSEyuvframe[comp] = (double)uiSSDtemp / size;
 #if WCG_WPSNR
-    const double uiSSDtempWeighted = xFindDistortionPlaneWPSNR(recPB, orgPB, 0, org.get(COMPONENT_Y), compID, format);
+    const double uiSSDtempWeighted = distWeighted[comp];
     if (useLumaWPSNR)
     {
       dPSNRWeighted[comp] = uiSSDtempWeighted ? 10.0 * log10(fRefValue / (double)uiSSDtempWeighted) : 999.99;
@@ -3540,12 +3575,34 @@ void EncGOP::xCalculateInterlacedAddPSNR( Picture* pcPicOrgFirstField, Picture*
   CHECK(!(acPicRecFields[0].chromaFormat==acPicRecFields[1].chromaFormat), "Unspecified error");
   const uint32_t numValidComponents = ::getNumberValidComponents( acPicRecFields[0].chromaFormat );
 
+  // the distortions of all fields and components are computed as jobs on the thread pool
+  JobCounter            distJobs;
+  std::vector<uint64_t> bandDist[2][MAX_NUM_COMPONENT];
+
   for (int chan = 0; chan < numValidComponents; chan++)
   {
     const ComponentID ch=ComponentID(chan);
     CHECK(!(acPicRecFields[0].get(ch).width==acPicRecFields[1].get(ch).width), "Unspecified error");
     CHECK(!(acPicRecFields[0].get(ch).height==acPicRecFields[0].get(ch).height), "Unspecified error");
 
+    for(uint32_t fieldNum=0; fieldNum<2; fieldNum++)
+    {
+      CHECK(!(conversion == IPCOLOURSPACE_UNCHANGED), "Unspecified error");
+#if ENABLE_QPA
+      const uint32_t bitDepth = sps.getBitDepth(toChannelType(ch));
+      xAddDistortionPlaneJobs( acPicRecFields[fieldNum].get(ch), apcPicOrgFields[fieldNum]->getOrigBuf().get(ch), useWPSNR ? bitDepth : 0, ::getComponentScaleX(ch, format), bandDist[fieldNum][chan], distJobs );
+#else
+      xAddDistortionPlaneJobs( acPicRecFields[fieldNum].get(ch), apcPicOrgFields[fieldNum]->getOrigBuf().get(ch), 0, 0, bandDist[fieldNum][chan], distJobs );
+#endif
+    }
+  }
+
+  m_pcEncLib->getThreadPool()->wait( distJobs );
+
+  for (int chan = 0; chan < numValidComponents; chan++)
+  {
+    const ComponentID ch=ComponentID(chan);
+
     uint64_t uiSSDtemp=0;
     const uint32_t width    = acPicRecFields[0].get(ch).width - (m_pcEncLib->getPad(0) >> ::getComponentScaleX(ch, format));
     const uint32_t height   = acPicRecFields[0].get(ch).height - ((m_pcEncLib->getPad(1) >> 1) >> ::getComponentScaleY(ch, format));
@@ -3553,12 +3610,10 @@ void EncGOP::xCalculateInterlacedAddPSNR( Picture* pcPicOrgFirstField, Picture*
 
     for(uint32_t fieldNum=0; fieldNum<2; fieldNum++)
     {
-      CHECK(!(conversion == IPCOLOURSPACE_UNCHANGED), "Unspecified error");
-#if ENABLE_QPA
-      uiSSDtemp += xFindDistortionPlane( acPicRecFields[fieldNum].get(ch), apcPicOrgFields[fieldNum]->getOrigBuf().get(ch), useWPSNR ? bitDepth : 0, ::getComponentScaleX(ch, format) );
-#else
-      uiSSDtemp += xFindDistortionPlane( acPicRecFields[fieldNum].get(ch), apcPicOrgFields[fieldNum]->getOrigBuf().get(ch), 0 );
-#endif
+      for (const auto& dist : bandDist[fieldNum][chan])
+      {
+        uiSSDtemp += dist;
+      }
     }
     const uint32_t maxval = 255 << (bitDepth - 8);
     const uint32_t size   = width * height * 2;
@@ -43,7 +43,7 @@
 #include <stdlib.h>
 
 #include "CommonLib/Picture.h"
-#include "CommonLib/LoopFilter.h"
+#include "CommonLib/InLoopFilterStage.h"
 #include "CommonLib/NAL.h"
 #include "EncSampleAdaptiveOffset.h"
 #include "EncAdaptiveLoopFilter.h"
@@ -126,7 +126,7 @@ private:
   PicList*                m_pcListPic;
 
   HLSWriter*              m_HLSWriter;
-  LoopFilter*             m_pcLoopFilter;
+  InLoopFilterStage*      m_pcInLoopFilter;
 
   SEIWriter               m_seiWriter;
 
@@ -247,6 +247,7 @@ protected:
                             , const uint32_t chromaShift = 0
 #endif
                              );
+  void     xAddDistortionPlaneJobs( const CPelBuf& pic0, const CPelBuf& pic1, const uint32_t rshift, const uint32_t chromaShift, std::vector<uint64_t>& bandDist, JobCounter& jobs );
 #if WCG_WPSNR
   double xFindDistortionPlaneWPSNR(const CPelBuf& pic0, const CPelBuf& pic1, const uint32_t rshift, const CPelBuf& picLuma0, ComponentID compID, const ChromaFormat chfmt );
 #endif
@@ -44,9 +44,6 @@
 #include "CommonLib/Picture.h"
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/ChromaFormat.h"
-#if ENABLE_SPLIT_PARALLELISM
-#include <omp.h>
-#endif
 
 //! \ingroup EncoderLib
 //! \{
@@ -137,6 +134,16 @@ void EncLib::create ()
   {
     m_cLoopFilter.initEncPicYuvBuffer( m_chromaFormatIDC, getSourceWidth(), getSourceHeight() );
   }
+  int numCodingThreads = 1;
+#if ENABLE_WPP_PARALLELISM
+  numCodingThreads  = m_numWppThreads + m_numWppExtraLines;
+#endif
+#if ENABLE_SPLIT_PARALLELISM
+  // every CTU row in flight can run its split jobs next to the rows waiting on it
+  numCodingThreads *= m_forceSingleSplitThread ? 1 : m_numSplitThreads;
+#endif
+  m_threadPool.create( std::max( m_numThreads, numCodingThreads ) );
+  m_cInLoopFilter.init( &m_cEncSAO, &m_cEncALF, &m_threadPool );
   if( m_alf )
   {
 #if JVET_N0242_NON_LINEAR_ALF
@@ -188,6 +195,8 @@ void EncLib::destroy ()
   m_cEncSAO.            destroyEncData();
   m_cEncSAO.            destroy();
   m_cLoopFilter.        destroy();
+  m_threadPool.         destroy();
+  m_cInLoopFilter.      destroy();
   m_cRateCtrl.          destroy();
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   for (int jId = 0; jId < m_numCuEncStacks; jId++)
@@ -242,14 +251,6 @@ void EncLib::init( bool isFieldCoding, AUWriterIf* auWriterIf )
   xInitVPS(m_cVPS, sps0);
 #endif
 
-#if ENABLE_SPLIT_PARALLELISM
-  if( omp_get_dynamic() )
-  {
-    omp_set_dynamic( false );
-  }
-  omp_set_nested( true );
-#endif
-
   if (getUseCompositeRef())
   {
     sps0.setLongTermRefsPresent(true);
@@ -520,6 +521,25 @@ void EncLib::xInitPPSforLT(PPS& pps)
 // Public member functions
 // ====================================================================================================================
 
+void EncLib::printModeProfile( const std::string& csvFileName )
+{
+  EncModeProfile profile;
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
+  for( int jId = 0; jId < m_numCuEncStacks; jId++ )
+  {
+    profile.merge( m_cCuEncoder[jId].getModeProfile() );
+  }
+#else
+  profile.merge( m_cCuEncoder.getModeProfile() );
+#endif
+
+  profile.print();
+  if( !csvFileName.empty() && !profile.writeCsv( csvFileName ) )
+  {
+    msg( WARNING, "Failed to write the mode profile to %s\n", csvFileName.c_str() );
+  }
+}
+
 void EncLib::deletePicBuffer()
 {
   PicList::iterator iterPic = m_cListPic.begin();
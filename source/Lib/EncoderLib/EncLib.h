@@ -41,6 +41,8 @@
 // Include files
 #include "CommonLib/TrQuant.h"
 #include "CommonLib/LoopFilter.h"
+#include "CommonLib/InLoopFilterStage.h"
+#include "CommonLib/ThreadPool.h"
 #include "CommonLib/NAL.h"
 
 #include "Utilities/VideoIOYuv.h"
@@ -90,6 +92,8 @@ private:
   TrQuant                   m_cTrQuant;                           ///< transform & quantization class
 #endif
   LoopFilter                m_cLoopFilter;                        ///< deblocking filter class
+  InLoopFilterStage         m_cInLoopFilter;                      ///< deblocking of the CTU rows of a picture in parallel
+  ThreadPool                m_threadPool;                         ///< workers of the in-loop filter stage and the CTU row parallel encoding
   EncSampleAdaptiveOffset   m_cEncSAO;                            ///< sample adaptive offset class
   EncAdaptiveLoopFilter     m_cEncALF;
   HLSWriter                 m_HLSWriter;                          ///< CAVLC encoder
@@ -192,6 +196,7 @@ public:
   TrQuant*                getTrQuant            ()              { return  &m_cTrQuant;             }
 #endif
   LoopFilter*             getLoopFilter         ()              { return  &m_cLoopFilter;          }
+  InLoopFilterStage*      getInLoopFilter       ()              { return  &m_cInLoopFilter;        }
   EncSampleAdaptiveOffset* getSAO               ()              { return  &m_cEncSAO;              }
   EncAdaptiveLoopFilter*  getALF                ()              { return  &m_cEncALF;              }
   EncGOP*                 getGOPEncoder         ()              { return  &m_cGOPEncoder;          }
@@ -214,6 +219,7 @@ public:
   CtxCache*               getCtxCache           ()              { return  &m_CtxCache;             }
 #endif
   RateCtrl*               getRateCtrl           ()              { return  &m_cRateCtrl;            }
+  ThreadPool*             getThreadPool         ()              { return  &m_threadPool;           }
 
 
   void selectReferencePictureSet(Slice* slice, int POCCurr, int GOPid
@@ -264,6 +270,7 @@ public:
 
 
   void printSummary(bool isField) { m_cGOPEncoder.printOutSummary (m_uiNumAllPicCoded, isField, m_printMSEBasedSequencePSNR, m_printSequenceMSE, m_printHexPsnr, m_spsMap.getFirstPS()->getBitDepths()); }
+  void printModeProfile( const std::string& csvFileName ); ///< prints the time of the CU test modes of all CU encoders, and writes it to a CSV file if a name is given
 
 };
 
@@ -48,6 +48,93 @@
 #include "CommonLib/dtrace_next.h"
 
 #include <cmath>
+#include <fstream>
+
+const char* getEncTestModeName( const EncTestModeType type )
+{
+  switch( type )
+  {
+  case ETM_HASH_INTER     : return "HASH_INTER";
+  case ETM_MERGE_SKIP     : return "MERGE_SKIP";
+  case ETM_INTER_ME       : return "INTER_ME";
+  case ETM_AFFINE         : return "AFFINE";
+  case ETM_MERGE_TRIANGLE : return "MERGE_TRIANGLE";
+  case ETM_INTRA          : return "INTRA";
+  case ETM_IPCM           : return "IPCM";
+  case ETM_SPLIT_QT       : return "SPLIT_QT";
+  case ETM_SPLIT_BT_H     : return "SPLIT_BT_H";
+  case ETM_SPLIT_BT_V     : return "SPLIT_BT_V";
+  case ETM_SPLIT_TT_H     : return "SPLIT_TT_H";
+  case ETM_SPLIT_TT_V     : return "SPLIT_TT_V";
+  case ETM_POST_DONT_SPLIT: return "POST_DONT_SPLIT";
+#if REUSE_CU_RESULTS
+  case ETM_RECO_CACHED    : return "RECO_CACHED";
+#endif
+  case ETM_TRIGGER_IMV_LIST: return "TRIGGER_IMV_LIST";
+  case ETM_IBC            : return "IBC";
+  case ETM_IBC_MERGE      : return "IBC_MERGE";
+  default:                  return "INVALID";
+  }
+}
+
+void EncModeProfile::merge( const EncModeProfile& other )
+{
+  for( const auto& it : other.m_entries )
+  {
+    Entry& entry = m_entries[it.first];
+    entry.count       += it.second.count;
+    entry.seconds     += it.second.seconds;
+    entry.selfSeconds += it.second.selfSeconds;
+  }
+}
+
+void EncModeProfile::print() const
+{
+  std::map<int, Entry> modes;
+  double totalSelfSeconds = 0.0;
+
+  for( const auto& it : m_entries )
+  {
+    Entry& mode = modes[int( it.first >> 48 )];
+    mode.count       += it.second.count;
+    mode.seconds     += it.second.seconds;
+    mode.selfSeconds += it.second.selfSeconds;
+    totalSelfSeconds += it.second.selfSeconds;
+  }
+
+  msg( INFO, "\nMode profile (split modes include the search of their sub-CUs in the total time)\n" );
+  msg( INFO, "%-18s %12s %12s %12s %8s %12s\n", "Mode", "Tests", "Total [s]", "Self [s]", "Self [%]", "Avg [us]" );
+  for( const auto& it : modes )
+  {
+    const Entry& mode = it.second;
+    msg( INFO, "%-18s %12llu %12.3f %12.3f %8.2f %12.2f\n", getEncTestModeName( EncTestModeType( it.first ) ), ( unsigned long long ) mode.count,
+         mode.seconds, mode.selfSeconds, totalSelfSeconds > 0.0 ? 100.0 * mode.selfSeconds / totalSelfSeconds : 0.0, 1e6 * mode.selfSeconds / mode.count );
+  }
+  msg( INFO, "%-18s %12s %12s %12.3f\n", "Sum", "", "", totalSelfSeconds );
+}
+
+bool EncModeProfile::writeCsv( const std::string& fileName ) const
+{
+  std::ofstream file( fileName.c_str() );
+  if( !file )
+  {
+    return false;
+  }
+
+  file << "mode,width,height,qp,temporal_layer,tests,total_seconds,self_seconds\n";
+  for( const auto& it : m_entries )
+  {
+    file << getEncTestModeName( EncTestModeType( it.first >> 48 ) ) << ","
+         << ( ( it.first >> 32 ) & 0xffff ) << ","
+         << ( ( it.first >> 16 ) & 0xffff ) << ","
+         << int( ( it.first >> 8 ) & 0xff ) - 128 << ","
+         << ( it.first & 0xff ) << ","
+         << it.second.count << ","
+         << it.second.seconds << ","
+         << it.second.selfSeconds << "\n";
+  }
+  return bool( file );
+}
 
 void EncModeCtrl::init( EncCfg *pCfg, RateCtrl *pRateCtrl, RdCost* pRdCost )
 {
@@ -713,6 +800,9 @@ void BestEncInfoCache::create( const ChromaFormat chFmt )
 
               m_bestEncInfo[x][y][wIdx][hIdx]->poc      = -1;
               m_bestEncInfo[x][y][wIdx][hIdx]->testMode = EncTestMode();
+#if ENABLE_SPLIT_PARALLELISM
+              m_bestEncInfo[x][y][wIdx][hIdx]->temporalId = 0;
+#endif
             }
             else
             {
@@ -1020,14 +1110,27 @@ void BestEncInfoCache::copyState(const BestEncInfoCache &other, const UnitArea &
             {
               if( other.m_bestEncInfo[x][y][wIdx][hIdx]->temporalId > m_bestEncInfo[x][y][wIdx][hIdx]->temporalId )
               {
-                m_bestEncInfo[x][y][wIdx][hIdx]->cu       = other.m_bestEncInfo[x][y][wIdx][hIdx]->cu;
-                m_bestEncInfo[x][y][wIdx][hIdx]->pu       = other.m_bestEncInfo[x][y][wIdx][hIdx]->pu;
-                m_bestEncInfo[x][y][wIdx][hIdx]->numTus   = other.m_bestEncInfo[x][y][wIdx][hIdx]->numTus;
-                m_bestEncInfo[x][y][wIdx][hIdx]->poc      = other.m_bestEncInfo[x][y][wIdx][hIdx]->poc;
-                m_bestEncInfo[x][y][wIdx][hIdx]->testMode = other.m_bestEncInfo[x][y][wIdx][hIdx]->testMode;
-
-                for( int i = 0; i < m_bestEncInfo[x][y][wIdx][hIdx]->numTus; i++ )
-                  m_bestEncInfo[x][y][wIdx][hIdx]->tus[i] = other.m_bestEncInfo[x][y][wIdx][hIdx]->tus[i];
+                      BestEncodingInfo& encInfo   = *      m_bestEncInfo[x][y][wIdx][hIdx];
+                const BestEncodingInfo& otherInfo = *other.m_bestEncInfo[x][y][wIdx][hIdx];
+
+                // the unit assignments copy only the data, the areas have to be taken over explicitly as in setFromCs
+                encInfo.cu.repositionTo( otherInfo.cu );
+                encInfo.pu.repositionTo( otherInfo.pu );
+                encInfo.cu       = otherInfo.cu;
+                encInfo.pu       = otherInfo.pu;
+                encInfo.numTus   = otherInfo.numTus;
+                encInfo.poc      = otherInfo.poc;
+                encInfo.testMode = otherInfo.testMode;
+
+                for( int i = 0; i < encInfo.numTus; i++ )
+                {
+                  encInfo.tus[i].repositionTo( otherInfo.tus[i] );
+                  encInfo.tus[i].resizeTo    ( otherInfo.tus[i] );
+                  for( auto &blk : otherInfo.tus[i].blocks )
+                  {
+                    if( blk.valid() ) encInfo.tus[i].copyComponentFrom( otherInfo.tus[i], blk.compID );
+                  }
+                }
               }
             }
             else if( y + ( height >> MIN_CU_LOG2 ) > maxPosY + 1 )
@@ -2086,7 +2189,8 @@ bool EncModeCtrlMTnoRQT::isParallelSplit( const CodingStructure &cs, Partitioner
   if( cs.pps->getUseDQP() && partitioner.currQgEnable() ) return false;
   const int numJobs = getNumParallelJobs( cs, partitioner );
   const int numPxl  = partitioner.currArea().Y().area();
-  const int parlAt  = m_pcEncCfg->getNumSplitThreads() <= 3 ? 1024 : 256;
+  // fixed granularity, the split decisions must not depend on the number of threads
+  const int parlAt  = 1024;
   if(  cs.slice->isIntra() && numJobs > 2 && ( numPxl == parlAt || !partitioner.canSplit( CU_QUAD_SPLIT, cs ) ) ) return true;
   if( !cs.slice->isIntra() && numJobs > 1 && ( numPxl == parlAt || !partitioner.canSplit( CU_QUAD_SPLIT, cs ) ) ) return true;
   return false; 
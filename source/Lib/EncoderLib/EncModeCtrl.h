@@ -44,6 +44,8 @@
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/CodingStructure.h"
 
+#include <map>
+#include <string>
 #include <typeinfo>
 #include <vector>
 
@@ -162,6 +164,47 @@ inline EncTestMode getCSEncMode( const CodingStructure& cs )
                       false);
 }
 
+const char* getEncTestModeName( const EncTestModeType type );
+
+
+//////////////////////////////////////////////////////////////////////////
+// EncModeProfile accumulates the encoder time spent in the test modes
+//////////////////////////////////////////////////////////////////////////
+
+class EncModeProfile
+{
+public:
+  struct Entry
+  {
+    Entry() : count( 0 ), seconds( 0.0 ), selfSeconds( 0.0 ) {}
+
+    uint64_t count;
+    double   seconds;                                   ///< time of the mode tests, split modes include the search of their sub-CUs
+    double   selfSeconds;                               ///< time of the mode tests without the mode tests nested in them
+  };
+
+  void add( const EncTestModeType type, const int width, const int height, const int qp, const int temporalLayer, const double seconds, const double selfSeconds )
+  {
+    Entry& entry = m_entries[xKey( type, width, height, qp, temporalLayer )];
+    entry.count++;
+    entry.seconds     += seconds;
+    entry.selfSeconds += selfSeconds;
+  }
+
+  void merge    ( const EncModeProfile& other );
+  void print    () const;                               ///< prints the time per mode type
+  bool writeCsv ( const std::string& fileName ) const;  ///< writes the time per mode type, CU size, QP and temporal layer
+
+private:
+  // the key orders the entries by mode type, width, height, QP and temporal layer
+  static uint64_t xKey( const EncTestModeType type, const int width, const int height, const int qp, const int temporalLayer )
+  {
+    return ( uint64_t( type ) << 48 ) | ( uint64_t( width ) << 32 ) | ( uint64_t( height ) << 16 ) | ( uint64_t( qp + 128 ) << 8 ) | uint64_t( temporalLayer );
+  }
+
+  std::map<uint64_t, Entry> m_entries;
+};
+
 
 
 //////////////////////////////////////////////////////////////////////////
@@ -471,7 +514,6 @@ private:
   TCoeff             *m_pCoeff;
   Pel                *m_pPcmBuf;
   CodingStructure     m_dummyCS;
-  XUCache             m_dummyCache;
 #if ENABLE_SPLIT_PARALLELISM
   int64_t m_currTemporalId;
 #endif
@@ -489,7 +531,7 @@ protected:
 #endif
 public:
 
-  BestEncInfoCache() : m_slice_bencinf( nullptr ), m_dummyCS( m_dummyCache.cuCache, m_dummyCache.puCache, m_dummyCache.tuCache ) {}
+  BestEncInfoCache() : m_slice_bencinf( nullptr ) {}
   virtual ~BestEncInfoCache() {}
 
 #if ENABLE_SPLIT_PARALLELISM
@@ -286,13 +286,6 @@ void EncSampleAdaptiveOffset::getStatistics(std::vector<SAOStatData**>& blkStats
   const PreCalcValues& pcv = *cs.pcv;
   const int numberOfComponents = getNumberValidComponents(pcv.chrFormat);
 
-  size_t lineBufferSize = pcv.maxCUWidth + 1;
-  if (m_signLineBuf1.size() != lineBufferSize)
-  {
-    m_signLineBuf1.resize(lineBufferSize);
-    m_signLineBuf2.resize(lineBufferSize);
-  }
-
   int ctuRsAddr = 0;
   for( uint32_t yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight )
   {
@@ -1137,13 +1130,21 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
                         , bool isCalculatePreDeblockSamples
                         )
 {
-  int x,y, startX, startY, endX, endY, edgeType, firstLineStartX, firstLineEndX;
-  int8_t signLeft, signRight, signDown;
+  int x,y, startX, startY, endX, endY, firstLineStartX, firstLineEndX;
   int64_t *diff, *count;
   Pel *srcLine, *orgLine;
   int* skipLinesR = m_skipLinesR[compIdx];
   int* skipLinesB = m_skipLinesB[compIdx];
 
+  // statistics of the samples [x0, x1) of the lines [y0, y1), the neighbours of a sample are at -neighbour and +neighbour
+  auto statsEO = [&]( const int x0, const int x1, const int y0, const int y1, const int neighbour )
+  {
+    if( x1 > x0 && y1 > y0 )
+    {
+      m_calcStatsEO( srcBlk + y0 * srcStride + x0, orgBlk + y0 * orgStride + x0, srcStride, orgStride, x1 - x0, y1 - y0, neighbour, diff, count );
+    }
+  };
+
   for(int typeIdx=0; typeIdx< NUM_SAO_NEW_TYPES; typeIdx++)
   {
     SAOStatData& statsData= statsDataTypes[typeIdx];
@@ -1157,8 +1158,6 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
     {
     case SAO_TYPE_EO_0:
       {
-        diff +=2;
-        count+=2;
         endY   = (isBelowAvail) ? (height - skipLinesB[typeIdx]) : height;
         startX = (!isCalculatePreDeblockSamples) ? (isLeftAvail  ? 0 : 1)
                                                  : (isRightAvail ? (width - skipLinesR[typeIdx]) : (width - 1))
@@ -1166,53 +1165,21 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
         endX   = (!isCalculatePreDeblockSamples) ? (isRightAvail ? (width - skipLinesR[typeIdx]) : (width - 1))
                                                  : (isRightAvail ? width : (width - 1))
                                                  ;
-        for (y=0; y<endY; y++)
-        {
-          signLeft = (int8_t)sgn(srcLine[startX] - srcLine[startX-1]);
-          for (x=startX; x<endX; x++)
-          {
-            signRight =  (int8_t)sgn(srcLine[x] - srcLine[x+1]);
-            edgeType  =  signRight + signLeft;
-            signLeft  = -signRight;
+        statsEO( startX, endX, 0, endY, 1 );
 
-            diff [edgeType] += (orgLine[x] - srcLine[x]);
-            count[edgeType] ++;
-          }
-          srcLine  += srcStride;
-          orgLine  += orgStride;
-        }
         if(isCalculatePreDeblockSamples)
         {
           if(isBelowAvail)
           {
             startX = isLeftAvail  ? 0 : 1;
             endX   = isRightAvail ? width : (width -1);
-
-            for(y=0; y<skipLinesB[typeIdx]; y++)
-            {
-              signLeft = (int8_t)sgn(srcLine[startX] - srcLine[startX-1]);
-              for (x=startX; x<endX; x++)
-              {
-                signRight =  (int8_t)sgn(srcLine[x] - srcLine[x+1]);
-                edgeType  =  signRight + signLeft;
-                signLeft  = -signRight;
-
-                diff [edgeType] += (orgLine[x] - srcLine[x]);
-                count[edgeType] ++;
-              }
-              srcLine  += srcStride;
-              orgLine  += orgStride;
-            }
+            statsEO( startX, endX, endY, endY + skipLinesB[typeIdx], 1 );
           }
         }
       }
       break;
     case SAO_TYPE_EO_90:
       {
-        diff +=2;
-        count+=2;
-        int8_t *signUpLine = &m_signLineBuf1[0];
-
         startX = (!isCalculatePreDeblockSamples) ? 0
                                                  : (isRightAvail ? (width - skipLinesR[typeIdx]) : width)
                                                  ;
@@ -1221,70 +1188,19 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
                                                  : width
                                                  ;
         endY   = isBelowAvail ? (height - skipLinesB[typeIdx]) : (height - 1);
-        if (!isAboveAvail)
-        {
-          srcLine += srcStride;
-          orgLine += orgStride;
-        }
+        statsEO( startX, endX, startY, endY, srcStride );
 
-        Pel* srcLineAbove = srcLine - srcStride;
-        for (x=startX; x<endX; x++)
-        {
-          signUpLine[x] = (int8_t)sgn(srcLine[x] - srcLineAbove[x]);
-        }
-
-        Pel* srcLineBelow;
-        for (y=startY; y<endY; y++)
-        {
-          srcLineBelow = srcLine + srcStride;
-
-          for (x=startX; x<endX; x++)
-          {
-            signDown  = (int8_t)sgn(srcLine[x] - srcLineBelow[x]);
-            edgeType  = signDown + signUpLine[x];
-            signUpLine[x]= -signDown;
-
-            diff [edgeType] += (orgLine[x] - srcLine[x]);
-            count[edgeType] ++;
-          }
-          srcLine += srcStride;
-          orgLine += orgStride;
-        }
         if(isCalculatePreDeblockSamples)
         {
           if(isBelowAvail)
           {
-            startX = 0;
-            endX   = width;
-
-            for(y=0; y<skipLinesB[typeIdx]; y++)
-            {
-              srcLineBelow = srcLine + srcStride;
-              srcLineAbove = srcLine - srcStride;
-
-              for (x=startX; x<endX; x++)
-              {
-                edgeType = sgn(srcLine[x] - srcLineBelow[x]) + sgn(srcLine[x] - srcLineAbove[x]);
-                diff [edgeType] += (orgLine[x] - srcLine[x]);
-                count[edgeType] ++;
-              }
-              srcLine  += srcStride;
-              orgLine  += orgStride;
-            }
+            statsEO( 0, width, endY, endY + skipLinesB[typeIdx], srcStride );
           }
         }
-
       }
       break;
     case SAO_TYPE_EO_135:
       {
-        diff +=2;
-        count+=2;
-        int8_t *signUpLine, *signDownLine, *signTmpLine;
-
-        signUpLine  = &m_signLineBuf1[0];
-        signDownLine= &m_signLineBuf2[0];
-
         startX = (!isCalculatePreDeblockSamples) ? (isLeftAvail  ? 0 : 1)
                                                  : (isRightAvail ? (width - skipLinesR[typeIdx]) : (width - 1))
                                                  ;
@@ -1294,81 +1210,27 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
                                                  ;
         endY   = isBelowAvail ? (height - skipLinesB[typeIdx]) : (height - 1);
 
-        //prepare 2nd line's upper sign
-        Pel* srcLineBelow = srcLine + srcStride;
-        for (x=startX; x<endX+1; x++)
-        {
-          signUpLine[x] = (int8_t)sgn(srcLineBelow[x] - srcLine[x-1]);
-        }
-
         //1st line
-        Pel* srcLineAbove = srcLine - srcStride;
         firstLineStartX = (!isCalculatePreDeblockSamples) ? (isAboveLeftAvail ? 0    : 1) : startX;
         firstLineEndX   = (!isCalculatePreDeblockSamples) ? (isAboveAvail     ? endX : 1) : endX;
-        for(x=firstLineStartX; x<firstLineEndX; x++)
-        {
-          edgeType = sgn(srcLine[x] - srcLineAbove[x-1]) - signUpLine[x+1];
-          diff [edgeType] += (orgLine[x] - srcLine[x]);
-          count[edgeType] ++;
-        }
-        srcLine  += srcStride;
-        orgLine  += orgStride;
-
+        statsEO( firstLineStartX, firstLineEndX, 0, 1, srcStride + 1 );
 
         //middle lines
-        for (y=1; y<endY; y++)
-        {
-          srcLineBelow = srcLine + srcStride;
-
-          for (x=startX; x<endX; x++)
-          {
-            signDown = (int8_t)sgn(srcLine[x] - srcLineBelow[x+1]);
-            edgeType = signDown + signUpLine[x];
-            diff [edgeType] += (orgLine[x] - srcLine[x]);
-            count[edgeType] ++;
-
-            signDownLine[x+1] = -signDown;
-          }
-          signDownLine[startX] = (int8_t)sgn(srcLineBelow[startX] - srcLine[startX-1]);
+        statsEO( startX, endX, 1, endY, srcStride + 1 );
 
-          signTmpLine  = signUpLine;
-          signUpLine   = signDownLine;
-          signDownLine = signTmpLine;
-
-          srcLine += srcStride;
-          orgLine += orgStride;
-        }
         if(isCalculatePreDeblockSamples)
         {
           if(isBelowAvail)
           {
             startX = isLeftAvail  ? 0     : 1 ;
             endX   = isRightAvail ? width : (width -1);
-
-            for(y=0; y<skipLinesB[typeIdx]; y++)
-            {
-              srcLineBelow = srcLine + srcStride;
-              srcLineAbove = srcLine - srcStride;
-
-              for (x=startX; x< endX; x++)
-              {
-                edgeType = sgn(srcLine[x] - srcLineBelow[x+1]) + sgn(srcLine[x] - srcLineAbove[x-1]);
-                diff [edgeType] += (orgLine[x] - srcLine[x]);
-                count[edgeType] ++;
-              }
-              srcLine  += srcStride;
-              orgLine  += orgStride;
-            }
+            statsEO( startX, endX, endY, endY + skipLinesB[typeIdx], srcStride + 1 );
           }
         }
       }
       break;
     case SAO_TYPE_EO_45:
       {
-        diff +=2;
-        count+=2;
-        int8_t *signUpLine = &m_signLineBuf1[1];
-
         startX = (!isCalculatePreDeblockSamples) ? (isLeftAvail  ? 0 : 1)
                                                  : (isRightAvail ? (width - skipLinesR[typeIdx]) : (width - 1))
                                                  ;
@@ -1377,72 +1239,25 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
                                                  ;
         endY   = isBelowAvail ? (height - skipLinesB[typeIdx]) : (height - 1);
 
-        //prepare 2nd line upper sign
-        Pel* srcLineBelow = srcLine + srcStride;
-        for (x=startX-1; x<endX; x++)
-        {
-          signUpLine[x] = (int8_t)sgn(srcLineBelow[x] - srcLine[x+1]);
-        }
-
-
         //first line
-        Pel* srcLineAbove = srcLine - srcStride;
         firstLineStartX = (!isCalculatePreDeblockSamples) ? (isAboveAvail ? startX : endX)
                                                           : startX
                                                           ;
         firstLineEndX   = (!isCalculatePreDeblockSamples) ? ((!isRightAvail && isAboveRightAvail) ? width : endX)
                                                           : endX
                                                           ;
-        for(x=firstLineStartX; x<firstLineEndX; x++)
-        {
-          edgeType = sgn(srcLine[x] - srcLineAbove[x+1]) - signUpLine[x-1];
-          diff [edgeType] += (orgLine[x] - srcLine[x]);
-          count[edgeType] ++;
-        }
-
-        srcLine += srcStride;
-        orgLine += orgStride;
+        statsEO( firstLineStartX, firstLineEndX, 0, 1, srcStride - 1 );
 
         //middle lines
-        for (y=1; y<endY; y++)
-        {
-          srcLineBelow = srcLine + srcStride;
-
-          for(x=startX; x<endX; x++)
-          {
-            signDown = (int8_t)sgn(srcLine[x] - srcLineBelow[x-1]);
-            edgeType = signDown + signUpLine[x];
+        statsEO( startX, endX, 1, endY, srcStride - 1 );
 
-            diff [edgeType] += (orgLine[x] - srcLine[x]);
-            count[edgeType] ++;
-
-            signUpLine[x-1] = -signDown;
-          }
-          signUpLine[endX-1] = (int8_t)sgn(srcLineBelow[endX-1] - srcLine[endX]);
-          srcLine  += srcStride;
-          orgLine  += orgStride;
-        }
         if(isCalculatePreDeblockSamples)
         {
           if(isBelowAvail)
           {
             startX = isLeftAvail  ? 0     : 1 ;
             endX   = isRightAvail ? width : (width -1);
-
-            for(y=0; y<skipLinesB[typeIdx]; y++)
-            {
-              srcLineBelow = srcLine + srcStride;
-              srcLineAbove = srcLine - srcStride;
-
-              for (x=startX; x<endX; x++)
-              {
-                edgeType = sgn(srcLine[x] - srcLineBelow[x-1]) + sgn(srcLine[x] - srcLineAbove[x+1]);
-                diff [edgeType] += (orgLine[x] - srcLine[x]);
-                count[edgeType] ++;
-              }
-              srcLine  += srcStride;
-              orgLine  += orgStride;
-            }
+            statsEO( startX, endX, endY, endY + skipLinesB[typeIdx], srcStride - 1 );
           }
         }
       }
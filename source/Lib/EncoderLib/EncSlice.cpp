@@ -44,11 +44,6 @@
 #include "CommonLib/dtrace_blockstatistics.h"
 #endif
 
-#if ENABLE_WPP_PARALLELISM
-#include <mutex>
-extern recursive_mutex g_cache_mutex;
-#endif
-
 #include <math.h>
 
 //! \ingroup EncoderLib
@@ -60,6 +55,12 @@ extern recursive_mutex g_cache_mutex;
 
 EncSlice::EncSlice()
  : m_encCABACTableIdx(I_SLICE)
+#if ENABLE_WPP_PARALLELISM
+ , m_threadPool( nullptr )
+ , m_numWppDataInstances( 1 )
+ , m_ctuPredBufs( nullptr )
+ , m_ctuResiBufs( nullptr )
+#endif
 #if ENABLE_QPA
  , m_adaptedLumaQP(-1)
 #endif
@@ -81,6 +82,13 @@ void EncSlice::destroy()
   m_vdRdPicLambda.clear();
   m_vdRdPicQp.clear();
   m_viRdPicQp.clear();
+
+#if ENABLE_WPP_PARALLELISM
+  delete[] m_ctuPredBufs;
+  m_ctuPredBufs = nullptr;
+  delete[] m_ctuResiBufs;
+  m_ctuResiBufs = nullptr;
+#endif
 }
 
 void EncSlice::init( EncLib* pcEncLib, const SPS& sps )
@@ -102,6 +110,26 @@ void EncSlice::init( EncLib* pcEncLib, const SPS& sps )
   m_vdRdPicQp.resize(    m_pcCfg->getDeltaQpRD() * 2 + 1 );
   m_viRdPicQp.resize(    m_pcCfg->getDeltaQpRD() * 2 + 1 );
   m_pcRateCtrl        = pcEncLib->getRateCtrl();
+
+#if ENABLE_WPP_PARALLELISM
+  m_threadPool          = pcEncLib->getThreadPool();
+  m_numWppDataInstances = pcEncLib->getNumWppThreads() + pcEncLib->getNumWppExtraLines();
+
+  if( pcEncLib->getNumWppThreads() > 1 && !m_ctuPredBufs )
+  {
+    // the picture level prediction and residual buffers are only kept for one CTU, the rows encoded in parallel need their own
+    const UnitArea ctuArea( sps.getChromaFormatIdc(), Area( 0, 0, sps.getMaxCUWidth(), sps.getMaxCUHeight() ) );
+
+    m_ctuPredBufs = new PelStorage[m_numWppDataInstances];
+    m_ctuResiBufs = new PelStorage[m_numWppDataInstances];
+
+    for( int dataId = 0; dataId < m_numWppDataInstances; dataId++ )
+    {
+      m_ctuPredBufs[dataId].create( ctuArea );
+      m_ctuResiBufs[dataId].create( ctuArea );
+    }
+  }
+#endif
 }
 
 void
@@ -1366,7 +1394,6 @@ void EncSlice::compressSlice( Picture* pcPic, const bool bCompressEntireSlice, c
   }
 
 #endif
-  m_pcCuEncoder->getModeCtrl()->setFastDeltaQp(bFastDeltaQP);
 
 
   //------------------------------------------------------------------------------
@@ -1473,47 +1500,179 @@ void EncSlice::compressSlice( Picture* pcPic, const bool bCompressEntireSlice, c
   }
 #endif // ENABLE_QPA
 
+#if K0149_BLOCK_STATISTICS
+  const SPS *sps = pcSlice->getSPS();
+  CHECK(sps == 0, "No SPS present");
+  writeBlockStatisticsHeader(sps);
+#endif
+  xInitCtuEncoders( pcPic, bFastDeltaQP, startCtuTsAddr, boundingCtuTsAddr );
+
 #if ENABLE_WPP_PARALLELISM
-  bool bUseThreads = m_pcCfg->getNumWppThreads() > 1;
-  if( bUseThreads )
+  if( m_pcCfg->getNumWppThreads() > 1 )
+  {
+    xCompressCtuRows( pcPic, bCompressEntireSlice, bFastDeltaQP, startCtuTsAddr, boundingCtuTsAddr );
+  }
+  else
+#endif
   {
-    CHECK( startCtuTsAddr != 0 || boundingCtuTsAddr != pcPic->cs->pcv->sizeInCtus, "not intended" );
+    encodeCtus( pcPic, bCompressEntireSlice, bFastDeltaQP, startCtuTsAddr, boundingCtuTsAddr, m_pcLib );
+  }
 
-    pcPic->cs->allocateVectorsAtPicLevel();
+#if HEVC_DEPENDENT_SLICES
+  // store context state at the end of this slice-segment, in case the next slice is a dependent slice and continues using the CABAC contexts.
+  if( pcSlice->getPPS()->getDependentSliceSegmentsEnabledFlag() )
+  {
+    m_lastSliceSegmentEndContextState = m_CABACEstimator->getCtx();//ctx end of dep.slice
+  }
+#endif
+
+}
 
-    omp_set_num_threads( m_pcCfg->getNumWppThreads() + m_pcCfg->getNumWppExtraLines() );
+void EncSlice::xInitCtuEncoders( Picture* pcPic, const bool bFastDeltaQP, uint32_t startCtuTsAddr, uint32_t boundingCtuTsAddr )
+{
+  CodingStructure&  cs            = *pcPic->cs;
+  Slice* pcSlice                  = cs.slice;
 
-    #pragma omp parallel for schedule(static,1) if(bUseThreads)
-    for( int ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ctuTsAddr += widthInCtus )
+  if ( pcSlice->getSPS()->getFpelMmvdEnabledFlag() ||
+      (pcSlice->getSPS()->getIBCFlag() && m_pcCuEncoder->getEncCfg()->getIBCHashSearch()))
+  {
+#if JVET_N0329_IBC_SEARCH_IMP
+    m_pcCuEncoder->getIbcHashMap().rebuildPicHashMap(cs.picture->getTrueOrigBuf());
+    if (m_pcCfg->getIntraPeriod() != -1)
     {
-      // wpp thread start
-      pcPic->scheduler.setWppThreadId();
-#if ENABLE_SPLIT_PARALLELISM
-      pcPic->scheduler.setSplitThreadId( 0 );
+      int hashBlkHitPerc = m_pcCuEncoder->getIbcHashMap().calHashBlkMatchPerc(cs.area.Y());
+      cs.slice->setDisableSATDForRD(hashBlkHitPerc > 59);
+    }
+#else
+    if (pcSlice->getSPS()->getUseReshaper() && m_pcLib->getReshaper()->getCTUFlag() && pcSlice->getSPS()->getIBCFlag())
+      cs.picture->getOrigBuf(COMPONENT_Y).rspSignal(m_pcLib->getReshaper()->getFwdLUT());
+    m_pcCuEncoder->getIbcHashMap().rebuildPicHashMap( cs.picture->getOrigBuf() );
+    if (pcSlice->getSPS()->getUseReshaper() && m_pcLib->getReshaper()->getCTUFlag() && pcSlice->getSPS()->getIBCFlag())
+      cs.picture->getOrigBuf().copyFrom(cs.picture->getTrueOrigBuf());
 #endif
-      encodeCtus( pcPic, bCompressEntireSlice, bFastDeltaQP, ctuTsAddr, ctuTsAddr + widthInCtus, m_pcLib );
-      // wpp thread stop
+  }
+  checkDisFracMmvd( pcPic, startCtuTsAddr, boundingCtuTsAddr );
+
+  if( cs.slice->getSliceType() == B_SLICE )
+  {
+    resetGbiCodingOrder(false, cs);
+  }
+
+  m_pcInterSearch->resetAffineMVList();
+
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
+  for( int jId = 0; jId < m_pcLib->getNumCuEncStacks(); jId++ )
+  {
+    if( jId > 0 )
+    {
+      // the lambdas of the slice have only been set up for the first stack
+      m_pcLib->getRdCost( jId )->copyState( *m_pcRdCost );
+      if( pcSlice->getSPS()->getUseReshaper() )
+      {
+        m_pcLib->getReshaper( jId )->copyState( *m_pcLib->getReshaper() );
+      }
+    }
+    EncCu* cuEncoder = m_pcLib->getCuEncoder( jId );
+    cuEncoder->getModeCtrl()->setFastDeltaQp( bFastDeltaQP );
+    if( cs.slice->getSliceType() == B_SLICE )
+    {
+      m_pcLib->getInterSearch( jId )->initWeightIdxBits();
+    }
+    if( pcSlice->getSPS()->getUseReshaper() )
+    {
+      cuEncoder->setDecCuReshaperInEncCU( m_pcLib->getReshaper( jId ), pcSlice->getSPS()->getChromaFormatIdc() );
     }
   }
-  else
+#else
+  m_pcCuEncoder->getModeCtrl()->setFastDeltaQp( bFastDeltaQP );
+  if( cs.slice->getSliceType() == B_SLICE )
+  {
+    m_pcInterSearch->initWeightIdxBits();
+  }
+  if( pcSlice->getSPS()->getUseReshaper() )
+  {
+    m_pcCuEncoder->setDecCuReshaperInEncCU( m_pcLib->getReshaper(), pcSlice->getSPS()->getChromaFormatIdc() );
+  }
 #endif
-#if K0149_BLOCK_STATISTICS
-  const SPS *sps = pcSlice->getSPS();
-  CHECK(sps == 0, "No SPS present");
-  writeBlockStatisticsHeader(sps);
+}
+
+#if ENABLE_WPP_PARALLELISM
+void EncSlice::xCompressCtuRows( Picture* pcPic, const bool bCompressEntireSlice, const bool bFastDeltaQP, uint32_t startCtuTsAddr, uint32_t boundingCtuTsAddr )
+{
+  CodingStructure&  cs            = *pcPic->cs;
+  const uint32_t    widthInCtus   = cs.pcv->widthInCtus;
+  const int         numCtuRows    = ( int ) cs.pcv->heightInCtus;
+
+  CHECK( startCtuTsAddr != 0 || boundingCtuTsAddr != cs.pcv->sizeInCtus, "CTU row parallel encoding requires one slice per picture" );
+
+  // every CTU row is a job, a row can only take over the CU encoder stack of the row m_numWppDataInstances above once that one is
+  // finished. The rows only wait on rows submitted before them and the encoding does not depend on which thread runs a row.
+  std::vector<CSSubstreamCtx> rowCtx ( numCtuRows );
+  std::vector<SyncValue>      rowDone( numCtuRows );
+  JobCounter                  jobs;
+
+  // the row progress has to be reset for every pass, e.g. the slice QP RD search compresses a picture several times
+#if ENABLE_SPLIT_PARALLELISM
+  pcPic->scheduler.init( numCtuRows, widthInCtus, m_pcCfg->getNumWppThreads(), m_pcCfg->getNumWppExtraLines(), m_pcCfg->getNumSplitThreads() );
+#else
+  pcPic->scheduler.init( numCtuRows, widthInCtus, m_pcCfg->getNumWppThreads(), m_pcCfg->getNumWppExtraLines(), 1 );
 #endif
-  m_pcInterSearch->resetAffineMVList();
-  encodeCtus( pcPic, bCompressEntireSlice, bFastDeltaQP, startCtuTsAddr, boundingCtuTsAddr, m_pcLib );
+  cs.startParallelInsertion();
 
-#if HEVC_DEPENDENT_SLICES
-  // store context state at the end of this slice-segment, in case the next slice is a dependent slice and continues using the CABAC contexts.
-  if( pcSlice->getPPS()->getDependentSliceSegmentsEnabledFlag() )
+  for( int ctuRow = 0; ctuRow < numCtuRows; ctuRow++ )
   {
-    m_lastSliceSegmentEndContextState = m_CABACEstimator->getCtx();//ctx end of dep.slice
+    m_threadPool->addJob( [=, &cs, &rowCtx, &rowDone]()
+    {
+      const int dataId = ctuRow % m_numWppDataInstances;
+
+      if( ctuRow >= m_numWppDataInstances )
+      {
+        rowDone[ctuRow - m_numWppDataInstances].wait( 1 );
+      }
+
+      CSSubstreamCtx& ctx = rowCtx[ctuRow];
+      ctx.predBuf = &m_ctuPredBufs[dataId];
+      ctx.resiBuf = &m_ctuResiBufs[dataId];
+
+      cs.bindSubstreamCtx( &ctx );
+      pcPic->scheduler.setWppThreadId( dataId );
+
+      try
+      {
+        encodeCtus( pcPic, bCompressEntireSlice, bFastDeltaQP, ctuRow * widthInCtus, ( ctuRow + 1 ) * widthInCtus, m_pcLib );
+      }
+      catch( ... )
+      {
+        // release the rows waiting on this one, the error is reported by the pool
+        pcPic->scheduler.setReady( widthInCtus - 1, ctuRow );
+        pcPic->scheduler.setWppThreadId( 0 );
+        cs.bindSubstreamCtx( nullptr );
+        rowDone[ctuRow].set( 1 );
+        throw;
+      }
+
+      pcPic->scheduler.setWppThreadId( 0 );
+      cs.bindSubstreamCtx( nullptr );
+      rowDone[ctuRow].set( 1 );
+    }, jobs );
   }
-#endif
 
+  try
+  {
+    m_threadPool->wait( jobs );
+  }
+  catch( ... )
+  {
+    cs.finishParallelInsertion( rowCtx );
+    throw;
+  }
+
+  cs.finishParallelInsertion( rowCtx );
+
+  m_uiPicTotalBits = cs.fracBits >> SCALE_BITS;
+  m_uiPicDist      = cs.dist;
 }
+#endif
 
 void EncSlice::checkDisFracMmvd( Picture* pcPic, uint32_t startCtuTsAddr, uint32_t boundingCtuTsAddr )
 {
@@ -1576,8 +1735,11 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
   EncCfg*         pCfg            = pEncLib;
   RateCtrl*       pRateCtrl       = pEncLib->getRateCtrl();
 #if ENABLE_WPP_PARALLELISM
-  // first version dont use ctx from above
-  pCABACWriter->initCtxModels( *pcSlice );
+  // the CTU rows are estimated like wavefront substreams, independently of the order they are encoded in
+  const bool      independentRows = pEncLib->getNumWppThreads() > 1 || pEncLib->getEnsureWppBitEqual();
+  const bool      parallelRows    = pEncLib->getNumWppThreads() > 1;
+#else
+  const bool      parallelRows    = false;
 #endif
 #if RDOQ_CHROMA_LAMBDA
   pTrQuant    ->setLambdas( pcSlice->getLambdas() );
@@ -1599,25 +1761,6 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
 #if HEVC_DEPENDENT_SLICES
   }
 #endif
-  if ( pcSlice->getSPS()->getFpelMmvdEnabledFlag() ||
-      (pcSlice->getSPS()->getIBCFlag() && m_pcCuEncoder->getEncCfg()->getIBCHashSearch()))
-  {
-#if JVET_N0329_IBC_SEARCH_IMP
-    m_pcCuEncoder->getIbcHashMap().rebuildPicHashMap(cs.picture->getTrueOrigBuf());
-    if (m_pcCfg->getIntraPeriod() != -1)
-    {
-      int hashBlkHitPerc = m_pcCuEncoder->getIbcHashMap().calHashBlkMatchPerc(cs.area.Y());
-      cs.slice->setDisableSATDForRD(hashBlkHitPerc > 59);
-    }
-#else
-    if (pcSlice->getSPS()->getUseReshaper() && m_pcLib->getReshaper()->getCTUFlag() && pcSlice->getSPS()->getIBCFlag())
-      cs.picture->getOrigBuf(COMPONENT_Y).rspSignal(m_pcLib->getReshaper()->getFwdLUT());
-    m_pcCuEncoder->getIbcHashMap().rebuildPicHashMap( cs.picture->getOrigBuf() );
-    if (pcSlice->getSPS()->getUseReshaper() && m_pcLib->getReshaper()->getCTUFlag() && pcSlice->getSPS()->getIBCFlag())
-      cs.picture->getOrigBuf().copyFrom(cs.picture->getTrueOrigBuf());
-#endif
-  }
-  checkDisFracMmvd( pcPic, startCtuTsAddr, boundingCtuTsAddr );
   // for every CTU in the slice segment (may terminate sooner if there is a byte limit on the slice-segment)
   for( uint32_t ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ctuTsAddr++ )
   {
@@ -1636,12 +1779,12 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
     if( pCfg->getSwitchPOC() != pcPic->poc || -1 == pCfg->getDebugCTU() )
     if ((cs.slice->getSliceType() != I_SLICE || cs.sps->getIBCFlag()) && ctuXPosInCtus == 0)
     {
-      cs.motionLut.lut.resize(0);
-      cs.motionLut.lutIbc.resize(0);
+      cs.getMotionLut().lut.resize(0);
+      cs.getMotionLut().lutIbc.resize(0);
 #if !JVET_N0266_SMALL_BLOCKS
-      cs.motionLut.lutShare.resize(0);
+      cs.getMotionLut().lutShare.resize(0);
 #endif
-      cs.motionLut.lutShareIbc.resize(0);
+      cs.getMotionLut().lutShareIbc.resize(0);
     }
 
 #if ENABLE_WPP_PARALLELISM
@@ -1653,6 +1796,18 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
       pCABACWriter->initCtxModels( *pcSlice );
       prevQP[0] = prevQP[1] = pcSlice->getSliceQp();
     }
+#if ENABLE_WPP_PARALLELISM
+    else if( ctuXPosInCtus == 0 && independentRows )
+    {
+      pCABACWriter->initCtxModels( *pcSlice );
+      if( widthInCtus > 1 )
+      {
+        pCABACWriter->getCtx() = pEncLib->m_entropyCodingSyncContextStateVec[ctuYPosInCtus-1];  // last line
+      }
+      prevQP[0] = prevQP[1] = pcSlice->getSliceQp();
+      pEncLib->getInterSearch( dataId )->resetAffineMVList();
+    }
+#endif
     else if (ctuXPosInCtus == tileXPosInCtus && pEncLib->getEntropyCodingSyncEnabledFlag())
     {
       // reset and then update contexts to the state at the end of the top-right CTU (if within current slice and tile).
@@ -1665,14 +1820,6 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
       prevQP[0] = prevQP[1] = pcSlice->getSliceQp();
     }
 
-#if ENABLE_WPP_PARALLELISM
-    if( ctuXPosInCtus == 0 && ctuYPosInCtus > 0 && widthInCtus > 1 && ( pEncLib->getNumWppThreads() > 1 || pEncLib->getEnsureWppBitEqual() ) )
-    {
-      pCABACWriter->getCtx() = pEncLib->m_entropyCodingSyncContextStateVec[ctuYPosInCtus-1];  // last line
-    }
-#else
-#endif
-
 #if RDOQ_CHROMA_LAMBDA && ENABLE_QPA && !ENABLE_QPA_SUB_CTU
     double oldLambdaArray[MAX_NUM_COMPONENT] = {0.0};
 #endif
@@ -1741,23 +1888,6 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
     }
 #endif
 
-    bool updateGbiCodingOrder = cs.slice->getSliceType() == B_SLICE && ctuTsAddr == startCtuTsAddr;
-    if( updateGbiCodingOrder )
-    {
-      resetGbiCodingOrder(false, cs);
-      m_pcInterSearch->initWeightIdxBits();
-    }
-    if (pcSlice->getSPS()->getUseReshaper())
-    {
-      m_pcCuEncoder->setDecCuReshaperInEncCU(m_pcLib->getReshaper(), pcSlice->getSPS()->getChromaFormatIdc());
-
-#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
-      for (int jId = 1; jId < m_pcLib->getNumCuEncStacks(); jId++)
-      {
-        m_pcLib->getCuEncoder(jId)->setDecCuReshaperInEncCU(m_pcLib->getReshaper(jId), pcSlice->getSPS()->getChromaFormatIdc());
-      }
-#endif
-    }
     if( !cs.slice->isIntra() && pCfg->getMCTSEncConstraint() )
     {
       pcPic->mctsInfo.init( &cs, ctuRsAddr );
@@ -1802,16 +1932,19 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
       break;
     }
 
-#if ENABLE_WPP_PARALLELISM || ENABLE_SPLIT_PARALLELISM
-#pragma omp critical
-#endif
-    pcSlice->setSliceBits( ( uint32_t ) ( pcSlice->getSliceBits() + numberOfWrittenBits ) );
-#if ENABLE_WPP_PARALLELISM || ENABLE_SPLIT_PARALLELISM
-#pragma omp critical
+    {
+#if ENABLE_WPP_PARALLELISM
+      std::unique_lock<std::mutex> lock( m_sliceBitsMutex, std::defer_lock );
+      if( parallelRows )
+      {
+        lock.lock();
+      }
 #endif
+      pcSlice->setSliceBits( ( uint32_t ) ( pcSlice->getSliceBits() + numberOfWrittenBits ) );
 #if HEVC_DEPENDENT_SLICES
-    pcSlice->setSliceSegmentBits( pcSlice->getSliceSegmentBits() + numberOfWrittenBits );
+      pcSlice->setSliceSegmentBits( pcSlice->getSliceSegmentBits() + numberOfWrittenBits );
 #endif
+    }
 
     // Store probabilities of second CTU in line into buffer - used only if wavefront-parallel-processing is enabled.
     if( ctuXPosInCtus == tileXPosInCtus + 1 && pEncLib->getEntropyCodingSyncEnabledFlag() )
@@ -1819,22 +1952,21 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
       pEncLib->m_entropyCodingSyncContextState = pCABACWriter->getCtx();
     }
 #if ENABLE_WPP_PARALLELISM
-    if( ctuXPosInCtus == 1 && ( pEncLib->getNumWppThreads() > 1 || pEncLib->getEnsureWppBitEqual() ) )
+    if( ctuXPosInCtus == 1 && independentRows )
     {
       pEncLib->m_entropyCodingSyncContextStateVec[ctuYPosInCtus] = pCABACWriter->getCtx();
     }
 #endif
 
-#if !ENABLE_WPP_PARALLELISM
-    int actualBits = int(cs.fracBits >> SCALE_BITS);
-    actualBits    -= (int)m_uiPicTotalBits;
-#endif
+    // with the CTU rows encoded in parallel the picture totals are only taken once all rows are done
+    int actualBits = 0;
+    if( !parallelRows )
+    {
+      actualBits  = int(cs.fracBits >> SCALE_BITS);
+      actualBits -= (int)m_uiPicTotalBits;
+    }
     if ( pCfg->getUseRateCtrl() )
     {
-#if ENABLE_WPP_PARALLELISM
-      int actualBits      = int( cs.fracBits >> SCALE_BITS );
-      actualBits         -= (int)m_uiPicTotalBits;
-#endif
       int actualQP        = g_RCInvalidQPValue;
       double actualLambda = pRdCost->getLambda();
       int numberOfEffectivePixels    = 0;
@@ -1880,20 +2012,15 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
     }
 #endif
 
-#if !ENABLE_WPP_PARALLELISM
-    m_uiPicTotalBits += actualBits;
-    m_uiPicDist       = cs.dist;
-#endif
+    if( !parallelRows )
+    {
+      m_uiPicTotalBits += actualBits;
+      m_uiPicDist       = cs.dist;
+    }
 #if ENABLE_WPP_PARALLELISM
     pcPic->scheduler.setReady( ctuXPosInCtus, ctuYPosInCtus );
 #endif
   }
-
-  // this is wpp exclusive section
-
-//  m_uiPicTotalBits += actualBits;
-//  m_uiPicDist       = cs.dist;
-
 }
 
 void EncSlice::encodeSlice   ( Picture* pcPic, OutputBitstream* pcSubstreams, uint32_t &numBinsCoded )
@@ -45,6 +45,7 @@
 
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/Picture.h"
+#include "CommonLib/ThreadPool.h"
 
 //! \ingroup EncoderLib
 //! \{
@@ -98,6 +99,13 @@ private:
 #if SHARP_LUMA_DELTA_QP
   int                     m_gopID;
 #endif
+#if ENABLE_WPP_PARALLELISM
+  ThreadPool*             m_threadPool;                         ///< workers of the CTU row parallel encoding
+  int                     m_numWppDataInstances;                ///< number of CU encoder stacks used by the CTU rows
+  PelStorage*             m_ctuPredBufs;                        ///< CTU sized prediction buffers, one per CU encoder stack
+  PelStorage*             m_ctuResiBufs;                        ///< CTU sized residual buffers, one per CU encoder stack
+  std::mutex              m_sliceBitsMutex;                     ///< guards the slice bit counters updated by all CTU rows
+#endif
 
 #if SHARP_LUMA_DELTA_QP
 public:
@@ -108,6 +116,10 @@ public:
 private:
 #endif
   void    calculateBoundingCtuTsAddrForSlice( uint32_t &startCtuTSAddrSlice, uint32_t &boundingCtuTSAddrSlice, bool &haveReachedTileBoundary, Picture* pcPic, const int sliceMode, const int sliceArgument );
+  void    xInitCtuEncoders    ( Picture* pcPic, const bool bFastDeltaQP, uint32_t startCtuTsAddr, uint32_t boundingCtuTsAddr );
+#if ENABLE_WPP_PARALLELISM
+  void    xCompressCtuRows    ( Picture* pcPic, const bool bCompressEntireSlice, const bool bFastDeltaQP, uint32_t startCtuTsAddr, uint32_t boundingCtuTsAddr );
+#endif
 
 
 public:
@@ -136,9 +148,6 @@ public:
   void    calCostSliceI       ( Picture* pcPic );
 
   void    encodeSlice         ( Picture* pcPic, OutputBitstream* pcSubstreams, uint32_t &numBinsCoded );
-#if ENABLE_WPP_PARALLELISM
-  static
-#endif
   void    encodeCtus          ( Picture* pcPic, const bool bCompressEntireSlice, const bool bFastDeltaQP, uint32_t startCtuTsAddr, uint32_t boundingCtuTsAddr, EncLib* pcEncLib );
   void    checkDisFracMmvd    ( Picture* pcPic, uint32_t startCtuTsAddr, uint32_t boundingCtuTsAddr );
 
@@ -66,8 +66,6 @@ private:
   EncModeCtrl    *m_modeCtrl;
   Pel*            m_pSharedPredTransformSkip[MAX_NUM_TBLOCKS];
 
-  XUCache         m_unitCache;
-
   CodingStructure ****m_pSplitCS;
   CodingStructure ****m_pFullCS;
 
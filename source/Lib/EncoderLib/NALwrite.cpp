@@ -33,10 +33,12 @@
 
 #include <vector>
 #include <algorithm>
+#include <string.h>
 #include <ostream>
 
 #include "CommonLib/NAL.h"
 #include "CommonLib/BitStream.h"
+#include "CommonLib/SSE2Baseline.h"
 #include "NALwrite.h"
 
 using namespace std;
@@ -90,8 +92,20 @@ void write(ostream& out, OutputNALUnit& nalu)
   outputBuffer.resize(rbsp.size()*2+1); //there can never be enough emulation_prevention_three_bytes to require this much space
   std::size_t outputAmount = 0;
   int         zeroCount    = 0;
-  for (vector<uint8_t>::iterator it = rbsp.begin(); it != rbsp.end(); it++)
+  const uint8_t* const itEnd = rbsp.data() + rbsp.size();
+  for (const uint8_t* it = rbsp.data(); it != itEnd; it++)
   {
+#if ENABLE_SSE2_BASELINE
+    if (zeroCount == 0 && itEnd - it > 16 && !hasZeroBytePair(it))
+    {
+      // no emulation_prevention_three_byte required within the next 16 bytes
+      memcpy(&outputBuffer[outputAmount], it, 16);
+      outputAmount += 16;
+      zeroCount     = (it[15] == 0) ? 1 : 0;
+      it           += 15;
+      continue;
+    }
+#endif
     const uint8_t v=(*it);
     if (zeroCount==2 && v<=3)
     {
@@ -36,9 +36,6 @@
 #include "EncGOP.h"
 #include "EncLib.h"
 
-uint32_t calcMD5(const CPelUnitBuf& pic, PictureHash &digest, const BitDepths &bitDepths);
-uint32_t calcCRC(const CPelUnitBuf& pic, PictureHash &digest, const BitDepths &bitDepths);
-uint32_t calcChecksum(const CPelUnitBuf& pic, PictureHash &digest, const BitDepths &bitDepths);
 std::string hashToString(const PictureHash &digest, int numChar);
 
 //! \ingroup EncoderLib
@@ -301,34 +298,14 @@ void SEIEncoder::initSEIRecoveryPoint(SEIRecoveryPoint *recoveryPointSEI, Slice
 
 
 //! calculate hashes for entire reconstructed picture
-void SEIEncoder::initDecodedPictureHashSEI(SEIDecodedPictureHash *decodedPictureHashSEI, PelUnitBuf& pic, std::string &rHashString, const BitDepths &bitDepths)
+void SEIEncoder::initDecodedPictureHashSEI(SEIDecodedPictureHash *decodedPictureHashSEI, PictureHashJobs& hashJobs, std::string &rHashString)
 {
   CHECK(!(m_isInitialized), "Unspecified error");
   CHECK(!(decodedPictureHashSEI!=NULL), "Unspecified error");
 
   decodedPictureHashSEI->method = m_pcCfg->getDecodedPictureHashSEIType();
-  switch (m_pcCfg->getDecodedPictureHashSEIType())
-  {
-    case HASHTYPE_MD5:
-      {
-        uint32_t numChar=calcMD5(pic, decodedPictureHashSEI->m_pictureHash, bitDepths);
-        rHashString = hashToString(decodedPictureHashSEI->m_pictureHash, numChar);
-      }
-      break;
-    case HASHTYPE_CRC:
-      {
-        uint32_t numChar=calcCRC(pic, decodedPictureHashSEI->m_pictureHash, bitDepths);
-        rHashString = hashToString(decodedPictureHashSEI->m_pictureHash, numChar);
-      }
-      break;
-    case HASHTYPE_CHECKSUM:
-    default:
-      {
-        uint32_t numChar=calcChecksum(pic, decodedPictureHashSEI->m_pictureHash, bitDepths);
-        rHashString = hashToString(decodedPictureHashSEI->m_pictureHash, numChar);
-      }
-      break;
-  }
+  uint32_t numChar=hashJobs.finish(decodedPictureHashSEI->m_pictureHash);
+  rHashString = hashToString(decodedPictureHashSEI->m_pictureHash, numChar);
 }
 
 void SEIEncoder::initTemporalLevel0IndexSEI(SEITemporalLevel0Index *temporalLevel0IndexSEI, Slice *slice)
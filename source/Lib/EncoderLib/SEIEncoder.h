@@ -42,6 +42,7 @@
 class EncCfg;
 class EncLib;
 class EncGOP;
+class PictureHashJobs;
 
 
 //! Initializes different SEI message types based on given encoder configuration parameters
@@ -90,7 +91,7 @@ public:
 #endif
 
   // trailing SEIs
-  void initDecodedPictureHashSEI(SEIDecodedPictureHash *sei, PelUnitBuf& pic, std::string &rHashString, const BitDepths &bitDepths);
+  void initDecodedPictureHashSEI(SEIDecodedPictureHash *sei, PictureHashJobs& hashJobs, std::string &rHashString);  ///< finishes the hash jobs started for the picture
   void initTemporalLevel0IndexSEI(SEITemporalLevel0Index *sei, Slice *slice);
   void initSEIGreenMetadataInfo(SEIGreenMetadataInfo *sei, uint32_t u);
 
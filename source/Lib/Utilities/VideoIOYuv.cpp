@@ -45,11 +45,15 @@
 #include "CommonLib/Rom.h"
 #include "VideoIOYuv.h"
 #include "CommonLib/Unit.h"
+#include "CommonLib/SSE2Baseline.h"
 
 using namespace std;
 
 #define FLIP_PIC 0
 
+// the samples of 16 bit files can be copied as they are (little-endian host with 16 bit Pel)
+#define VIDEOIO_COPY_16BIT ( ENABLE_SSE2_BASELINE && !RExt__HIGH_BIT_DEPTH_SUPPORT )
+
 // ====================================================================================================================
 // Local Functions
 // ====================================================================================================================
@@ -104,6 +108,83 @@ static void scalePlane( PelBuf& areaBuf, const int shiftbits, const Pel minval,
 }
 
 
+/**
+ * Convert one line of width file samples (8 bit or 16 bit little-endian)
+ * at src to dst.
+ */
+static void readLine( Pel* dst, const uint8_t* src, const uint32_t width, const bool is16bit )
+{
+  uint32_t x = 0;
+
+  if( is16bit )
+  {
+#if VIDEOIO_COPY_16BIT
+    memcpy( dst, src, width * sizeof( Pel ) );
+    x = width;
+#endif
+    for( ; x < width; x++ )
+    {
+      dst[x] = Pel( src[2*x+0] ) | ( Pel( src[2*x+1] ) << 8 );
+    }
+  }
+  else
+  {
+#if ENABLE_SSE2_BASELINE && !RExt__HIGH_BIT_DEPTH_SUPPORT
+    const __m128i vzero = _mm_setzero_si128();
+    for( ; x + 16 <= width; x += 16 )
+    {
+      const __m128i vsrc = _mm_loadu_si128( ( const __m128i* ) &src[x] );
+      _mm_storeu_si128( ( __m128i* ) &dst[x],     _mm_unpacklo_epi8( vsrc, vzero ) );
+      _mm_storeu_si128( ( __m128i* ) &dst[x + 8], _mm_unpackhi_epi8( vsrc, vzero ) );
+    }
+#endif
+    for( ; x < width; x++ )
+    {
+      dst[x] = src[x];
+    }
+  }
+}
+
+/**
+ * Convert one line of width samples at src to the file format (8 bit or
+ * 16 bit little-endian) at dst.
+ */
+static void writeLine( uint8_t* dst, const Pel* src, const uint32_t width, const bool is16bit )
+{
+  uint32_t x = 0;
+
+  if( is16bit )
+  {
+#if VIDEOIO_COPY_16BIT
+    memcpy( dst, src, width * sizeof( Pel ) );
+    x = width;
+#endif
+    for( ; x < width; x++ )
+    {
+      dst[2*x  ] = ( src[x] >> 0 ) & 0xff;
+      dst[2*x+1] = ( src[x] >> 8 ) & 0xff;
+    }
+  }
+  else
+  {
+#if ENABLE_SSE2_BASELINE && !RExt__HIGH_BIT_DEPTH_SUPPORT
+    // keep the low byte, as the scalar cast does
+    const __m128i vmask = _mm_set1_epi16( 0xff );
+    for( ; x + 16 <= width; x += 16 )
+    {
+      const __m128i vlo = _mm_and_si128( _mm_loadu_si128( ( const __m128i* ) &src[x] ),     vmask );
+      const __m128i vhi = _mm_and_si128( _mm_loadu_si128( ( const __m128i* ) &src[x + 8] ), vmask );
+      _mm_storeu_si128( ( __m128i* ) &dst[x], _mm_packus_epi16( vlo, vhi ) );
+    }
+#endif
+    for( ; x < width; x++ )
+    {
+      dst[x] = ( uint8_t ) src[x];
+    }
+  }
+}
+
+
 // ====================================================================================================================
 // Public member functions
 // ====================================================================================================================
@@ -242,6 +323,7 @@ void VideoIOYuv::skipFrames(uint32_t numFrames, uint32_t width, uint32_t height,
  *
  * @param dst          destination image plane
  * @param fd           input file stream
+ * @param fileBuf      buffer for the file data of one plane
  * @param is16bit      true if input file carries > 8bit data, false otherwise.
  * @param stride444    distance between vertically adjacent pixels of dst.
  * @param width444     width of active area in dst.
@@ -256,6 +338,7 @@ void VideoIOYuv::skipFrames(uint32_t numFrames, uint32_t width, uint32_t height,
  */
 static bool readPlane(Pel* dst,
                       istream& fd,
+                      std::vector<uint8_t>& fileBuf,
                       bool is16bit,
                       uint32_t stride444,
                       uint32_t width444,
@@ -317,6 +400,35 @@ static bool readPlane(Pel* dst,
       }
     }
   }
+  else if (csx_file == csx_dest && csy_file == csy_dest)
+  {
+    // same sampling in file and picture, read the whole plane at once
+    fileBuf.resize(stride_file * height_dest);
+    fd.read(reinterpret_cast<char*>(fileBuf.data()), fileBuf.size());
+    if (fd.eof() || fd.fail() )
+    {
+      return false;
+    }
+
+    const uint8_t *pFileBuf = fileBuf.data();
+    for (uint32_t y = 0; y < height_dest; y++, pFileBuf+= stride_file, pDstBuf+= dstbuf_stride)
+    {
+      readLine(pDstBuf, pFileBuf, width_dest, is16bit);
+
+      // process right hand side padding
+      const Pel padVal=dst[width_dest-1];
+      for (uint32_t x = width_dest; x < full_width_dest; x++)
+      {
+        pDstBuf[x] = padVal;
+      }
+    }
+
+    // process lower padding
+    for (uint32_t y = height_dest; y < full_height_dest; y++, pDstPad+=stride_dest)
+    {
+      memcpy(pDstPad, pDstPad - stride_dest, full_width_dest * sizeof(Pel));
+    }
+  }
   else
   {
     const uint32_t mask_y_file=(1<<csy_file)-1;
@@ -442,6 +554,7 @@ static bool verifyPlane(Pel* dst,
  * Write an image plane (width444*height444 pixels) from src into output stream fd.
  *
  * @param fd         output file stream
+ * @param fileBuf    buffer for the file data of one plane
  * @param src        source image
  * @param is16bit    true if input file carries > 8bit data, false otherwise.
  * @param stride444  distance between vertically adjacent pixels of src.
@@ -453,7 +566,7 @@ static bool verifyPlane(Pel* dst,
  * @param fileBitDepth component bit depth in file
  * @return true for success, false in case of error
  */
-static bool writePlane(ostream& fd, const Pel* src,
+static bool writePlane(ostream& fd, std::vector<uint8_t>& fileBuf, const Pel* src,
                        const bool is16bit,
                        const uint32_t stride_src,
                        uint32_t width444, uint32_t height444,
@@ -606,6 +719,23 @@ static bool writePlane(ostream& fd, const Pel* src,
       }
     }
   }
+  else if (csx_file == csx_src && csy_file == csy_src)
+  {
+    // same sampling in picture and file, write the whole plane at once
+    fileBuf.resize(stride_file * height_file);
+
+    uint8_t *pFileBuf = fileBuf.data();
+    for (uint32_t y = 0; y < height_file; y++, pFileBuf += stride_file, pSrcBuf += srcbuf_stride)
+    {
+      writeLine(pFileBuf, pSrcBuf, width_file, is16bit);
+    }
+
+    fd.write(reinterpret_cast<const char*>(fileBuf.data()), fileBuf.size());
+    if (fd.eof() || fd.fail())
+    {
+      return false;
+    }
+  }
   else
   {
     const uint32_t mask_y_file = (1 << csy_file) - 1;
@@ -881,7 +1011,7 @@ bool VideoIOYuv::read ( PelUnitBuf& pic, PelUnitBuf& picOrg, const InputColourSp
 #if EXTENSION_360_VIDEO
     const uint32_t stride444 = picOrg.get(compID).stride;
 #endif
-    if ( ! readPlane( dst, m_cHandle, is16bit, stride444, width444, height444, pad_h444, pad_v444, compID, picOrg.chromaFormat, format, m_fileBitdepth[chType]))
+    if ( ! readPlane( dst, m_cHandle, m_fileBuf, is16bit, stride444, width444, height444, pad_h444, pad_v444, compID, picOrg.chromaFormat, format, m_fileBitdepth[chType]))
     {
       return false;
     }
@@ -998,7 +1128,7 @@ bool VideoIOYuv::write( const CPelUnitBuf& pic,
     const uint32_t    csy         = ::getComponentScaleY(compID, format);
     const CPelBuf     area        = picO.get(compID);
     const int         planeOffset = (confLeft >> csx) + (confTop >> csy) * area.stride;
-    if (!writePlane (m_cHandle, area.bufAt (0, 0) + planeOffset, is16bit, area.stride,
+    if (!writePlane (m_cHandle, m_fileBuf, area.bufAt (0, 0) + planeOffset, is16bit, area.stride,
                      width444, height444, compID, picO.chromaFormat, format, m_fileBitdepth[ch],
                      bPackedYUVOutputMode ? 1 : 0))
     {
@@ -41,6 +41,7 @@
 #include <stdio.h>
 #include <fstream>
 #include <iostream>
+#include <vector>
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/Unit.h"
 
@@ -58,6 +59,7 @@ private:
   int       m_fileBitdepth[MAX_NUM_CHANNEL_TYPE]; ///< bitdepth of input/output video file
   int       m_MSBExtendedBitDepth[MAX_NUM_CHANNEL_TYPE];  ///< bitdepth after addition of MSBs (with value 0)
   int       m_bitdepthShift[MAX_NUM_CHANNEL_TYPE];  ///< number of bits to increase or decrease image by before/after write/read
+  std::vector<uint8_t> m_fileBuf;                   ///< file data of one plane, for reading/writing whole planes
 
 public:
   VideoIOYuv()           {}
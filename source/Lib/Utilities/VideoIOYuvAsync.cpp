@@ -0,0 +1,417 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     VideoIOYuvAsync.cpp
+    \brief    background threads reading YUV frames ahead of and writing YUV frames behind the coder
+*/
+
+#include "VideoIOYuvAsync.h"
+
+// ====================================================================================================================
+// Read ahead
+// ====================================================================================================================
+
+VideoIOYuvReadAhead::VideoIOYuvReadAhead()
+: m_file           ( nullptr )
+, m_numFramesToRead( 0 )
+, m_numSkipFrames  ( 0 )
+, m_numRead        ( 0 )
+, m_numTaken       ( 0 )
+, m_numReleased    ( 0 )
+, m_done           ( false )
+, m_exit           ( false )
+{
+}
+
+VideoIOYuvReadAhead::~VideoIOYuvReadAhead()
+{
+  destroy();
+}
+
+void VideoIOYuvReadAhead::create( VideoIOYuv& file, const int numBufFrames, const UnitArea& area,
+                                  const InputColourSpaceConversion ipcsc, const int aiPad[2], const ChromaFormat fileFormat, const bool bClipToRec709,
+                                  const int numFramesToRead, const int numSkipFrames, const uint32_t skipWidth, const uint32_t skipHeight, const ChromaFormat skipFormat )
+{
+  CHECK( numBufFrames < 1, "The read ahead needs at least one frame buffer" );
+  CHECK( m_thread.joinable(), "The read ahead is already running" );
+
+  m_file            = &file;
+  m_ipcsc           = ipcsc;
+  m_pad[0]          = aiPad[0];
+  m_pad[1]          = aiPad[1];
+  m_fileFormat      = fileFormat;
+  m_clipToRec709    = bClipToRec709;
+  m_numFramesToRead = numFramesToRead;
+  m_numSkipFrames   = numSkipFrames;
+  m_skipWidth       = skipWidth;
+  m_skipHeight      = skipHeight;
+  m_skipFormat      = skipFormat;
+
+  // one more buffer than frames read ahead, the caller holds the last frame returned by read()
+  for( int i = 0; i <= numBufFrames; i++ )
+  {
+    Frame* frame = new Frame;
+    frame->pic   .create( area );
+    frame->picOrg.create( area );
+    frame->eof   = false;
+    m_frames.push_back( frame );
+  }
+
+  m_numRead     = 0;
+  m_numTaken    = 0;
+  m_numReleased = 0;
+  m_done        = false;
+  m_exit        = false;
+  m_thread      = std::thread( &VideoIOYuvReadAhead::xReadFrames, this );
+}
+
+void VideoIOYuvReadAhead::destroy()
+{
+  if( m_thread.joinable() )
+  {
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_exit = true;
+    }
+    m_cond.notify_all();
+    m_thread.join();
+  }
+
+  for( auto& frame : m_frames )
+  {
+    delete frame;
+  }
+  m_frames.clear();
+}
+
+bool VideoIOYuvReadAhead::read( PelStorage*& pic, PelStorage*& picOrg )
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+
+  if( m_numTaken > m_numReleased )
+  {
+    m_numReleased = m_numTaken;
+    m_cond.notify_all();
+  }
+
+  m_cond.wait( lock, [this]{ return m_numTaken < m_numRead || m_done; } );
+
+  if( m_numTaken == m_numRead )
+  {
+    return false;
+  }
+
+  Frame& frame = *m_frames[m_numTaken++ % m_frames.size()];
+
+  if( frame.error )
+  {
+    std::rethrow_exception( frame.error );
+  }
+
+  pic    = &frame.pic;
+  picOrg = &frame.picOrg;
+
+  return !frame.eof;
+}
+
+void VideoIOYuvReadAhead::xReadFrames()
+{
+  int numRead = 0;
+
+  while( true )
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_cond.wait( lock, [this]{ return m_exit || m_numRead < m_numReleased + m_frames.size(); } );
+
+    if( m_exit )
+    {
+      break;
+    }
+
+    Frame& frame = *m_frames[m_numRead % m_frames.size()];
+    lock.unlock();
+
+    try
+    {
+      m_file->read( frame.pic, frame.picOrg, m_ipcsc, m_pad, m_fileFormat, m_clipToRec709 );
+      frame.eof = m_file->isEof();
+
+      if( !frame.eof && m_numSkipFrames > 0 )
+      {
+        m_file->skipFrames( m_numSkipFrames, m_skipWidth, m_skipHeight, m_skipFormat );
+      }
+    }
+    catch( ... )
+    {
+      frame.error = std::current_exception();
+      frame.eof   = true;
+    }
+
+    lock.lock();
+    m_numRead++;
+    m_cond.notify_all();
+
+    if( frame.eof || ++numRead == m_numFramesToRead )
+    {
+      break;
+    }
+  }
+
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_done = true;
+  m_cond.notify_all();
+}
+
+// ====================================================================================================================
+// Write behind
+// ====================================================================================================================
+
+static void copyToStorage( PelStorage& dst, const CPelUnitBuf& src )
+{
+  const Area area( 0, 0, src.Y().width, src.Y().height );
+
+  if( dst.bufs.empty() || dst.chromaFormat != src.chromaFormat || dst.Y().width != area.width || dst.Y().height != area.height )
+  {
+    dst.destroy();
+    dst.create( src.chromaFormat, area );
+  }
+
+  dst.copyFrom( src );
+}
+
+VideoIOYuvWriteBehind::VideoIOYuvWriteBehind()
+: m_file      ( nullptr )
+, m_numQueued ( 0 )
+, m_numWritten( 0 )
+, m_exit      ( false )
+{
+}
+
+VideoIOYuvWriteBehind::~VideoIOYuvWriteBehind()
+{
+  destroy();
+}
+
+void VideoIOYuvWriteBehind::create( VideoIOYuv& file, const int numBufFrames )
+{
+  CHECK( m_thread.joinable(), "The write behind is already running" );
+
+  m_file = &file;
+
+  for( int i = 0; i < numBufFrames; i++ )
+  {
+    m_frames.push_back( new Frame );
+  }
+
+  m_numQueued  = 0;
+  m_numWritten = 0;
+  m_error      = nullptr;
+  m_exit       = false;
+
+  if( !m_frames.empty() )
+  {
+    m_thread = std::thread( &VideoIOYuvWriteBehind::xWriteFrames, this );
+  }
+}
+
+void VideoIOYuvWriteBehind::destroy()
+{
+  if( m_thread.joinable() )
+  {
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_exit = true;
+    }
+    m_cond.notify_all();
+    m_thread.join();
+  }
+
+  for( auto& frame : m_frames )
+  {
+    delete frame;
+  }
+  m_frames.clear();
+}
+
+void VideoIOYuvWriteBehind::write( const CPelUnitBuf& pic,
+                                   const InputColourSpaceConversion ipCSC,
+                                   const bool bPackedYUVOutputMode,
+                                   int confLeft, int confRight, int confTop, int confBottom, ChromaFormat format, const bool bClipToRec709 )
+{
+  if( m_frames.empty() )
+  {
+    if( !m_file->write( pic, ipCSC, bPackedYUVOutputMode, confLeft, confRight, confTop, confBottom, format, bClipToRec709 ) )
+    {
+      THROW( "Failed to write the output frame" );
+    }
+    return;
+  }
+
+  Frame& frame = xGetFreeFrame();
+
+  copyToStorage( frame.pic, pic );
+  frame.isField             = false;
+  frame.ipCSC               = ipCSC;
+  frame.packedYUVOutputMode = bPackedYUVOutputMode;
+  frame.conf[0]             = confLeft;
+  frame.conf[1]             = confRight;
+  frame.conf[2]             = confTop;
+  frame.conf[3]             = confBottom;
+  frame.format              = format;
+  frame.isTff               = false;
+  frame.clipToRec709        = bClipToRec709;
+
+  xPushFrame();
+}
+
+void VideoIOYuvWriteBehind::write( const CPelUnitBuf& picTop, const CPelUnitBuf& picBot,
+                                   const InputColourSpaceConversion ipCSC,
+                                   const bool bPackedYUVOutputMode,
+                                   int confLeft, int confRight, int confTop, int confBottom, ChromaFormat format, const bool isTff, const bool bClipToRec709 )
+{
+  if( m_frames.empty() )
+  {
+    if( !m_file->write( picTop, picBot, ipCSC, bPackedYUVOutputMode, confLeft, confRight, confTop, confBottom, format, isTff, bClipToRec709 ) )
+    {
+      THROW( "Failed to write the output frame" );
+    }
+    return;
+  }
+
+  Frame& frame = xGetFreeFrame();
+
+  copyToStorage( frame.pic,    picTop );
+  copyToStorage( frame.picBot, picBot );
+  frame.isField             = true;
+  frame.ipCSC               = ipCSC;
+  frame.packedYUVOutputMode = bPackedYUVOutputMode;
+  frame.conf[0]             = confLeft;
+  frame.conf[1]             = confRight;
+  frame.conf[2]             = confTop;
+  frame.conf[3]             = confBottom;
+  frame.format              = format;
+  frame.isTff               = isTff;
+  frame.clipToRec709        = bClipToRec709;
+
+  xPushFrame();
+}
+
+void VideoIOYuvWriteBehind::flush()
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_cond.wait( lock, [this]{ return m_numWritten == m_numQueued; } );
+
+  if( m_error )
+  {
+    std::rethrow_exception( m_error );
+  }
+}
+
+VideoIOYuvWriteBehind::Frame& VideoIOYuvWriteBehind::xGetFreeFrame()
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_cond.wait( lock, [this]{ return m_numQueued < m_numWritten + m_frames.size(); } );
+
+  if( m_error )
+  {
+    std::rethrow_exception( m_error );
+  }
+
+  return *m_frames[m_numQueued % m_frames.size()];
+}
+
+void VideoIOYuvWriteBehind::xPushFrame()
+{
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_numQueued++;
+  }
+  m_cond.notify_all();
+}
+
+void VideoIOYuvWriteBehind::xWriteFrames()
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+
+  while( true )
+  {
+    m_cond.wait( lock, [this]{ return m_exit || m_numWritten < m_numQueued; } );
+
+    if( m_numWritten == m_numQueued )
+    {
+      // only left when all queued frames are written
+      break;
+    }
+
+    Frame&     frame  = *m_frames[m_numWritten % m_frames.size()];
+    const bool skip  = m_error != nullptr;
+    lock.unlock();
+
+    // after a failed write the remaining frames are dropped, the error is reported by the next write() or flush()
+    std::exception_ptr error;
+    if( !skip )
+    {
+      try
+      {
+        bool written;
+        if( frame.isField )
+        {
+          written = m_file->write( frame.pic, frame.picBot, frame.ipCSC, frame.packedYUVOutputMode,
+                                   frame.conf[0], frame.conf[1], frame.conf[2], frame.conf[3], frame.format, frame.isTff, frame.clipToRec709 );
+        }
+        else
+        {
+          written = m_file->write( frame.pic, frame.ipCSC, frame.packedYUVOutputMode,
+                                   frame.conf[0], frame.conf[1], frame.conf[2], frame.conf[3], frame.format, frame.clipToRec709 );
+        }
+        if( !written )
+        {
+          THROW( "Failed to write the output frame" );
+        }
+      }
+      catch( ... )
+      {
+        error = std::current_exception();
+      }
+    }
+
+    lock.lock();
+    if( error && !m_error )
+    {
+      m_error = error;
+    }
+    m_numWritten++;
+    m_cond.notify_all();
+  }
+}
@@ -0,0 +1,155 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     VideoIOYuvAsync.h
+    \brief    background threads reading YUV frames ahead of and writing YUV frames behind the coder (header)
+*/
+
+#ifndef __VIDEOIOYUVASYNC__
+#define __VIDEOIOYUVASYNC__
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "VideoIOYuv.h"
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// reads the frames of an input file on a background thread, up to a fixed number of frames ahead of the encoder
+class VideoIOYuvReadAhead
+{
+public:
+  VideoIOYuvReadAhead();
+  ~VideoIOYuvReadAhead();
+
+  /// starts reading numFramesToRead frames (0: up to the end of the file) with the parameters of VideoIOYuv::read,
+  /// numSkipFrames frames of the given file size are skipped after each frame
+  void  create ( VideoIOYuv& file, const int numBufFrames, const UnitArea& area,
+                 const InputColourSpaceConversion ipcsc, const int aiPad[2], const ChromaFormat fileFormat, const bool bClipToRec709,
+                 const int numFramesToRead, const int numSkipFrames, const uint32_t skipWidth, const uint32_t skipHeight, const ChromaFormat skipFormat );
+  void  destroy();
+
+  /// returns the next frame or false at the end of the file, the buffers are valid up to the next call
+  bool  read   ( PelStorage*& pic, PelStorage*& picOrg );
+
+private:
+  struct Frame
+  {
+    PelStorage         pic;
+    PelStorage         picOrg;
+    bool               eof;
+    std::exception_ptr error;
+  };
+
+  void  xReadFrames();
+
+  VideoIOYuv*                m_file;
+  std::vector<Frame*>        m_frames;
+  InputColourSpaceConversion m_ipcsc;
+  int                        m_pad[2];
+  ChromaFormat               m_fileFormat;
+  bool                       m_clipToRec709;
+  int                        m_numFramesToRead;
+  int                        m_numSkipFrames;
+  uint32_t                   m_skipWidth;
+  uint32_t                   m_skipHeight;
+  ChromaFormat               m_skipFormat;
+
+  size_t                     m_numRead;        ///< frames read by the background thread
+  size_t                     m_numTaken;       ///< frames handed out by read()
+  size_t                     m_numReleased;    ///< frames whose buffers can be reused
+  bool                       m_done;
+  bool                       m_exit;
+  std::thread                m_thread;
+  std::mutex                 m_mutex;
+  std::condition_variable    m_cond;
+};
+
+/// writes frames to an output file on a background thread, the frames are copied into a ring of buffers
+/// Without buffers (numBufFrames = 0) the frames are written directly by the calling thread.
+class VideoIOYuvWriteBehind
+{
+public:
+  VideoIOYuvWriteBehind();
+  ~VideoIOYuvWriteBehind();
+
+  void  create ( VideoIOYuv& file, const int numBufFrames );
+  void  destroy();                                          ///< writes all pending frames and stops the thread
+
+  /// same parameters as VideoIOYuv::write, a failed write throws (when written behind: in the next write() or flush())
+  void  write  ( const CPelUnitBuf& pic,
+                 const InputColourSpaceConversion ipCSC,
+                 const bool bPackedYUVOutputMode,
+                 int confLeft = 0, int confRight = 0, int confTop = 0, int confBottom = 0, ChromaFormat format = NUM_CHROMA_FORMAT, const bool bClipToRec709 = false );
+  void  write  ( const CPelUnitBuf& picTop, const CPelUnitBuf& picBot,
+                 const InputColourSpaceConversion ipCSC,
+                 const bool bPackedYUVOutputMode,
+                 int confLeft = 0, int confRight = 0, int confTop = 0, int confBottom = 0, ChromaFormat format = NUM_CHROMA_FORMAT, const bool isTff = false, const bool bClipToRec709 = false );
+  void  flush  ();                                          ///< blocks until all frames are written
+
+private:
+  struct Frame
+  {
+    PelStorage                 pic;
+    PelStorage                 picBot;
+    bool                       isField;
+    InputColourSpaceConversion ipCSC;
+    bool                       packedYUVOutputMode;
+    int                        conf[4];
+    ChromaFormat               format;
+    bool                       isTff;
+    bool                       clipToRec709;
+  };
+
+  Frame& xGetFreeFrame();
+  void   xPushFrame   ();
+  void   xWriteFrames ();
+
+  VideoIOYuv*                m_file;
+  std::vector<Frame*>        m_frames;
+  size_t                     m_numQueued;      ///< frames handed in by write()
+  size_t                     m_numWritten;     ///< frames written by the background thread
+  std::exception_ptr         m_error;
+  bool                       m_exit;
+  std::thread                m_thread;
+  std::mutex                 m_mutex;
+  std::condition_variable    m_cond;
+};
+
+#endif // __VIDEOIOYUVASYNC__